@@ -78,6 +78,8 @@ namespace automotive {
                  */
                 virtual void add(odcore::data::Container &container);
 
+                virtual void add(odcore::data::Container &&container);
+
                 virtual void clear();
 
                 virtual uint32_t getSize() const;
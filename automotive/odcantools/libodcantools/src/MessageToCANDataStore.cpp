@@ -40,6 +40,10 @@ namespace automotive {
             }
         }
 
+        void MessageToCANDataStore::add(odcore::data::Container &&container) {
+            add(container);
+        }
+
         void MessageToCANDataStore::clear() {}
 
         uint32_t MessageToCANDataStore::getSize() const {
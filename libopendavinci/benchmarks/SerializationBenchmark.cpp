@@ -0,0 +1,446 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// This benchmark measures the encoding and decoding throughput as well as
+// the number of heap allocations per message for the supported wire formats
+// and the throughput of the varint decoders.
+// The results are written as JSON to stdout to compare different releases:
+//
+// SerializationBenchmark [--iterations=N] > results.json
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Visitor.h"
+#include "opendavinci/odcore/serialization/QueryableNetstringsDeserializer.h"
+#include "opendavinci/odcore/serialization/QueryableNetstringsSerializer.h"
+#include "opendavinci/odcore/serialization/SerializationFactory.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
+#include "opendavincitestdata/generated/odcore/testdata/TestMessage3.h"
+#include "opendavincitestdata/generated/odcore/testdata/TestMessage5.h"
+#include "opendavincitestdata/generated/odcore/testdata/TestMessage7.h"
+#include "opendavincitestdata/generated/odcore/testdata/TestMessage8.h"
+#include "opendavincitestdata/generated/odcore/testdata/TestMessage11.h"
+
+using namespace std;
+using namespace odcore::base;
+using namespace odcore::serialization;
+
+///////////////////////////////////////////////////////////////////////////////
+// Count all heap allocations of this process.
+
+static std::atomic<uint64_t> numberOfAllocations(0);
+
+void* operator new(size_t size, const std::nothrow_t &) noexcept {
+    numberOfAllocations++;
+    return malloc(size > 0 ? size : 1);
+}
+
+void* operator new(size_t size) {
+    void *ptr = operator new(size, std::nothrow);
+    if (ptr == NULL) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    free(ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This SerializationFactory replaces the default serializers with the
+ * queryable Netstrings ones as done for recordings in this format.
+ */
+class QueryableNetstringsSerializationFactory : public SerializationFactory {
+    public:
+        QueryableNetstringsSerializationFactory() {
+            SerializationFactory::m_singleton = this;
+        }
+
+        virtual ~QueryableNetstringsSerializationFactory() {
+            SerializationFactory::m_singleton = NULL;
+        }
+
+        virtual std::shared_ptr<Serializer> getSerializer(ostream &out) const {
+            return getQueryableNetstringsSerializer(out);
+        }
+
+        virtual std::shared_ptr<Deserializer> getDeserializer(istream &in) const {
+            return getQueryableNetstringsDeserializer(in);
+        }
+
+    private:
+        QueryableNetstringsSerializationFactory(const QueryableNetstringsSerializationFactory &);
+        QueryableNetstringsSerializationFactory& operator=(const QueryableNetstringsSerializationFactory &);
+};
+
+/**
+ * Result of one benchmark.
+ */
+struct Result {
+    Result() :
+        format(),
+        message(),
+        type(),
+        operation(),
+        iterations(0),
+        bytes(0),
+        nanosecondsPerMessage(0),
+        allocationsPerMessage(0),
+        verified(false) {}
+
+    string format;
+    string message;
+    string type;
+    string operation;
+    uint32_t iterations;
+    uint32_t bytes;
+    double nanosecondsPerMessage;
+    double allocationsPerMessage;
+    bool verified;
+};
+
+/**
+ * Measures the given function.
+ */
+template<typename F>
+Result measure(const string &format, const string &message, const string &type, const string &operation, const uint32_t &iterations, const uint32_t &bytes, F f) {
+    // Warm up caches and pools.
+    f();
+
+    const uint64_t allocationsBefore = numberOfAllocations;
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        f();
+    }
+    const chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    const uint64_t allocationsAfter = numberOfAllocations;
+
+    Result r;
+    r.format = format;
+    r.message = message;
+    r.type = type;
+    r.operation = operation;
+    r.iterations = iterations;
+    r.bytes = bytes;
+    r.nanosecondsPerMessage = static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(end - start).count()) / iterations;
+    r.allocationsPerMessage = static_cast<double>(allocationsAfter - allocationsBefore) / iterations;
+    r.verified = true;
+    return r;
+}
+
+/**
+ * Benchmarks a message using its operator<< and operator>>, i.e. using
+ * the serializers provided by the current SerializationFactory.
+ */
+template<typename T>
+void benchmarkStreams(const string &format, const string &message, const T &data, const uint32_t &iterations, vector<Result> &results) {
+    stringstream sstr;
+    sstr << data;
+    const string serialized = sstr.str();
+    const uint32_t bytes = static_cast<uint32_t>(serialized.size());
+
+    results.push_back(measure(format, message, T::LongName(), "encode", iterations, bytes, [&data]() {
+        stringstream out;
+        out << data;
+    }));
+
+    T decoded;
+    Result r = measure(format, message, T::LongName(), "decode", iterations, bytes, [&serialized, &decoded]() {
+        SpanStreamBuffer buffer(serialized.data(), static_cast<uint32_t>(serialized.size()));
+        istream in(&buffer);
+        in >> decoded;
+    });
+
+    // Check that the decoded message encodes to the same bytes.
+    stringstream verification;
+    verification << decoded;
+    r.verified = (verification.str() == serialized);
+    results.push_back(r);
+}
+
+/**
+ * Benchmarks a message using the serialization visitors for the given wire format.
+ */
+template<typename T>
+void benchmarkVisitors(const SerializationFactory::WIRE_FORMAT &wireFormat, const string &format, const string &message, const T &data, const uint32_t &iterations, vector<Result> &results) {
+    SerializationFactory &sf = SerializationFactory::getInstance();
+    T copy(data);
+
+    stringstream sstr;
+    {
+        std::shared_ptr<Visitor> v = sf.getSerializerVisitor(wireFormat, sstr);
+        copy.accept(*v);
+    }
+    const string serialized = sstr.str();
+    const uint32_t bytes = static_cast<uint32_t>(serialized.size());
+
+    results.push_back(measure(format, message, T::LongName(), "encode", iterations, bytes, [&sf, &wireFormat, &copy]() {
+        stringstream out;
+        std::shared_ptr<Visitor> v = sf.getSerializerVisitor(wireFormat, out);
+        copy.accept(*v);
+    }));
+
+    T decoded;
+    Result r = measure(format, message, T::LongName(), "decode", iterations, bytes, [&sf, &wireFormat, &serialized, &decoded]() {
+        SpanStreamBuffer buffer(serialized.data(), static_cast<uint32_t>(serialized.size()));
+        istream in(&buffer);
+        std::shared_ptr<Visitor> v = sf.getDeserializerVisitor(wireFormat, in);
+        decoded.accept(*v);
+    });
+
+    // Check that the decoded message encodes to the same bytes.
+    stringstream verification;
+    {
+        std::shared_ptr<Visitor> v = sf.getSerializerVisitor(wireFormat, verification);
+        decoded.accept(*v);
+    }
+    r.verified = (verification.str() == serialized);
+    results.push_back(r);
+}
+
+/**
+ * Benchmarks decoding 10000 varints with up to the given number of bits
+ * using the former byte-wise istream decoder as well as the span and
+ * packed decoders from VarInt.
+ */
+void benchmarkVarInt(const uint32_t &bits, const uint32_t &iterations, vector<Result> &results) {
+    // Deterministic pseudo random values.
+    vector<uint64_t> values;
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t i = 0; i < 10000; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        values.push_back((bits < 64) ? (x & ((1ULL << bits) - 1)) : x);
+    }
+
+    string serialized;
+    uint64_t expectedChecksum = 0;
+    for (uint32_t i = 0; i < values.size(); i++) {
+        char bytes[VarInt::MAX_SIZE];
+        serialized.append(bytes, VarInt::encode(values[i], bytes));
+        expectedChecksum += values[i];
+    }
+    const uint32_t bytes = static_cast<uint32_t>(serialized.size());
+
+    stringstream message;
+    message << values.size() << " x " << bits << " bits";
+
+    uint64_t checksum = 0;
+    Result r = measure("varint", message.str(), "bytewise", "decode", iterations, bytes, [&serialized, &values, &checksum]() {
+        stringstream sstr(serialized);
+        checksum = 0;
+        for (uint32_t i = 0; i < values.size(); i++) {
+            // Decoder as used by ProtoDeserializer before VarInt.
+            uint64_t value = 0;
+            uint8_t size = 0;
+            while (sstr.good()) {
+                const char c = static_cast<char>(sstr.get());
+                value |= static_cast<unsigned int>( (c & 0x7f) << (0x7 * size++) );
+                if ( !(c & 0x80) ) break;
+            }
+            checksum += value;
+        }
+    });
+    // The byte-wise decoder truncates values above 28 bits.
+    r.verified = (bits > 28) || (checksum == expectedChecksum);
+    results.push_back(r);
+
+    r = measure("varint", message.str(), "span", "decode", iterations, bytes, [&serialized, &checksum]() {
+        const char *pos = serialized.data();
+        const char *end = serialized.data() + serialized.size();
+        uint64_t value = 0;
+        checksum = 0;
+        while (VarInt::decode(pos, end, value)) {
+            checksum += value;
+        }
+    });
+    r.verified = (checksum == expectedChecksum);
+    results.push_back(r);
+
+    vector<uint64_t> decoded(values.size());
+    r = measure("varint", message.str(), "packed", "decode", iterations, bytes, [&serialized, &decoded, &checksum]() {
+        const char *pos = serialized.data();
+        const uint32_t n = VarInt::decodePacked(pos, serialized.data() + serialized.size(), &decoded[0], static_cast<uint32_t>(decoded.size()));
+        checksum = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            checksum += decoded[i];
+        }
+    });
+    r.verified = (checksum == expectedChecksum);
+    results.push_back(r);
+}
+
+void printResults(const uint32_t &iterations, const vector<Result> &results) {
+    cout << "{" << endl;
+    cout << "    \"benchmark\": \"serialization\"," << endl;
+    cout << "    \"iterations\": " << iterations << "," << endl;
+    cout << "    \"results\": [" << endl;
+    for (uint32_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        const double megabytesPerSecond = (r.nanosecondsPerMessage > 0) ? (r.bytes * 1000.0 / r.nanosecondsPerMessage) : 0;
+        cout << "        { "
+             << "\"format\": \"" << r.format << "\", "
+             << "\"message\": \"" << r.message << "\", "
+             << "\"type\": \"" << r.type << "\", "
+             << "\"operation\": \"" << r.operation << "\", "
+             << "\"bytesPerMessage\": " << r.bytes << ", "
+             << "\"nanosecondsPerMessage\": " << r.nanosecondsPerMessage << ", "
+             << "\"messagesPerSecond\": " << ((r.nanosecondsPerMessage > 0) ? (1e9 / r.nanosecondsPerMessage) : 0) << ", "
+             << "\"megabytesPerSecond\": " << megabytesPerSecond << ", "
+             << "\"allocationsPerMessage\": " << r.allocationsPerMessage << ", "
+             << "\"verified\": " << (r.verified ? "true" : "false")
+             << " }" << ((i + 1) < results.size() ? "," : "") << endl;
+    }
+    cout << "    ]" << endl;
+    cout << "}" << endl;
+}
+
+int32_t main(int32_t argc, char **argv) {
+    uint32_t iterations = 10000;
+    for (int32_t i = 1; i < argc; i++) {
+        const string argument(argv[i]);
+        const string ITERATIONS = "--iterations=";
+        if ( (argument.find(ITERATIONS) == 0) && (atoi(argument.substr(ITERATIONS.size()).c_str()) > 0) ) {
+            iterations = static_cast<uint32_t>(atoi(argument.substr(ITERATIONS.size()).c_str()));
+        }
+        else {
+            cerr << "Usage: " << argv[0] << " [--iterations=N]" << endl;
+            return 1;
+        }
+    }
+
+    // Small scalars with a short string and a nested message.
+    odcore::testdata::TestMessage5 scalars;
+
+    // One string.
+    odcore::testdata::TestMessage3 text;
+    text.setField1(string(256, 'a'));
+
+    // Large raw bytes; as LCM and ROS do not support nested messages,
+    // the raw bytes are stored in the same message as the string.
+    odcore::testdata::TestMessage3 bytes;
+    {
+        string values(64000, '\0');
+        for (uint32_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<char>(i % 256);
+        }
+        bytes.setField1(values);
+    }
+
+    // List of floats.
+    odcore::testdata::TestMessage7 list;
+    {
+        vector<float> values;
+        for (uint32_t i = 0; i < 1024; i++) {
+            values.push_back(i * 0.5f);
+        }
+        list.setListOfField1(values);
+    }
+
+    // Map of integers.
+    odcore::testdata::TestMessage8 map;
+    {
+        std::map<uint32_t, uint32_t> values;
+        for (uint32_t i = 0; i < 256; i++) {
+            values[i] = i * 1000;
+        }
+        map.setMapOfField1(values);
+    }
+
+    vector<Result> results;
+
+    benchmarkStreams("proto", "scalars", scalars, iterations, results);
+    benchmarkStreams("proto", "string", text, iterations, results);
+    benchmarkStreams("proto", "bytes", bytes, iterations, results);
+    benchmarkStreams("proto", "list", list, iterations, results);
+    benchmarkStreams("proto", "map", map, iterations, results);
+
+    {
+        QueryableNetstringsSerializationFactory qnsf;
+        benchmarkStreams("queryablenetstrings", "scalars", scalars, iterations, results);
+        benchmarkStreams("queryablenetstrings", "string", text, iterations, results);
+        benchmarkStreams("queryablenetstrings", "bytes", bytes, iterations, results);
+        benchmarkStreams("queryablenetstrings", "list", list, iterations, results);
+        benchmarkStreams("queryablenetstrings", "map", map, iterations, results);
+    }
+
+    // LCM and ROS are only available as visitors that neither cover lists
+    // and maps nor nested messages; thus, the scalars are taken from a
+    // message without nested fields.
+    odcore::testdata::TestMessage11 flatScalars;
+    flatScalars.setField1(true);
+    flatScalars.setField2(2);
+    flatScalars.setField3(-3);
+    flatScalars.setField4(4);
+    flatScalars.setField5(5.5f);
+    flatScalars.setField6(6.25);
+    flatScalars.setField7(odcore::testdata::TestMessage11::ACTIVE);
+
+    benchmarkVisitors(SerializationFactory::LCM, "lcm", "scalars", flatScalars, iterations, results);
+    benchmarkVisitors(SerializationFactory::LCM, "lcm", "string", text, iterations, results);
+    benchmarkVisitors(SerializationFactory::LCM, "lcm", "bytes", bytes, iterations, results);
+
+    benchmarkVisitors(SerializationFactory::ROS, "ros", "scalars", flatScalars, iterations, results);
+    benchmarkVisitors(SerializationFactory::ROS, "ros", "string", text, iterations, results);
+    benchmarkVisitors(SerializationFactory::ROS, "ros", "bytes", bytes, iterations, results);
+
+    // Each varint run holds 10000 values.
+    const uint32_t varIntIterations = (iterations > 100) ? (iterations / 100) : 1;
+    benchmarkVarInt(7, varIntIterations, results);
+    benchmarkVarInt(14, varIntIterations, results);
+    benchmarkVarInt(32, varIntIterations, results);
+    benchmarkVarInt(64, varIntIterations, results);
+
+    printResults(iterations, results);
+
+    return 0;
+}
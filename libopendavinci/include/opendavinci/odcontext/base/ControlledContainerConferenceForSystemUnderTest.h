@@ -75,6 +75,8 @@ class BlockableContainerReceiver;
 
                 virtual void send(odcore::data::Container &container) const;
 
+                virtual void send(odcore::data::Container &&container) const;
+
                 virtual void nextContainer(odcore::data::Container &c);
 
                 /**
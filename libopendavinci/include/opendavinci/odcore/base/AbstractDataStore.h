@@ -55,6 +55,15 @@ namespace odcore {
                  */
                 virtual void add(odcore::data::Container &container) = 0;
 
+                /**
+                 * This method adds a new container to this data store
+                 * and takes over its content; the default implementation
+                 * delegates to add(Container&).
+                 *
+                 * @param container Container to be moved into this data store.
+                 */
+                virtual void add(odcore::data::Container &&container);
+
                 /**
                  * This method clears a datastore.
                  */
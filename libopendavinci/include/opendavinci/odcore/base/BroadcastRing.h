@@ -0,0 +1,319 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_BASE_BROADCASTRING_H_
+#define OPENDAVINCI_CORE_BASE_BROADCASTRING_H_
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore { namespace data { class TimeStamp; } }
+
+namespace odcore {
+    namespace base {
+
+        using namespace std;
+
+        /**
+         * This class implements a lock-free ring buffer on a given memory
+         * region (e.g. shared memory) where several producers broadcast
+         * entries to several consumers. Every consumer maintains its own
+         * cursor; thus, slow consumers do not block producers but are
+         * overrun and skip the entries that have been overwritten meanwhile.
+         *
+         * Producers claim one or more consecutive slots for an entry by
+         * incrementing a sequence counter. Entries never wrap around the
+         * end of the ring; instead, the remaining slots are filled with
+         * padding and the entry starts at the beginning of the ring.
+         * Every slot carries a sequence number that is odd while a
+         * producer writes the slot and that allows consumers to detect
+         * overwritten entries after reading.
+         *
+         * Slots are never taken over from a producer that stalls while
+         * writing as it might still write into them. Instead, a producer
+         * of the next round that waited too long for such slots closes
+         * the ring, i.e. the stalled producer is considered to have
+         * abandoned the ring and all participants need to reconnect.
+         *
+         * The creator of the ring calls heartbeat() regularly; other
+         * participants close the ring with closeIfAbandoned() when the
+         * creator terminated without calling close().
+         *
+         * @code
+         * // Creator:
+         * BroadcastRing ring(memory, size);
+         * ring.create(4096, 4096);
+         *
+         * // Producer:
+         * MyEntryWriter w(...);
+         * ring.write(length, origin, flags, w);
+         *
+         * // Consumer:
+         * uint64_t cursor = ring.getWriteSequence();
+         * BroadcastRing::Entry e;
+         * while (...) {
+         *     if (BroadcastRing::AVAILABLE == ring.read(cursor, e)) {
+         *         // Use e.m_data...
+         *         if (ring.release(cursor, e)) {
+         *             // ...if it was not overwritten meanwhile.
+         *         }
+         *     }
+         *     else {
+         *         ring.waitForData(cursor, 1000);
+         *     }
+         * }
+         * @endcode
+         */
+        class OPENDAVINCI_API BroadcastRing {
+            public:
+                enum STATUS {
+                    EMPTY,
+                    AVAILABLE,
+                    OVERRUN,
+                    CLOSED
+                };
+
+                /**
+                 * This structure describes an entry that was read from
+                 * the ring. Its data is only valid until release() is
+                 * called.
+                 */
+                struct Entry {
+                    Entry();
+
+                    uint64_t m_sequence;
+                    uint32_t m_numberOfSlots;
+                    const char *m_data;
+                    uint32_t m_length;
+                    uint32_t m_origin;
+                    uint32_t m_flags;
+                };
+
+                /**
+                 * This interface fills the buffer of an entry to be written.
+                 */
+                class EntryWriter {
+                    public:
+                        virtual ~EntryWriter();
+
+                        /**
+                         * This method writes the entry's data.
+                         *
+                         * @param buffer Buffer to write to.
+                         * @param length Length of the entry.
+                         */
+                        virtual void write(char *buffer, const uint32_t &length) const = 0;
+                };
+
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                BroadcastRing(const BroadcastRing &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                BroadcastRing& operator=(const BroadcastRing &);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param memory Memory to be used; the caller is responsible for its lifecycle.
+                 * @param size Size of the memory.
+                 */
+                BroadcastRing(void *memory, const uint32_t &size);
+
+                virtual ~BroadcastRing();
+
+                /**
+                 * This method returns the size of the memory that is
+                 * required for a ring with the given dimensions.
+                 *
+                 * @param numberOfSlots Number of slots.
+                 * @param slotSize Number of bytes per slot.
+                 * @return Required size in bytes.
+                 */
+                static uint32_t getRequiredSize(const uint32_t &numberOfSlots, const uint32_t &slotSize);
+
+                /**
+                 * This method initializes a new ring in the memory.
+                 *
+                 * @param numberOfSlots Number of slots.
+                 * @param slotSize Number of bytes per slot.
+                 * @return true if the ring could be initialized.
+                 */
+                bool create(const uint32_t &numberOfSlots, const uint32_t &slotSize);
+
+                /**
+                 * This method attaches to a ring that was created by
+                 * another instance and waits for its initialization.
+                 *
+                 * @param timeout Time in microseconds to wait for the initialization.
+                 * @return true if the ring is usable.
+                 */
+                bool attach(const uint32_t &timeout);
+
+                /**
+                 * @return true if the ring is created or attached.
+                 */
+                bool isValid() const;
+
+                /**
+                 * @return true if the creator has closed the ring.
+                 */
+                bool isClosed() const;
+
+                /**
+                 * This method returns true if the memory holds a ring that
+                 * was closed; in contrast to isClosed(), the ring does not
+                 * need to be attached. Thus, it tells whether attach()
+                 * failed since the memory is not used anymore.
+                 *
+                 * @return true if the ring in the memory was closed.
+                 */
+                bool hasBeenClosed() const;
+
+                /**
+                 * This method closes the ring and wakes up all waiting
+                 * consumers.
+                 */
+                void close();
+
+                /**
+                 * This method signals that the creator of the ring is
+                 * still alive; it needs to be called by the creator
+                 * more frequently than the timeout used by the other
+                 * participants in closeIfAbandoned().
+                 */
+                void heartbeat();
+
+                /**
+                 * This method closes the ring if the creator did not call
+                 * heartbeat() within the given time since it was observed
+                 * last by this instance (e.g. since the creator crashed).
+                 * Afterwards, the participants can create a new ring.
+                 *
+                 * @param now Current time.
+                 * @param timeout Time in microseconds without heartbeat.
+                 * @return true if the ring was closed by this call.
+                 */
+                bool closeIfAbandoned(const odcore::data::TimeStamp &now, const uint32_t &timeout);
+
+                /**
+                 * @return Maximum length of one entry.
+                 */
+                uint32_t getMaximumLength() const;
+
+                /**
+                 * This method returns a new identifier for a producer.
+                 *
+                 * @return Identifier that is unique for this ring.
+                 */
+                uint32_t registerParticipant();
+
+                /**
+                 * This method returns the sequence of the next entry to
+                 * be written; new consumers start reading there.
+                 *
+                 * @return Sequence of the next entry.
+                 */
+                uint64_t getWriteSequence() const;
+
+                /**
+                 * This method writes an entry into the ring. The given
+                 * writer is called with the ring's memory of the
+                 * requested length.
+                 *
+                 * @param length Length of the entry.
+                 * @param origin Identifier of the producer.
+                 * @param flags User-defined flags.
+                 * @param writer EntryWriter to fill the buffer.
+                 * @return true if the entry was written; false if the ring is closed,
+                 *         the entry is too large, or this producer was overtaken.
+                 */
+                bool write(const uint32_t &length, const uint32_t &origin, const uint32_t &flags, const EntryWriter &writer);
+
+                /**
+                 * This method reads the entry at the given cursor in place.
+                 *
+                 * @param cursor Cursor of the consumer; adjusted on overruns.
+                 * @param e Entry that was read.
+                 * @return AVAILABLE if e is valid.
+                 */
+                STATUS read(uint64_t &cursor, Entry &e) const;
+
+                /**
+                 * This method finishes reading an entry and advances the
+                 * cursor if the entry was not overwritten meanwhile.
+                 *
+                 * @param cursor Cursor of the consumer.
+                 * @param e Entry that was read.
+                 * @return true if the entry's data was intact.
+                 */
+                bool release(uint64_t &cursor, const Entry &e) const;
+
+                /**
+                 * This method waits until an entry is available at the
+                 * given cursor, the ring is closed, or the timeout expired.
+                 *
+                 * @param cursor Cursor of the consumer.
+                 * @param timeout Time in microseconds to wait at most.
+                 */
+                void waitForData(const uint64_t &cursor, const uint32_t &timeout) const;
+
+            private:
+                struct Header;
+                struct Slot;
+
+                Slot* getSlot(const uint64_t &sequence) const;
+
+                char* getData(const uint64_t &sequence) const;
+
+                bool isAvailable(const uint64_t &cursor) const;
+
+                bool acquireSlot(const uint64_t &sequence);
+
+                bool abandon();
+
+                void releaseAsPadding(const uint64_t &sequence, const uint32_t &numberOfSlots) const;
+
+                void notify() const;
+
+            private:
+                char *m_memory; // We have a pointer here that we receive from the caller; thus, the other class is responsible for the lifecycle of the variable to which we point to.
+                uint32_t m_size;
+                Header *m_header;
+                char *m_slots;
+                char *m_data;
+                uint32_t m_numberOfSlots;
+                uint32_t m_slotSize;
+                uint64_t m_lastHeartbeat;
+                int64_t m_lastHeartbeatChange;
+        };
+
+    }
+} // odcore::base
+
+#endif /*OPENDAVINCI_CORE_BASE_BROADCASTRING_H_*/
@@ -63,6 +63,8 @@ namespace odcore {
 
                 virtual void enter(const data::Container &container);
 
+                virtual void enter(data::Container &&container);
+
                 /**
                  * This method returns the index of the last element.
                  *
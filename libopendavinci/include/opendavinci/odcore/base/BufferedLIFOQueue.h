@@ -63,6 +63,8 @@ namespace odcore {
 
                 virtual void push(const data::Container &container);
 
+                virtual void push(data::Container &&container);
+
                 /**
                  * This method returns the index of the last element.
                  *
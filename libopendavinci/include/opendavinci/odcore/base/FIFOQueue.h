@@ -60,10 +60,14 @@ namespace odcore {
 
                 virtual void enter(const data::Container &container);
 
-                const data::Container leave();
+                virtual void enter(data::Container &&container);
+
+                data::Container leave();
 
                 virtual void add(odcore::data::Container &container);
 
+                virtual void add(odcore::data::Container &&container);
+
                 virtual uint32_t getSize() const;
 
                 virtual bool isEmpty() const;
@@ -60,10 +60,14 @@ namespace odcore {
 
                 virtual void push(const data::Container &container);
 
-                const data::Container pop();
+                virtual void push(data::Container &&container);
+
+                data::Container pop();
 
                 virtual void add(odcore::data::Container &container);
 
+                virtual void add(odcore::data::Container &&container);
+
                 virtual uint32_t getSize() const;
 
                 virtual bool isEmpty() const;
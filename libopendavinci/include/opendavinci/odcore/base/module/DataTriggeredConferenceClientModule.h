@@ -72,6 +72,10 @@ namespace odcore {
              *     return myModule.runModule();
              * }
              * @endcode
+             *
+             * If the conference partitions its data types across several
+             * multicast groups, the data types to be received must be
+             * declared using getConference().subscribe(...) in setUp().
              */
             class OPENDAVINCI_API DataTriggeredConferenceClientModule : public AbstractConferenceClientModule {
                 private:
@@ -59,6 +59,8 @@ namespace odcore {
 
                     virtual void send(odcore::data::Container &container) const;
 
+                    virtual void send(odcore::data::Container &&container) const;
+
                     void receiveFromLocal(odcore::data::Container &c);
 
                     /**
@@ -75,6 +77,15 @@ namespace odcore {
                      */
                     vector<odcore::data::Container> getListOfContainers() const;
 
+                private:
+                    /**
+                     * This method sets the sent and sample time stamps for
+                     * the given container.
+                     *
+                     * @param container Container to be stamped.
+                     */
+                    void stamp(odcore::data::Container &container) const;
+
                 private:
                     vector<odcore::data::Container> m_listOfContainersToBeDelivered;
             };
@@ -92,6 +92,13 @@ namespace odcore {
              *     return myModule.runModule();
              * }
              * @endcode
+             *
+             * All data types are received by default as the key/value-map
+             * is always filled. A module that is only interested in specific
+             * data types can declare them using getConference().subscribe(...)
+             * in setUp(); afterwards, the conference drops containers of all
+             * other data types upon reception, i.e. they are neither passed
+             * to any queue nor to the key/value-map.
              */
             class OPENDAVINCI_API TimeTriggeredConferenceClientModule : public AbstractConferenceClientModule, public DataStoreManager {
                 private:
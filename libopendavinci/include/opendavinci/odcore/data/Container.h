@@ -20,13 +20,20 @@
 #ifndef OPENDAVINCI_CORE_DATA_CONTAINER_H_
 #define OPENDAVINCI_CORE_DATA_CONTAINER_H_
 
+#include <memory>
 #include <sstream>
 #include <string>
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
 #include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odcore/serialization/SerializationFactory.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 
+namespace odcore { namespace base { class Visitable; } }
+namespace odcore { namespace serialization { class ByteWriter; } }
+
 namespace odcore {
     namespace data {
 
@@ -35,7 +42,10 @@ class SerializableData;
         using namespace std;
 
         /**
-         * Container for all interchangeable data.
+         * Container for all interchangeable data. The serialized payload
+         * is kept in an immutable and reference-counted buffer; thus,
+         * copying a Container only copies its header fields while all
+         * copies share the same payload.
          */
         class OPENDAVINCI_API Container : public odcore::serialization::Serializable {
             public:
@@ -44,6 +54,11 @@ class SerializableData;
                     DMCP_CONFIGURATION_REQUEST   =  5,
                 };
 
+                enum ENVELOPE {
+                    ENVELOPE_V1 = 1, // Protobuf-encoded header fields.
+                    ENVELOPE_V2 = 2, // Fixed-layout header fields (cf. ContainerHeaderView).
+                };
+
             public:
                 Container();
 
@@ -62,6 +77,15 @@ class SerializableData;
                  */
                 Container(const SerializableData &serializableData, const int32_t &dataType);
 
+                /**
+                 * Constructor.
+                 *
+                 * @param visitable Data to be serialized.
+                 * @param dataType Type of data inside this container.
+                 * @param wireFormat Wire format to be used for serializing visitable.
+                 */
+                Container(odcore::base::Visitable &visitable, const int32_t &dataType, const odcore::serialization::SerializationFactory::WIRE_FORMAT &wireFormat);
+
                 /**
                  * Copy constructor.
                  *
@@ -69,6 +93,13 @@ class SerializableData;
                  */
                 Container(const Container &obj);
 
+                /**
+                 * Move constructor.
+                 *
+                 * @param obj Reference to an object of this class to be moved.
+                 */
+                Container(Container &&obj);
+
                 virtual ~Container();
 
                 /**
@@ -79,6 +110,14 @@ class SerializableData;
                  */
                 Container& operator=(const Container &obj);
 
+                /**
+                 * Move assignment operator.
+                 *
+                 * @param obj Reference to an object of this class to be moved.
+                 * @return Reference to this instance.
+                 */
+                Container& operator=(Container &&obj);
+
                 /**
                  * This method returns the data type inside this container.
                  *
@@ -89,6 +128,24 @@ class SerializableData;
                 virtual ostream& operator<<(ostream &out) const;
                 virtual istream& operator>>(istream &in);
 
+                /**
+                 * This method returns the number of bytes that this
+                 * container occupies when it is serialized using its
+                 * envelope.
+                 *
+                 * @return Number of bytes.
+                 */
+                uint32_t getSerializedSize() const;
+
+                /**
+                 * This method serializes this container using its envelope
+                 * into a pre-sized buffer without allocating memory. The
+                 * buffer should provide at least getSerializedSize() bytes.
+                 *
+                 * @param out ByteWriter to write to.
+                 */
+                void serializeTo(odcore::serialization::ByteWriter &out) const;
+
                 /**
                  * This method returns a usable object:
                  *
@@ -103,14 +160,53 @@ class SerializableData;
                 template<class T>
                 inline T getData() {
                     T containerData;
-                    // Reset failbit as some Deserializer fully consume the entire stream.
-                    m_serializedData.clear();
-                    // Read from beginning.
-                    m_serializedData.seekg(ios::beg);
-                    m_serializedData >> containerData;
+                    if ( (m_serializedData.get() != NULL) && !m_serializedData->empty() ) {
+                        // Read directly from the shared payload to avoid copying data.
+                        odcore::serialization::SpanStreamBuffer buffer(m_serializedData->data(), m_serializedData->size());
+                        istream in(&buffer);
+                        in >> containerData;
+                    }
+                    return containerData;
+                }
+
+                /**
+                 * This method returns a usable object from a payload
+                 * serialized in the given wire format:
+                 *
+                 * @code
+                 * Container c;
+                 * ...
+                 * T t = c.getData<T>(odcore::serialization::SerializationFactory::LCM);
+                 * @endcode
+                 *
+                 * @param wireFormat Wire format of the payload.
+                 * @return Usable object.
+                 */
+                template<class T>
+                inline T getData(const odcore::serialization::SerializationFactory::WIRE_FORMAT &wireFormat) {
+                    T containerData;
+                    getData(containerData, wireFormat);
                     return containerData;
                 }
 
+                /**
+                 * This method deserializes the payload in the given wire
+                 * format into the given object.
+                 *
+                 * @param visitable Object to deserialize into.
+                 * @param wireFormat Wire format of the payload.
+                 */
+                void getData(odcore::base::Visitable &visitable, const odcore::serialization::SerializationFactory::WIRE_FORMAT &wireFormat);
+
+                /**
+                 * This method returns the serialized payload of this
+                 * container without copying it. The bytes are valid as
+                 * long as this container or a copy of it exists.
+                 *
+                 * @return Serialized payload.
+                 */
+                odcore::serialization::ByteSpan getPayload() const;
+
                 /**
                  * This method returns the time stamp when this
                  * container was sent.
@@ -179,9 +275,76 @@ class SerializableData;
                  */
                 uint32_t getSenderStamp() const;
 
+                /**
+                 * This method sets the envelope to be used when this
+                 * container is serialized.
+                 *
+                 * @param envelope Envelope to be used.
+                 */
+                void setEnvelope(const ENVELOPE &envelope);
+
+                /**
+                 * This method returns the envelope used to serialize this
+                 * container; for a received container, it is the envelope
+                 * that it was received with.
+                 *
+                 * @return Envelope.
+                 */
+                ENVELOPE getEnvelope() const;
+
+            private:
+                /**
+                 * This method returns the length of the Protobuf-encoded
+                 * header fields and payload of an ENVELOPE_V1 container.
+                 *
+                 * @return Number of bytes following the prefix.
+                 */
+                uint32_t getEnvelopeV1Length() const;
+
+                /**
+                 * This method writes the prefix and the Protobuf-encoded
+                 * fields preceding the payload's bytes.
+                 *
+                 * @param out ByteWriter to write to.
+                 */
+                void writeEnvelopeV1Header(odcore::serialization::ByteWriter &out) const;
+
+                /**
+                 * This method writes the Protobuf-encoded fields
+                 * following the payload.
+                 *
+                 * @param out ByteWriter to write to.
+                 */
+                void writeEnvelopeV1Trailer(odcore::serialization::ByteWriter &out) const;
+
+                /**
+                 * This method writes the fixed-layout ENVELOPE_V2 header.
+                 *
+                 * @param out ByteWriter to write to.
+                 */
+                void writeEnvelopeV2Header(odcore::serialization::ByteWriter &out) const;
+
+                /**
+                 * This method returns the length of a Protobuf-encoded TimeStamp.
+                 *
+                 * @param timeStamp TimeStamp to be encoded.
+                 * @return Number of bytes without key and length.
+                 */
+                static uint32_t getTimeStampLength(const TimeStamp &timeStamp);
+
+                /**
+                 * This method writes a TimeStamp as Protobuf-encoded field.
+                 *
+                 * @param out ByteWriter to write to.
+                 * @param id Field identifier.
+                 * @param timeStamp TimeStamp to be encoded.
+                 */
+                static void writeTimeStamp(odcore::serialization::ByteWriter &out, const uint32_t &id, const TimeStamp &timeStamp);
+
             private:
+                ENVELOPE m_envelope;
                 int32_t m_dataType;
-                stringstream m_serializedData;
+                std::shared_ptr<const string> m_serializedData;
 
                 TimeStamp m_sent;
                 TimeStamp m_received;
@@ -0,0 +1,242 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2008 - 2015 Christian Berger, Bernhard Rumpe
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_DATA_CONTAINERHEADERVIEW_H_
+#define OPENDAVINCI_CORE_DATA_CONTAINERHEADERVIEW_H_
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+
+namespace odcore {
+    namespace data {
+
+        using namespace std;
+
+        /**
+         * This class provides read-only access to the header fields of a
+         * serialized Container without decoding its payload and without
+         * allocating memory. The view does not own the given bytes; thus,
+         * they must outlive this instance.
+         *
+         * Every envelope starts with five bytes 0x0D 0xA4 A B C where
+         * A B C is the little endian encoded length of the remaining
+         * bytes. In an ENVELOPE_V1 container, the remaining bytes are the
+         * Protobuf-encoded fields of the Container. In an ENVELOPE_V2
+         * container, the following fixed layout (little endian) is used:
+         *
+         * @code
+         * Offset  Size  Field
+         *      5     1  version (0x02)
+         *      6     3  reserved (0x00)
+         *      9     4  dataType
+         *     13     4  senderStamp
+         *     17     8  sent (seconds, microseconds)
+         *     25     8  received (seconds, microseconds)
+         *     33     8  sampleTimeStamp (seconds, microseconds)
+         *     41     *  payload
+         * @endcode
+         *
+         * The version byte 0x02 cannot start an ENVELOPE_V1 container as
+         * it would denote the invalid Protobuf field number 0.
+         */
+        class OPENDAVINCI_API ContainerHeaderView {
+            public:
+                /**
+                 * Size of the prefix 0x0D 0xA4 A B C shared by all envelopes.
+                 */
+                static const uint32_t PREFIX_SIZE = 5;
+
+                /**
+                 * Size of the fixed ENVELOPE_V2 header including the prefix.
+                 */
+                static const uint32_t V2_HEADER_SIZE = 41;
+
+                /**
+                 * Marker following the prefix in an ENVELOPE_V2 container.
+                 */
+                static const uint8_t V2_MARKER = 0x02;
+
+            public:
+                /**
+                 * Constructor for an invalid view.
+                 */
+                ContainerHeaderView();
+
+                /**
+                 * Constructor.
+                 *
+                 * @param data Pointer to the first byte of a serialized Container.
+                 * @param length Number of available bytes.
+                 */
+                ContainerHeaderView(const char *data, const uint32_t &length);
+
+                /**
+                 * Copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                ContainerHeaderView(const ContainerHeaderView &obj);
+
+                virtual ~ContainerHeaderView();
+
+                /**
+                 * Assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                ContainerHeaderView& operator=(const ContainerHeaderView &obj);
+
+                /**
+                 * This method returns true if the given bytes contain
+                 * a complete and well-formed Container.
+                 *
+                 * @return true if the header could be decoded.
+                 */
+                bool isValid() const;
+
+                /**
+                 * This method returns the number of bytes occupied by the
+                 * viewed Container including its prefix. This information
+                 * is already available if only the prefix was given.
+                 *
+                 * @return Number of bytes of the serialized Container or 0 if the prefix is invalid.
+                 */
+                uint32_t getSize() const;
+
+                /**
+                 * This method returns the envelope of the viewed Container.
+                 *
+                 * @return Envelope.
+                 */
+                Container::ENVELOPE getEnvelope() const;
+
+                /**
+                 * This method returns the data type of the viewed Container.
+                 *
+                 * @return Data type.
+                 */
+                int32_t getDataType() const;
+
+                /**
+                 * This method returns the sender stamp of the viewed Container.
+                 *
+                 * @return Sender stamp.
+                 */
+                uint32_t getSenderStamp() const;
+
+                /**
+                 * This method returns the time stamp when the viewed
+                 * Container was sent.
+                 *
+                 * @return Sent time stamp.
+                 */
+                const TimeStamp getSentTimeStamp() const;
+
+                /**
+                 * This method returns the time stamp when the viewed
+                 * Container was received.
+                 *
+                 * @return Received time stamp.
+                 */
+                const TimeStamp getReceivedTimeStamp() const;
+
+                /**
+                 * This method returns the time stamp of the sample
+                 * inside the viewed Container.
+                 *
+                 * @return Sample time stamp.
+                 */
+                const TimeStamp getSampleTimeStamp() const;
+
+                /**
+                 * This method returns a pointer to the serialized payload
+                 * inside the viewed bytes.
+                 *
+                 * @return Pointer to the payload or NULL.
+                 */
+                const char* getPayload() const;
+
+                /**
+                 * This method returns the length of the serialized payload.
+                 *
+                 * @return Length of the payload.
+                 */
+                uint32_t getPayloadLength() const;
+
+            private:
+                /**
+                 * This method decodes the fixed layout of an ENVELOPE_V2 container.
+                 *
+                 * @return true if the header could be decoded.
+                 */
+                bool decodeV2();
+
+                /**
+                 * This method scans the Protobuf fields of an ENVELOPE_V1
+                 * container without copying the payload.
+                 *
+                 * @return true if the header could be decoded.
+                 */
+                bool decodeV1();
+
+                /**
+                 * This method decodes a Protobuf-encoded TimePoint.
+                 *
+                 * @param begin First byte of the encoded TimePoint.
+                 * @param end Byte after the encoded TimePoint.
+                 * @param seconds Decoded seconds.
+                 * @param microseconds Decoded microseconds.
+                 * @return true if the TimePoint could be decoded.
+                 */
+                static bool decodeTimePoint(const char *begin, const char *end, int32_t &seconds, int32_t &microseconds);
+
+                /**
+                 * This method reads a little endian encoded uint32_t.
+                 *
+                 * @param data Pointer to the first byte.
+                 * @return Value in host byte order.
+                 */
+                static uint32_t readUInt32(const char *data);
+
+            private:
+                const char *m_data;
+                uint32_t m_length;
+                uint32_t m_size;
+                bool m_valid;
+                Container::ENVELOPE m_envelope;
+
+                int32_t m_dataType;
+                uint32_t m_senderStamp;
+                int32_t m_sentSeconds;
+                int32_t m_sentMicroseconds;
+                int32_t m_receivedSeconds;
+                int32_t m_receivedMicroseconds;
+                int32_t m_sampleSeconds;
+                int32_t m_sampleMicroseconds;
+
+                const char *m_payload;
+                uint32_t m_payloadLength;
+        };
+
+    }
+} // odcore::data
+
+#endif /*OPENDAVINCI_CORE_DATA_CONTAINERHEADERVIEW_H_*/
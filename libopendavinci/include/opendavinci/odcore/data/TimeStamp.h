@@ -216,6 +216,23 @@ namespace odcore {
                  */
                 const string getYYYYMMDD_HHMMSSms() const;
 
+                /**
+                 * This method returns the number of bytes needed to
+                 * encode this time, which is encoded as TimePoint. It
+                 * lets nested TimeStamps be encoded in place by
+                 * ProtoEncoder instead of using operator<<.
+                 *
+                 * @return Number of bytes.
+                 */
+                uint32_t getEncodedSize() const;
+
+                /**
+                 * This method encodes this time as TimePoint.
+                 *
+                 * @param out ByteWriter to write to.
+                 */
+                void encodeTo(odcore::serialization::ByteWriter &out) const;
+
             private:
                 /**
                  * This method returns true if the given year is
@@ -0,0 +1,103 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_PACKETBUFFERPOOL_H_
+#define OPENDAVINCI_CORE_IO_PACKETBUFFERPOOL_H_
+
+#include <memory>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+
+        /**
+         * This class keeps buffers of a fixed size for receiving data
+         * from sockets. A buffer is handed out as std::shared_ptr and
+         * returns to the pool once the last reference is released; thus,
+         * received data can be passed on without copying it. Buffers
+         * exceeding the maximum number of idle buffers are freed.
+         *
+         * @code
+         * PacketBufferPool pool(65535, 16);
+         * std::shared_ptr<char> buffer = pool.acquire();
+         * const int32_t nbytes = recv(fd, buffer.get(), pool.getBufferSize(), 0);
+         * SharedPacket p(buffer, nbytes, ...);
+         * @endcode
+         */
+        class OPENDAVINCI_API PacketBufferPool {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                PacketBufferPool(const PacketBufferPool &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                PacketBufferPool& operator=(const PacketBufferPool &);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param bufferSize Size of each buffer in bytes.
+                 * @param maximumNumberOfIdleBuffers Number of released buffers to keep for reuse.
+                 */
+                PacketBufferPool(const uint32_t &bufferSize, const uint32_t &maximumNumberOfIdleBuffers);
+
+                virtual ~PacketBufferPool();
+
+                /**
+                 * This method returns a buffer of getBufferSize() bytes;
+                 * its content is undefined.
+                 *
+                 * @return Buffer that returns to this pool when released.
+                 */
+                std::shared_ptr<char> acquire();
+
+                /**
+                 * @return Size of each buffer in bytes.
+                 */
+                uint32_t getBufferSize() const;
+
+                /**
+                 * @return Number of buffers that are available for reuse.
+                 */
+                uint32_t getNumberOfIdleBuffers() const;
+
+            private:
+                class Buffers;
+                class ReleaseBuffer;
+
+                // Buffers that are still referenced keep the idle buffers alive when the pool is destroyed.
+                std::shared_ptr<Buffers> m_buffers;
+        };
+
+    }
+} // odcore::io
+
+#endif /*OPENDAVINCI_CORE_IO_PACKETBUFFERPOOL_H_*/
@@ -20,7 +20,10 @@
 #ifndef OPENDAVINCI_CORE_IO_PACKETLISTENER_H_
 #define OPENDAVINCI_CORE_IO_PACKETLISTENER_H_
 
+#include <vector>
+
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/io/SharedPacket.h"
 #include "opendavinci/generated/odcore/data/Packet.h"
 
 namespace odcore {
@@ -40,6 +43,34 @@ namespace odcore {
                  * @param p Packet that has been occurred.
                  */
                 virtual void nextPacket(const odcore::data::Packet &p) = 0;
+
+                /**
+                 * This method is called whenever several packets have been
+                 * received at once. The default implementation passes each
+                 * packet in order to nextPacket.
+                 *
+                 * @param packets Packets that have been occurred.
+                 */
+                virtual void nextPackets(const std::vector<odcore::data::Packet> &packets);
+
+                /**
+                 * This method is called whenever a new packet occurs that
+                 * refers to the receive buffer. Listeners overriding this
+                 * method can process the data without copying it; the
+                 * default implementation passes a copy to nextPacket.
+                 *
+                 * @param p Packet that has been occurred.
+                 */
+                virtual void nextSharedPacket(const SharedPacket &p);
+
+                /**
+                 * This method is called whenever several packets referring
+                 * to the receive buffers have been received at once. The
+                 * default implementation passes copies to nextPackets.
+                 *
+                 * @param packets Packets that have been occurred.
+                 */
+                virtual void nextSharedPackets(const std::vector<SharedPacket> &packets);
         };
 
     }
@@ -20,13 +20,16 @@
 #ifndef OPENDAVINCI_CORE_IO_PACKETPIPELINE_H_
 #define OPENDAVINCI_CORE_IO_PACKETPIPELINE_H_
 
-#include <queue>
+#include <atomic>
+#include <vector>
 
 #include "opendavinci/odcore/base/Condition.h"
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/base/Service.h"
 #include "opendavinci/odcore/io/PacketListener.h"
 #include "opendavinci/odcore/io/PacketObserver.h"
+#include "opendavinci/odcore/io/PacketRing.h"
+#include "opendavinci/odcore/io/SharedPacket.h"
 #include "opendavinci/generated/odcore/data/Packet.h"
 
 namespace odcore {
@@ -37,6 +40,14 @@ namespace odcore {
         /**
          * This class distributes odcore::data::Packets using an asynchronous pipeline
          * to decouple the processing of the data when invoking a PacketListener at higher levels.
+         * Packets are queued as SharedPackets, i.e. the received data is not copied.
+         *
+         * The packets are kept in a bounded lock-free PacketRing; thus,
+         * a stalled PacketListener cannot make the pipeline grow without
+         * limit, neither in the number of packets nor in the number of
+         * bytes. When the ring is full, the configured OVERFLOW_POLICY
+         * decides whether the oldest or the newest packet is dropped or
+         * whether the producer waits for space.
          */
         class PacketPipeline : public odcore::base::Service, public PacketObserver, public PacketListener {
             private:
@@ -55,7 +66,27 @@ namespace odcore {
                 PacketPipeline& operator=(const PacketPipeline &);
 
             public:
-                PacketPipeline();
+                enum OVERFLOW_POLICY {
+                    DROP_OLDEST,
+                    DROP_NEWEST,
+                    BLOCK
+                };
+
+                enum {
+                    DEFAULT_CAPACITY = 1024,
+                    DEFAULT_MAXIMUM_NUMBER_OF_BYTES = 16 * 1024 * 1024,
+                    MAX_BATCH_SIZE = 64
+                };
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param capacity Maximum number of queued packets; rounded up to the next power of two.
+                 * @param policy Policy to apply when the queue is full.
+                 * @param maximumNumberOfBytes Maximum number of bytes of all queued packets' data; 0 for no limit.
+                 */
+                PacketPipeline(const uint32_t &capacity = DEFAULT_CAPACITY, const OVERFLOW_POLICY &policy = DROP_OLDEST, const uint64_t &maximumNumberOfBytes = DEFAULT_MAXIMUM_NUMBER_OF_BYTES);
 
                 virtual ~PacketPipeline();
 
@@ -63,6 +94,55 @@ namespace odcore {
 
                 virtual void nextPacket(const odcore::data::Packet &p);
 
+                /**
+                 * This method enqueues all packets at once and wakes the
+                 * distributing thread only once.
+                 *
+                 * @param packets Packets to enqueue.
+                 */
+                virtual void nextPackets(const vector<odcore::data::Packet> &packets);
+
+                virtual void nextSharedPacket(const SharedPacket &p);
+
+                virtual void nextSharedPackets(const vector<SharedPacket> &packets);
+
+                /**
+                 * This method sets the policy to apply when the queue is full.
+                 *
+                 * @param policy Policy to apply.
+                 */
+                void setOverflowPolicy(const OVERFLOW_POLICY &policy);
+
+                /**
+                 * @return Policy to apply when the queue is full.
+                 */
+                OVERFLOW_POLICY getOverflowPolicy() const;
+
+                /**
+                 * @return Maximum number of queued packets.
+                 */
+                uint32_t getCapacity() const;
+
+                /**
+                 * @return Maximum number of bytes of all queued packets' data or 0 for no limit.
+                 */
+                uint64_t getMaximumNumberOfBytes() const;
+
+                /**
+                 * @return Number of packets that have been enqueued so far.
+                 */
+                uint64_t getNumberOfEnqueuedPackets() const;
+
+                /**
+                 * @return Number of packets that have been dropped due to a full queue.
+                 */
+                uint64_t getNumberOfDroppedPackets() const;
+
+                /**
+                 * @return Maximum number of packets that have been queued at once.
+                 */
+                uint32_t getHighWaterMark() const;
+
             private:
                 virtual void beforeStop();
 
@@ -73,10 +153,31 @@ namespace odcore {
                  */
                 void processQueue();
 
+                /**
+                 * This method enqueues one packet according to the overflow policy.
+                 *
+                 * @param p Packet to enqueue.
+                 * @return true if the packet was enqueued.
+                 */
+                bool enqueue(const SharedPacket &p);
+
+                /**
+                 * This method wakes the distributing thread if it awaits new packets.
+                 */
+                void wakeConsumer();
+
             private:
                 odcore::base::Condition m_queueCondition;
-                odcore::base::Mutex m_queueMutex;
-                queue<odcore::data::Packet> m_queue;
+                PacketRing m_queue;
+                std::atomic<bool> m_consumerWaiting;
+
+                odcore::base::Condition m_spaceCondition;
+                std::atomic<uint32_t> m_numberOfWaitingProducers;
+
+                std::atomic<uint32_t> m_overflowPolicy;
+                std::atomic<uint64_t> m_numberOfEnqueuedPackets;
+                std::atomic<uint64_t> m_numberOfDroppedPackets;
+                std::atomic<uint32_t> m_highWaterMark;
 
                 odcore::base::Mutex m_packetListenerMutex;
                 PacketListener *m_packetListener;
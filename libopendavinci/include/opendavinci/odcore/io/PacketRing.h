@@ -0,0 +1,154 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_PACKETRING_H_
+#define OPENDAVINCI_CORE_IO_PACKETRING_H_
+
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/io/SharedPacket.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+
+        /**
+         * This class implements a bounded lock-free ring of SharedPackets.
+         * Every slot carries a sequence number that tells producers and
+         * consumers whether the slot is free or filled for their position;
+         * thus, neither pushing nor popping needs a lock. Several threads
+         * may push and pop concurrently, which allows producers to discard
+         * the oldest packet when the ring is full. Besides the number of
+         * packets, the ring may limit the number of bytes of the packets'
+         * data; a single packet exceeding this limit is only accepted by
+         * an empty ring.
+         *
+         * @code
+         * PacketRing ring(1024, 16 * 1024 * 1024);
+         *
+         * // Producers:
+         * if (!ring.push(p)) {
+         *     // Ring is full.
+         * }
+         *
+         * // Consumer:
+         * vector<SharedPacket> batch;
+         * ring.pop(batch, 64);
+         * @endcode
+         */
+        class OPENDAVINCI_API PacketRing {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                PacketRing(const PacketRing &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                PacketRing& operator=(const PacketRing &);
+
+            public:
+                enum {
+                    MAXIMUM_CAPACITY = 65536
+                };
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param capacity Number of packets; rounded up to the next power of two and limited to MAXIMUM_CAPACITY.
+                 * @param maximumNumberOfBytes Maximum number of bytes of all packets' data; 0 for no limit.
+                 */
+                PacketRing(const uint32_t &capacity, const uint64_t &maximumNumberOfBytes = 0);
+
+                virtual ~PacketRing();
+
+                /**
+                 * This method appends a packet.
+                 *
+                 * @param p Packet to append.
+                 * @return false if the ring is full or the packet exceeds the maximum number of bytes.
+                 */
+                bool push(const SharedPacket &p);
+
+                /**
+                 * This method removes the oldest packet.
+                 *
+                 * @param p Packet that was removed.
+                 * @return false if the ring is empty.
+                 */
+                bool pop(SharedPacket &p);
+
+                /**
+                 * This method removes the oldest packets at once.
+                 *
+                 * @param packets Vector to append the removed packets to.
+                 * @param maximum Maximum number of packets to remove.
+                 * @return Number of removed packets.
+                 */
+                uint32_t pop(vector<SharedPacket> &packets, const uint32_t &maximum);
+
+                /**
+                 * @return Number of packets in the ring; only a snapshot while other threads modify the ring.
+                 */
+                uint32_t getSize() const;
+
+                /**
+                 * @return true if the ring is empty.
+                 */
+                bool isEmpty() const;
+
+                /**
+                 * @return Maximum number of packets.
+                 */
+                uint32_t getCapacity() const;
+
+                /**
+                 * @return Number of bytes of all packets' data in the ring; only a snapshot while other threads modify the ring.
+                 */
+                uint64_t getNumberOfBytes() const;
+
+                /**
+                 * @return Maximum number of bytes of all packets' data or 0 for no limit.
+                 */
+                uint64_t getMaximumNumberOfBytes() const;
+
+            private:
+                struct Cell;
+                struct Indices;
+
+                uint32_t m_capacity;
+                uint64_t m_mask;
+                uint64_t m_maximumNumberOfBytes;
+                Cell *m_cells;
+                Indices *m_indices;
+        };
+
+    }
+} // odcore::io
+
+#endif /*OPENDAVINCI_CORE_IO_PACKETRING_H_*/
@@ -0,0 +1,67 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_IO_REACTOR_H_
+#define OPENDAVINCI_CORE_IO_REACTOR_H_
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Mutex.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+
+        /**
+         * This class configures the I/O threads that are shared by all
+         * UDP receivers, TCP connections, and TCP acceptors of this
+         * process. By default, every socket uses its own thread for
+         * receiving data. If a number of I/O threads is set, sockets
+         * that are started afterwards are served by a readiness-based
+         * reactor (epoll on Linux) using the given number of threads
+         * instead; on other platforms, this setting is ignored.
+         *
+         * As received data is processed by the shared I/O threads,
+         * listeners should not block for a long time.
+         */
+        class OPENDAVINCI_API Reactor {
+            public:
+                /**
+                 * This method sets the number of shared I/O threads. The
+                 * number of running threads is never decreased; 0 lets
+                 * sockets started afterwards use their own threads again.
+                 *
+                 * @param numberOfThreads Number of shared I/O threads.
+                 */
+                static void setNumberOfThreads(const uint32_t &numberOfThreads);
+
+                /**
+                 * @return Number of shared I/O threads; 0 if every socket uses its own thread.
+                 */
+                static uint32_t getNumberOfThreads();
+
+            private:
+                static base::Mutex m_numberOfThreadsMutex;
+                static uint32_t m_numberOfThreads;
+        };
+
+    }
+} // odcore::io
+
+#endif /*OPENDAVINCI_CORE_IO_REACTOR_H_*/
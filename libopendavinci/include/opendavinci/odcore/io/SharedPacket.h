@@ -0,0 +1,157 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_SHAREDPACKET_H_
+#define OPENDAVINCI_CORE_IO_SHAREDPACKET_H_
+
+#include <memory>
+#include <string>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/generated/odcore/data/Packet.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+
+        /**
+         * This class represents data received from a socket without
+         * copying it: It refers to a slice of a reference-counted buffer
+         * (cf. PacketBufferPool) and keeps the sender's IPv4 address in
+         * numerical form; copying a SharedPacket only shares the buffer.
+         * The data must not be modified by any receiver. As a buffer is
+         * held as long as any SharedPacket refers to it, small datagrams
+         * should be copied into a buffer of their own size instead of
+         * holding a large receive buffer.
+         *
+         * toPacket() creates an odcore::data::Packet for receivers that
+         * need to keep the data as std::string.
+         */
+        class OPENDAVINCI_API SharedPacket {
+            public:
+                SharedPacket();
+
+                /**
+                 * Constructor.
+                 *
+                 * @param buffer Buffer holding the data.
+                 * @param length Number of bytes of data at the beginning of the buffer.
+                 * @param senderAddress Sender's IPv4 address in host byte order.
+                 * @param senderPort Sender's port.
+                 * @param received Time stamp when the data was received.
+                 */
+                SharedPacket(const std::shared_ptr<char> &buffer, const uint32_t &length,
+                             const uint32_t &senderAddress, const uint16_t &senderPort,
+                             const odcore::data::TimeStamp &received);
+
+                /**
+                 * Constructor copying the given data into a buffer of
+                 * its own size.
+                 *
+                 * @param data Data to copy.
+                 * @param length Number of bytes to copy.
+                 * @param senderAddress Sender's IPv4 address in host byte order.
+                 * @param senderPort Sender's port.
+                 * @param received Time stamp when the data was received.
+                 */
+                SharedPacket(const char *data, const uint32_t &length,
+                             const uint32_t &senderAddress, const uint16_t &senderPort,
+                             const odcore::data::TimeStamp &received);
+
+                /**
+                 * Constructor copying the data from the given Packet. A
+                 * sender's address in dotted notation is kept numerically.
+                 *
+                 * @param p Packet to copy.
+                 */
+                SharedPacket(const odcore::data::Packet &p);
+
+                /**
+                 * Copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                SharedPacket(const SharedPacket &obj);
+
+                virtual ~SharedPacket();
+
+                /**
+                 * Assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                SharedPacket& operator=(const SharedPacket &obj);
+
+                /**
+                 * @return Pointer to the received data or NULL.
+                 */
+                const char* getData() const;
+
+                /**
+                 * @return Number of bytes of received data.
+                 */
+                uint32_t getLength() const;
+
+                /**
+                 * This method returns the sender's address. The
+                 * textual representation is only created when needed.
+                 *
+                 * @return Sender's address in dotted notation.
+                 */
+                const string getSender() const;
+
+                /**
+                 * @return Sender's IPv4 address in host byte order or 0 if unknown.
+                 */
+                uint32_t getSenderAddress() const;
+
+                /**
+                 * @return Sender's port or 0 if unknown.
+                 */
+                uint16_t getSenderPort() const;
+
+                /**
+                 * @return Time stamp when the data was received.
+                 */
+                const odcore::data::TimeStamp getReceived() const;
+
+                /**
+                 * This method copies the received data into a Packet.
+                 *
+                 * @return Packet.
+                 */
+                odcore::data::Packet toPacket() const;
+
+            private:
+                std::shared_ptr<char> m_buffer;
+                uint32_t m_length;
+                string m_sender; // Only set if the sender's address is not numerical.
+                uint32_t m_senderAddress;
+                uint16_t m_senderPort;
+                odcore::data::TimeStamp m_received;
+        };
+
+    }
+} // odcore::io
+
+#endif /*OPENDAVINCI_CORE_IO_SHAREDPACKET_H_*/
@@ -39,6 +39,19 @@ namespace odcore {
                  * param data Data to be sent.
                  */
                 virtual void send(const string& data) = 0;
+
+                /**
+                 * This method sends several buffers as one consecutive byte
+                 * sequence. The default implementation concatenates the
+                 * buffers once and passes them to send(); senders being able
+                 * to write several buffers at once can override this method
+                 * to avoid the copy.
+                 *
+                 * @param buffers Buffers to be sent.
+                 * @param lengths Length of each buffer.
+                 * @param numberOfBuffers Number of buffers.
+                 */
+                virtual void sendBuffers(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers);
         };
     }
 }
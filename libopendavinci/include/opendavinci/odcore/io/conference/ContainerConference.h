@@ -20,6 +20,10 @@
 #ifndef OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCE_H_
 #define OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCE_H_
 
+#include <map>
+#include <set>
+#include <vector>
+
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/io/conference/ContainerObserver.h"
@@ -81,6 +85,79 @@ class ContainerListener;
                      */
                     virtual void send(odcore::data::Container &container) const = 0;
 
+                    /**
+                     * This method sends a container to this conference that
+                     * is not needed by the caller anymore; the default
+                     * implementation delegates to send(Container&).
+                     *
+                     * @param container Container to be sent.
+                     */
+                    virtual void send(odcore::data::Container &&container) const;
+
+                    /**
+                     * This method sends several containers at once to this
+                     * conference; the default implementation calls
+                     * send(Container&) for each container.
+                     * @param containers Containers to be sent.
+                     */
+                    virtual void sendBatch(vector<odcore::data::Container> &containers) const;
+
+                    /**
+                     * This method enables the coalescing of small containers
+                     * into fewer network packets. Containers are sent at the
+                     * latest after the given deadline. Conferences that do not
+                     * send over the network ignore this setting.
+                     * @param flushDeadline Deadline in microseconds; 0 disables coalescing.
+                     */
+                    virtual void setSendCoalescingDeadline(const uint32_t &flushDeadline);
+
+                    /**
+                     * This method declares that the participant of this
+                     * conference is interested in containers of the given
+                     * data type. Once any data type is declared, received
+                     * containers of other data types are dropped before
+                     * they are decoded; conferences that partition their
+                     * traffic by data type furthermore only join the
+                     * multicast groups of declared data types.
+                     *
+                     * @param dataType Data type to receive.
+                     */
+                    virtual void subscribe(const int32_t &dataType);
+
+                    /**
+                     * This method declares that the participant of this
+                     * conference is interested in containers of all data
+                     * types.
+                     */
+                    virtual void subscribeAll();
+
+                    /**
+                     * This method replaces all data types that were declared
+                     * before; an empty set declares that the participant is
+                     * interested in containers of all data types. Multicast
+                     * groups that were joined before are not left.
+                     *
+                     * @param dataTypes Data types to receive.
+                     */
+                    virtual void setSubscriptions(const set<int32_t> &dataTypes);
+
+                    /**
+                     * This method returns true if containers of the given
+                     * data type are distributed to the ContainerListener.
+                     *
+                     * @param dataType Data type.
+                     * @return true if no data type or the given data type is subscribed.
+                     */
+                    bool isSubscribed(const int32_t &dataType) const;
+
+                    /**
+                     * This method returns the number of received containers
+                     * that were dropped as their data type is not subscribed.
+                     *
+                     * @return Map of data type to number of dropped containers.
+                     */
+                    map<int32_t, uint64_t> getNumberOfDroppedContainers() const;
+
                     /**
                      * This method sets a user-defined attribute to be used for
                      * stamping any container that is sent.
@@ -98,6 +175,24 @@ class ContainerListener;
                     uint32_t getSenderStamp() const;
 
                 protected:
+                    /**
+                     * This method returns true if a received container of
+                     * the given data type shall be distributed; otherwise,
+                     * the container is counted as dropped.
+                     *
+                     * @param dataType Data type of the received container.
+                     * @return true if the container shall be distributed.
+                     */
+                    bool accept(const int32_t &dataType);
+
+                    /**
+                     * This method sets the sent, sample, and sender stamps
+                     * of a container to be sent.
+                     *
+                     * @param container Container to be stamped.
+                     */
+                    void stamp(odcore::data::Container &container) const;
+
                     /**
                      * This method can be called from any subclass to distribute
                      * a newly received container.
@@ -119,6 +214,11 @@ class ContainerListener;
 
                     mutable base::Mutex m_senderStampMutex;
                     uint32_t m_senderStamp;
+
+                    mutable base::Mutex m_subscriptionsMutex;
+                    bool m_subscribedToAll;
+                    set<int32_t> m_subscriptions;
+                    map<int32_t, uint64_t> m_droppedContainers;
             };
 
         }
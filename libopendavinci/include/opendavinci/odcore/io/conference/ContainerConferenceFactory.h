@@ -20,17 +20,21 @@
 #ifndef OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCEFACTORY_H_
 #define OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCEFACTORY_H_
 
+#include <map>
+#include <set>
 #include <string>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include <memory>
 #include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/io/conference/TopicPartitioning.h"
 
 namespace odcore {
     namespace io {
         namespace conference {
 
 class ContainerConference;
+class InProcessContainerHub;
 
             using namespace std;
 
@@ -84,6 +88,72 @@ class ContainerConference;
                      */
                     virtual std::shared_ptr<ContainerConference> getContainerConference(const string &address, const uint32_t &port = ContainerConferenceFactory::MULTICAST_PORT);
 
+                    /**
+                     * This method selects shared memory for conferences on
+                     * the given address (i.e. for one CID). Participants on
+                     * the same host exchange containers via shared memory
+                     * while remote peers are reached via UDP multicast. If
+                     * no shared memory is available, UDP multicast is used.
+                     *
+                     * @param address Address of the conference.
+                     * @param enabled true to use shared memory for this address.
+                     */
+                    void setSharedMemoryEnabled(const string &address, const bool &enabled);
+
+                    /**
+                     * This method returns true if shared memory is selected
+                     * for conferences on the given address.
+                     *
+                     * @param address Address of the conference.
+                     * @return true if shared memory is selected.
+                     */
+                    bool isSharedMemoryEnabled(const string &address) const;
+
+                    /**
+                     * This method selects in-process conferences for the
+                     * given address (i.e. for one CID). All conferences
+                     * returned for this address share one hub that hands
+                     * containers to the other modules in this process
+                     * without serialization; remote peers are reached via
+                     * one network conference per process.
+                     *
+                     * @param address Address of the conference.
+                     * @param enabled true to use in-process conferences for this address.
+                     */
+                    void setInProcessEnabled(const string &address, const bool &enabled);
+
+                    /**
+                     * This method returns true if in-process conferences
+                     * are selected for the given address.
+                     *
+                     * @param address Address of the conference.
+                     * @return true if in-process conferences are selected.
+                     */
+                    bool isInProcessEnabled(const string &address) const;
+
+                    /**
+                     * This method sets the mapping of data types to
+                     * multicast groups for conferences using the given
+                     * address. Participants of such conferences only
+                     * receive containers of the data types they subscribed
+                     * to (cf. ContainerConference::subscribe) and of the
+                     * data types that remain on the conference's address.
+                     * The mapping must be identical for all participants.
+                     *
+                     * @param address Address of the conference.
+                     * @param partitioning Mapping of data types to multicast groups; an empty mapping disables partitioning.
+                     */
+                    void setTopicPartitioning(const string &address, const TopicPartitioning &partitioning);
+
+                    /**
+                     * This method returns the mapping of data types to
+                     * multicast groups for the given address.
+                     *
+                     * @param address Address of the conference.
+                     * @return Mapping of data types to multicast groups.
+                     */
+                    TopicPartitioning getTopicPartitioning(const string &address) const;
+
                 protected:
                     /**
                      * This method sets the singleton pointer.
@@ -92,9 +162,30 @@ class ContainerConference;
                      */
                     static void setSingleton(ContainerConferenceFactory* singleton);
 
+                private:
+                    /**
+                     * This method returns a new ContainerConference to
+                     * reach other processes.
+                     *
+                     * @param address Use address for joining.
+                     * @param port Use port for joining.
+                     * @return ContainerConference.
+                     */
+                    std::shared_ptr<ContainerConference> getNetworkConference(const string &address, const uint32_t &port);
+
                 private:
                     static base::Mutex m_singletonMutex;
                     static ContainerConferenceFactory* m_singleton;
+
+                    mutable base::Mutex m_sharedMemoryAddressesMutex;
+                    set<string> m_sharedMemoryAddresses;
+
+                    mutable base::Mutex m_inProcessMutex;
+                    set<string> m_inProcessAddresses;
+                    map<string, std::weak_ptr<InProcessContainerHub> > m_inProcessHubs;
+
+                    mutable base::Mutex m_topicPartitioningMutex;
+                    map<string, TopicPartitioning> m_topicPartitioning;
             };
 
         }
@@ -0,0 +1,145 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_CONFERENCE_INPROCESSCONTAINERCONFERENCE_H_
+#define OPENDAVINCI_CORE_IO_CONFERENCE_INPROCESSCONTAINERCONFERENCE_H_
+
+#include <deque>
+#include <memory>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Condition.h"
+#include "opendavinci/odcore/base/Service.h"
+#include "opendavinci/odcore/io/conference/ContainerConference.h"
+
+namespace odcore { namespace data { class Container; } }
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+class InProcessContainerHub;
+
+            using namespace std;
+
+            /**
+             * This class encapsulates a conference about containers between
+             * modules running in the same process. Every module has its own
+             * instance; all instances for the same conference share one
+             * InProcessContainerHub that hands containers to the other
+             * modules and bridges to the network for remote peers.
+             *
+             * Containers are delivered asynchronously by one thread per
+             * instance; thus, a slow ContainerListener does not block
+             * the senders. At most MAX_QUEUE_SIZE containers are queued
+             * per instance; when a ContainerListener does not keep up,
+             * the oldest queued containers are dropped.
+             */
+            class OPENDAVINCI_API InProcessContainerConference : public ContainerConference, public odcore::base::Service {
+                private:
+                    friend class ContainerConferenceFactory;
+                    friend class InProcessContainerHub;
+
+                public:
+                    enum {
+                        MAX_QUEUE_SIZE = 1024 // Containers queued for delivery.
+                    };
+
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    InProcessContainerConference(const InProcessContainerConference &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    InProcessContainerConference& operator=(const InProcessContainerConference &);
+
+                protected:
+                    /**
+                     * Constructor.
+                     *
+                     * @param hub Hub shared by all local participants of the conference.
+                     */
+                    InProcessContainerConference(std::shared_ptr<InProcessContainerHub> hub);
+
+                public:
+                    virtual ~InProcessContainerConference();
+
+                    virtual void setContainerListener(ContainerListener *cl);
+
+                    virtual void send(odcore::data::Container &container) const;
+
+                    virtual void send(odcore::data::Container &&container) const;
+
+                    virtual void setSendCoalescingDeadline(const uint32_t &flushDeadline);
+
+                    virtual void subscribe(const int32_t &dataType);
+
+                    virtual void subscribeAll();
+
+                    /**
+                     * This method returns the hub shared by all local
+                     * participants of this conference.
+                     *
+                     * @return Hub.
+                     */
+                    std::shared_ptr<InProcessContainerHub> getHub() const;
+
+                    /**
+                     * This method returns how many containers were dropped
+                     * since the ContainerListener did not keep up.
+                     *
+                     * @return Number of dropped containers.
+                     */
+                    uint64_t getNumberOfOverruns() const;
+
+                protected:
+                    virtual void beforeStop();
+
+                    virtual void run();
+
+                private:
+                    /**
+                     * This method enqueues a container to be delivered to
+                     * the registered ContainerListener.
+                     *
+                     * @param container Container shared with the other participants.
+                     */
+                    void enqueue(const std::shared_ptr<const odcore::data::Container> &container);
+
+                private:
+                    std::shared_ptr<InProcessContainerHub> m_hub;
+
+                    mutable base::Condition m_queueCondition;
+                    deque<std::shared_ptr<const odcore::data::Container> > m_queue;
+                    uint64_t m_numberOfOverruns;
+            };
+
+        }
+    }
+} // odcore::io::conference
+
+#endif /*OPENDAVINCI_CORE_IO_CONFERENCE_INPROCESSCONTAINERCONFERENCE_H_*/
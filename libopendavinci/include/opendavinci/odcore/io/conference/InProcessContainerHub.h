@@ -0,0 +1,188 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_CONFERENCE_INPROCESSCONTAINERHUB_H_
+#define OPENDAVINCI_CORE_IO_CONFERENCE_INPROCESSCONTAINERHUB_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/io/conference/ContainerListener.h"
+
+namespace odcore { namespace data { class Container; } }
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+class ContainerConference;
+class InProcessContainerConference;
+
+            using namespace std;
+
+            /**
+             * This class connects all InProcessContainerConferences of one
+             * process that join the same conference. Containers are handed
+             * to the other local participants as reference-counted pointers
+             * without being serialized; only the network conference for
+             * remote peers serializes them.
+             *
+             * The network conference is shared by all participants. Hence,
+             * it is subscribed to the union of the participants' data types;
+             * while one participant receives all data types, the network
+             * conference receives all data types, too. A participant that
+             * neither has subscribed nor has a ContainerListener yet (i.e.
+             * a module that is still in setUp()) is not considered. The
+             * subscriptions are recomputed whenever participants subscribe,
+             * register their ContainerListener, or leave.
+             */
+            class OPENDAVINCI_API InProcessContainerHub : public ContainerListener {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    InProcessContainerHub(const InProcessContainerHub &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    InProcessContainerHub& operator=(const InProcessContainerHub &);
+
+                public:
+                    /**
+                     * Constructor.
+                     *
+                     * @param network Conference to reach remote peers; may be NULL.
+                     */
+                    InProcessContainerHub(std::shared_ptr<ContainerConference> network);
+
+                    virtual ~InProcessContainerHub();
+
+                    /**
+                     * This method adds a local participant.
+                     *
+                     * @param conference Participant to be added.
+                     */
+                    void add(InProcessContainerConference *conference);
+
+                    /**
+                     * This method removes a local participant; afterwards,
+                     * no more containers are handed to it.
+                     *
+                     * @param conference Participant to be removed.
+                     */
+                    void remove(InProcessContainerConference *conference);
+
+                    /**
+                     * This method hands a stamped container to all other
+                     * local participants and sends it to remote peers.
+                     *
+                     * @param container Container to be sent.
+                     * @param sender Participant that sends the container.
+                     */
+                    void send(odcore::data::Container &container, const InProcessContainerConference *sender);
+
+                    /**
+                     * This method sets the coalescing deadline for sending
+                     * to remote peers.
+                     *
+                     * @param flushDeadline Deadline in microseconds; 0 disables coalescing.
+                     */
+                    void setSendCoalescingDeadline(const uint32_t &flushDeadline);
+
+                    /**
+                     * This method subscribes a local participant to a data
+                     * type from remote peers; containers received from remote
+                     * peers are handed to all local participants.
+                     *
+                     * @param conference Participant that subscribes.
+                     * @param dataType Data type to receive.
+                     */
+                    void subscribe(const InProcessContainerConference *conference, const int32_t &dataType);
+
+                    /**
+                     * This method subscribes a local participant to all
+                     * data types from remote peers.
+                     *
+                     * @param conference Participant that subscribes.
+                     */
+                    void subscribeAll(const InProcessContainerConference *conference);
+
+                    /**
+                     * This method tells whether a local participant has a
+                     * ContainerListener and thus receives containers.
+                     *
+                     * @param conference Participant.
+                     * @param listening true if the participant has a ContainerListener.
+                     */
+                    void setListening(const InProcessContainerConference *conference, const bool &listening);
+
+                    /**
+                     * This method returns the conference to reach remote peers.
+                     *
+                     * @return Network conference or NULL.
+                     */
+                    std::shared_ptr<ContainerConference> getNetworkConference() const;
+
+                    virtual void nextContainer(odcore::data::Container &c);
+
+                private:
+                    /**
+                     * This method hands a container to all local participants
+                     * except for the sender.
+                     *
+                     * @param container Container to be handed.
+                     * @param sender Participant that sends the container or NULL.
+                     */
+                    void distribute(const odcore::data::Container &container, const InProcessContainerConference *sender);
+
+                    /**
+                     * This method subscribes the network conference to the
+                     * data types of all local participants. The caller must
+                     * hold m_subscriptionsMutex.
+                     */
+                    void updateNetworkSubscriptions();
+
+                private:
+                    std::shared_ptr<ContainerConference> m_network;
+
+                    mutable base::Mutex m_conferencesMutex;
+                    vector<InProcessContainerConference*> m_conferences;
+
+                    base::Mutex m_subscriptionsMutex;
+                    map<const InProcessContainerConference*, set<int32_t> > m_subscriptions;
+                    set<const InProcessContainerConference*> m_subscribedToAll;
+                    set<const InProcessContainerConference*> m_listening;
+                    set<int32_t> m_networkSubscriptions;
+            };
+
+        }
+    }
+} // odcore::io::conference
+
+#endif /*OPENDAVINCI_CORE_IO_CONFERENCE_INPROCESSCONTAINERHUB_H_*/
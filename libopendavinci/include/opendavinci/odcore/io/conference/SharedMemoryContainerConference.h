@@ -0,0 +1,209 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_CONFERENCE_SHAREDMEMORYCONTAINERCONFERENCE_H_
+#define OPENDAVINCI_CORE_IO_CONFERENCE_SHAREDMEMORYCONTAINERCONFERENCE_H_
+
+#include <memory>
+#include <string>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/BroadcastRing.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/base/Service.h"
+#include "opendavinci/odcore/io/conference/ContainerConference.h"
+#include "opendavinci/odcore/io/conference/ContainerListener.h"
+
+namespace odcore { namespace data { class Container; } }
+namespace odcore { namespace wrapper { class SharedMemory; } }
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+class UDPMultiCastContainerConference;
+
+            using namespace std;
+
+            /**
+             * This class encapsulates a conference about containers between
+             * processes on the same host. Containers are serialized once
+             * into a broadcast ring in shared memory from which all other
+             * participants read.
+             *
+             * Exactly one participant creates the shared memory; it bridges
+             * the conference to the UDP multicast group with the same
+             * address: It forwards local containers to the network and
+             * publishes containers received from remote peers into the
+             * ring. When this participant leaves, the remaining ones
+             * reconnect and one of them takes over. The same happens when
+             * the creator did not signal for CREATOR_TIMEOUT, e.g. since it
+             * crashed; it signals from a separate thread so that a slow
+             * ContainerListener does not let the others replace the ring.
+             */
+            class OPENDAVINCI_API SharedMemoryContainerConference : public ContainerConference, public ContainerListener, public odcore::base::Service {
+                private:
+                    friend class ContainerConferenceFactory;
+
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    SharedMemoryContainerConference(const SharedMemoryContainerConference &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    SharedMemoryContainerConference& operator=(const SharedMemoryContainerConference &);
+
+                private:
+                    class Heartbeat;
+
+                    enum {
+                        NUMBER_OF_SLOTS = 4096,
+                        SLOT_SIZE = 4096, // Containers may span several slots.
+                        ATTACH_TIMEOUT = 100 * 1000, // Time to wait for the creator's initialization.
+                        CONNECT_ATTEMPTS = 10, // Attempts to attach to a ring that is created concurrently.
+                        RETRY_INTERVAL = 10 * 1000, // Time between two attempts to connect.
+                        WAIT_TIMEOUT = 100 * 1000, // Maximum time to wait for new containers.
+                        CREATOR_TIMEOUT = 1000 * 1000, // Time without heartbeat until the creator's ring is replaced.
+                        HEARTBEAT_INTERVAL = 100, // Milliseconds between two heartbeats of the creator.
+                        FROM_NETWORK = 1 // Flag for containers received from remote peers.
+                    };
+
+                protected:
+                    /**
+                     * Constructor.
+                     *
+                     * @param address Use address for joining.
+                     * @param port Use port for joining.
+                     */
+                    SharedMemoryContainerConference(const string &address, const uint32_t &port);
+
+                public:
+                    virtual ~SharedMemoryContainerConference();
+
+                    /**
+                     * This method returns true if the shared memory could
+                     * be used.
+                     *
+                     * @return true if the conference is usable.
+                     */
+                    bool isValid() const;
+
+                    /**
+                     * This method returns true if this participant bridges
+                     * the conference to the network.
+                     *
+                     * @return true if this participant is the bridge.
+                     */
+                    bool isBridge() const;
+
+                    /**
+                     * This method returns how often this participant was
+                     * overrun by the producers and had to skip containers.
+                     *
+                     * @return Number of overruns.
+                     */
+                    uint64_t getNumberOfOverruns() const;
+
+                    virtual void send(odcore::data::Container &container) const;
+
+                    virtual void send(odcore::data::Container &&container) const;
+
+                    virtual void nextContainer(odcore::data::Container &c);
+
+                protected:
+                    virtual void beforeStop();
+
+                    virtual void run();
+
+                private:
+                    /**
+                     * This method returns the name of the shared memory for
+                     * the given conference.
+                     *
+                     * @param address Address of the conference.
+                     * @param port Port of the conference.
+                     * @return Name for the shared memory.
+                     */
+                    static string getSharedMemoryName(const string &address, const uint32_t &port);
+
+                    /**
+                     * This method attaches to the shared memory or creates
+                     * it if it does not exist; m_ringMutex must be held.
+                     *
+                     * @return true if the shared memory is usable.
+                     */
+                    bool connect();
+
+                    /**
+                     * This method signals that the creator of the ring is
+                     * still alive if this participant is the creator.
+                     */
+                    void heartbeat();
+
+                    /**
+                     * This method writes a container into the ring.
+                     *
+                     * @param container Container to be written.
+                     * @param flags Flags for the entry.
+                     */
+                    void write(const odcore::data::Container &container, const uint32_t &flags) const;
+
+                    /**
+                     * This method reads the next container from the given
+                     * ring and distributes it or waits for new containers.
+                     *
+                     * @param ring Ring to read from.
+                     * @param cursor Cursor of this participant.
+                     * @param origin Identifier of this participant.
+                     * @param network Network conference if this participant is the bridge.
+                     */
+                    void distribute(odcore::base::BroadcastRing &ring, uint64_t &cursor, const uint32_t &origin, std::shared_ptr<UDPMultiCastContainerConference> network);
+
+                private:
+                    const string m_address;
+                    const uint32_t m_port;
+                    const string m_name;
+
+                    mutable base::Mutex m_ringMutex;
+                    std::shared_ptr<odcore::wrapper::SharedMemory> m_sharedMemory;
+                    std::shared_ptr<odcore::base::BroadcastRing> m_ring;
+                    bool m_creator;
+                    uint32_t m_origin;
+                    uint64_t m_cursor;
+                    std::shared_ptr<UDPMultiCastContainerConference> m_network;
+
+                    mutable base::Mutex m_overrunsMutex;
+                    uint64_t m_numberOfOverruns;
+
+                    std::shared_ptr<Heartbeat> m_heartbeat;
+            };
+
+        }
+    }
+} // odcore::io::conference
+
+#endif /*OPENDAVINCI_CORE_IO_CONFERENCE_SHAREDMEMORYCONTAINERCONFERENCE_H_*/
@@ -0,0 +1,134 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_IO_CONFERENCE_TOPICPARTITIONING_H_
+#define OPENDAVINCI_CORE_IO_CONFERENCE_TOPICPARTITIONING_H_
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+
+            /**
+             * This class maps data types to multicast groups. Group 0 is
+             * the conference's own multicast group; group n uses the
+             * conference's address with its second octet increased by n
+             * (e.g. 225.2.0.100 for group 2 of 225.0.0.100). Thus, the
+             * groups of one CID never collide with the conferences of
+             * other CIDs, which differ in the last octet. Data types are mapped
+             * to groups either by configured ranges or by distributing
+             * them evenly across a number of hashed groups, which are
+             * numbered after the highest configured group. Data types
+             * that are not mapped remain on group 0.
+             *
+             * @code
+             * TopicPartitioning tp;
+             * tp.addRange(Container::SHARED_IMAGE, Container::SHARED_IMAGE, 1);
+             * tp.setNumberOfHashedGroups(4);
+             * ContainerConferenceFactory::getInstance().setTopicPartitioning("225.0.0.100", tp);
+             * @endcode
+             */
+            class OPENDAVINCI_API TopicPartitioning {
+                public:
+                    TopicPartitioning();
+
+                    /**
+                     * Copy constructor.
+                     *
+                     * @param obj Reference to an object of this class.
+                     */
+                    TopicPartitioning(const TopicPartitioning &obj);
+
+                    virtual ~TopicPartitioning();
+
+                    /**
+                     * Assignment operator.
+                     *
+                     * @param obj Reference to an object of this class.
+                     * @return Reference to this instance.
+                     */
+                    TopicPartitioning& operator=(const TopicPartitioning &obj);
+
+                    /**
+                     * This method maps the given range of data types to a
+                     * multicast group; an overlapping range that was added
+                     * before is replaced.
+                     *
+                     * @param firstDataType First data type of the range.
+                     * @param lastDataType Last data type of the range.
+                     * @param group Multicast group (> 0).
+                     * @return true if the range was added.
+                     */
+                    bool addRange(const int32_t &firstDataType, const int32_t &lastDataType, const uint32_t &group);
+
+                    /**
+                     * This method sets the number of groups across which
+                     * the data types not covered by any range are spread.
+                     *
+                     * @param numberOfHashedGroups Number of groups; 0 keeps unmapped data types on group 0.
+                     */
+                    void setNumberOfHashedGroups(const uint32_t &numberOfHashedGroups);
+
+                    /**
+                     * @return true if any data type is mapped to another group than 0.
+                     */
+                    bool isEnabled() const;
+
+                    /**
+                     * This method returns the multicast group for a data type.
+                     *
+                     * @param dataType Data type.
+                     * @return Multicast group.
+                     */
+                    uint32_t getGroup(const int32_t &dataType) const;
+
+                    /**
+                     * @return Highest multicast group to which data types are mapped.
+                     */
+                    uint32_t getNumberOfGroups() const;
+
+                    /**
+                     * This method returns the address of a multicast group.
+                     *
+                     * @param address Address of the conference (i.e. group 0).
+                     * @param group Multicast group.
+                     * @return Address of the multicast group or an empty string if the address is invalid
+                     *         or the second octet would exceed 255.
+                     */
+                    static string getAddress(const string &address, const uint32_t &group);
+
+                private:
+                    // First data type -> (last data type, group).
+                    map<int32_t, pair<int32_t, uint32_t> > m_ranges;
+                    uint32_t m_highestConfiguredGroup;
+                    uint32_t m_numberOfHashedGroups;
+            };
+
+        }
+    }
+} // odcore::io::conference
+
+#endif /*OPENDAVINCI_CORE_IO_CONFERENCE_TOPICPARTITIONING_H_*/
@@ -20,13 +20,20 @@
 #ifndef OPENDAVINCI_CORE_IO_CONFERENCE_UDPMULTICASTCONTAINERCONFERENCE_H_
 #define OPENDAVINCI_CORE_IO_CONFERENCE_UDPMULTICASTCONTAINERCONFERENCE_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/exceptions/Exceptions.h"
 #include "opendavinci/odcore/io/PacketListener.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
+#include "opendavinci/odcore/io/conference/TopicPartitioning.h"
+#include "opendavinci/odcore/io/udp/CoalescingUDPSender.h"
+#include "opendavinci/odcore/io/udp/FragmentReassembler.h"
 #include "opendavinci/odcore/io/udp/UDPReceiver.h"
 #include "opendavinci/odcore/io/udp/UDPSender.h"
 
@@ -44,10 +51,17 @@ namespace odcore {
              * sending and receiving containers. Therefore, it implements
              * a StringListener for getting informed about new strings from
              * the UDPReceiver and informs any connected ContainerListener.
+             *
+             * If a TopicPartitioning is given, containers are sent to the
+             * multicast group of their data type and only the groups of
+             * subscribed data types are joined besides the conference's
+             * own group; thus, unwanted traffic is already dropped by the
+             * network interface.
              */
             class OPENDAVINCI_API UDPMultiCastContainerConference : public ContainerConference, public odcore::io::PacketListener {
                 private:
                     friend class ContainerConferenceFactory;
+                    friend class SharedMemoryContainerConference;
 
                 private:
                     /**
@@ -64,26 +78,172 @@ namespace odcore {
                      */
                     UDPMultiCastContainerConference& operator=(const UDPMultiCastContainerConference &);
 
+                private:
+                    enum {
+                        RECEIVE_BATCH_SIZE = 16, // Maximum number of datagrams to be received at once.
+                        COALESCED_DATAGRAM_SIZE = 1472, // Ethernet MTU without IP and UDP headers.
+                        MAX_DATAGRAM_SIZE = 65507, // Larger containers are sent in fragments.
+                        MAX_PENDING_FRAGMENT_BYTES = 16 * 1024 * 1024, // Memory for incomplete containers.
+                        MAX_FRAGMENTS_PER_CONTAINER = 256, // Larger containers (about 16 MB) are not sent.
+                        MAX_PENDING_CONTAINERS = 64, // Number of incomplete containers.
+                        FRAGMENT_TIMEOUT = 1000 * 1000 // Incomplete containers are evicted after 1s.
+                    };
+
                 protected:
                     /**
                      * Constructor.
                      *
                      * @param address Use address for joining.
                      * @param port Use port for joining.
+                     * @param partitioning Mapping of data types to multicast groups.
                      * @throws ConferenceException if the conference could not be created.
                      */
-                    UDPMultiCastContainerConference(const string &address, const uint32_t &port) throw (exceptions::ConferenceException);
+                    UDPMultiCastContainerConference(const string &address, const uint32_t &port, const TopicPartitioning &partitioning = TopicPartitioning()) throw (exceptions::ConferenceException);
 
                 public:
                     virtual ~UDPMultiCastContainerConference();
 
                     virtual void nextPacket(const odcore::data::Packet &p);
 
+                    virtual void nextSharedPacket(const odcore::io::SharedPacket &p);
+
+                    virtual void nextSharedPackets(const vector<odcore::io::SharedPacket> &packets);
+
                     virtual void send(odcore::data::Container &container) const;
 
+                    virtual void send(odcore::data::Container &&container) const;
+
+                    virtual void sendBatch(vector<odcore::data::Container> &containers) const;
+
+                    virtual void setSendCoalescingDeadline(const uint32_t &flushDeadline);
+
+                    virtual void subscribe(const int32_t &dataType);
+
+                    virtual void subscribeAll();
+
+                    virtual void setSubscriptions(const set<int32_t> &dataTypes);
+
+                    /**
+                     * This method returns the number of received fragments of
+                     * large containers that were dropped since they were
+                     * invalid or their container could not be completed in time.
+                     *
+                     * @return Number of dropped fragments.
+                     */
+                    uint64_t getNumberOfDroppedFragments() const;
+
                 private:
+                    /**
+                     * This method returns the multicast group for a
+                     * serialized container.
+                     *
+                     * @param data Serialized container.
+                     * @return Multicast group.
+                     */
+                    uint32_t getGroup(const string &data) const;
+
+                    /**
+                     * This method returns the senders for a multicast group
+                     * and creates them if necessary; the send buffer's mutex
+                     * must be held by the caller.
+                     *
+                     * @param group Multicast group.
+                     * @param sender Sender for the group.
+                     * @param coalescingSender Coalescing sender for the group; NULL if coalescing is disabled.
+                     */
+                    void getSenders(const uint32_t &group, std::shared_ptr<odcore::io::udp::UDPSender> &sender, std::shared_ptr<odcore::io::udp::CoalescingUDPSender> &coalescingSender) const;
+
+                    /**
+                     * This method joins a multicast group.
+                     *
+                     * @param group Multicast group.
+                     */
+                    void join(const uint32_t &group);
+
+                    /**
+                     * This method distributes all containers contained in
+                     * the given data.
+                     *
+                     * @param data Received data.
+                     * @param length Length of the received data.
+                     * @param received Time stamp when the data was received.
+                     */
+                    void receiveContainers(const char *data, const uint32_t &length, const odcore::data::TimeStamp &received);
+
+                    /**
+                     * This method appends the given serialized container to
+                     * the datagrams to be sent; containers exceeding one
+                     * datagram are split into fragments. Containers requiring
+                     * more than MAX_FRAGMENTS_PER_CONTAINER fragments are
+                     * dropped without modifying the datagrams.
+                     *
+                     * @param data Serialized container.
+                     * @param datagrams Datagrams to be sent.
+                     * @return false if the container is too large to be sent.
+                     */
+                    bool appendDatagrams(const string &data, vector<string> &datagrams) const;
+
+                    /**
+                     * This method sends the fragments of a large container.
+                     * As a fragment's header does not carry the payload's
+                     * length, fragments are never coalesced with other
+                     * containers; pending containers are sent before.
+                     *
+                     * @param fragments Fragments to be sent.
+                     * @param sender Sender to be used.
+                     * @param coalescingSender Coalescing sender with pending containers or NULL.
+                     */
+                    void sendFragments(const vector<string> &fragments, std::shared_ptr<odcore::io::udp::UDPSender> sender, std::shared_ptr<odcore::io::udp::CoalescingUDPSender> coalescingSender) const;
+
+                    /**
+                     * This method sends an already stamped and serialized
+                     * container that was received from another conference.
+                     *
+                     * @param data Serialized container.
+                     */
+                    void forward(const string &data) const;
+
+                    /**
+                     * This method sends a serialized container; the send
+                     * buffer's mutex must be held by the caller.
+                     *
+                     * @param data Serialized container.
+                     */
+                    void sendSerialized(const string &data) const;
+
+                    /**
+                     * This method serializes a container.
+                     *
+                     * @param container Container to be serialized.
+                     * @param buffer Buffer to serialize to.
+                     */
+                    void serialize(const odcore::data::Container &container, string &buffer) const;
+
+                private:
+                    const string m_address;
+                    const uint32_t m_port;
+                    const TopicPartitioning m_partitioning;
+
                     std::shared_ptr<odcore::io::udp::UDPSender> m_sender;
                     std::shared_ptr<odcore::io::udp::UDPReceiver> m_receiver;
+
+                    // Containers are serialized into this buffer, which is
+                    // reused across calls to avoid allocating memory. The
+                    // mutex also protects the coalescing sender.
+                    mutable base::Mutex m_sendBufferMutex;
+                    mutable string m_sendBuffer;
+                    std::shared_ptr<odcore::io::udp::CoalescingUDPSender> m_coalescingSender;
+                    mutable uint32_t m_nextMessageId;
+                    uint32_t m_flushDeadline;
+
+                    // Senders and receivers for the multicast groups of
+                    // partitioned data types; group 0 uses the ones above.
+                    mutable map<uint32_t, std::shared_ptr<odcore::io::udp::UDPSender> > m_groupSenders;
+                    mutable map<uint32_t, std::shared_ptr<odcore::io::udp::CoalescingUDPSender> > m_groupCoalescingSenders;
+                    base::Mutex m_groupReceiversMutex;
+                    map<uint32_t, std::shared_ptr<odcore::io::udp::UDPReceiver> > m_groupReceivers;
+
+                    odcore::io::udp::FragmentReassembler m_reassembler;
             };
 
         }
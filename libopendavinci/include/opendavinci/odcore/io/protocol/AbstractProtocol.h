@@ -78,6 +78,17 @@ namespace odcore {
                      */
                     void sendByStringSender(const string &data);
 
+                    /**
+                     * This method needs to be called by subclasses to send
+                     * several buffers as one consecutive byte sequence
+                     * according to the implemented protocol.
+                     *
+                     * @param buffers Buffers to be sent.
+                     * @param lengths Length of each buffer.
+                     * @param numberOfBuffers Number of buffers.
+                     */
+                    void sendByStringSender(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers);
+
                 private:
                     odcore::base::Mutex m_stringSenderMutex;
                     StringSender *m_stringSender;
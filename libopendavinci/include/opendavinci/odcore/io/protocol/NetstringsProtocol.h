@@ -20,8 +20,8 @@
 #ifndef OPENDAVINCI_CORE_IO_PROTOCOL_NETSTRINGSPROTOCOL_H_
 #define OPENDAVINCI_CORE_IO_PROTOCOL_NETSTRINGSPROTOCOL_H_
 
-#include <sstream>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
@@ -57,6 +57,11 @@ namespace odcore {
              * np.send(payload);
              *
              * @endcode
+             *
+             * Received data is gathered in a growable buffer that is only
+             * compacted when running out of space. The length prefix is
+             * parsed incrementally so that no byte is scanned twice and
+             * payloads are passed directly from the buffer.
              */
             class OPENDAVINCI_API NetstringsProtocol : public StringObserver, public AbstractProtocol {
                 private:
@@ -104,8 +109,35 @@ namespace odcore {
                     virtual void nextString(const string &s);
 
                 private:
+                    enum DECODER_STATE {
+                        READING_LENGTH,
+                        READING_PAYLOAD
+                    };
+
+                    enum {
+                        INITIAL_BUFFER_SIZE = 4096
+                    };
+
+                    /**
+                     * This method decodes all complete Netstrings from the buffer.
+                     */
                     void decodeNetstring();
 
+                    /**
+                     * This method appends received data to the buffer and
+                     * compacts or enlarges the buffer if necessary.
+                     *
+                     * @param data Received data.
+                     * @param length Length of the received data.
+                     */
+                    void append(const char *data, const uint32_t &length);
+
+                    /**
+                     * This method discards all buffered data, for instance
+                     * after receiving corrupted data.
+                     */
+                    void resetDecoder();
+
                     /**
                      * This method is used to pass received data thread-safe
                      * to the registered StringListener.
@@ -116,7 +148,14 @@ namespace odcore {
                     StringListener *m_stringListener;
 
                     odcore::base::Mutex m_partialDataMutex;
-                    stringstream m_partialData;
+                    vector<char> m_partialData;
+                    uint32_t m_begin;
+                    uint32_t m_end;
+
+                    DECODER_STATE m_state;
+                    uint32_t m_lengthOfPayload;
+                    uint32_t m_parsedBytes;
+                    string m_payload;
             };
 
         }
@@ -27,6 +27,7 @@
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/io/ConnectionObserver.h"
 #include "opendavinci/odcore/io/StringObserver.h"
+#include "opendavinci/odcore/io/StringSender.h"
 
 namespace odcore { namespace io { class ConnectionListener; } }
 namespace odcore { namespace io { class StringListener; } }
@@ -37,7 +38,7 @@ namespace odcore {
 
             using namespace std;
 
-            class OPENDAVINCI_API TCPConnection : public StringObserver, public ConnectionObserver {
+            class OPENDAVINCI_API TCPConnection : public StringObserver, public ConnectionObserver, public StringSender {
                 private:
                     /**
                      * "Forbidden" copy constructor. Goal: The compiler should warn
@@ -67,7 +68,19 @@ namespace odcore {
                      *
                      * @param data Data to send.
                      */
-                    void send(const string &data);
+                    virtual void send(const string &data);
+
+                    /**
+                     * This method sends several buffers as one consecutive
+                     * byte sequence using this TCP connection. The buffers
+                     * and the prepended size information are written at
+                     * once without concatenating them.
+                     *
+                     * @param buffers Buffers to be sent.
+                     * @param lengths Length of each buffer.
+                     * @param numberOfBuffers Number of buffers.
+                     */
+                    virtual void sendBuffers(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers);
 
                     /**
                      * This method registers a ConnectionListener that will be
@@ -132,6 +145,19 @@ namespace odcore {
                      */
                     virtual void sendImplementation(const string &data) = 0;
 
+                    /**
+                     * This method is called from within sendBuffers() to
+                     * send several buffers at once. The default implementation
+                     * concatenates the buffers and calls sendImplementation();
+                     * subclasses being able to write several buffers at once
+                     * override this method.
+                     *
+                     * @param buffers Buffers including the prepended size information.
+                     * @param lengths Length of each buffer.
+                     * @param numberOfBuffers Number of buffers.
+                     */
+                    virtual void sendBuffersImplementation(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers);
+
                     /**
                      * This method is called be subclasses to invoke
                      * the connection listener.
@@ -0,0 +1,137 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_UDP_COALESCINGUDPSENDER_H_
+#define OPENDAVINCI_CORE_IO_UDP_COALESCINGUDPSENDER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Condition.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/base/Service.h"
+#include "opendavinci/odcore/io/udp/UDPSender.h"
+
+namespace odcore {
+    namespace io {
+        namespace udp {
+
+            using namespace std;
+
+            /**
+             * This class packs several small payloads into one datagram
+             * and sends the collected datagrams at once when the flush
+             * deadline has passed after the first pending payload. The
+             * payloads are concatenated; thus, the receiver must be able
+             * to split them (for instance, serialized Containers).
+             *
+             * @code
+             * std::shared_ptr<UDPSender> s = UDPFactory::createUDPSender(address, port);
+             * CoalescingUDPSender cs(s, 200, 1472);
+             * cs.start();
+             * cs.send(a);
+             * cs.send(b); // a and b are sent in one datagram after 200us.
+             * ...
+             * cs.stop();
+             * @endcode
+             */
+            class OPENDAVINCI_API CoalescingUDPSender : public odcore::base::Service, public UDPSender {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    CoalescingUDPSender(const CoalescingUDPSender &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    CoalescingUDPSender& operator=(const CoalescingUDPSender &);
+
+                public:
+                    /**
+                     * Constructor.
+                     *
+                     * @param sender UDPSender to be used for sending the datagrams.
+                     * @param flushDeadline Time in microseconds after which pending payloads are sent.
+                     * @param maxDatagramSize Maximum size of a coalesced datagram; larger payloads are sent alone.
+                     */
+                    CoalescingUDPSender(std::shared_ptr<UDPSender> sender, const uint32_t &flushDeadline, const uint32_t &maxDatagramSize);
+
+                    virtual ~CoalescingUDPSender();
+
+                    virtual void send(const string &data) const;
+
+                    virtual void sendBatch(const vector<string> &data) const;
+
+                    virtual uint16_t getPort() const;
+
+                    /**
+                     * This method sends all pending payloads immediately.
+                     */
+                    void flush() const;
+
+                private:
+                    virtual void beforeStop();
+
+                    virtual void run();
+
+                    /**
+                     * This method appends the given payload to the current
+                     * datagram.
+                     *
+                     * @param data Payload to append.
+                     * @return true if there were no pending payloads before.
+                     */
+                    bool append(const string &data) const;
+
+                    /**
+                     * This method wakes the flushing thread.
+                     */
+                    void wakeUp() const;
+
+                    /**
+                     * This method sends all pending payloads; the caller
+                     * must hold m_sendMutex.
+                     */
+                    void sendPending() const;
+
+                private:
+                    std::shared_ptr<UDPSender> m_sender;
+                    const uint32_t m_flushDeadline;
+                    const uint32_t m_maxDatagramSize;
+
+                    mutable odcore::base::Condition m_pendingCondition;
+                    mutable odcore::base::Mutex m_pendingMutex;
+                    mutable odcore::base::Mutex m_sendMutex;
+                    mutable string m_currentDatagram;
+                    mutable vector<string> m_datagrams;
+            };
+
+        }
+    }
+} // odcore::io::udp
+
+#endif /*OPENDAVINCI_CORE_IO_UDP_COALESCINGUDPSENDER_H_*/
@@ -0,0 +1,212 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_IO_UDP_FRAGMENTREASSEMBLER_H_
+#define OPENDAVINCI_CORE_IO_UDP_FRAGMENTREASSEMBLER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+
+namespace odcore {
+    namespace io {
+        namespace udp {
+
+            using namespace std;
+
+            /**
+             * This class splits messages that are too large for one UDP
+             * datagram into fragments and reassembles them on the
+             * receiving side. Every fragment starts with the following
+             * header (little endian):
+             *
+             * 0x0D 0xA5 origin (4 bytes) message id (4 bytes) index (2 bytes) count (2 bytes)
+             *
+             * Incomplete messages are evicted after a timeout, when the
+             * memory for pending messages is exhausted, or when too many
+             * messages are pending; their fragments are counted as dropped.
+             * The memory for pending messages includes the bookkeeping
+             * per message and per announced fragment.
+             *
+             * @code
+             * vector<string> fragments;
+             * FragmentReassembler::fragment(data, origin, messageId, 65507, fragments);
+             * ...
+             * FragmentReassembler r(16 * 1024 * 1024, 1000 * 1000, 256, 64);
+             * string message;
+             * if (r.add(p.getSenderAddress(), p.getSenderPort(), p.getData(), p.getLength(), TimeStamp(), message)) {
+             *     // message is complete.
+             * }
+             * @endcode
+             */
+            class OPENDAVINCI_API FragmentReassembler {
+                public:
+                    enum {
+                        HEADER_SIZE = 14,
+                        MAX_NUMBER_OF_FRAGMENTS = 65535
+                    };
+
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    FragmentReassembler(const FragmentReassembler &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    FragmentReassembler& operator=(const FragmentReassembler &);
+
+                public:
+                    /**
+                     * Constructor.
+                     *
+                     * @param maxPendingBytes Maximum number of bytes held for incomplete messages.
+                     * @param timeout Time in microseconds after which incomplete messages are evicted.
+                     * @param maxNumberOfFragments Maximum number of fragments of one message as used by the sender.
+                     * @param maxPendingMessages Maximum number of incomplete messages.
+                     */
+                    FragmentReassembler(const uint32_t &maxPendingBytes, const uint32_t &timeout, const uint32_t &maxNumberOfFragments, const uint32_t &maxPendingMessages);
+
+                    virtual ~FragmentReassembler();
+
+                    /**
+                     * This method splits the given data into fragments.
+                     *
+                     * @param data Data to be split.
+                     * @param origin Identifier of the sending instance.
+                     * @param messageId Identifier of the message unique for the origin.
+                     * @param maxDatagramSize Maximum size of one fragment including its header.
+                     * @param fragments Resulting fragments.
+                     * @return false if the data requires too many fragments.
+                     */
+                    static bool fragment(const string &data, const uint32_t &origin, const uint32_t &messageId, const uint32_t &maxDatagramSize, vector<string> &fragments);
+
+                    /**
+                     * This method returns true if the given data starts
+                     * with a fragment header.
+                     *
+                     * @param data Received data.
+                     * @param length Length of the received data.
+                     * @return true if data is a fragment.
+                     */
+                    static bool isFragment(const char *data, const uint32_t &length);
+
+                    /**
+                     * This method adds a received fragment.
+                     *
+                     * @param senderAddress Sender's IPv4 address.
+                     * @param senderPort Sender's port.
+                     * @param data Received fragment including its header.
+                     * @param length Length of the received fragment.
+                     * @param now Current time used for evicting incomplete messages.
+                     * @param message Reassembled message if this fragment completed it.
+                     * @return true if a message was completed.
+                     */
+                    bool add(const uint32_t &senderAddress, const uint16_t &senderPort, const char *data, const uint32_t &length, const odcore::data::TimeStamp &now, string &message);
+
+                    /**
+                     * @return Number of fragments that were dropped since they were invalid,
+                     *         empty, duplicated, or belonged to an evicted message.
+                     */
+                    uint64_t getNumberOfDroppedFragments() const;
+
+                    /**
+                     * @return Number of incomplete messages that were evicted.
+                     */
+                    uint64_t getNumberOfEvictedMessages() const;
+
+                    /**
+                     * @return Number of bytes currently held for incomplete messages including their bookkeeping.
+                     */
+                    uint32_t getNumberOfPendingBytes() const;
+
+                private:
+                    struct Key {
+                        Key();
+                        Key(const uint32_t &senderAddress, const uint16_t &senderPort, const uint32_t &origin, const uint32_t &messageId);
+
+                        bool operator<(const Key &other) const;
+
+                        uint32_t m_senderAddress;
+                        uint16_t m_senderPort;
+                        uint32_t m_origin;
+                        uint32_t m_messageId;
+                    };
+
+                    struct PendingMessage {
+                        PendingMessage();
+
+                        int64_t m_firstFragment;
+                        uint32_t m_numberOfReceivedFragments;
+                        uint32_t m_numberOfBytes;
+                        vector<bool> m_received;
+                        vector<string> m_fragments;
+                    };
+
+                    /**
+                     * This method returns the number of bytes needed to
+                     * keep track of a message with the given number of
+                     * fragments besides their payload.
+                     */
+                    static uint32_t getOverhead(const uint32_t &numberOfFragments);
+
+                    /**
+                     * This method evicts all messages older than the timeout.
+                     */
+                    void evictExpired(const int64_t &now);
+
+                    /**
+                     * This method evicts the oldest incomplete message.
+                     */
+                    void evictOldest();
+
+                    /**
+                     * This method removes a pending message and counts its
+                     * fragments as dropped.
+                     */
+                    void evict(map<Key, PendingMessage>::iterator it);
+
+                private:
+                    const uint32_t m_maxPendingBytes;
+                    const int64_t m_timeout;
+                    const uint32_t m_maxNumberOfFragments;
+                    const uint32_t m_maxPendingMessages;
+
+                    mutable odcore::base::Mutex m_mutex;
+                    map<Key, PendingMessage> m_pendingMessages;
+                    uint32_t m_numberOfPendingBytes;
+                    uint64_t m_numberOfDroppedFragments;
+                    uint64_t m_numberOfEvictedMessages;
+            };
+
+        }
+    }
+} // odcore::io::udp
+
+#endif /*OPENDAVINCI_CORE_IO_UDP_FRAGMENTREASSEMBLER_H_*/
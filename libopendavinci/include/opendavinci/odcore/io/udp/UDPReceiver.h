@@ -20,11 +20,13 @@
 #ifndef OPENDAVINCI_CORE_IO_UDP_UDPRECEIVER_H_
 #define OPENDAVINCI_CORE_IO_UDP_UDPRECEIVER_H_
 
+#include <vector>
+
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/io/PacketObserver.h"
 #include "opendavinci/odcore/io/PacketPipeline.h"
+#include "opendavinci/odcore/io/SharedPacket.h"
 #include "opendavinci/odcore/io/StringObserver.h"
-#include "opendavinci/generated/odcore/data/Packet.h"
 
 namespace odcore { namespace io { class PacketListener; } }
 namespace odcore { namespace io { class StringListener; } }
@@ -137,12 +139,43 @@ namespace odcore {
                      */
                     virtual void setSenderPortToIgnore(const uint16_t &portToIgnore) = 0;
 
+                    /**
+                     * This method sets the maximum number of datagrams to be
+                     * received with one system call. Received datagrams are
+                     * passed as one batch to the PacketListener. This method
+                     * must be called before start(); implementations not
+                     * supporting batched receiving ignore this value.
+                     *
+                     * @param batchSize Maximum number of datagrams per system call; 1 disables batching.
+                     */
+                    virtual void setReceiveBatchSize(const uint32_t &batchSize);
+
+                    /**
+                     * This method sets the policy to apply when the decoupling
+                     * PacketPipeline is full, i.e. when the PacketListener
+                     * cannot keep up with the received packets.
+                     *
+                     * @param policy Policy to apply.
+                     */
+                    void setPacketPipelineOverflowPolicy(const PacketPipeline::OVERFLOW_POLICY &policy);
+
+                    /**
+                     * @return PacketPipeline decoupling the PacketListener to query its counters.
+                     */
+                    const PacketPipeline& getPacketPipeline() const;
+
                 protected:
                     /**
                      * This method is called from deriving classes to
                      * pass newly arrived packets.
                      */
-                    void nextPacket(const odcore::data::Packet &p);
+                    void nextPacket(const SharedPacket &p);
+
+                    /**
+                     * This method is called from deriving classes to
+                     * pass several newly arrived packets at once.
+                     */
+                    void nextPackets(const vector<SharedPacket> &packets);
 
                 private:
                     odcore::base::Mutex m_listenerMutex;
@@ -21,6 +21,7 @@
 #define OPENDAVINCI_CORE_IO_UDP_UDPSENDER_H_
 
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 
@@ -68,6 +69,14 @@ namespace odcore {
                      */
                     virtual void send(const string &data) const = 0;
 
+                    /**
+                     * This method sends several datagrams at once. The
+                     * default implementation calls send for each entry.
+                     *
+                     * @param data Datagrams to be sent.
+                     */
+                    virtual void sendBatch(const vector<string> &data) const;
+
                     /**
                      * This method returns the port in use when sending UDP packets.
                      *
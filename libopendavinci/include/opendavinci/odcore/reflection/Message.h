@@ -20,6 +20,7 @@
 #ifndef OPENDAVINCI_CORE_REFLECTION_MESSAGE_H_
 #define OPENDAVINCI_CORE_REFLECTION_MESSAGE_H_
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -117,8 +118,18 @@ namespace odcore {
                  */
                 uint32_t getNumberOfFields() const;
 
+                /**
+                 * This method returns the field at the given position.
+                 *
+                 * @param index Position of the field in the order it was added.
+                 * @return Field or an empty std::shared_ptr if index is out of range.
+                 */
+                std::shared_ptr<odcore::data::reflection::AbstractField> getFieldByIndex(const uint32_t &index) const;
+
                 /**
                  * This method tries to find a field with the given identifier.
+                 * The lookup uses a table indexed by the fields' identifiers;
+                 * if several fields share an identifier, the first one is returned.
                  *
                  * @param ID to find.
                  * @param found Flag modified by this method indicating if the field was found.
@@ -194,6 +205,7 @@ namespace odcore {
                 string m_shortName;
                 string m_longName;
                 vector<std::shared_ptr<odcore::data::reflection::AbstractField> > m_fields;
+                map<uint32_t, uint32_t> m_fieldIndex; // Maps a field's identifier to its position in m_fields.
         };
 
     }
@@ -21,12 +21,15 @@
 #define MESSAGE_RESOLVER_H_
 
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/reflection/Helper.h"
 #include "opendavinci/odcore/reflection/Message.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
 
 namespace odcore {
     namespace reflection {
@@ -51,8 +54,56 @@ namespace odcore {
                 odcore::reflection::Helper *m_helper;
         };
 
+        /**
+         * Internal class to decode the Protobuf-encoded payload of a
+         * container directly into a Message. The plan is compiled from
+         * a message that was resolved by a helper before and maps the
+         * field identifiers to the fields' types and names.
+         */
+        class DecodePlan {
+            public:
+                DecodePlan();
+
+                /**
+                 * Constructor.
+                 *
+                 * @param prototype Message that was resolved by a helper.
+                 */
+                DecodePlan(const odcore::reflection::Message &prototype);
+
+                DecodePlan(const DecodePlan &obj);
+                DecodePlan& operator=(const DecodePlan &obj);
+
+                virtual ~DecodePlan();
+
+                /**
+                 * @return true if the prototype's fields can be decoded using this plan.
+                 */
+                bool isValid() const;
+
+                /**
+                 * This method decodes the given payload.
+                 *
+                 * @param payload Protobuf-encoded payload.
+                 * @param msg Message to be filled.
+                 * @return true if all fields of the prototype were decoded.
+                 */
+                bool decode(const odcore::serialization::ByteSpan &payload, odcore::reflection::Message &msg) const;
+
+            private:
+                bool m_valid;
+                int32_t m_messageID;
+                string m_shortName;
+                string m_longName;
+                vector<std::shared_ptr<odcore::data::reflection::AbstractField> > m_fields;
+                vector<pair<uint32_t, uint32_t> > m_positionsById; // Sorted by identifier.
+                vector<std::shared_ptr<DecodePlan> > m_nestedPlans; // For fields of type SERIALIZABLE_T.
+        };
+
         /**
          * This class can be used to simply display data distributed using a conference.
+         * The helper that resolved a data type is cached; subsequent containers of this
+         * type are decoded using a DecodePlan if the default serialization is used.
          */
         class OPENDAVINCI_API MessageResolver {
             private:
@@ -101,12 +152,22 @@ namespace odcore {
                 void unloadSharedLibraries();
                 vector<string> getListOfLibrariesToLoad(const vector<string> &paths);
 
+                /**
+                 * This method returns the pretty printed representation of
+                 * the given message to compare messages.
+                 *
+                 * @param msg Message to be pretty printed.
+                 * @return Pretty printed representation.
+                 */
+                static const string getPrettyPrinted(odcore::reflection::Message &msg);
+
             private:
                 string m_libraryPrefixToMatch;
                 string m_librarySuffixToMatch;
                 vector<string> m_listOfLibrariesToLoad;
                 vector<HelperEntry> m_listOfHelpers;
                 map<int32_t, HelperEntry> m_previouslyMatchedHelper;
+                map<int32_t, DecodePlan> m_decodePlans;
         };
 
     }
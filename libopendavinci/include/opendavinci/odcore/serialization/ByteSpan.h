@@ -0,0 +1,103 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_SERIALIZATION_BYTESPAN_H_
+#define OPENDAVINCI_CORE_SERIALIZATION_BYTESPAN_H_
+
+#include <string>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        /**
+         * This class refers to a contiguous range of bytes without
+         * owning them. Thus, the bytes must outlive any ByteSpan
+         * referring to them.
+         *
+         * @code
+         * string data = ...;
+         * ByteSpan span(data.data(), data.size());
+         * MyMessage m;
+         * m.decodeFrom(span);
+         * @endcode
+         */
+        class OPENDAVINCI_API ByteSpan {
+            public:
+                ByteSpan();
+
+                /**
+                 * Constructor.
+                 *
+                 * @param data Pointer to the first byte; the caller is responsible for its lifecycle.
+                 * @param length Number of bytes.
+                 */
+                ByteSpan(const char *data, const uint32_t &length);
+
+                /**
+                 * Constructor.
+                 *
+                 * @param data String holding the bytes; it must outlive this instance.
+                 */
+                ByteSpan(const string &data);
+
+                /**
+                 * Copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                ByteSpan(const ByteSpan &obj);
+
+                virtual ~ByteSpan();
+
+                /**
+                 * Assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                ByteSpan& operator=(const ByteSpan &obj);
+
+                /**
+                 * @return Pointer to the first byte.
+                 */
+                const char* getData() const;
+
+                /**
+                 * @return Number of bytes.
+                 */
+                uint32_t getLength() const;
+
+                /**
+                 * @return true if this span does not contain any bytes.
+                 */
+                bool isEmpty() const;
+
+            private:
+                const char *m_data;
+                uint32_t m_length;
+        };
+
+    }
+} // odcore::serialization
+
+#endif /*OPENDAVINCI_CORE_SERIALIZATION_BYTESPAN_H_*/
@@ -0,0 +1,156 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_SERIALIZATION_BYTEWRITER_H_
+#define OPENDAVINCI_CORE_SERIALIZATION_BYTEWRITER_H_
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        /**
+         * This class writes bytes into a contiguous, caller-provided
+         * buffer without allocating any memory. The caller is expected
+         * to compute the required size beforehand; writes exceeding
+         * the capacity are discarded and flagged.
+         *
+         * @code
+         * vector<char> buffer(c.getSerializedSize());
+         * ByteWriter w(&buffer[0], buffer.size());
+         * c.serializeTo(w);
+         * if (w.isGood()) { ... }
+         * @endcode
+         */
+        class OPENDAVINCI_API ByteWriter {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                ByteWriter(const ByteWriter &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                ByteWriter& operator=(const ByteWriter &);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param buffer Buffer to write to; the caller is responsible for its lifecycle.
+                 * @param capacity Number of bytes available in the buffer.
+                 */
+                ByteWriter(char *buffer, const uint32_t &capacity);
+
+                virtual ~ByteWriter();
+
+                /**
+                 * This method writes one byte.
+                 *
+                 * @param value Byte to write.
+                 */
+                void writeByte(const uint8_t &value);
+
+                /**
+                 * This method writes the given bytes.
+                 *
+                 * @param data Bytes to write.
+                 * @param length Number of bytes to write.
+                 */
+                void writeBytes(const void *data, const uint32_t &length);
+
+                /**
+                 * This method writes a value using Protobuf's VarInt encoding.
+                 *
+                 * @param value Value to write.
+                 */
+                void writeVarInt(uint64_t value);
+
+                /**
+                 * This method writes a four bytes value in little endian.
+                 *
+                 * @param value Value to write.
+                 */
+                void writeFixed32(const uint32_t &value);
+
+                /**
+                 * This method writes an eight bytes value in little endian.
+                 *
+                 * @param value Value to write.
+                 */
+                void writeFixed64(const uint64_t &value);
+
+                /**
+                 * This method writes consecutive four bytes values in
+                 * little endian. On little endian hosts, the values are
+                 * copied at once.
+                 *
+                 * @param values Pointer to the first value.
+                 * @param count Number of values.
+                 */
+                void writeFixed32Array(const void *values, const uint32_t &count);
+
+                /**
+                 * This method writes consecutive eight bytes values in
+                 * little endian. On little endian hosts, the values are
+                 * copied at once.
+                 *
+                 * @param values Pointer to the first value.
+                 * @param count Number of values.
+                 */
+                void writeFixed64Array(const void *values, const uint32_t &count);
+
+                /**
+                 * @return Number of bytes written so far.
+                 */
+                uint32_t getPosition() const;
+
+                /**
+                 * @return Number of bytes available in the buffer.
+                 */
+                uint32_t getCapacity() const;
+
+                /**
+                 * @return Pointer to the beginning of the buffer.
+                 */
+                const char* getData() const;
+
+                /**
+                 * @return true if no write exceeded the buffer's capacity.
+                 */
+                bool isGood() const;
+
+            private:
+                char *m_buffer; // We have a pointer here that we receive from the caller; thus, the other class is responsible for the lifecycle of the variable to which we point to.
+                uint32_t m_capacity;
+                uint32_t m_position;
+                bool m_good;
+        };
+
+    }
+} // odcore::serialization
+
+#endif /*OPENDAVINCI_CORE_SERIALIZATION_BYTEWRITER_H_*/
@@ -0,0 +1,111 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef OPENDAVINCI_CORE_SERIALIZATION_FLATCODEC_H_
+#define OPENDAVINCI_CORE_SERIALIZATION_FLATCODEC_H_
+
+#include <cstring>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        /**
+         * This class writes and reads the fields of messages declared
+         * as flat in an .odvd file. Every field occupies a fixed number
+         * of bytes (bool, char, int8, and uint8: 1; int16 and uint16: 2;
+         * int32, uint32, float, and enums: 4; int64, uint64, and double: 8)
+         * in little endian; thus, every field is found at a fixed offset
+         * and can be read directly from a received buffer.
+         */
+        class OPENDAVINCI_API FlatCodec {
+            private:
+                /**
+                 * "Forbidden" constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the constructor.
+                 */
+                FlatCodec();
+
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                FlatCodec(const FlatCodec &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                FlatCodec& operator=(const FlatCodec &);
+
+            public:
+                // The following methods write one field in little endian.
+                static inline void write(ByteWriter &out, const bool &v) { out.writeByte(v ? 1 : 0); }
+                static inline void write(ByteWriter &out, const char &v) { out.writeByte(static_cast<uint8_t>(v)); }
+                static inline void write(ByteWriter &out, const int8_t &v) { out.writeByte(static_cast<uint8_t>(v)); }
+                static inline void write(ByteWriter &out, const uint8_t &v) { out.writeByte(v); }
+                static inline void write(ByteWriter &out, const int16_t &v) { const uint16_t _v = htole16(static_cast<uint16_t>(v)); out.writeBytes(&_v, sizeof(uint16_t)); }
+                static inline void write(ByteWriter &out, const uint16_t &v) { const uint16_t _v = htole16(v); out.writeBytes(&_v, sizeof(uint16_t)); }
+                static inline void write(ByteWriter &out, const int32_t &v) { out.writeFixed32(static_cast<uint32_t>(v)); }
+                static inline void write(ByteWriter &out, const uint32_t &v) { out.writeFixed32(v); }
+                static inline void write(ByteWriter &out, const int64_t &v) { out.writeFixed64(static_cast<uint64_t>(v)); }
+                static inline void write(ByteWriter &out, const uint64_t &v) { out.writeFixed64(v); }
+                static inline void write(ByteWriter &out, const float &v) { uint32_t _v = 0; memcpy(&_v, &v, sizeof(uint32_t)); out.writeFixed32(_v); }
+                static inline void write(ByteWriter &out, const double &v) { uint64_t _v = 0; memcpy(&_v, &v, sizeof(uint64_t)); out.writeFixed64(_v); }
+
+                // The following methods read one field in little endian from a possibly unaligned address.
+                static inline void read(const char *data, bool &v) { v = (0 != data[0]); }
+                static inline void read(const char *data, char &v) { v = data[0]; }
+                static inline void read(const char *data, int8_t &v) { v = static_cast<int8_t>(data[0]); }
+                static inline void read(const char *data, uint8_t &v) { v = static_cast<uint8_t>(data[0]); }
+                static inline void read(const char *data, int16_t &v) { uint16_t _v = 0; memcpy(&_v, data, sizeof(uint16_t)); v = static_cast<int16_t>(le16toh(_v)); }
+                static inline void read(const char *data, uint16_t &v) { uint16_t _v = 0; memcpy(&_v, data, sizeof(uint16_t)); v = le16toh(_v); }
+                static inline void read(const char *data, int32_t &v) { uint32_t _v = 0; memcpy(&_v, data, sizeof(uint32_t)); v = static_cast<int32_t>(le32toh(_v)); }
+                static inline void read(const char *data, uint32_t &v) { uint32_t _v = 0; memcpy(&_v, data, sizeof(uint32_t)); v = le32toh(_v); }
+                static inline void read(const char *data, int64_t &v) { uint64_t _v = 0; memcpy(&_v, data, sizeof(uint64_t)); v = static_cast<int64_t>(le64toh(_v)); }
+                static inline void read(const char *data, uint64_t &v) { uint64_t _v = 0; memcpy(&_v, data, sizeof(uint64_t)); v = le64toh(_v); }
+                static inline void read(const char *data, float &v) { uint32_t _v = 0; memcpy(&_v, data, sizeof(uint32_t)); _v = le32toh(_v); memcpy(&v, &_v, sizeof(float)); }
+                static inline void read(const char *data, double &v) { uint64_t _v = 0; memcpy(&_v, data, sizeof(uint64_t)); _v = le64toh(_v); memcpy(&v, &_v, sizeof(double)); }
+
+                /**
+                 * This method reads one field in little endian.
+                 *
+                 * @param data Pointer to the field's first byte.
+                 * @return Value.
+                 */
+                template<typename T>
+                static inline T read(const char *data) {
+                    T v = T();
+                    read(data, v);
+                    return v;
+                }
+        };
+
+    }
+} // odcore::serialization
+
+#endif /*OPENDAVINCI_CORE_SERIALIZATION_FLATCODEC_H_*/
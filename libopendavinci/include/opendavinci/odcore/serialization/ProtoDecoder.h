@@ -0,0 +1,459 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_SERIALIZATION_PROTODECODER_H_
+#define OPENDAVINCI_CORE_SERIALIZATION_PROTODECODER_H_
+
+#include <cstring>
+#include <istream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
+#include "opendavinci/odcore/serialization/ProtoSerializer.h"
+#include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        /**
+         * This class iterates over the fields of Protobuf-encoded bytes
+         * and decodes the current field with the same semantics as
+         * ProtoDeserializer: A value having an unexpected wire type
+         * is read as 0 or as empty string, respectively. It is used by
+         * the generated data structures to decode themselves from a
+         * contiguous buffer without any virtual method calls:
+         *
+         * @code
+         * bool MyMessage::decodeFrom(const ByteSpan &in) {
+         *     ProtoDecoder d(in);
+         *     while (d.next()) {
+         *         switch (d.getFieldId()) {
+         *             case 1: d.read(m_attribute); break;
+         *             ...
+         *         }
+         *     }
+         *     return d.isGood();
+         * }
+         * @endcode
+         *
+         * Nested data structures providing decodeFrom(const ByteSpan&)
+         * themselves are decoded in place; any other Serializable is
+         * decoded using its operator>>.
+         */
+        class OPENDAVINCI_API ProtoDecoder {
+            public:
+                /**
+                 * This class checks whether T itself (i.e. not only one of
+                 * its super classes) provides decodeFrom(const ByteSpan&).
+                 */
+                template<typename T>
+                class HasDecodeFrom {
+                    private:
+                        template<typename U>
+                        static char test(typename enable_if<is_same<decltype(&U::decodeFrom), bool (U::*)(const ByteSpan&)>::value>::type*);
+
+                        template<typename U>
+                        static long test(...);
+
+                    public:
+                        static const bool value = (sizeof(test<T>(NULL)) == sizeof(char));
+                };
+
+            public:
+                ProtoDecoder();
+
+                /**
+                 * Constructor.
+                 *
+                 * @param in Bytes to decode; they must outlive this instance.
+                 */
+                ProtoDecoder(const ByteSpan &in);
+
+                /**
+                 * Copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                ProtoDecoder(const ProtoDecoder &obj);
+
+                virtual ~ProtoDecoder();
+
+                /**
+                 * Assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                ProtoDecoder& operator=(const ProtoDecoder &obj);
+
+                /**
+                 * This method decodes the next field.
+                 *
+                 * @return true if a complete field was decoded; false at the end of the bytes or for malformed bytes.
+                 */
+                bool next();
+
+                /**
+                 * @return false if malformed bytes were encountered.
+                 */
+                bool isGood() const;
+
+                /**
+                 * @return Identifier of the current field.
+                 */
+                uint32_t getFieldId() const;
+
+                /**
+                 * @return Wire type of the current field.
+                 */
+                ProtoSerializer::PROTOBUF_TYPE getType() const;
+
+                /**
+                 * @return Bytes of the current field's value (empty for VarInts).
+                 */
+                ByteSpan getValue() const;
+
+                /**
+                 * This method returns the remaining bytes of the given
+                 * stream, which are consumed. If the stream is backed by
+                 * a SpanStreamBuffer, the bytes are used in place;
+                 * otherwise, they are copied once into the given buffer.
+                 *
+                 * @param in Stream to read from.
+                 * @param buffer Buffer to be used for copying.
+                 * @return Remaining bytes.
+                 */
+                static ByteSpan getRemainingBytes(istream &in, string &buffer);
+
+                /**
+                 * This method decodes the given data structure using its
+                 * decodeFrom(const ByteSpan&) method from the remaining
+                 * bytes of the given stream (cf. getRemainingBytes).
+                 *
+                 * @param in Stream to read from.
+                 * @param v Data structure to decode.
+                 * @return in.
+                 */
+                template<typename T>
+                static inline istream& decode(istream &in, T &v) {
+                    string buffer;
+                    v.decodeFrom(getRemainingBytes(in, buffer));
+                    return in;
+                }
+
+            public:
+                // The following methods map VarInt representations to integral values.
+                static inline void fromVarInt(const uint64_t &_v, bool &v) { v = static_cast<bool>(_v); }
+                static inline void fromVarInt(const uint64_t &_v, char &v) { v = static_cast<char>(_v); }
+                static inline void fromVarInt(const uint64_t &_v, unsigned char &v) { v = static_cast<unsigned char>(_v); }
+                static inline void fromVarInt(const uint64_t &_v, int8_t &v) { const uint8_t value = static_cast<uint8_t>(_v); v = static_cast<int8_t>((value >> 1) ^ -(value & 1)); }
+                static inline void fromVarInt(const uint64_t &_v, int16_t &v) { const uint16_t value = static_cast<uint16_t>(_v); v = static_cast<int16_t>((value >> 1) ^ -(value & 1)); }
+                static inline void fromVarInt(const uint64_t &_v, uint16_t &v) { v = static_cast<uint16_t>(_v); }
+                static inline void fromVarInt(const uint64_t &_v, int32_t &v) { const uint32_t value = static_cast<uint32_t>(_v); v = static_cast<int32_t>((value >> 1) ^ -(value & 1)); }
+                static inline void fromVarInt(const uint64_t &_v, uint32_t &v) { v = static_cast<uint32_t>(_v); }
+                static inline void fromVarInt(const uint64_t &_v, int64_t &v) { v = static_cast<int64_t>((_v >> 1) ^ -(_v & 1)); }
+                static inline void fromVarInt(const uint64_t &_v, uint64_t &v) { v = _v; }
+
+                /**
+                 * This method reads the current field.
+                 *
+                 * @param v Value to be read.
+                 */
+                template<typename T>
+                inline typename enable_if<is_integral<T>::value>::type read(T &v) const {
+                    fromVarInt((m_type == ProtoSerializer::VARINT) ? m_varIntValue : 0, v);
+                }
+
+                inline void read(float &v) const {
+                    // 4 bytes values need to obey little endian encoding.
+                    uint32_t _v = 0;
+                    if (m_type == ProtoSerializer::FOUR_BYTES) {
+                        memcpy(&_v, m_data, sizeof(uint32_t));
+                        _v = le32toh(_v);
+                    }
+                    memcpy(&v, &_v, sizeof(float));
+                }
+
+                inline void read(double &v) const {
+                    // 8 bytes values need to obey little endian encoding.
+                    uint64_t _v = 0;
+                    if (m_type == ProtoSerializer::EIGHT_BYTES) {
+                        memcpy(&_v, m_data, sizeof(uint64_t));
+                        _v = le64toh(_v);
+                    }
+                    memcpy(&v, &_v, sizeof(double));
+                }
+
+                inline void read(string &v) const {
+                    if (m_type == ProtoSerializer::LENGTH_DELIMITED) {
+                        v.assign(m_data, m_length);
+                    }
+                    else {
+                        v.clear();
+                    }
+                }
+
+                inline void read(void *data, const uint32_t &size) const {
+                    memcpy(data, m_data, (size < m_length ? size : m_length));
+                    if (size > m_length) {
+                        memset(static_cast<char*>(data) + m_length, 0, (size - m_length));
+                    }
+                }
+
+                template<typename T>
+                inline typename enable_if<is_base_of<Serializable, T>::value>::type read(T &v) const {
+                    readSerializable(ByteSpan(m_data, m_length), v, integral_constant<bool, HasDecodeFrom<T>::value>());
+                }
+
+                /**
+                 * This method reads the current field as list; the
+                 * given list is cleared beforehand.
+                 *
+                 * @param v List to be read.
+                 */
+                template<typename T>
+                inline void read(vector<T> &v) const {
+                    v.clear();
+                    if (m_type == ProtoSerializer::LENGTH_DELIMITED) {
+                        v.reserve(countValues<T>(m_data, m_data + m_length));
+                        readValues<T>(m_data, m_data + m_length, [&v](const T &element) { v.push_back(element); }, integral_constant<bool, is_integral<T>::value>());
+                    }
+                }
+
+                /**
+                 * This method reads the current field as map; the
+                 * given map is cleared beforehand.
+                 *
+                 * @param v Map to be read.
+                 */
+                template<typename K, typename V>
+                inline void read(map<K, V> &v) const {
+                    v.clear();
+                    if (m_type == ProtoSerializer::LENGTH_DELIMITED) {
+                        const char *pos = m_data;
+                        const char *end = m_data + m_length;
+                        while (pos < end) {
+                            uint64_t length = 0;
+                            if (!VarInt::decode(pos, end, length) || (length > static_cast<uint64_t>(end - pos))) {
+                                break;
+                            }
+                            if (length > 0) {
+                                // Each entry contains the key as field 1 and the value as field 2.
+                                ProtoDecoder entry(ByteSpan(pos, static_cast<uint32_t>(length)));
+                                K key = K();
+                                V value = V();
+                                while (entry.next()) {
+                                    if (1 == entry.getFieldId()) {
+                                        entry.read(key);
+                                    }
+                                    else if (2 == entry.getFieldId()) {
+                                        entry.read(value);
+                                    }
+                                }
+                                v[key] = value;
+                            }
+                            pos += length;
+                        }
+                    }
+                }
+
+                /**
+                 * This method reads the current field as fixed size
+                 * array; surplus elements are skipped.
+                 *
+                 * @param data Array to be read.
+                 * @param size Number of elements.
+                 */
+                template<typename T>
+                inline void readArray(T *data, const uint32_t &size) const {
+                    if (m_type == ProtoSerializer::LENGTH_DELIMITED) {
+                        uint32_t i = 0;
+                        readValues<T>(m_data, m_data + m_length, [data, &size, &i](const T &element) {
+                            if (i < size) {
+                                data[i] = element;
+                            }
+                            i++;
+                        }, integral_constant<bool, is_integral<T>::value>());
+                    }
+                }
+
+            private:
+                /**
+                 * This method returns the number of values that a list
+                 * occupying the given bytes contains to reserve memory
+                 * for all its elements at once.
+                 *
+                 * @param pos Pointer to the first byte.
+                 * @param end Pointer behind the last byte.
+                 * @return Number of values.
+                 */
+                template<typename T>
+                static inline typename enable_if<is_integral<T>::value, uint32_t>::type countValues(const char *pos, const char *end) {
+                    // Every VarInt ends with the first byte having its MSB cleared.
+                    uint32_t count = 0;
+                    for (; pos < end; ++pos) {
+                        count += (static_cast<uint8_t>(*pos) < 0x80) ? 1 : 0;
+                    }
+                    return count;
+                }
+
+                template<typename T>
+                static inline typename enable_if<is_floating_point<T>::value, uint32_t>::type countValues(const char *pos, const char *end) {
+                    return static_cast<uint32_t>((end - pos) / sizeof(T));
+                }
+
+                template<typename T>
+                static inline typename enable_if<!is_integral<T>::value && !is_floating_point<T>::value, uint32_t>::type countValues(const char *pos, const char *end) {
+                    // Skip over the length-delimited values.
+                    uint32_t count = 0;
+                    uint64_t length = 0;
+                    while ( (pos < end) && VarInt::decode(pos, end, length) && (length <= static_cast<uint64_t>(end - pos)) ) {
+                        pos += length;
+                        count++;
+                    }
+                    return count;
+                }
+
+                /**
+                 * This method decodes the values of a list and passes
+                 * each one to the given consumer; integral values are
+                 * decoded in batches using VarInt::decodePacked.
+                 *
+                 * @param pos Pointer to the first byte.
+                 * @param end Pointer behind the last byte.
+                 * @param consumer Function to be called for every value.
+                 */
+                template<typename T, typename F>
+                static inline void readValues(const char *pos, const char *end, F consumer, const true_type &) {
+                    const uint32_t BATCH_SIZE = 64;
+                    uint64_t values[BATCH_SIZE];
+                    while (pos < end) {
+                        const uint32_t count = VarInt::decodePacked(pos, end, values, BATCH_SIZE);
+                        if (0 == count) {
+                            break;
+                        }
+                        for (uint32_t i = 0; i < count; i++) {
+                            T element = T();
+                            fromVarInt(values[i], element);
+                            consumer(element);
+                        }
+                    }
+                }
+
+                template<typename T, typename F>
+                static inline void readValues(const char *pos, const char *end, F consumer, const false_type &) {
+                    while (pos < end) {
+                        T element = T();
+                        if (!readValue(pos, end, element)) {
+                            break;
+                        }
+                        consumer(element);
+                    }
+                }
+
+                template<typename T>
+                static inline typename enable_if<is_integral<T>::value, bool>::type readValue(const char *&pos, const char *end, T &v) {
+                    uint64_t _v = 0;
+                    if (!VarInt::decode(pos, end, _v)) {
+                        return false;
+                    }
+                    fromVarInt(_v, v);
+                    return true;
+                }
+
+                static inline bool readValue(const char *&pos, const char *end, float &v) {
+                    uint32_t _v = 0;
+                    if (static_cast<uint32_t>(end - pos) < sizeof(uint32_t)) {
+                        return false;
+                    }
+                    memcpy(&_v, pos, sizeof(uint32_t));
+                    _v = le32toh(_v);
+                    memcpy(&v, &_v, sizeof(float));
+                    pos += sizeof(uint32_t);
+                    return true;
+                }
+
+                static inline bool readValue(const char *&pos, const char *end, double &v) {
+                    uint64_t _v = 0;
+                    if (static_cast<uint32_t>(end - pos) < sizeof(uint64_t)) {
+                        return false;
+                    }
+                    memcpy(&_v, pos, sizeof(uint64_t));
+                    _v = le64toh(_v);
+                    memcpy(&v, &_v, sizeof(double));
+                    pos += sizeof(uint64_t);
+                    return true;
+                }
+
+                static inline bool readValue(const char *&pos, const char *end, string &v) {
+                    uint64_t length = 0;
+                    if (!VarInt::decode(pos, end, length) || (length > static_cast<uint64_t>(end - pos))) {
+                        return false;
+                    }
+                    v.assign(pos, static_cast<uint32_t>(length));
+                    pos += length;
+                    return true;
+                }
+
+                template<typename T>
+                static inline typename enable_if<is_base_of<Serializable, T>::value, bool>::type readValue(const char *&pos, const char *end, T &v) {
+                    uint64_t length = 0;
+                    if (!VarInt::decode(pos, end, length) || (length > static_cast<uint64_t>(end - pos))) {
+                        return false;
+                    }
+                    readSerializable(ByteSpan(pos, static_cast<uint32_t>(length)), v, integral_constant<bool, HasDecodeFrom<T>::value>());
+                    pos += length;
+                    return true;
+                }
+
+                template<typename T>
+                static inline void readSerializable(const ByteSpan &in, T &v, const true_type &) {
+                    v.decodeFrom(in);
+                }
+
+                template<typename T>
+                static inline void readSerializable(const ByteSpan &in, T &v, const false_type &) {
+                    SpanStreamBuffer buffer(in.getData(), in.getLength());
+                    istream stream(&buffer);
+                    stream >> v;
+                }
+
+            private:
+                const char *m_position;
+                const char *m_end;
+                bool m_good;
+                uint32_t m_id;
+                ProtoSerializer::PROTOBUF_TYPE m_type;
+                uint64_t m_varIntValue;
+                const char *m_data;
+                uint32_t m_length;
+        };
+
+    }
+} // odcore::serialization
+
+#endif /*OPENDAVINCI_CORE_SERIALIZATION_PROTODECODER_H_*/
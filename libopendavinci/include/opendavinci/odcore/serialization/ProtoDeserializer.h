@@ -20,13 +20,14 @@
 #ifndef OPENDAVINCI_CORE_SERIALIZATION_PROTODESERIALIZER_H_
 #define OPENDAVINCI_CORE_SERIALIZATION_PROTODESERIALIZER_H_
 
-#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
 #include "opendavinci/odcore/serialization/Deserializer.h"
+#include "opendavinci/odcore/serialization/ProtoDecoder.h"
 #include "opendavinci/odcore/serialization/ProtoSerializer.h"
 #include "opendavinci/odcore/serialization/ProtoSerializerVisitor.h"
 
@@ -138,7 +139,13 @@ namespace odcore {
 
         /**
          * This class provides a deserialization to decode data
-         * encoded in Google's Protobuf format.
+         * encoded in Google's Protobuf format. The data is decoded
+         * from one contiguous buffer: As long as fields are read in
+         * the order they were written, each field is decoded in place
+         * right after its predecessor. Only if a requested field is
+         * not the next one in the buffer, a flat table with the
+         * locations of all fields is built once and used for all
+         * subsequent reads.
          */
         class ProtoDeserializer : public Deserializer {
             private:
@@ -166,10 +173,35 @@ namespace odcore {
                  */
                 ProtoDeserializer(istream &i);
 
+                /**
+                 * Contructor.
+                 *
+                 * @param data Bytes to deserialize data from; they must outlive this instance.
+                 * @param length Number of bytes.
+                 */
+                ProtoDeserializer(const char *data, const uint32_t &length);
+
                 virtual ~ProtoDeserializer();
 
+                /**
+                 * This method prepares the deserialization of the
+                 * remaining bytes from the given stream. If the stream
+                 * is backed by a SpanStreamBuffer, the bytes are used
+                 * in place; otherwise, they are copied once.
+                 *
+                 * @param in Stream to deserialize data from.
+                 */
                 virtual void deserializeDataFrom(istream &in);
 
+                /**
+                 * This method prepares the deserialization of the given
+                 * bytes without copying them.
+                 *
+                 * @param data Bytes to deserialize data from; they must outlive this instance.
+                 * @param length Number of bytes.
+                 */
+                void deserializeDataFrom(const char *data, const uint32_t &length);
+
             private:
                 /**
                  * This method decodes a value from a given varint encoding.
@@ -274,9 +306,34 @@ namespace odcore {
                  */
                 uint32_t readAndValidateKey(istream &in, const uint32_t &id, const ProtoSerializer::PROTOBUF_TYPE &expectedType);
 
+                /**
+                 * This method locates the field with the given identifier.
+                 *
+                 * @param id Identifier of the field.
+                 * @param field Decoder positioned at the field.
+                 * @return true if the field was found.
+                 */
+                bool findField(const uint32_t &id, ProtoDecoder &field);
+
+                /**
+                 * This method builds the table with the locations of all fields.
+                 */
+                void buildFieldTable();
+
+                /**
+                 * This method checks whether the field identifiers in the
+                 * data are strictly increasing, i.e. no field occurs twice.
+                 *
+                 * @return true if the field identifiers are strictly increasing.
+                 */
+                bool hasStrictlyIncreasingFieldIds() const;
+
             private:
-                stringstream m_buffer;
-                map<uint32_t, ProtoKeyValue> m_mapOfKeyValues;
+                string m_buffer;
+                ByteSpan m_data;
+                ProtoDecoder m_decoder;
+                vector<ProtoDecoder> m_fieldTable;
+                bool m_useFieldTable;
         };
 
     }
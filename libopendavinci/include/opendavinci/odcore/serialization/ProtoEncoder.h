@@ -0,0 +1,671 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_SERIALIZATION_PROTOENCODER_H_
+#define OPENDAVINCI_CORE_SERIALIZATION_PROTOENCODER_H_
+
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
+#include "opendavinci/odcore/serialization/ProtoSerializer.h"
+#include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        /**
+         * This class provides statically typed encoders producing the
+         * same bytes as ProtoSerializer. They are used by the generated
+         * data structures to encode themselves into a pre-sized buffer
+         * without any virtual method calls:
+         *
+         * @code
+         * uint32_t MyMessage::getEncodedSize() const {
+         *     return ProtoEncoder::getSize(1, m_attribute) + ...;
+         * }
+         *
+         * void MyMessage::encodeTo(ByteWriter &out) const {
+         *     ProtoEncoder::write(out, 1, m_attribute);
+         *     ...
+         * }
+         * @endcode
+         *
+         * Nested data structures providing getEncodedSize() and
+         * encodeTo(ByteWriter&) themselves are encoded in place; any
+         * other Serializable is encoded using its operator<<.
+         *
+         * While encode() determines the size of a data structure, the
+         * lengths of its nested data structures, lists, and maps and the
+         * bytes of its nested Serializables are cached; the following
+         * call to encodeTo(ByteWriter&) reuses them instead of computing
+         * them again at every nesting level. Thus, encodeTo(ByteWriter&)
+         * must visit the fields in the same order as getEncodedSize().
+         */
+        class OPENDAVINCI_API ProtoEncoder {
+            private:
+                /**
+                 * "Forbidden" constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the constructor.
+                 */
+                ProtoEncoder();
+
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                ProtoEncoder(const ProtoEncoder &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                ProtoEncoder& operator=(const ProtoEncoder &);
+
+            private:
+                /**
+                 * This class caches the lengths and bytes computed while
+                 * determining the size of a data structure in the order
+                 * of their computation so that they can be consumed in
+                 * the same order while writing the data structure.
+                 */
+                class OPENDAVINCI_API EncodingCache {
+                    private:
+                        /**
+                         * "Forbidden" copy constructor. Goal: The compiler should warn
+                         * already at compile time for unwanted bugs caused by any misuse
+                         * of the copy constructor.
+                         */
+                        EncodingCache(const EncodingCache &);
+
+                        /**
+                         * "Forbidden" assignment operator. Goal: The compiler should warn
+                         * already at compile time for unwanted bugs caused by any misuse
+                         * of the assignment operator.
+                         */
+                        EncodingCache& operator=(const EncodingCache &);
+
+                    public:
+                        EncodingCache();
+
+                        /**
+                         * This method resets the cache for the next data
+                         * structure while keeping its allocated memory.
+                         */
+                        void clear();
+
+                        /**
+                         * This method switches from caching to consuming.
+                         */
+                        void startWriting();
+
+                        /**
+                         * @return true if the cached values are consumed.
+                         */
+                        bool isWriting() const;
+
+                        /**
+                         * This method reserves the next length; it must be
+                         * called before the lengths of any nested fields
+                         * are computed as these are written afterwards.
+                         *
+                         * @return Slot for the length.
+                         */
+                        uint32_t reserveLength();
+
+                        /**
+                         * This method sets a reserved length.
+                         *
+                         * @param slot Slot returned by reserveLength().
+                         * @param length Length.
+                         * @return length.
+                         */
+                        uint32_t setLength(const uint32_t &slot, const uint32_t &length);
+
+                        /**
+                         * @return Next cached length.
+                         */
+                        uint32_t getNextLength();
+
+                        /**
+                         * This method adds the bytes of a Serializable.
+                         *
+                         * @param bytes Bytes to add; they are moved into the cache.
+                         * @return Number of bytes.
+                         */
+                        uint32_t addBytes(string &bytes);
+
+                        /**
+                         * @return Next cached bytes.
+                         */
+                        const string& getNextBytes();
+
+                    private:
+                        vector<uint32_t> m_lengths;
+                        uint32_t m_nextLength;
+                        vector<string> m_bytes;
+                        uint32_t m_nextBytes;
+                        bool m_writing;
+                };
+
+                /**
+                 * This class selects the EncodingCache used by the calling
+                 * thread while it exists and restores the previous one
+                 * afterwards. Disabled scopes are used while a Serializable
+                 * without encodeTo(ByteWriter&) is serialized so that any
+                 * data structure encoded by its operator<< does not use
+                 * the cache of the surrounding data structure.
+                 */
+                class OPENDAVINCI_API EncodingScope {
+                    private:
+                        /**
+                         * "Forbidden" copy constructor. Goal: The compiler should warn
+                         * already at compile time for unwanted bugs caused by any misuse
+                         * of the copy constructor.
+                         */
+                        EncodingScope(const EncodingScope &);
+
+                        /**
+                         * "Forbidden" assignment operator. Goal: The compiler should warn
+                         * already at compile time for unwanted bugs caused by any misuse
+                         * of the assignment operator.
+                         */
+                        EncodingScope& operator=(const EncodingScope &);
+
+                    public:
+                        /**
+                         * Constructor.
+                         *
+                         * @param enableCache true to cache while this scope exists.
+                         */
+                        EncodingScope(const bool &enableCache);
+
+                        virtual ~EncodingScope();
+
+                        /**
+                         * This method switches the cache of this scope from
+                         * caching to consuming.
+                         */
+                        void startWriting();
+
+                    private:
+                        EncodingCache *m_previousCache;
+                        EncodingCache *m_cache;
+                        bool m_usesThreadCache;
+                        EncodingCache m_ownCache;
+                };
+
+                /**
+                 * @return Cache currently selected by the calling thread.
+                 */
+                static EncodingCache*& getCurrentCache();
+
+                /**
+                 * This method hands out the cache that the calling thread
+                 * reuses for all data structures to avoid allocations.
+                 *
+                 * @return The calling thread's cache or NULL if it is in use.
+                 */
+                static EncodingCache* acquireThreadCache();
+
+                /**
+                 * This method hands the calling thread's cache back.
+                 */
+                static void releaseThreadCache();
+
+                /**
+                 * @return The calling thread's cache if it is caching, NULL otherwise.
+                 */
+                static EncodingCache* getSizingCache();
+
+                /**
+                 * @return The calling thread's cache if it is consumed, NULL otherwise.
+                 */
+                static EncodingCache* getWritingCache();
+
+            public:
+                /**
+                 * This class checks whether T itself (i.e. not only one of
+                 * its super classes) provides getEncodedSize() and
+                 * encodeTo(ByteWriter&).
+                 */
+                template<typename T>
+                class HasEncodeTo {
+                    private:
+                        template<typename U>
+                        static char test(typename enable_if<is_same<decltype(&U::encodeTo), void (U::*)(ByteWriter&) const>::value &&
+                                                            is_same<decltype(&U::getEncodedSize), uint32_t (U::*)() const>::value>::type*);
+
+                        template<typename U>
+                        static long test(...);
+
+                    public:
+                        static const bool value = (sizeof(test<T>(NULL)) == sizeof(char));
+                };
+
+                /**
+                 * This method returns the wire type used for T.
+                 *
+                 * @return Wire type.
+                 */
+                template<typename T>
+                static inline ProtoSerializer::PROTOBUF_TYPE getType() {
+                    return is_integral<T>::value ? ProtoSerializer::VARINT :
+                           (is_same<T, float>::value ? ProtoSerializer::FOUR_BYTES :
+                           (is_same<T, double>::value ? ProtoSerializer::EIGHT_BYTES : ProtoSerializer::LENGTH_DELIMITED));
+                }
+
+                /**
+                 * This method returns the key for the given field.
+                 *
+                 * @param id Field identifier.
+                 * @param type Wire type.
+                 * @return Key.
+                 */
+                static inline uint32_t getKey(const uint32_t &id, const ProtoSerializer::PROTOBUF_TYPE &type) {
+                    return (id << 3) | type;
+                }
+
+                // The following methods map integral values to their VarInt representation.
+                static inline uint64_t toVarInt(const bool &v) { return (v ? 1 : 0); }
+                static inline uint64_t toVarInt(const char &v) { return static_cast<uint64_t>(v); }
+                static inline uint64_t toVarInt(const unsigned char &v) { return v; }
+                static inline uint64_t toVarInt(const int8_t &v) { return static_cast<uint8_t>((v << 1) ^ (v >> 7)); }
+                static inline uint64_t toVarInt(const int16_t &v) { return static_cast<uint16_t>((v << 1) ^ (v >> 15)); }
+                static inline uint64_t toVarInt(const uint16_t &v) { return v; }
+                static inline uint64_t toVarInt(const int32_t &v) { return static_cast<uint32_t>((v << 1) ^ (v >> 31)); }
+                static inline uint64_t toVarInt(const uint32_t &v) { return v; }
+                static inline uint64_t toVarInt(const int64_t &v) { return static_cast<uint64_t>((v << 1) ^ (v >> 63)); }
+                static inline uint64_t toVarInt(const uint64_t &v) { return v; }
+
+                /**
+                 * This method returns the number of bytes needed to encode
+                 * the given value without key (cf. ProtoSerializer::writeValue).
+                 *
+                 * @param v Value.
+                 * @return Number of bytes.
+                 */
+                template<typename T>
+                static inline typename enable_if<is_integral<T>::value, uint32_t>::type getValueSize(const T &v) {
+                    return VarInt::getSize(toVarInt(v));
+                }
+
+                static inline uint32_t getValueSize(const float &/*v*/) {
+                    return sizeof(float);
+                }
+
+                static inline uint32_t getValueSize(const double &/*v*/) {
+                    return sizeof(double);
+                }
+
+                static inline uint32_t getValueSize(const string &v) {
+                    const uint32_t length = static_cast<uint32_t>(v.size());
+                    return VarInt::getSize(length) + length;
+                }
+
+                template<typename T>
+                static inline typename enable_if<is_base_of<Serializable, T>::value, uint32_t>::type getValueSize(const T &v) {
+                    const uint32_t length = getSerializableLength(v, integral_constant<bool, HasEncodeTo<T>::value>());
+                    return VarInt::getSize(length) + length;
+                }
+
+                /**
+                 * This method encodes the given value without key
+                 * (cf. ProtoSerializer::writeValue).
+                 *
+                 * @param out ByteWriter to write to.
+                 * @param v Value.
+                 */
+                template<typename T>
+                static inline typename enable_if<is_integral<T>::value>::type writeValue(ByteWriter &out, const T &v) {
+                    out.writeVarInt(toVarInt(v));
+                }
+
+                static inline void writeValue(ByteWriter &out, const float &v) {
+                    uint32_t _v = 0;
+                    memcpy(&_v, &v, sizeof(float));
+                    out.writeFixed32(_v);
+                }
+
+                static inline void writeValue(ByteWriter &out, const double &v) {
+                    uint64_t _v = 0;
+                    memcpy(&_v, &v, sizeof(double));
+                    out.writeFixed64(_v);
+                }
+
+                static inline void writeValue(ByteWriter &out, const string &v) {
+                    out.writeVarInt(v.size());
+                    out.writeBytes(v.data(), static_cast<uint32_t>(v.size()));
+                }
+
+                template<typename T>
+                static inline typename enable_if<is_base_of<Serializable, T>::value>::type writeValue(ByteWriter &out, const T &v) {
+                    writeSerializable(out, v, integral_constant<bool, HasEncodeTo<T>::value>());
+                }
+
+                /**
+                 * This method returns the number of bytes needed to encode
+                 * the given field including its key.
+                 *
+                 * @param id Field identifier.
+                 * @param v Value.
+                 * @return Number of bytes.
+                 */
+                template<typename T>
+                static inline uint32_t getSize(const uint32_t &id, const T &v) {
+                    return VarInt::getSize(getKey(id, getType<T>())) + getValueSize(v);
+                }
+
+                /**
+                 * This method encodes the given field including its key.
+                 *
+                 * @param out ByteWriter to write to.
+                 * @param id Field identifier.
+                 * @param v Value.
+                 */
+                template<typename T>
+                static inline void write(ByteWriter &out, const uint32_t &id, const T &v) {
+                    out.writeVarInt(getKey(id, getType<T>()));
+                    writeValue(out, v);
+                }
+
+                /**
+                 * This method returns the number of bytes needed to encode
+                 * a list; its elements are encoded one after another into
+                 * one length-delimited field.
+                 *
+                 * @param id Field identifier.
+                 * @param v List.
+                 * @return Number of bytes.
+                 */
+                template<typename T>
+                static inline uint32_t getSize(const uint32_t &id, const vector<T> &v) {
+                    EncodingCache *cache = getSizingCache();
+                    const uint32_t slot = (cache != NULL) ? cache->reserveLength() : 0;
+                    uint32_t length = getListLength(v);
+                    if (cache != NULL) {
+                        length = cache->setLength(slot, length);
+                    }
+                    return VarInt::getSize(getKey(id, ProtoSerializer::LENGTH_DELIMITED)) + VarInt::getSize(length) + length;
+                }
+
+                /**
+                 * This method encodes a list.
+                 *
+                 * @param out ByteWriter to write to.
+                 * @param id Field identifier.
+                 * @param v List.
+                 */
+                template<typename T>
+                static inline void write(ByteWriter &out, const uint32_t &id, const vector<T> &v) {
+                    EncodingCache *cache = getWritingCache();
+                    out.writeVarInt(getKey(id, ProtoSerializer::LENGTH_DELIMITED));
+                    out.writeVarInt((cache != NULL) ? cache->getNextLength() : getListLength(v));
+                    writeValues(out, v);
+                }
+
+                /**
+                 * This method returns the number of bytes needed to encode
+                 * a map; each entry is encoded as length-delimited value
+                 * containing the key as field 1 and the value as field 2.
+                 *
+                 * @param id Field identifier.
+                 * @param v Map.
+                 * @return Number of bytes.
+                 */
+                template<typename K, typename V>
+                static inline uint32_t getSize(const uint32_t &id, const map<K, V> &v) {
+                    EncodingCache *cache = getSizingCache();
+                    const uint32_t slot = (cache != NULL) ? cache->reserveLength() : 0;
+                    uint32_t length = getMapLength(v, cache);
+                    if (cache != NULL) {
+                        length = cache->setLength(slot, length);
+                    }
+                    return VarInt::getSize(getKey(id, ProtoSerializer::LENGTH_DELIMITED)) + VarInt::getSize(length) + length;
+                }
+
+                /**
+                 * This method encodes a map.
+                 *
+                 * @param out ByteWriter to write to.
+                 * @param id Field identifier.
+                 * @param v Map.
+                 */
+                template<typename K, typename V>
+                static inline void write(ByteWriter &out, const uint32_t &id, const map<K, V> &v) {
+                    EncodingCache *cache = getWritingCache();
+                    out.writeVarInt(getKey(id, ProtoSerializer::LENGTH_DELIMITED));
+                    out.writeVarInt((cache != NULL) ? cache->getNextLength() : getMapLength(v, cache));
+                    for (typename map<K, V>::const_iterator it = v.begin(); it != v.end(); ++it) {
+                        out.writeVarInt((cache != NULL) ? cache->getNextLength() : (getSize(1, it->first) + getSize(2, it->second)));
+                        write(out, 1, it->first);
+                        write(out, 2, it->second);
+                    }
+                }
+
+                /**
+                 * This method returns the number of bytes needed to encode
+                 * a fixed size array like a list.
+                 *
+                 * @param id Field identifier.
+                 * @param data Array.
+                 * @param size Number of elements.
+                 * @return Number of bytes.
+                 */
+                template<typename T>
+                static inline uint32_t getArraySize(const uint32_t &id, const T *data, const uint32_t &size) {
+                    EncodingCache *cache = getSizingCache();
+                    const uint32_t slot = (cache != NULL) ? cache->reserveLength() : 0;
+                    uint32_t length = getArrayLength(data, size);
+                    if (cache != NULL) {
+                        length = cache->setLength(slot, length);
+                    }
+                    return VarInt::getSize(getKey(id, ProtoSerializer::LENGTH_DELIMITED)) + VarInt::getSize(length) + length;
+                }
+
+                /**
+                 * This method encodes a fixed size array like a list.
+                 *
+                 * @param out ByteWriter to write to.
+                 * @param id Field identifier.
+                 * @param data Array.
+                 * @param size Number of elements.
+                 */
+                template<typename T>
+                static inline void writeArray(ByteWriter &out, const uint32_t &id, const T *data, const uint32_t &size) {
+                    EncodingCache *cache = getWritingCache();
+                    out.writeVarInt(getKey(id, ProtoSerializer::LENGTH_DELIMITED));
+                    out.writeVarInt((cache != NULL) ? cache->getNextLength() : getArrayLength(data, size));
+                    writeValues(out, data, size);
+                }
+
+                /**
+                 * This method encodes the given data structure using its
+                 * encodeTo(ByteWriter&) method and writes the bytes to the
+                 * given stream. Small data structures are encoded on the
+                 * stack to avoid allocating memory.
+                 *
+                 * @param out Stream to write to.
+                 * @param v Data structure to encode.
+                 * @return out.
+                 */
+                template<typename T>
+                static inline ostream& encode(ostream &out, const T &v) {
+                    const uint32_t STACK_BUFFER_SIZE = 256;
+                    char stackBuffer[STACK_BUFFER_SIZE];
+                    string heapBuffer;
+
+                    EncodingScope scope(true);
+                    const uint32_t size = v.getEncodedSize();
+                    scope.startWriting();
+                    char *buffer = stackBuffer;
+                    if (size > STACK_BUFFER_SIZE) {
+                        heapBuffer.resize(size);
+                        buffer = &heapBuffer[0];
+                    }
+
+                    ByteWriter w(buffer, size);
+                    v.encodeTo(w);
+                    out.write(buffer, w.getPosition());
+                    return out;
+                }
+
+            private:
+                template<typename T>
+                static inline uint32_t getListLength(const vector<T> &v) {
+                    uint32_t length = 0;
+                    for (typename vector<T>::const_iterator it = v.begin(); it != v.end(); ++it) {
+                        length += getValueSize(*it);
+                    }
+                    return length;
+                }
+
+                // Fixed size elements do not need to be visited.
+                static inline uint32_t getListLength(const vector<float> &v) {
+                    return static_cast<uint32_t>(v.size() * sizeof(float));
+                }
+
+                static inline uint32_t getListLength(const vector<double> &v) {
+                    return static_cast<uint32_t>(v.size() * sizeof(double));
+                }
+
+                template<typename T>
+                static inline uint32_t getArrayLength(const T *data, const uint32_t &size) {
+                    uint32_t length = 0;
+                    for (uint32_t i = 0; i < size; i++) {
+                        length += getValueSize(data[i]);
+                    }
+                    return length;
+                }
+
+                static inline uint32_t getArrayLength(const float */*data*/, const uint32_t &size) {
+                    return static_cast<uint32_t>(size * sizeof(float));
+                }
+
+                static inline uint32_t getArrayLength(const double */*data*/, const uint32_t &size) {
+                    return static_cast<uint32_t>(size * sizeof(double));
+                }
+
+                template<typename T>
+                static inline void writeValues(ByteWriter &out, const vector<T> &v) {
+                    for (typename vector<T>::const_iterator it = v.begin(); it != v.end(); ++it) {
+                        writeValue(out, *it);
+                    }
+                }
+
+                // Lists of fixed size elements are written as one block.
+                static inline void writeValues(ByteWriter &out, const vector<float> &v) {
+                    out.writeFixed32Array(v.data(), static_cast<uint32_t>(v.size()));
+                }
+
+                static inline void writeValues(ByteWriter &out, const vector<double> &v) {
+                    out.writeFixed64Array(v.data(), static_cast<uint32_t>(v.size()));
+                }
+
+                template<typename T>
+                static inline void writeValues(ByteWriter &out, const T *data, const uint32_t &size) {
+                    for (uint32_t i = 0; i < size; i++) {
+                        writeValue(out, data[i]);
+                    }
+                }
+
+                static inline void writeValues(ByteWriter &out, const float *data, const uint32_t &size) {
+                    out.writeFixed32Array(data, size);
+                }
+
+                static inline void writeValues(ByteWriter &out, const double *data, const uint32_t &size) {
+                    out.writeFixed64Array(data, size);
+                }
+
+                template<typename K, typename V>
+                static inline uint32_t getMapLength(const map<K, V> &v, EncodingCache *cache) {
+                    uint32_t length = 0;
+                    for (typename map<K, V>::const_iterator it = v.begin(); it != v.end(); ++it) {
+                        const uint32_t slot = (cache != NULL) ? cache->reserveLength() : 0;
+                        uint32_t entryLength = getSize(1, it->first) + getSize(2, it->second);
+                        if (cache != NULL) {
+                            entryLength = cache->setLength(slot, entryLength);
+                        }
+                        length += VarInt::getSize(entryLength) + entryLength;
+                    }
+                    return length;
+                }
+
+                template<typename T>
+                static inline uint32_t getSerializableLength(const T &v, const true_type &) {
+                    EncodingCache *cache = getSizingCache();
+                    if (cache == NULL) {
+                        return v.getEncodedSize();
+                    }
+                    const uint32_t slot = cache->reserveLength();
+                    return cache->setLength(slot, v.getEncodedSize());
+                }
+
+                template<typename T>
+                static inline uint32_t getSerializableLength(const T &v, const false_type &) {
+                    EncodingCache *cache = getSizingCache();
+                    string bytes = serialize(v);
+                    if (cache == NULL) {
+                        return static_cast<uint32_t>(bytes.size());
+                    }
+                    return cache->addBytes(bytes);
+                }
+
+                template<typename T>
+                static inline void writeSerializable(ByteWriter &out, const T &v, const true_type &) {
+                    EncodingCache *cache = getWritingCache();
+                    out.writeVarInt((cache != NULL) ? cache->getNextLength() : v.getEncodedSize());
+                    v.encodeTo(out);
+                }
+
+                template<typename T>
+                static inline void writeSerializable(ByteWriter &out, const T &v, const false_type &) {
+                    EncodingCache *cache = getWritingCache();
+                    if (cache != NULL) {
+                        writeValue(out, cache->getNextBytes());
+                    }
+                    else {
+                        writeValue(out, serialize(v));
+                    }
+                }
+
+                template<typename T>
+                static inline string serialize(const T &v) {
+                    EncodingScope scope(false);
+                    stringstream buffer;
+                    buffer << v;
+                    return buffer.str();
+                }
+        };
+
+    }
+} // odcore::serialization
+
+#endif /*OPENDAVINCI_CORE_SERIALIZATION_PROTOENCODER_H_*/
@@ -78,6 +78,12 @@ class Serializable;
 
                 virtual void getSerializedData(ostream &o);
 
+                /**
+                 * This method discards all data serialized so far so that
+                 * this instance can be reused.
+                 */
+                void reset();
+
             private:
                 /**
                  * This method encodes a given value using the varuint encoding.
@@ -88,13 +94,23 @@ class Serializable;
                  */
                 uint8_t encodeVarInt(ostream &out, uint64_t value);
 
+            public:
+                /**
+                 * This method returns the number of bytes needed to encode
+                 * the given value using the varuint encoding.
+                 *
+                 * @param value Value to be encoded.
+                 * @return Number of bytes.
+                 */
+                static uint32_t getVarIntSize(const uint64_t &value);
+
                 /**
                  * This method encodes a given value using zigzag8 encoding.
                  *
                  * @param value Value to be encoded.
                  * @return size Encoded value.
                  */
-                uint8_t encodeZigZag8(int8_t value);
+                static uint8_t encodeZigZag8(int8_t value);
 
                 /**
                  * This method encodes a given value using zigzag16 encoding.
@@ -102,7 +118,7 @@ class Serializable;
                  * @param value Value to be encoded.
                  * @return size Encoded value.
                  */
-                uint16_t encodeZigZag16(int16_t value);
+                static uint16_t encodeZigZag16(int16_t value);
 
                 /**
                  * This method encodes a given value using zigzag32 encoding.
@@ -110,7 +126,7 @@ class Serializable;
                  * @param value Value to be encoded.
                  * @return size Encoded value.
                  */
-                uint32_t encodeZigZag32(int32_t value);
+                static uint32_t encodeZigZag32(int32_t value);
 
                 /**
                  * This method encodes a given value using zigzag64 encoding.
@@ -118,7 +134,7 @@ class Serializable;
                  * @param value Value to be encoded.
                  * @return size Encoded value.
                  */
-                uint64_t encodeZigZag64(int64_t value);
+                static uint64_t encodeZigZag64(int64_t value);
 
             public:
                 virtual uint32_t writeValue(ostream &o, const Serializable &v);
@@ -20,11 +20,12 @@
 #ifndef OPENDAVINCI_CORE_SERIALIZATION_QUERYABLENETSTRINGSDESERIALIZERABCF_H_
 #define OPENDAVINCI_CORE_SERIALIZATION_QUERYABLENETSTRINGSDESERIALIZERABCF_H_
 
-#include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
 #include "opendavinci/odcore/serialization/Serializer.h"
 #include "opendavinci/odcore/serialization/Deserializer.h"
 
@@ -41,6 +42,12 @@ namespace odcore {
          *
          * '0xAB' '0xCF' 'binary length encoded as varint' 'PAYLOAD' ','
          *
+         * The payload is decoded from contiguous memory: When reading
+         * from an istream backed by a SpanStreamBuffer, the bytes are
+         * used in place; otherwise, they are copied once. The fields
+         * are located using a table of offsets sorted by their IDs and
+         * nested Serializables are read from sub-spans of the payload.
+         *
          * @See Serializable
          */
         class OPENDAVINCI_API QueryableNetstringsDeserializerABCF : public Deserializer {
@@ -164,9 +171,61 @@ namespace odcore {
                  */
                 uint8_t decodeVarInt(istream& in, int64_t &value);
 
+                /**
+                 * This method builds the table of fields contained
+                 * in the given payload.
+                 *
+                 * @param payload Payload to index.
+                 */
+                void buildFieldTable(const ByteSpan &payload);
+
+                /**
+                 * This method returns the bytes of the field with the
+                 * given identifier.
+                 *
+                 * @param id Identifier of the field.
+                 * @param value Bytes of the field.
+                 * @return true if the field was found.
+                 */
+                bool getField(const uint32_t &id, ByteSpan &value) const;
+
+                /**
+                 * This method reads the unsigned varint of the field with
+                 * the given identifier.
+                 *
+                 * @param id Identifier of the field.
+                 * @param value Destination variable to be written into.
+                 * @return true if the field was found.
+                 */
+                bool readVarUInt(const uint32_t &id, uint64_t &value) const;
+
+                /**
+                 * This method reads the ZigZag encoded varint of the field
+                 * with the given identifier.
+                 *
+                 * @param id Identifier of the field.
+                 * @param value Destination variable to be written into.
+                 * @return true if the field was found.
+                 */
+                bool readVarInt(const uint32_t &id, int64_t &value) const;
+
             private:
-                stringstream m_buffer;
-                map<uint32_t, streampos> m_values;
+                /**
+                 * Location of one field within the payload.
+                 */
+                struct Field {
+                    uint32_t m_id;
+                    uint32_t m_offset;
+                    uint32_t m_length;
+
+                    bool operator<(const Field &other) const {
+                        return m_id < other.m_id;
+                    }
+                };
+
+                string m_buffer;
+                ByteSpan m_payload;
+                vector<Field> m_fields;
         };
 
     }
@@ -69,6 +69,12 @@ class Serializable;
 
                 virtual void getSerializedData(ostream &o);
 
+                /**
+                 * This method discards all data serialized so far so that
+                 * this instance can be reused.
+                 */
+                void reset();
+
             public:
                 virtual uint32_t writeValue(ostream &o, const Serializable &v);
                 virtual uint32_t writeValue(ostream &o, const bool &v);
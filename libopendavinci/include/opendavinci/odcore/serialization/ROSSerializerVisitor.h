@@ -61,6 +61,12 @@ class Serializable;
 
                 virtual void getSerializedData(ostream &o);
 
+                /**
+                 * This method discards all data serialized so far so that
+                 * this instance can be reused.
+                 */
+                void reset();
+
                 /**
                  * This method sets the message identifier.
                  *
@@ -28,6 +28,8 @@
 
 class SerializationFactoryTestCase;
 
+namespace odcore { namespace base { class Visitor; } }
+
 namespace odcore {
     namespace serialization {
 
@@ -40,9 +42,30 @@ class Serializer;
          * This class is the factory for providing serializers and
          * deserializers.
          *
+         * The serializers and deserializers provided by this class are
+         * kept in a pool: Once the last reference to a returned instance
+         * is released, a serializer writes its data to the given output
+         * stream and is reset; afterwards, the instance is handed out
+         * again. Thus, obtaining a serializer does not allocate memory
+         * once the pool has reached the number of concurrently used
+         * instances.
+         *
          * @See Serializable
          */
         class OPENDAVINCI_API SerializationFactory {
+            public:
+                /**
+                 * Wire formats that can be selected for the payload of
+                 * a Container (cf. Container(Visitable&, int32_t, WIRE_FORMAT)
+                 * and Container::getData<T>(WIRE_FORMAT)).
+                 */
+                enum WIRE_FORMAT {
+                    PROTO = 0,
+                    QUERYABLE_NETSTRINGS = 1,
+                    LCM = 2,
+                    ROS = 3,
+                };
+
             protected:
                 friend class SerializationFactoryTestCase;
                 SerializationFactory();
@@ -99,6 +122,45 @@ class Serializer;
                  */
                 std::shared_ptr<Deserializer> getQueryableNetstringsDeserializer(istream &in) const;
 
+                /**
+                 * This method returns a visitor to serialize a Visitable
+                 * in the given wire format. The serialized data is written
+                 * to out once the last reference to the visitor is released.
+                 *
+                 * @code
+                 * {
+                 *     std::shared_ptr<Visitor> v = sf.getSerializerVisitor(SerializationFactory::LCM, out);
+                 *     myVisitable.accept(*v);
+                 * }
+                 * @endcode
+                 *
+                 * @param format Wire format to be used.
+                 * @param out Output stream for serialization.
+                 * @return Visitor.
+                 */
+                std::shared_ptr<odcore::base::Visitor> getSerializerVisitor(const WIRE_FORMAT &format, ostream &out) const;
+
+                /**
+                 * This method returns a visitor to deserialize a Visitable
+                 * from data in the given wire format.
+                 *
+                 * @param format Wire format to be used.
+                 * @param in Input stream for deserialization.
+                 * @return Visitor.
+                 */
+                std::shared_ptr<odcore::base::Visitor> getDeserializerVisitor(const WIRE_FORMAT &format, istream &in) const;
+
+                /**
+                 * This method returns true if this factory provides the
+                 * default Protobuf serializers, i.e. getSerializer and
+                 * getDeserializer are not replaced by a subclass. In this
+                 * case, the wire format is known in advance and data can
+                 * be encoded directly into a contiguous buffer.
+                 *
+                 * @return true if the default serializers are used.
+                 */
+                bool usesDefaultSerialization() const;
+
             protected:
                 /**
                  * This method sets the singleton pointer.
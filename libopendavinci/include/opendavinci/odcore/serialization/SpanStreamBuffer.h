@@ -0,0 +1,96 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_SERIALIZATION_SPANSTREAMBUFFER_H_
+#define OPENDAVINCI_CORE_SERIALIZATION_SPANSTREAMBUFFER_H_
+
+#include <streambuf>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        /**
+         * This class provides a read-only stream buffer on top of a
+         * contiguous range of bytes without copying them. Deserializers
+         * recognize this stream buffer and decode directly from the
+         * underlying bytes; thus, the bytes must outlive any istream
+         * using this stream buffer.
+         *
+         * @code
+         * SpanStreamBuffer buffer(data, length);
+         * istream in(&buffer);
+         * in >> serializable;
+         * @endcode
+         */
+        class OPENDAVINCI_API SpanStreamBuffer : public std::streambuf {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                SpanStreamBuffer(const SpanStreamBuffer &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                SpanStreamBuffer& operator=(const SpanStreamBuffer &);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param data Pointer to the first byte; the caller is responsible for its lifecycle.
+                 * @param length Number of bytes.
+                 */
+                SpanStreamBuffer(const char *data, const uint32_t &length);
+
+                virtual ~SpanStreamBuffer();
+
+                /**
+                 * @return Pointer to the next byte to be read.
+                 */
+                const char* getPosition() const;
+
+                /**
+                 * @return Pointer behind the last byte.
+                 */
+                const char* getEnd() const;
+
+                /**
+                 * This method marks all remaining bytes as read.
+                 */
+                void consume();
+
+            protected:
+                virtual pos_type seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which = ios_base::in | ios_base::out);
+
+                virtual pos_type seekpos(pos_type pos, ios_base::openmode which = ios_base::in | ios_base::out);
+        };
+
+    }
+} // odcore::serialization
+
+#endif /*OPENDAVINCI_CORE_SERIALIZATION_SPANSTREAMBUFFER_H_*/
@@ -0,0 +1,142 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_SERIALIZATION_VARINT_H_
+#define OPENDAVINCI_CORE_SERIALIZATION_VARINT_H_
+
+#include <istream>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        /**
+         * This class encodes and decodes unsigned integers using the
+         * VarInt encoding from Google's Protobuf: Each byte carries seven
+         * bits of the value starting with the least significant bits,
+         * and the MSB of each byte indicates whether another byte follows.
+         * All methods handle the full range of 64 bit values.
+         */
+        class OPENDAVINCI_API VarInt {
+            public:
+                /**
+                 * Maximum number of bytes of an encoded 64 bit value.
+                 */
+                static const uint32_t MAX_SIZE = 10;
+
+            private:
+                /**
+                 * "Forbidden" constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the constructor.
+                 */
+                VarInt();
+
+            public:
+                /**
+                 * This method returns the number of bytes needed to
+                 * encode the given value.
+                 *
+                 * @param value Value to be encoded.
+                 * @return Number of bytes.
+                 */
+                static uint32_t getSize(const uint64_t &value);
+
+                /**
+                 * This method encodes the given value.
+                 *
+                 * @param value Value to be encoded.
+                 * @param out Buffer providing at least MAX_SIZE bytes.
+                 * @return Number of bytes written.
+                 */
+                static uint32_t encode(uint64_t value, char *out);
+
+                /**
+                 * This method decodes one value. Values occupying one or
+                 * two bytes, which are most field keys and lengths, are
+                 * decoded inline.
+                 *
+                 * @param pos Current position; advanced behind the decoded value.
+                 * @param end Pointer behind the last available byte.
+                 * @param value Decoded value.
+                 * @return true if a complete value was decoded.
+                 */
+                static inline bool decode(const char *&pos, const char *end, uint64_t &value) {
+                    if (pos < end) {
+                        const uint8_t b0 = static_cast<uint8_t>(pos[0]);
+                        if (b0 < 0x80) {
+                            value = b0;
+                            pos += 1;
+                            return true;
+                        }
+                        if ( (pos + 1 < end) && (static_cast<uint8_t>(pos[1]) < 0x80) ) {
+                            value = static_cast<uint64_t>(b0 & 0x7f) | (static_cast<uint64_t>(static_cast<uint8_t>(pos[1])) << 7);
+                            pos += 2;
+                            return true;
+                        }
+                    }
+                    return decodeSlow(pos, end, value);
+                }
+
+                /**
+                 * This method decodes one value from the given stream. If
+                 * the stream is backed by a SpanStreamBuffer, the value is
+                 * decoded directly from the underlying bytes. If the stream
+                 * ends before the value is complete, eofbit and failbit
+                 * are set.
+                 *
+                 * @param in Stream to read from.
+                 * @param value Decoded value.
+                 * @return Number of bytes consumed.
+                 */
+                static uint32_t decode(istream &in, uint64_t &value);
+
+                /**
+                 * This method decodes a run of consecutively encoded
+                 * values. Where available, SSE2 or AVX2 is used to check
+                 * 16 or 32 bytes at once; windows holding only single byte
+                 * values are widened without decoding byte by byte.
+                 *
+                 * @param pos Current position; advanced behind the last decoded value.
+                 * @param end Pointer behind the last available byte.
+                 * @param values Destination for the decoded values.
+                 * @param capacity Maximum number of values to decode.
+                 * @return Number of decoded values.
+                 */
+                static uint32_t decodePacked(const char *&pos, const char *end, uint64_t *values, const uint32_t &capacity);
+
+            private:
+                /**
+                 * This method decodes one value of arbitrary length.
+                 *
+                 * @param pos Current position; advanced behind the decoded value.
+                 * @param end Pointer behind the last available byte.
+                 * @param value Decoded value.
+                 * @return true if a complete value was decoded.
+                 */
+                static bool decodeSlow(const char *&pos, const char *end, uint64_t &value);
+        };
+
+    }
+} // odcore::serialization
+
+#endif /*OPENDAVINCI_CORE_SERIALIZATION_VARINT_H_*/
@@ -0,0 +1,209 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_WRAPPER_POSIX_POSIXREACTOR_H_
+#define OPENDAVINCI_CORE_WRAPPER_POSIX_POSIXREACTOR_H_
+
+#include <pthread.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Condition.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/wrapper/Runnable.h"
+
+namespace odcore { namespace wrapper { class Thread; } }
+
+namespace odcore {
+    namespace wrapper {
+        namespace POSIX {
+
+            using namespace std;
+
+            /**
+             * This class waits for readable sockets using epoll and calls
+             * their handlers from a pool of shared I/O threads (cf.
+             * odcore::io::Reactor). Each socket is handled by at most one
+             * thread at a time; thus, data from one socket is processed
+             * in order. On platforms without epoll, no socket can be added
+             * and every socket keeps its own thread.
+             */
+            class POSIXReactor {
+                public:
+                    /**
+                     * Interface for sockets to be served by the reactor.
+                     */
+                    class Handler {
+                        public:
+                            virtual ~Handler();
+
+                            /**
+                             * This method is called when the socket is readable.
+                             *
+                             * @return false if the socket shall not be served anymore.
+                             */
+                            virtual bool onReadable() = 0;
+                    };
+
+                private:
+                    /**
+                     * This class runs one of the shared I/O threads.
+                     */
+                    class Worker : public Runnable {
+                        private:
+                            /**
+                             * "Forbidden" copy constructor. Goal: The compiler should warn
+                             * already at compile time for unwanted bugs caused by any misuse
+                             * of the copy constructor.
+                             */
+                            Worker(const Worker &);
+
+                            /**
+                             * "Forbidden" assignment operator. Goal: The compiler should warn
+                             * already at compile time for unwanted bugs caused by any misuse
+                             * of the assignment operator.
+                             */
+                            Worker& operator=(const Worker &);
+
+                        public:
+                            Worker(POSIXReactor &reactor);
+
+                            virtual ~Worker();
+
+                            void start();
+
+                            void stop();
+
+                            virtual bool isRunning();
+
+                            virtual void run();
+
+                        private:
+                            POSIXReactor &m_reactor;
+                            unique_ptr<Thread> m_thread;
+                    };
+
+                    /**
+                     * This class describes a registered socket.
+                     */
+                    class Registration {
+                        public:
+                            Registration();
+
+                            Registration(const int32_t &fileDescriptor, Handler *handler);
+
+                            int32_t m_fileDescriptor;
+                            Handler *m_handler;
+                            bool m_dispatching;
+                            bool m_removed;
+                            pthread_t m_dispatcher;
+                    };
+
+                    enum {
+                        MAX_EVENTS = 64 // Number of events retrieved at once per thread.
+                    };
+
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    POSIXReactor(const POSIXReactor &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    POSIXReactor& operator=(const POSIXReactor &);
+
+                    POSIXReactor();
+
+                public:
+                    virtual ~POSIXReactor();
+
+                    /**
+                     * @return Reactor shared by all sockets of this process.
+                     */
+                    static POSIXReactor& getInstance();
+
+                    /**
+                     * This method adds a socket to be served by the shared
+                     * I/O threads if any are configured.
+                     *
+                     * @param fileDescriptor Socket.
+                     * @param handler Handler to be called when the socket is readable.
+                     * @return Identifier of the registration; 0 if the socket needs its own thread.
+                     */
+                    uint64_t add(const int32_t &fileDescriptor, Handler *handler);
+
+                    /**
+                     * This method removes a socket. Once this method returns,
+                     * the handler is not called anymore unless this method
+                     * is called by the handler itself.
+                     *
+                     * @param registration Identifier of the registration.
+                     */
+                    void remove(const uint64_t &registration);
+
+                    /**
+                     * @return Number of running I/O threads.
+                     */
+                    uint32_t getNumberOfThreads() const;
+
+                private:
+                    /**
+                     * This method waits for readable sockets and calls their
+                     * handlers until the given worker is stopped.
+                     *
+                     * @param worker Calling worker.
+                     */
+                    void serve(Worker &worker);
+
+                    /**
+                     * This method calls the handler of a readable socket.
+                     *
+                     * @param registration Identifier of the registration.
+                     */
+                    void dispatch(const uint64_t &registration);
+
+                private:
+                    static odcore::base::Mutex m_singletonMutex;
+                    static POSIXReactor *m_singleton;
+
+                    int32_t m_epollFileDescriptor;
+                    int32_t m_wakeUpFileDescriptor;
+
+                    mutable odcore::base::Mutex m_workersMutex;
+                    vector<std::shared_ptr<Worker> > m_workers;
+
+                    odcore::base::Condition m_registrationsCondition;
+                    uint64_t m_nextRegistration;
+                    map<uint64_t, Registration> m_registrations;
+            };
+
+        }
+    }
+} // odcore::wrapper::POSIX
+
+#endif /*OPENDAVINCI_CORE_WRAPPER_POSIX_POSIXREACTOR_H_*/
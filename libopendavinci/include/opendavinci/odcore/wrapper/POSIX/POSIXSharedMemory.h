@@ -49,8 +49,9 @@ namespace odcore {
                      *
                      * @param name Name of the shared memory.
                      * @param size Create a new shared memory with the given size.
+                     * @param exclusive true if an existing shared memory with this name must not be replaced.
                      */
-                    POSIXSharedMemory(const string &name, const uint32_t &size);
+                    POSIXSharedMemory(const string &name, const uint32_t &size, const bool &exclusive);
 
                     /**
                      * Constructor.
@@ -89,10 +90,13 @@ namespace odcore {
 
                     virtual uint32_t getSize() const;
 
+                    virtual void remove();
+
                 private:
                     string m_name;
                     string m_internalName;
                     bool m_releaseSharedMemory;
+                    bool m_exclusive;
                     int32_t m_shmID;
                     sem_t* m_mutexSharedMemory;
                     void *m_sharedMemory;
@@ -33,7 +33,11 @@ namespace odcore {
         template <> class OPENDAVINCI_API SharedMemoryFactoryWorker<SystemLibraryPosix> {
             public:
                 static std::shared_ptr<SharedMemory> createSharedMemory(const string &name, const uint32_t &size) {
-                    return std::shared_ptr<SharedMemory>(new POSIX::POSIXSharedMemory(name, size));
+                    return std::shared_ptr<SharedMemory>(new POSIX::POSIXSharedMemory(name, size, false));
+                };
+
+                static std::shared_ptr<SharedMemory> createSharedMemoryExclusively(const string &name, const uint32_t &size) {
+                    return std::shared_ptr<SharedMemory>(new POSIX::POSIXSharedMemory(name, size, true));
                 };
 
                 static std::shared_ptr<SharedMemory> attachToSharedMemory(const string &name) {
@@ -24,6 +24,7 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/io/tcp/TCPAcceptor.h"
+#include "opendavinci/odcore/wrapper/POSIX/POSIXReactor.h"
 #include "opendavinci/odcore/wrapper/Runnable.h"
 
 namespace odcore { namespace io { namespace tcp { class TCPAcceptorListener; } } }
@@ -37,7 +38,12 @@ namespace odcore {
 
             using namespace std;
 
-            class POSIXTCPAcceptor : public odcore::io::tcp::TCPAcceptor, public Runnable {
+            /**
+             * This class implements a TCP acceptor using POSIX. It either
+             * uses its own thread or the shared I/O threads of the
+             * POSIXReactor if configured (cf. odcore::io::Reactor).
+             */
+            class POSIXTCPAcceptor : public odcore::io::tcp::TCPAcceptor, public Runnable, public POSIXReactor::Handler {
                 private:
                     static const int32_t BACKLOG = 100;
 
@@ -68,10 +74,18 @@ namespace odcore {
                     virtual bool isRunning();
                     virtual void run();
 
+                    virtual bool onReadable();
+
                 protected:
                     void invokeAcceptorListener(std::shared_ptr<odcore::io::tcp::TCPConnection> connection);
 
+                    /**
+                     * This method accepts a pending connection.
+                     */
+                    void acceptConnection();
+
                     unique_ptr<Thread> m_thread;
+                    uint64_t m_registration;
 
                     unique_ptr<Mutex> m_listenerMutex;
                     odcore::io::tcp::TCPAcceptorListener* m_listener;
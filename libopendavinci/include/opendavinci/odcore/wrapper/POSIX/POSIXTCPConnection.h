@@ -25,6 +25,7 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/io/tcp/TCPConnection.h"
+#include "opendavinci/odcore/wrapper/POSIX/POSIXReactor.h"
 #include "opendavinci/odcore/wrapper/Runnable.h"
 
 namespace odcore { namespace wrapper { class Mutex; } }
@@ -36,7 +37,12 @@ namespace odcore {
 
             using namespace std;
 
-            class POSIXTCPConnection : public odcore::io::tcp::TCPConnection, public Runnable {
+            /**
+             * This class implements a TCP connection using POSIX. It either
+             * uses its own thread or the shared I/O threads of the
+             * POSIXReactor if configured (cf. odcore::io::Reactor).
+             */
+            class POSIXTCPConnection : public odcore::io::tcp::TCPConnection, public Runnable, public POSIXReactor::Handler {
                 private:
                     /**
                      * "Forbidden" copy constructor. Goal: The compiler should warn
@@ -61,16 +67,29 @@ namespace odcore {
 
                     virtual void sendImplementation(const std::string& data);
 
+                    virtual void sendBuffersImplementation(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers);
+
                     virtual void start();
                     virtual void stop();
 
                     virtual bool isRunning();
                     virtual void run();
 
+                    virtual bool onReadable();
+
                 protected:
                     void initialize();
 
+                    /**
+                     * This method receives the pending data from the
+                     * readable socket.
+                     *
+                     * @return false if the connection was closed.
+                     */
+                    bool receive();
+
                     unique_ptr<Thread> m_thread;
+                    uint64_t m_registration;
 
                     unique_ptr<Mutex> m_socketMutex;
                     int32_t m_fileDescriptor;
@@ -26,10 +26,14 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/io/PacketBufferPool.h"
+#include "opendavinci/odcore/io/SharedPacket.h"
 #include "opendavinci/odcore/io/udp/UDPReceiver.h"
 #include "opendavinci/odcore/wrapper/NetworkLibraryProducts.h"
+#include "opendavinci/odcore/wrapper/POSIX/POSIXReactor.h"
 #include "opendavinci/odcore/wrapper/Runnable.h"
 
 namespace odcore { namespace wrapper { class Thread; } }
@@ -43,10 +47,12 @@ namespace odcore {
 
             /**
              * This class implements a UDP receiver for receiving data using POSIX.
+             * It either uses its own thread or the shared I/O threads of
+             * the POSIXReactor if configured (cf. odcore::io::Reactor).
              *
              * @See UDPReceiver
              */
-            class POSIXUDPReceiver : public Runnable, public odcore::io::udp::UDPReceiver {
+            class POSIXUDPReceiver : public Runnable, public POSIXReactor::Handler, public odcore::io::udp::UDPReceiver {
                 private:
                     friend class UDPFactoryWorker<NetworkLibraryPosix>;
 
@@ -61,7 +67,11 @@ namespace odcore {
 
                 private:
                     enum {
-                        BUFFER_SIZE = 65535
+                        BUFFER_SIZE = 65535,
+                        MAX_COPIED_DATAGRAM_SIZE = 8192, // Smaller datagrams do not hold a receive buffer.
+                        CONTROL_SIZE = 64,
+                        MAX_RECEIVE_BATCH_SIZE = 64,
+                        NUMBER_OF_IDLE_BUFFERS = 2 * MAX_RECEIVE_BATCH_SIZE
                     };
 
                 private:
@@ -88,6 +98,10 @@ namespace odcore {
 
                     virtual void setSenderPortToIgnore(const uint16_t &portToIgnore);
 
+                    virtual void setReceiveBatchSize(const uint32_t &batchSize);
+
+                    virtual bool onReadable();
+
                 private:
                     map<unsigned long, bool> m_mapOfIPAddresses;
                     uint16_t m_portToIgnore;
@@ -95,11 +109,45 @@ namespace odcore {
                     struct sockaddr_in m_address;
                     struct ip_mreq m_mreq;
                     int32_t m_fd;
-                    char *m_buffer;
+                    // Received datagrams are passed on in these buffers without copying them.
+                    odcore::io::PacketBufferPool m_bufferPool;
+                    uint32_t m_receiveBatchSize;
                     unique_ptr<Thread> m_thread;
+                    uint64_t m_registration;
+
+#ifdef __linux__
+                    // One buffer, sender address, and control buffer per datagram;
+                    // buffers handed out with a packet are replaced before receiving.
+                    vector<std::shared_ptr<char> > m_batchBuffers;
+                    vector<char> m_batchControls;
+                    vector<struct sockaddr_in> m_batchRemotes;
+                    vector<struct iovec> m_batchIOVecs;
+                    vector<struct mmsghdr> m_batchMessages;
+                    vector<odcore::io::SharedPacket> m_batchPackets;
+#endif
 
                     virtual void run();
 
+                    /**
+                     * This method receives the pending datagrams from the
+                     * readable socket.
+                     */
+                    void receive();
+
+                    /**
+                     * This method receives one datagram.
+                     */
+                    void receiveDatagram();
+
+#ifdef __linux__
+                    /**
+                     * This method receives up to m_receiveBatchSize datagrams
+                     * per system call using recvmmsg and retrieves the kernel's
+                     * time stamps from the control messages (SO_TIMESTAMPNS).
+                     */
+                    void receiveDatagrams();
+#endif
+
                     virtual bool isRunning();
 
                     void getIPAddresses();
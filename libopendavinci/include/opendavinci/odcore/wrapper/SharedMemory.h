@@ -77,6 +77,14 @@ namespace odcore {
                  * @return Size of the shared memory.
                  */
                 virtual uint32_t getSize() const = 0;
+
+                /**
+                 * This method removes the shared memory's name so that a
+                 * new shared memory can be created with this name; processes
+                 * that are attached already keep using the shared memory
+                 * until they detach.
+                 */
+                virtual void remove() = 0;
         };
 
     }
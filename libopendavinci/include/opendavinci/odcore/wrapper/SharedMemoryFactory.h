@@ -46,6 +46,18 @@ class SharedMemory;
              */
             static std::shared_ptr<SharedMemory> createSharedMemory(const string &name, const uint32_t &size);
 
+            /**
+             * This method returns the shared memory only if no shared
+             * memory with the given name exists; otherwise, the returned
+             * shared memory is invalid. Thus, exactly one of several
+             * concurrent callers creates the shared memory.
+             *
+             * @param name Name of the shared memory to create.
+             * @param size Required size for the new shared memory.
+             * @return Shared memory based on the type of instance this factory is.
+             */
+            static std::shared_ptr<SharedMemory> createSharedMemoryExclusively(const string &name, const uint32_t &size);
+
             /**
              * This method returns the shared memory.
              *
@@ -54,6 +54,16 @@ namespace odcore {
                  */
                 static std::shared_ptr<SharedMemory> createSharedMemory(const string &name, const uint32_t &size);
 
+                /**
+                 * This method returns the shared memory only if no shared
+                 * memory with the given name exists.
+                 *
+                 * @param name Name of the shared memory to create.
+                 * @param size Required size for the new shared memory.
+                 * @return Shared memory based on the type of instance this factory is.
+                 */
+                static std::shared_ptr<SharedMemory> createSharedMemoryExclusively(const string &name, const uint32_t &size);
+
                 /**
                  * This method returns the shared memory.
                  *
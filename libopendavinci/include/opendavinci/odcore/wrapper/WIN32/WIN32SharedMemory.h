@@ -49,8 +49,9 @@ namespace odcore {
                      *
                      * @param name Name of the shared memory.
                      * @param size Create a new shared memory with the given size.
+                     * @param exclusive true if an existing shared memory with this name must not be replaced.
                      */
-                    WIN32SharedMemory(const string &name, const uint32_t &size);
+                    WIN32SharedMemory(const string &name, const uint32_t &size, const bool &exclusive);
 
                     /**
                      * Constructor.
@@ -89,6 +90,8 @@ namespace odcore {
 
                     virtual uint32_t getSize() const;
 
+                    virtual void remove();
+
                 private:
                     string m_name;
                     string m_internalName;
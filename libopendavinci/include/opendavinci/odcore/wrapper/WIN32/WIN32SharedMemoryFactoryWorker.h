@@ -35,7 +35,11 @@ namespace odcore {
         template <> class OPENDAVINCI_API SharedMemoryFactoryWorker<SystemLibraryWin32> {
             public:
                 static std::shared_ptr<SharedMemory> createSharedMemory(const string &name, const uint32_t &size) {
-                    return std::shared_ptr<SharedMemory>(new WIN32Impl::WIN32SharedMemory(name, size));
+                    return std::shared_ptr<SharedMemory>(new WIN32Impl::WIN32SharedMemory(name, size, false));
+                };
+
+                static std::shared_ptr<SharedMemory> createSharedMemoryExclusively(const string &name, const uint32_t &size) {
+                    return std::shared_ptr<SharedMemory>(new WIN32Impl::WIN32SharedMemory(name, size, true));
                 };
 
                 static std::shared_ptr<SharedMemory> attachToSharedMemory(const string &name) {
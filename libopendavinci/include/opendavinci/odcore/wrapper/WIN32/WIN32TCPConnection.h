@@ -61,6 +61,8 @@ namespace odcore {
 
                     virtual void sendImplementation(const std::string& data);
 
+                    virtual void sendBuffersImplementation(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers);
+
                     virtual void start();
                     virtual void stop();
 
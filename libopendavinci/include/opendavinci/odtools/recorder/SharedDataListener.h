@@ -81,6 +81,8 @@ class SharedDataWriter;
 
                 virtual void add(odcore::data::Container &container);
 
+                virtual void add(odcore::data::Container &&container);
+
                 virtual void clear();
 
                 virtual uint32_t getSize() const;
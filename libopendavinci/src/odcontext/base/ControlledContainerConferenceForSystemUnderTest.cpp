@@ -67,6 +67,10 @@ namespace odcontext {
             m_sendToListener.nextContainer(container);
         }
 
+        void ControlledContainerConferenceForSystemUnderTest::send(Container &&container) const {
+            send(container);
+        }
+
         BlockableContainerReceiver& ControlledContainerConferenceForSystemUnderTest::getBlockableContainerReceiver() {
             return m_sendToListener;
         }
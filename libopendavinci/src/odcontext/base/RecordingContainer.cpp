@@ -61,7 +61,7 @@ namespace odcontext {
                 for (uint32_t i = 0; i < SIZE; i++) {
                     Container c = getFIFO().leave();
                     clog << "(RecordingContainer) Storing '" << c.toString() << "'." << endl;
-                    m_recorder->store(c);
+                    m_recorder->store(std::move(c));
                 }
             }
             getFIFO().clear();
@@ -19,6 +19,7 @@
 
 #include "opendavinci/odcore/base/AbstractDataStore.h"
 #include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/data/Container.h"
 
 namespace odcore {
     namespace base {
@@ -28,6 +29,10 @@ namespace odcore {
 
         AbstractDataStore::~AbstractDataStore() {}
 
+        void AbstractDataStore::add(odcore::data::Container &&container) {
+            add(container);
+        }
+
         void AbstractDataStore::waitForData() {
             Lock l(m_condition);
             if (isEmpty()) {
@@ -0,0 +1,505 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifdef __linux__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <new>
+
+#include "opendavinci/odcore/base/BroadcastRing.h"
+#include "opendavinci/odcore/base/Thread.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+
+namespace odcore {
+    namespace base {
+
+        using namespace std;
+
+        namespace {
+            enum {
+                ALIGNMENT = 64, // Cache line size.
+                NUMBER_OF_SPINS = 1000, // Busy waiting before sleeping.
+                POLLING_INTERVAL = 100, // Sleeping interval in microseconds without futexes.
+                MAX_WAITS_FOR_PRODUCER = 10000 // Sleeps before a stalled producer is considered to have abandoned the ring.
+            };
+
+            enum STATE {
+                UNINITIALIZED = 0,
+                READY = 1,
+                CLOSED = 2
+            };
+
+            enum KIND {
+                HEAD = 0,
+                CONTINUATION = 1,
+                PADDING = 2
+            };
+
+            uint64_t align(const uint64_t &value) {
+                return ((value + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+            }
+
+            // Sequence number of a slot while it is written for the given entry.
+            uint64_t writing(const uint64_t &sequence) {
+                return 2 * sequence + 1;
+            }
+
+            // Sequence number of a slot after it was written for the given entry.
+            uint64_t published(const uint64_t &sequence) {
+                return 2 * sequence + 2;
+            }
+        }
+
+        struct BroadcastRing::Header {
+            Header() :
+                m_state(UNINITIALIZED),
+                m_numberOfSlots(0),
+                m_slotSize(0),
+                m_nextParticipant(0),
+                m_heartbeat(0),
+                m_claimed(0),
+                m_notification(0),
+                m_waiters(0) {}
+
+            std::atomic<uint32_t> m_state;
+            uint32_t m_numberOfSlots;
+            uint32_t m_slotSize;
+            std::atomic<uint32_t> m_nextParticipant;
+            std::atomic<uint64_t> m_heartbeat;
+
+            // Producers and consumers modify separate cache lines.
+            alignas(ALIGNMENT) std::atomic<uint64_t> m_claimed;
+            alignas(ALIGNMENT) std::atomic<uint32_t> m_notification;
+            std::atomic<uint32_t> m_waiters;
+        };
+
+        struct BroadcastRing::Slot {
+            Slot() :
+                m_sequence(0),
+                m_kind(PADDING),
+                m_numberOfSlots(0),
+                m_length(0),
+                m_origin(0),
+                m_flags(0) {}
+
+            alignas(ALIGNMENT) std::atomic<uint64_t> m_sequence;
+            std::atomic<uint32_t> m_kind;
+            std::atomic<uint32_t> m_numberOfSlots;
+            std::atomic<uint32_t> m_length;
+            std::atomic<uint32_t> m_origin;
+            std::atomic<uint32_t> m_flags;
+        };
+
+        BroadcastRing::Entry::Entry() :
+            m_sequence(0),
+            m_numberOfSlots(0),
+            m_data(NULL),
+            m_length(0),
+            m_origin(0),
+            m_flags(0) {}
+
+        BroadcastRing::EntryWriter::~EntryWriter() {}
+
+        BroadcastRing::BroadcastRing(void *memory, const uint32_t &size) :
+            m_memory(static_cast<char*>(memory)),
+            m_size(size),
+            m_header(NULL),
+            m_slots(NULL),
+            m_data(NULL),
+            m_numberOfSlots(0),
+            m_slotSize(0),
+            m_lastHeartbeat(0),
+            m_lastHeartbeatChange(0) {
+            // Align the header to a cache line.
+            if (m_memory != NULL) {
+                const uint32_t OFFSET = static_cast<uint32_t>((ALIGNMENT - (reinterpret_cast<uintptr_t>(m_memory) % ALIGNMENT)) % ALIGNMENT);
+                if (m_size >= OFFSET + align(sizeof(Header))) {
+                    m_header = reinterpret_cast<Header*>(m_memory + OFFSET);
+                    m_slots = m_memory + OFFSET + align(sizeof(Header));
+                }
+            }
+        }
+
+        BroadcastRing::~BroadcastRing() {}
+
+        uint32_t BroadcastRing::getRequiredSize(const uint32_t &numberOfSlots, const uint32_t &slotSize) {
+            const uint64_t SIZE = ALIGNMENT + align(sizeof(Header))
+                                + static_cast<uint64_t>(numberOfSlots) * sizeof(Slot)
+                                + static_cast<uint64_t>(numberOfSlots) * align(slotSize);
+            return (SIZE > UINT_MAX) ? UINT_MAX : static_cast<uint32_t>(SIZE);
+        }
+
+        bool BroadcastRing::create(const uint32_t &numberOfSlots, const uint32_t &slotSize) {
+            // Sharing the ring between processes requires lock-free atomics.
+            const std::atomic<uint64_t> probe(0);
+            if ( (m_header == NULL) || (numberOfSlots < 2) || (slotSize == 0)
+              || (m_size < getRequiredSize(numberOfSlots, slotSize)) || !probe.is_lock_free() ) {
+                return false;
+            }
+
+            new (m_header) Header();
+            for (uint32_t i = 0; i < numberOfSlots; i++) {
+                new (m_slots + i * sizeof(Slot)) Slot();
+            }
+            m_header->m_numberOfSlots = numberOfSlots;
+            m_header->m_slotSize = static_cast<uint32_t>(align(slotSize));
+
+            m_numberOfSlots = numberOfSlots;
+            m_slotSize = m_header->m_slotSize;
+            m_data = m_slots + m_numberOfSlots * sizeof(Slot);
+
+            m_header->m_state.store(READY, std::memory_order_release);
+            return true;
+        }
+
+        bool BroadcastRing::attach(const uint32_t &timeout) {
+            if (m_header == NULL) {
+                return false;
+            }
+
+            // Wait for the creator to finish its initialization.
+            for (uint32_t waited = 0; (UNINITIALIZED == m_header->m_state.load(std::memory_order_acquire)) && (waited < timeout); waited += 1000) {
+                Thread::usleepFor(1000);
+            }
+
+            if (READY != m_header->m_state.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            const uint32_t NUMBER_OF_SLOTS = m_header->m_numberOfSlots;
+            const uint32_t SLOT_SIZE = m_header->m_slotSize;
+            if ( (NUMBER_OF_SLOTS < 2) || (SLOT_SIZE == 0) || (m_size < getRequiredSize(NUMBER_OF_SLOTS, SLOT_SIZE)) ) {
+                return false;
+            }
+
+            m_numberOfSlots = NUMBER_OF_SLOTS;
+            m_slotSize = SLOT_SIZE;
+            m_data = m_slots + m_numberOfSlots * sizeof(Slot);
+            return true;
+        }
+
+        bool BroadcastRing::isValid() const {
+            return (m_numberOfSlots > 0);
+        }
+
+        bool BroadcastRing::isClosed() const {
+            return !isValid() || (READY != m_header->m_state.load(std::memory_order_acquire));
+        }
+
+        bool BroadcastRing::hasBeenClosed() const {
+            return (m_header != NULL) && (CLOSED == m_header->m_state.load(std::memory_order_acquire));
+        }
+
+        void BroadcastRing::close() {
+            if (isValid()) {
+                m_header->m_state.store(CLOSED, std::memory_order_release);
+                m_header->m_notification.fetch_add(1);
+#ifdef __linux__
+                syscall(SYS_futex, reinterpret_cast<int*>(&m_header->m_notification), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+            }
+        }
+
+        bool BroadcastRing::abandon() {
+            // Only one participant closes the ring.
+            uint32_t state = READY;
+            if (!m_header->m_state.compare_exchange_strong(state, CLOSED, std::memory_order_acq_rel)) {
+                return false;
+            }
+            m_header->m_notification.fetch_add(1);
+#ifdef __linux__
+            syscall(SYS_futex, reinterpret_cast<int*>(&m_header->m_notification), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+            return true;
+        }
+
+        void BroadcastRing::heartbeat() {
+            if (isValid()) {
+                m_header->m_heartbeat.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        bool BroadcastRing::closeIfAbandoned(const odcore::data::TimeStamp &now, const uint32_t &timeout) {
+            if (isClosed()) {
+                return false;
+            }
+
+            const uint64_t HEARTBEAT = m_header->m_heartbeat.load(std::memory_order_relaxed);
+            const int64_t NOW = now.toMicroseconds();
+            if ( (HEARTBEAT != m_lastHeartbeat) || (m_lastHeartbeatChange == 0) ) {
+                m_lastHeartbeat = HEARTBEAT;
+                m_lastHeartbeatChange = NOW;
+                return false;
+            }
+            if ((NOW - m_lastHeartbeatChange) <= static_cast<int64_t>(timeout)) {
+                return false;
+            }
+
+            return abandon();
+        }
+
+        uint32_t BroadcastRing::getMaximumLength() const {
+            // An entry must not occupy more than half of the ring.
+            return (m_numberOfSlots / 2) * m_slotSize;
+        }
+
+        uint32_t BroadcastRing::registerParticipant() {
+            return isValid() ? (m_header->m_nextParticipant.fetch_add(1) + 1) : 0;
+        }
+
+        uint64_t BroadcastRing::getWriteSequence() const {
+            return isValid() ? m_header->m_claimed.load(std::memory_order_acquire) : 0;
+        }
+
+        BroadcastRing::Slot* BroadcastRing::getSlot(const uint64_t &sequence) const {
+            return reinterpret_cast<Slot*>(m_slots + (sequence % m_numberOfSlots) * sizeof(Slot));
+        }
+
+        char* BroadcastRing::getData(const uint64_t &sequence) const {
+            return m_data + (sequence % m_numberOfSlots) * m_slotSize;
+        }
+
+        bool BroadcastRing::acquireSlot(const uint64_t &sequence) {
+            Slot *s = getSlot(sequence);
+            const uint64_t WRITING = writing(sequence);
+
+            uint32_t waits = 0;
+            uint64_t current = s->m_sequence.load(std::memory_order_acquire);
+            while (true) {
+                if (current >= WRITING) {
+                    // A producer of a later round has taken this slot already.
+                    return false;
+                }
+                if (1 == (current & 1)) {
+                    // A producer of an earlier round is still writing.
+                    if (waits >= MAX_WAITS_FOR_PRODUCER) {
+                        abandon();
+                        return false;
+                    }
+                    waits++;
+                    Thread::usleepFor(1);
+                    current = s->m_sequence.load(std::memory_order_acquire);
+                    continue;
+                }
+                if (s->m_sequence.compare_exchange_weak(current, WRITING, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    return true;
+                }
+            }
+        }
+
+        void BroadcastRing::releaseAsPadding(const uint64_t &sequence, const uint32_t &numberOfSlots) const {
+            // Slots that were acquired by a producer of a later round remain untouched.
+            for (uint32_t i = 0; i < numberOfSlots; i++) {
+                Slot *s = getSlot(sequence + i);
+                uint64_t expected = writing(sequence + i);
+                if (expected == s->m_sequence.load(std::memory_order_acquire)) {
+                    s->m_kind.store(PADDING, std::memory_order_relaxed);
+                    s->m_sequence.compare_exchange_strong(expected, published(sequence + i), std::memory_order_acq_rel);
+                }
+            }
+        }
+
+        void BroadcastRing::notify() const {
+            m_header->m_notification.fetch_add(1);
+            if (m_header->m_waiters.load() > 0) {
+#ifdef __linux__
+                syscall(SYS_futex, reinterpret_cast<int*>(&m_header->m_notification), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+            }
+        }
+
+        bool BroadcastRing::write(const uint32_t &length, const uint32_t &origin, const uint32_t &flags, const EntryWriter &writer) {
+            if (isClosed() || (length > getMaximumLength())) {
+                return false;
+            }
+
+            const uint32_t COUNT = std::max(static_cast<uint32_t>(1), (length + m_slotSize - 1) / m_slotSize);
+
+            // Entries that would wrap around the end of the ring start at
+            // its beginning instead; the slots up to the end are padding.
+            uint64_t claimed = m_header->m_claimed.load(std::memory_order_acquire);
+            uint32_t padding = 0;
+            do {
+                const uint32_t INDEX = static_cast<uint32_t>(claimed % m_numberOfSlots);
+                padding = (INDEX + COUNT > m_numberOfSlots) ? (m_numberOfSlots - INDEX) : 0;
+            } while (!m_header->m_claimed.compare_exchange_weak(claimed, claimed + padding + COUNT, std::memory_order_acq_rel, std::memory_order_acquire));
+
+            if (padding > 0) {
+                for (uint32_t i = 0; i < padding; i++) {
+                    acquireSlot(claimed + i);
+                }
+                releaseAsPadding(claimed, padding);
+            }
+
+            const uint64_t SEQUENCE = claimed + padding;
+            bool acquired = true;
+            for (uint32_t i = 0; i < COUNT; i++) {
+                acquired &= acquireSlot(SEQUENCE + i);
+            }
+
+            // This producer might have been overtaken or the ring was abandoned.
+            if (!acquired) {
+                releaseAsPadding(SEQUENCE, COUNT);
+                notify();
+                return false;
+            }
+
+            // The acquired slots belong to this producer until they are published.
+            writer.write(getData(SEQUENCE), length);
+
+            Slot *head = getSlot(SEQUENCE);
+            head->m_kind.store(HEAD, std::memory_order_relaxed);
+            head->m_numberOfSlots.store(COUNT, std::memory_order_relaxed);
+            head->m_length.store(length, std::memory_order_relaxed);
+            head->m_origin.store(origin, std::memory_order_relaxed);
+            head->m_flags.store(flags, std::memory_order_relaxed);
+            for (uint32_t i = 1; i < COUNT; i++) {
+                getSlot(SEQUENCE + i)->m_kind.store(CONTINUATION, std::memory_order_relaxed);
+            }
+
+            // Publish the head slot last to make the entry visible at once.
+            for (uint32_t i = COUNT - 1; i > 0; i--) {
+                getSlot(SEQUENCE + i)->m_sequence.store(published(SEQUENCE + i), std::memory_order_release);
+            }
+            head->m_sequence.store(published(SEQUENCE), std::memory_order_release);
+
+            notify();
+
+            // The entry is lost if this producer stalled for so long that the ring was abandoned.
+            return !isClosed();
+        }
+
+        BroadcastRing::STATUS BroadcastRing::read(uint64_t &cursor, Entry &e) const {
+            while (true) {
+                if (isClosed()) {
+                    return CLOSED;
+                }
+
+                const uint64_t CLAIMED = m_header->m_claimed.load(std::memory_order_acquire);
+                Slot *s = getSlot(cursor);
+                const uint64_t SEQUENCE = s->m_sequence.load(std::memory_order_acquire);
+
+                if (SEQUENCE < published(cursor)) {
+                    if (CLAIMED > cursor + m_numberOfSlots) {
+                        // The producer of this entry stalled while the ring moved on.
+                        cursor = CLAIMED;
+                        return OVERRUN;
+                    }
+                    return EMPTY;
+                }
+                if (SEQUENCE > published(cursor)) {
+                    cursor = CLAIMED;
+                    return OVERRUN;
+                }
+
+                const uint32_t KIND = s->m_kind.load(std::memory_order_relaxed);
+                const uint32_t COUNT = s->m_numberOfSlots.load(std::memory_order_relaxed);
+                const uint32_t LENGTH = s->m_length.load(std::memory_order_relaxed);
+                const uint32_t ORIGIN = s->m_origin.load(std::memory_order_relaxed);
+                const uint32_t FLAGS = s->m_flags.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s->m_sequence.load(std::memory_order_relaxed) != published(cursor)) {
+                    cursor = CLAIMED;
+                    return OVERRUN;
+                }
+
+                const uint32_t INDEX = static_cast<uint32_t>(cursor % m_numberOfSlots);
+                if ( (HEAD != KIND) || (COUNT == 0) || (COUNT > m_numberOfSlots / 2)
+                  || (INDEX + COUNT > m_numberOfSlots) || (LENGTH > COUNT * m_slotSize) ) {
+                    // Skip padding and the remainders of partially overrun entries.
+                    cursor++;
+                    continue;
+                }
+
+                for (uint32_t i = 1; i < COUNT; i++) {
+                    if (getSlot(cursor + i)->m_sequence.load(std::memory_order_acquire) != published(cursor + i)) {
+                        cursor = CLAIMED;
+                        return OVERRUN;
+                    }
+                }
+
+                e.m_data = getData(cursor);
+                e.m_sequence = cursor;
+                e.m_numberOfSlots = COUNT;
+                e.m_length = LENGTH;
+                e.m_origin = ORIGIN;
+                e.m_flags = FLAGS;
+                return AVAILABLE;
+            }
+        }
+
+        bool BroadcastRing::release(uint64_t &cursor, const Entry &e) const {
+            // Check that no producer overwrote the entry while reading.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            for (uint32_t i = 0; i < e.m_numberOfSlots; i++) {
+                if (getSlot(e.m_sequence + i)->m_sequence.load(std::memory_order_relaxed) != published(e.m_sequence + i)) {
+                    return false;
+                }
+            }
+
+            cursor = e.m_sequence + e.m_numberOfSlots;
+            return true;
+        }
+
+        bool BroadcastRing::isAvailable(const uint64_t &cursor) const {
+            return isClosed()
+                || (getSlot(cursor)->m_sequence.load(std::memory_order_acquire) >= published(cursor))
+                || (m_header->m_claimed.load(std::memory_order_acquire) > cursor + m_numberOfSlots);
+        }
+
+        void BroadcastRing::waitForData(const uint64_t &cursor, const uint32_t &timeout) const {
+            if (!isValid()) {
+                Thread::usleepFor(timeout);
+                return;
+            }
+
+            // Busy waiting keeps the latency low for frequent entries.
+            for (uint32_t i = 0; i < NUMBER_OF_SPINS; i++) {
+                if (isAvailable(cursor)) {
+                    return;
+                }
+            }
+
+#ifdef __linux__
+            const uint32_t NOTIFICATION = m_header->m_notification.load();
+            m_header->m_waiters.fetch_add(1);
+            if (!isAvailable(cursor)) {
+                struct timespec ts;
+                ts.tv_sec = timeout / (1000 * 1000);
+                ts.tv_nsec = (timeout % (1000 * 1000)) * 1000;
+                syscall(SYS_futex, reinterpret_cast<int*>(&m_header->m_notification), FUTEX_WAIT, NOTIFICATION, &ts, NULL, 0);
+            }
+            m_header->m_waiters.fetch_sub(1);
+#else
+            for (uint32_t waited = 0; (waited < timeout) && !isAvailable(cursor); waited += POLLING_INTERVAL) {
+                Thread::usleepFor(POLLING_INTERVAL);
+            }
+#endif
+        }
+
+    }
+} // odcore::base
@@ -38,6 +38,12 @@ namespace odcore {
             }
         }
 
+        void BufferedFIFOQueue::enter(data::Container &&container) {
+            if (getSize() < m_bufferSize) {
+                FIFOQueue::enter(std::move(container));
+            }
+        }
+
         int32_t BufferedFIFOQueue::getIndexOfLastElement() const {
             return (getSize() - 1);
         }
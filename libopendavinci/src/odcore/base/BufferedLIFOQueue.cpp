@@ -38,6 +38,12 @@ namespace odcore {
             }
         }
 
+        void BufferedLIFOQueue::push(data::Container &&container) {
+            if (getSize() < m_bufferSize) {
+                LIFOQueue::push(std::move(container));
+            }
+        }
+
         int32_t BufferedLIFOQueue::getIndexOfLastElement() const {
             return (getSize() - 1);
         }
@@ -49,13 +49,21 @@ namespace odcore {
             wakeAll();
         }
 
-        const Container FIFOQueue::leave() {
+        void FIFOQueue::enter(Container &&container) {
+            {
+                Lock l(m_mutexQueue);
+                m_queue.push_back(std::move(container));
+            }
+            wakeAll();
+        }
+
+        Container FIFOQueue::leave() {
             waitForData();
 
             Container container;
             if (!isEmpty()) {
                 Lock l(m_mutexQueue);
-                container = m_queue.front();
+                container = std::move(m_queue.front());
                 m_queue.pop_front();
             }
 
@@ -79,6 +87,10 @@ namespace odcore {
             enter(container);
         }
 
+        void FIFOQueue::add(Container &&container) {
+            enter(std::move(container));
+        }
+
         uint32_t FIFOQueue::getSize() const {
             Lock l(m_mutexQueue);
             return static_cast<uint32_t>(m_queue.size());
@@ -51,13 +51,22 @@ namespace odcore {
             wakeAll();
         }
 
-        const Container LIFOQueue::pop() {
+        void LIFOQueue::push(Container &&container) {
+            {
+                Lock l(m_mutexQueue);
+                m_queue.push_front(std::move(container));
+            }
+
+            wakeAll();
+        }
+
+        Container LIFOQueue::pop() {
             waitForData();
 
             Container container;
             if (!isEmpty()) {
                 Lock l(m_mutexQueue);
-                container = m_queue.front();
+                container = std::move(m_queue.front());
                 m_queue.pop_front();
             }
 
@@ -81,6 +90,10 @@ namespace odcore {
             push(container);
         }
 
+        void LIFOQueue::add(Container &&container) {
+            push(std::move(container));
+        }
+
         uint32_t LIFOQueue::getSize() const {
             Lock l(m_mutexQueue);
             return static_cast<uint32_t>(m_queue.size());
@@ -670,8 +670,8 @@ namespace odcore {
                 reached_ManagedLevel_Pulse_Time();
 
                 // Deliver containers from last cycle before starting current cycle.
-                vector<Container> listOfContainersToBeDistributed = m_pulseMessage.getListOfContainers();
-                vector<Container>::iterator it = listOfContainersToBeDistributed.begin();
+                const vector<Container> &listOfContainersToBeDistributed = m_pulseMessage.getConstRef_ListOfContainers();
+                vector<Container>::const_iterator it = listOfContainersToBeDistributed.begin();
                 while (it != listOfContainersToBeDistributed.end()) {
                     Container c = *it;
                     c.setReceivedTimeStamp(TimeStamp());
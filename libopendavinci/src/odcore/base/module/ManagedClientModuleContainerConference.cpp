@@ -31,19 +31,31 @@ namespace odcore {
 
             ManagedClientModuleContainerConference::~ManagedClientModuleContainerConference() {}
 
-            void ManagedClientModuleContainerConference::send(odcore::data::Container &container) const {
-                // Put container to be sent into our list of data to be distributed.
+            void ManagedClientModuleContainerConference::stamp(odcore::data::Container &container) const {
                 container.setSentTimeStamp(TimeStamp());
 
                 // If sample time stamp is unset, use sent time stamp.
                 if (container.getSampleTimeStamp().toMicroseconds() == 0) {
                     container.setSampleTimeStamp(container.getSentTimeStamp());
                 }
+            }
+
+            void ManagedClientModuleContainerConference::send(odcore::data::Container &container) const {
+                // Put container to be sent into our list of data to be distributed.
+                stamp(container);
 
                 // The const cast is required as the method signature is designed to be const...
                 const_cast<ManagedClientModuleContainerConference*>(this)->m_listOfContainersToBeDelivered.push_back(container);
             }
 
+            void ManagedClientModuleContainerConference::send(odcore::data::Container &&container) const {
+                // Move container to be sent into our list of data to be distributed.
+                stamp(container);
+
+                // The const cast is required as the method signature is designed to be const...
+                const_cast<ManagedClientModuleContainerConference*>(this)->m_listOfContainersToBeDelivered.push_back(std::move(container));
+            }
+
             vector<odcore::data::Container> ManagedClientModuleContainerConference::getListOfContainers() const {
                 return m_listOfContainersToBeDelivered;
             }
@@ -17,16 +17,23 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "opendavinci/odcore/base/Visitable.h"
+#include "opendavinci/odcore/base/Visitor.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
 #include "opendavinci/odcore/serialization/Deserializer.h"
 #include "opendavinci/odcore/serialization/SerializationFactory.h"
+#include "opendavinci/odcore/serialization/ProtoSerializer.h"
 #include "opendavinci/odcore/serialization/Serializer.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/ContainerHeaderView.h"
 #include "opendavinci/odcore/data/SerializableData.h"
 
 namespace odcore {
@@ -37,6 +44,7 @@ namespace odcore {
         using namespace odcore::serialization;
 
         Container::Container() :
+                m_envelope(ENVELOPE_V1),
                 m_dataType(UNDEFINEDDATA),
                 m_serializedData(),
                 m_sent(TimeStamp(0, 0)),
@@ -45,6 +53,7 @@ namespace odcore {
                 m_senderStamp(0) {}
 
         Container::Container(const SerializableData &serializableData) :
+                m_envelope(ENVELOPE_V1),
                 m_dataType(serializableData.getID()),
                 m_serializedData(),
                 m_sent(TimeStamp(0, 0)),
@@ -52,10 +61,13 @@ namespace odcore {
                 m_sampleTimeStamp(TimeStamp(0, 0)),
                 m_senderStamp(0) {
             // Get data for container.
-            m_serializedData << serializableData;
+            stringstream sstr;
+            sstr << serializableData;
+            m_serializedData = std::make_shared<const string>(sstr.str());
         }
 
         Container::Container(const SerializableData &serializableData, const int32_t &dataType) :
+                m_envelope(ENVELOPE_V1),
                 m_dataType(dataType),
                 m_serializedData(),
                 m_sent(TimeStamp(0, 0)),
@@ -63,23 +75,66 @@ namespace odcore {
                 m_sampleTimeStamp(TimeStamp(0, 0)),
                 m_senderStamp(0) {
             // Get data for container.
-            m_serializedData << serializableData;
+            stringstream sstr;
+            sstr << serializableData;
+            m_serializedData = std::make_shared<const string>(sstr.str());
+        }
+
+        Container::Container(Visitable &visitable, const int32_t &dataType, const SerializationFactory::WIRE_FORMAT &wireFormat) :
+                m_envelope(ENVELOPE_V1),
+                m_dataType(dataType),
+                m_serializedData(),
+                m_sent(TimeStamp(0, 0)),
+                m_received(TimeStamp(0, 0)),
+                m_sampleTimeStamp(TimeStamp(0, 0)),
+                m_senderStamp(0) {
+            // Get data for container.
+            stringstream sstr;
+            {
+                // The serialized data is written to sstr when the visitor is released.
+                std::shared_ptr<Visitor> v = SerializationFactory::getInstance().getSerializerVisitor(wireFormat, sstr);
+                visitable.accept(*v);
+            }
+            m_serializedData = std::make_shared<const string>(sstr.str());
         }
 
         Container::Container(const Container &obj) :
                 Serializable(),
+                m_envelope(obj.m_envelope),
                 m_dataType(obj.getDataType()),
-                m_serializedData(),
+                m_serializedData(obj.m_serializedData),
                 m_sent(obj.m_sent),
                 m_received(obj.m_received),
                 m_sampleTimeStamp(obj.m_sampleTimeStamp),
-                m_senderStamp(obj.m_senderStamp) {
-            m_serializedData.str(obj.m_serializedData.str());
-        }
+                m_senderStamp(obj.m_senderStamp) {}
+
+        Container::Container(Container &&obj) :
+                Serializable(),
+                m_envelope(obj.m_envelope),
+                m_dataType(obj.getDataType()),
+                m_serializedData(std::move(obj.m_serializedData)),
+                m_sent(obj.m_sent),
+                m_received(obj.m_received),
+                m_sampleTimeStamp(obj.m_sampleTimeStamp),
+                m_senderStamp(obj.m_senderStamp) {}
 
         Container& Container::operator=(const Container &obj) {
+            m_envelope = obj.m_envelope;
             m_dataType = obj.getDataType();
-            m_serializedData.str(obj.m_serializedData.str());
+            // The payload is immutable and thus, shared between both instances.
+            m_serializedData = obj.m_serializedData;
+            setSentTimeStamp(obj.getSentTimeStamp());
+            setReceivedTimeStamp(obj.getReceivedTimeStamp());
+            setSampleTimeStamp(obj.getSampleTimeStamp());
+            setSenderStamp(obj.getSenderStamp());
+
+            return (*this);
+        }
+
+        Container& Container::operator=(Container &&obj) {
+            m_envelope = obj.m_envelope;
+            m_dataType = obj.getDataType();
+            m_serializedData = std::move(obj.m_serializedData);
             setSentTimeStamp(obj.getSentTimeStamp());
             setReceivedTimeStamp(obj.getReceivedTimeStamp());
             setSampleTimeStamp(obj.getSampleTimeStamp());
@@ -90,6 +145,23 @@ namespace odcore {
 
         Container::~Container() {}
 
+        void Container::getData(Visitable &visitable, const SerializationFactory::WIRE_FORMAT &wireFormat) {
+            if ( (m_serializedData.get() != NULL) && !m_serializedData->empty() ) {
+                // Read directly from the shared payload to avoid copying data.
+                SpanStreamBuffer buffer(m_serializedData->data(), m_serializedData->size());
+                istream in(&buffer);
+                std::shared_ptr<Visitor> v = SerializationFactory::getInstance().getDeserializerVisitor(wireFormat, in);
+                visitable.accept(*v);
+            }
+        }
+
+        ByteSpan Container::getPayload() const {
+            if (m_serializedData.get() != NULL) {
+                return ByteSpan(*m_serializedData);
+            }
+            return ByteSpan();
+        }
+
         int32_t Container::getDataType() const {
             return m_dataType;
         }
@@ -126,14 +198,154 @@ namespace odcore {
             return m_senderStamp;
         }
 
+        void Container::setEnvelope(const ENVELOPE &envelope) {
+            m_envelope = envelope;
+        }
+
+        Container::ENVELOPE Container::getEnvelope() const {
+            return m_envelope;
+        }
+
+        uint32_t Container::getTimeStampLength(const TimeStamp &timeStamp) {
+            // Both fields are ZigZag encoded and use a one byte key.
+            return 1 + ProtoSerializer::getVarIntSize(ProtoSerializer::encodeZigZag32(timeStamp.getSeconds()))
+                 + 1 + ProtoSerializer::getVarIntSize(ProtoSerializer::encodeZigZag32(timeStamp.getMicroseconds()));
+        }
+
+        void Container::writeTimeStamp(ByteWriter &out, const uint32_t &id, const TimeStamp &timeStamp) {
+            out.writeVarInt((id << 3) | ProtoSerializer::LENGTH_DELIMITED);
+            out.writeVarInt(getTimeStampLength(timeStamp));
+            out.writeVarInt((1 << 3) | ProtoSerializer::VARINT);
+            out.writeVarInt(ProtoSerializer::encodeZigZag32(timeStamp.getSeconds()));
+            out.writeVarInt((2 << 3) | ProtoSerializer::VARINT);
+            out.writeVarInt(ProtoSerializer::encodeZigZag32(timeStamp.getMicroseconds()));
+        }
+
+        uint32_t Container::getEnvelopeV1Length() const {
+            const uint32_t payloadLength = (m_serializedData.get() != NULL) ? m_serializedData->size() : 0;
+            const uint32_t sentLength = getTimeStampLength(m_sent);
+            const uint32_t receivedLength = getTimeStampLength(m_received);
+            const uint32_t sampleLength = getTimeStampLength(m_sampleTimeStamp);
+
+            // All field identifiers are small enough to fit into a one byte key.
+            return (1 + ProtoSerializer::getVarIntSize(ProtoSerializer::encodeZigZag32(m_dataType)))
+                 + (1 + ProtoSerializer::getVarIntSize(payloadLength) + payloadLength)
+                 + (1 + ProtoSerializer::getVarIntSize(sentLength) + sentLength)
+                 + (1 + ProtoSerializer::getVarIntSize(receivedLength) + receivedLength)
+                 + (1 + ProtoSerializer::getVarIntSize(sampleLength) + sampleLength)
+                 + (1 + ProtoSerializer::getVarIntSize(m_senderStamp));
+        }
+
+        void Container::writeEnvelopeV1Header(ByteWriter &out) const {
+            const uint32_t payloadLength = (m_serializedData.get() != NULL) ? m_serializedData->size() : 0;
+
+            // Write Proto header: 0x0D 0xA4 A B C <payload>.
+            // 0xA4 A B C can be read as uint32_t, 0xA4 can be cut and
+            // A B C can be read as little endian shifted by 8 bits to
+            // the right.
+            out.writeByte(0x0D);
+            out.writeFixed32((getEnvelopeV1Length() << 8) | 0xA4);
+
+            // Write container data type.
+            out.writeVarInt((1 << 3) | ProtoSerializer::VARINT);
+            out.writeVarInt(ProtoSerializer::encodeZigZag32(m_dataType));
+
+            // Write key and length of container data; the caller appends the payload.
+            out.writeVarInt((2 << 3) | ProtoSerializer::LENGTH_DELIMITED);
+            out.writeVarInt(payloadLength);
+        }
+
+        void Container::writeEnvelopeV1Trailer(ByteWriter &out) const {
+            writeTimeStamp(out, 3, m_sent);
+            writeTimeStamp(out, 4, m_received);
+            writeTimeStamp(out, 5, m_sampleTimeStamp);
+
+            // Write sender stamp.
+            out.writeVarInt((6 << 3) | ProtoSerializer::VARINT);
+            out.writeVarInt(m_senderStamp);
+        }
+
+        void Container::writeEnvelopeV2Header(ByteWriter &out) const {
+            const uint32_t payloadLength = (m_serializedData.get() != NULL) ? m_serializedData->size() : 0;
+
+            // Write Proto-compatible header: 0x0D 0xA4 A B C.
+            out.writeByte(0x0D);
+            out.writeFixed32(((ContainerHeaderView::V2_HEADER_SIZE - ContainerHeaderView::PREFIX_SIZE + payloadLength) << 8) | 0xA4);
+
+            // Write version marker and reserved bytes.
+            out.writeByte(ContainerHeaderView::V2_MARKER);
+            out.writeByte(0);
+            out.writeByte(0);
+            out.writeByte(0);
+
+            // Write fixed-layout header fields.
+            out.writeFixed32(static_cast<uint32_t>(m_dataType));
+            out.writeFixed32(m_senderStamp);
+            out.writeFixed32(static_cast<uint32_t>(m_sent.getSeconds()));
+            out.writeFixed32(static_cast<uint32_t>(m_sent.getMicroseconds()));
+            out.writeFixed32(static_cast<uint32_t>(m_received.getSeconds()));
+            out.writeFixed32(static_cast<uint32_t>(m_received.getMicroseconds()));
+            out.writeFixed32(static_cast<uint32_t>(m_sampleTimeStamp.getSeconds()));
+            out.writeFixed32(static_cast<uint32_t>(m_sampleTimeStamp.getMicroseconds()));
+        }
+
+        uint32_t Container::getSerializedSize() const {
+            if (ENVELOPE_V2 == m_envelope) {
+                const uint32_t payloadLength = (m_serializedData.get() != NULL) ? m_serializedData->size() : 0;
+                return ContainerHeaderView::V2_HEADER_SIZE + payloadLength;
+            }
+            return ContainerHeaderView::PREFIX_SIZE + getEnvelopeV1Length();
+        }
+
+        void Container::serializeTo(ByteWriter &out) const {
+            if (ENVELOPE_V2 == m_envelope) {
+                writeEnvelopeV2Header(out);
+            }
+            else {
+                writeEnvelopeV1Header(out);
+            }
+
+            if (m_serializedData.get() != NULL) {
+                out.writeBytes(m_serializedData->data(), m_serializedData->size());
+            }
+
+            if (ENVELOPE_V1 == m_envelope) {
+                writeEnvelopeV1Trailer(out);
+            }
+        }
 
         ostream& Container::operator<<(ostream &out) const {
+            SerializationFactory& sf=SerializationFactory::getInstance();
+            if ( (ENVELOPE_V2 == m_envelope) || sf.usesDefaultSerialization() ) {
+                // The header fields are encoded on the stack and the
+                // payload is written directly from the shared buffer.
+                char header[ContainerHeaderView::V2_HEADER_SIZE];
+                char trailer[64];
+                ByteWriter headerWriter(header, sizeof(header));
+                ByteWriter trailerWriter(trailer, sizeof(trailer));
+
+                if (ENVELOPE_V2 == m_envelope) {
+                    writeEnvelopeV2Header(headerWriter);
+                }
+                else {
+                    writeEnvelopeV1Header(headerWriter);
+                    writeEnvelopeV1Trailer(trailerWriter);
+                }
+
+                out.write(header, headerWriter.getPosition());
+                if (m_serializedData.get() != NULL) {
+                    out.write(m_serializedData->data(), m_serializedData->size());
+                }
+                out.write(trailer, trailerWriter.getPosition());
+
+                return out;
+            }
+
             stringstream bufferOut;
 
             // We need a dedicated scope as the writing will take place
             // in the Serializer's destructor.
             {
-                SerializationFactory& sf=SerializationFactory::getInstance();
                 std::shared_ptr<Serializer> s = sf.getSerializer(bufferOut);
 
                 // Write container data type.
@@ -141,7 +353,13 @@ namespace odcore {
                 s->write(1, dataType);
 
                 // Write container data.
-                s->write(2, m_serializedData.str());
+                if (m_serializedData.get() != NULL) {
+                    s->write(2, *m_serializedData);
+                }
+                else {
+                    const string emptyData;
+                    s->write(2, emptyData);
+                }
 
                 // Write sent time stamp data.
                 s->write(3, m_sent);
@@ -191,14 +409,13 @@ namespace odcore {
             string rawData = "";
 
             // Read Container header.
+            const uint32_t OPENDAVINCI_CONTAINER_HEADER_SIZE = ContainerHeaderView::PREFIX_SIZE;
             vector<char> temporaryBuffer;
-            stringstream bufferIn;
+            uint32_t bufferPosition = 0;
             {
-                const uint32_t OPENDAVINCI_CONTAINER_HEADER_SIZE = 5;
                 bool consumedOpenDaVINCIContainerHeader = false;
                 uint32_t bytesRead = 0;
                 uint32_t expectedBytes = 0;
-                uint32_t bufferPosition = 0;
 
                 temporaryBuffer.resize(OPENDAVINCI_CONTAINER_HEADER_SIZE);
                 while (in.good()) {
@@ -206,11 +423,6 @@ namespace odcore {
                         in.read(&temporaryBuffer[bufferPosition], (OPENDAVINCI_CONTAINER_HEADER_SIZE - bufferPosition));
                         bytesRead = in.gcount();
                         bufferPosition += bytesRead;
-
-                        if (bufferPosition == OPENDAVINCI_CONTAINER_HEADER_SIZE) {
-                            // Stop processing and redirect bufferIn's underlying pointer to avoid copying data.
-                            bufferIn.rdbuf()->pubsetbuf(&temporaryBuffer[0], bufferPosition);
-                        }
                     }
                     else {
                         in.read(&temporaryBuffer[bufferPosition], (expectedBytes > 1024) ? 1024 : expectedBytes);
@@ -223,8 +435,7 @@ namespace odcore {
                             cerr << "[core::base::Container] Failed to read " << expectedBytes << "." << endl;
                         }
                         if (0 == expectedBytes) {
-                            // Stop processing and redirect bufferIn's underlying pointer to avoid copying data.
-                            bufferIn.rdbuf()->pubsetbuf(&temporaryBuffer[0], bufferPosition);
+                            // Stop processing as the entire container has been read.
                             break;
                         }
                     }
@@ -232,12 +443,10 @@ namespace odcore {
                     if ( (bytesRead == OPENDAVINCI_CONTAINER_HEADER_SIZE) && !consumedOpenDaVINCIContainerHeader) {
                         consumedOpenDaVINCIContainerHeader = true;
 
-                        char byte0 = 0;
-                        expectedBytes = 0;
-
                         // Read five bytes OpenDaVINCI Container header.
-                        bufferIn.read(&byte0, sizeof(char));
-                        bufferIn.read((char*)&expectedBytes, sizeof(uint32_t));
+                        const char byte0 = temporaryBuffer[0];
+                        expectedBytes = 0;
+                        memcpy(&expectedBytes, &temporaryBuffer[1], sizeof(uint32_t));
 
                         // Transform value from little endian to host.
                         expectedBytes = le32toh(expectedBytes);
@@ -246,20 +455,47 @@ namespace odcore {
                         unsigned char byte1 = (expectedBytes & 0xFF);
                         expectedBytes = expectedBytes >> 8;
 
-                        // Allocate contiguous space to store bytes.
-                        bufferPosition = 0;
-                        temporaryBuffer.resize(expectedBytes);
-
                         // Check validity of the received bytes.
                         if (!( (0x0D == byte0) && (0xA4 == byte1) )) {
                             std::cerr << "[core::base::Container] Failed to decode OpenDaVINCI container header." << std::endl;
                             return in;
                         }
+
+                        // Allocate contiguous space to store bytes while keeping the header.
+                        temporaryBuffer.resize(OPENDAVINCI_CONTAINER_HEADER_SIZE + expectedBytes);
                     }
                 }
             }
 
             SerializationFactory& sf=SerializationFactory::getInstance();
+
+            // Fixed-layout envelopes and envelopes in the default Proto
+            // encoding are decoded in one pass without Deserializer.
+            const bool isEnvelopeV2 = (bufferPosition > OPENDAVINCI_CONTAINER_HEADER_SIZE) &&
+                                      (ContainerHeaderView::V2_MARKER == static_cast<uint8_t>(temporaryBuffer[OPENDAVINCI_CONTAINER_HEADER_SIZE]));
+            if (isEnvelopeV2 || sf.usesDefaultSerialization()) {
+                const ContainerHeaderView view(&temporaryBuffer[0], bufferPosition);
+                if (view.isValid()) {
+                    m_envelope = view.getEnvelope();
+                    m_dataType = view.getDataType();
+                    m_serializedData = (view.getPayload() != NULL) ? std::make_shared<const string>(view.getPayload(), view.getPayloadLength())
+                                                                   : std::make_shared<const string>();
+                    m_sent = view.getSentTimeStamp(); m_sent.computeHumanReadableRepresentation();
+                    m_received = view.getReceivedTimeStamp(); m_received.computeHumanReadableRepresentation();
+                    m_sampleTimeStamp = view.getSampleTimeStamp(); m_sampleTimeStamp.computeHumanReadableRepresentation();
+                    m_senderStamp = view.getSenderStamp();
+
+                    return in;
+                }
+            }
+            m_envelope = ENVELOPE_V1;
+
+            // Let bufferIn read from temporaryBuffer to avoid copying data.
+            const bool hasFields = (bufferPosition > OPENDAVINCI_CONTAINER_HEADER_SIZE);
+            SpanStreamBuffer buffer(hasFields ? &temporaryBuffer[OPENDAVINCI_CONTAINER_HEADER_SIZE] : NULL,
+                                    hasFields ? bufferPosition - OPENDAVINCI_CONTAINER_HEADER_SIZE : 0);
+            istream bufferIn(&buffer);
+
             std::shared_ptr<Deserializer> d = sf.getDeserializer(bufferIn);
 
             // Read container data type.
@@ -267,7 +503,7 @@ namespace odcore {
 
             // Read container data.
             d->read(2, rawData);
-            m_serializedData.str(rawData);
+            m_serializedData = std::make_shared<const string>(std::move(rawData));
 
             // Read sent time stamp data.
             d->read(3, m_sent); m_sent.computeHumanReadableRepresentation();
@@ -0,0 +1,285 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2008 - 2015 Christian Berger, Bernhard Rumpe
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+
+#include "opendavinci/odcore/data/ContainerHeaderView.h"
+#include "opendavinci/odcore/serialization/ProtoSerializer.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
+
+namespace odcore {
+    namespace data {
+
+        using namespace std;
+        using namespace odcore::serialization;
+
+        const uint32_t ContainerHeaderView::PREFIX_SIZE;
+        const uint32_t ContainerHeaderView::V2_HEADER_SIZE;
+        const uint8_t ContainerHeaderView::V2_MARKER;
+
+        ContainerHeaderView::ContainerHeaderView() :
+            m_data(NULL),
+            m_length(0),
+            m_size(0),
+            m_valid(false),
+            m_envelope(Container::ENVELOPE_V1),
+            m_dataType(Container::UNDEFINEDDATA),
+            m_senderStamp(0),
+            m_sentSeconds(0),
+            m_sentMicroseconds(0),
+            m_receivedSeconds(0),
+            m_receivedMicroseconds(0),
+            m_sampleSeconds(0),
+            m_sampleMicroseconds(0),
+            m_payload(NULL),
+            m_payloadLength(0) {}
+
+        ContainerHeaderView::ContainerHeaderView(const char *data, const uint32_t &length) :
+            m_data(data),
+            m_length(length),
+            m_size(0),
+            m_valid(false),
+            m_envelope(Container::ENVELOPE_V1),
+            m_dataType(Container::UNDEFINEDDATA),
+            m_senderStamp(0),
+            m_sentSeconds(0),
+            m_sentMicroseconds(0),
+            m_receivedSeconds(0),
+            m_receivedMicroseconds(0),
+            m_sampleSeconds(0),
+            m_sampleMicroseconds(0),
+            m_payload(NULL),
+            m_payloadLength(0) {
+            if ( (m_data != NULL) && (m_length >= PREFIX_SIZE) ) {
+                // Check the OpenDaVINCI container header 0x0D 0xA4 A B C.
+                const uint32_t value = readUInt32(m_data + 1);
+                if ( (0x0D == static_cast<uint8_t>(m_data[0])) && (0xA4 == (value & 0xFF)) ) {
+                    m_size = PREFIX_SIZE + (value >> 8);
+
+                    if (m_length >= m_size) {
+                        if ( (m_size > PREFIX_SIZE) && (V2_MARKER == static_cast<uint8_t>(m_data[PREFIX_SIZE])) ) {
+                            m_envelope = Container::ENVELOPE_V2;
+                            m_valid = decodeV2();
+                        }
+                        else {
+                            m_valid = decodeV1();
+                        }
+                    }
+                }
+            }
+        }
+
+        ContainerHeaderView::ContainerHeaderView(const ContainerHeaderView &obj) :
+            m_data(obj.m_data),
+            m_length(obj.m_length),
+            m_size(obj.m_size),
+            m_valid(obj.m_valid),
+            m_envelope(obj.m_envelope),
+            m_dataType(obj.m_dataType),
+            m_senderStamp(obj.m_senderStamp),
+            m_sentSeconds(obj.m_sentSeconds),
+            m_sentMicroseconds(obj.m_sentMicroseconds),
+            m_receivedSeconds(obj.m_receivedSeconds),
+            m_receivedMicroseconds(obj.m_receivedMicroseconds),
+            m_sampleSeconds(obj.m_sampleSeconds),
+            m_sampleMicroseconds(obj.m_sampleMicroseconds),
+            m_payload(obj.m_payload),
+            m_payloadLength(obj.m_payloadLength) {}
+
+        ContainerHeaderView::~ContainerHeaderView() {}
+
+        ContainerHeaderView& ContainerHeaderView::operator=(const ContainerHeaderView &obj) {
+            m_data = obj.m_data;
+            m_length = obj.m_length;
+            m_size = obj.m_size;
+            m_valid = obj.m_valid;
+            m_envelope = obj.m_envelope;
+            m_dataType = obj.m_dataType;
+            m_senderStamp = obj.m_senderStamp;
+            m_sentSeconds = obj.m_sentSeconds;
+            m_sentMicroseconds = obj.m_sentMicroseconds;
+            m_receivedSeconds = obj.m_receivedSeconds;
+            m_receivedMicroseconds = obj.m_receivedMicroseconds;
+            m_sampleSeconds = obj.m_sampleSeconds;
+            m_sampleMicroseconds = obj.m_sampleMicroseconds;
+            m_payload = obj.m_payload;
+            m_payloadLength = obj.m_payloadLength;
+
+            return (*this);
+        }
+
+        bool ContainerHeaderView::isValid() const {
+            return m_valid;
+        }
+
+        uint32_t ContainerHeaderView::getSize() const {
+            return m_size;
+        }
+
+        Container::ENVELOPE ContainerHeaderView::getEnvelope() const {
+            return m_envelope;
+        }
+
+        int32_t ContainerHeaderView::getDataType() const {
+            return m_dataType;
+        }
+
+        uint32_t ContainerHeaderView::getSenderStamp() const {
+            return m_senderStamp;
+        }
+
+        const TimeStamp ContainerHeaderView::getSentTimeStamp() const {
+            return TimeStamp(m_sentSeconds, m_sentMicroseconds);
+        }
+
+        const TimeStamp ContainerHeaderView::getReceivedTimeStamp() const {
+            return TimeStamp(m_receivedSeconds, m_receivedMicroseconds);
+        }
+
+        const TimeStamp ContainerHeaderView::getSampleTimeStamp() const {
+            return TimeStamp(m_sampleSeconds, m_sampleMicroseconds);
+        }
+
+        const char* ContainerHeaderView::getPayload() const {
+            return m_payload;
+        }
+
+        uint32_t ContainerHeaderView::getPayloadLength() const {
+            return m_payloadLength;
+        }
+
+        uint32_t ContainerHeaderView::readUInt32(const char *data) {
+            uint32_t value = 0;
+            memcpy(&value, data, sizeof(uint32_t));
+            return le32toh(value);
+        }
+
+        bool ContainerHeaderView::decodeV2() {
+            if (m_size < V2_HEADER_SIZE) {
+                return false;
+            }
+
+            const char *pos = m_data + PREFIX_SIZE + 4;
+            m_dataType = static_cast<int32_t>(readUInt32(pos)); pos += 4;
+            m_senderStamp = readUInt32(pos); pos += 4;
+            m_sentSeconds = static_cast<int32_t>(readUInt32(pos)); pos += 4;
+            m_sentMicroseconds = static_cast<int32_t>(readUInt32(pos)); pos += 4;
+            m_receivedSeconds = static_cast<int32_t>(readUInt32(pos)); pos += 4;
+            m_receivedMicroseconds = static_cast<int32_t>(readUInt32(pos)); pos += 4;
+            m_sampleSeconds = static_cast<int32_t>(readUInt32(pos)); pos += 4;
+            m_sampleMicroseconds = static_cast<int32_t>(readUInt32(pos));
+
+            m_payload = m_data + V2_HEADER_SIZE;
+            m_payloadLength = m_size - V2_HEADER_SIZE;
+
+            return true;
+        }
+
+        bool ContainerHeaderView::decodeV1() {
+            const char *pos = m_data + PREFIX_SIZE;
+            const char *end = m_data + m_size;
+
+            while (pos < end) {
+                uint64_t key = 0;
+                if (!VarInt::decode(pos, end, key)) {
+                    return false;
+                }
+
+                const uint32_t fieldId = static_cast<uint32_t>(key >> 3);
+                switch (key & 0x7) {
+                    case ProtoSerializer::VARINT:
+                    {
+                        uint64_t value = 0;
+                        if (!VarInt::decode(pos, end, value)) {
+                            return false;
+                        }
+                        if (1 == fieldId) {
+                            // Data type is ZigZag encoded.
+                            m_dataType = static_cast<int32_t>((value >> 1) ^ -(value & 1));
+                        }
+                        else if (6 == fieldId) {
+                            m_senderStamp = static_cast<uint32_t>(value);
+                        }
+                    }
+                    break;
+                    case ProtoSerializer::LENGTH_DELIMITED:
+                    {
+                        uint64_t length = 0;
+                        if (!VarInt::decode(pos, end, length) || (length > static_cast<uint64_t>(end - pos))) {
+                            return false;
+                        }
+                        bool decoded = true;
+                        if (2 == fieldId) {
+                            m_payload = pos;
+                            m_payloadLength = static_cast<uint32_t>(length);
+                        }
+                        else if (3 == fieldId) {
+                            decoded = decodeTimePoint(pos, pos + length, m_sentSeconds, m_sentMicroseconds);
+                        }
+                        else if (4 == fieldId) {
+                            decoded = decodeTimePoint(pos, pos + length, m_receivedSeconds, m_receivedMicroseconds);
+                        }
+                        else if (5 == fieldId) {
+                            decoded = decodeTimePoint(pos, pos + length, m_sampleSeconds, m_sampleMicroseconds);
+                        }
+                        if (!decoded) {
+                            return false;
+                        }
+                        pos += length;
+                    }
+                    break;
+                    case ProtoSerializer::FOUR_BYTES:
+                        pos += 4;
+                    break;
+                    case ProtoSerializer::EIGHT_BYTES:
+                        pos += 8;
+                    break;
+                    default:
+                        return false;
+                }
+            }
+
+            return (pos == end);
+        }
+
+        bool ContainerHeaderView::decodeTimePoint(const char *begin, const char *end, int32_t &seconds, int32_t &microseconds) {
+            const char *pos = begin;
+            while (pos < end) {
+                uint64_t key = 0;
+                uint64_t value = 0;
+                if ( !VarInt::decode(pos, end, key) ||
+                     ((key & 0x7) != ProtoSerializer::VARINT) ||
+                     !VarInt::decode(pos, end, value) ) {
+                    return false;
+                }
+
+                // Both fields are ZigZag encoded.
+                const int32_t v = static_cast<int32_t>((value >> 1) ^ -(value & 1));
+                if (1 == (key >> 3)) {
+                    seconds = v;
+                }
+                else if (2 == (key >> 3)) {
+                    microseconds = v;
+                }
+            }
+            return true;
+        }
+
+    }
+} // odcore::data
@@ -249,6 +249,14 @@ namespace odcore {
             return getMicroseconds();
         }
 
+        uint32_t TimeStamp::getEncodedSize() const {
+            return TimePoint::getEncodedSize();
+        }
+
+        void TimeStamp::encodeTo(ByteWriter &out) const {
+            TimePoint::encodeTo(out);
+        }
+
         void TimeStamp::computeHumanReadableRepresentation() {
             const long int seconds = getSeconds();
             struct tm *tm = localtime(&seconds);
@@ -0,0 +1,136 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <vector>
+
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/io/PacketBufferPool.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+        using namespace odcore::base;
+
+        /**
+         * The idle buffers that are shared by the pool and the buffers
+         * that are handed out.
+         */
+        class PacketBufferPool::Buffers {
+            private:
+                Buffers(const Buffers &);
+                Buffers& operator=(const Buffers &);
+
+            public:
+                Buffers(const uint32_t &bufferSize, const uint32_t &maximumNumberOfIdleBuffers) :
+                    m_bufferSize(bufferSize),
+                    m_maximumNumberOfIdleBuffers(maximumNumberOfIdleBuffers),
+                    m_mutex(),
+                    m_idle() {
+                    m_idle.reserve(m_maximumNumberOfIdleBuffers);
+                }
+
+                ~Buffers() {
+                    for (vector<char*>::iterator it = m_idle.begin(); it != m_idle.end(); ++it) {
+                        delete [] (*it);
+                    }
+                }
+
+                char* acquire() {
+                    {
+                        Lock l(m_mutex);
+                        if (!m_idle.empty()) {
+                            char *buffer = m_idle.back();
+                            m_idle.pop_back();
+                            return buffer;
+                        }
+                    }
+                    return new char[m_bufferSize];
+                }
+
+                void release(char *buffer) {
+                    {
+                        Lock l(m_mutex);
+                        if (m_idle.size() < m_maximumNumberOfIdleBuffers) {
+                            m_idle.push_back(buffer);
+                            return;
+                        }
+                    }
+                    delete [] buffer;
+                }
+
+                uint32_t getNumberOfIdleBuffers() {
+                    Lock l(m_mutex);
+                    return static_cast<uint32_t>(m_idle.size());
+                }
+
+            public:
+                const uint32_t m_bufferSize;
+                const uint32_t m_maximumNumberOfIdleBuffers;
+
+            private:
+                Mutex m_mutex;
+                vector<char*> m_idle;
+        };
+
+        /**
+         * Deleter returning a buffer to its pool.
+         */
+        class PacketBufferPool::ReleaseBuffer {
+            public:
+                ReleaseBuffer(const std::shared_ptr<Buffers> &buffers) :
+                    m_buffers(buffers) {}
+
+                ReleaseBuffer(const ReleaseBuffer &obj) :
+                    m_buffers(obj.m_buffers) {}
+
+                ReleaseBuffer& operator=(const ReleaseBuffer &obj) {
+                    m_buffers = obj.m_buffers;
+                    return *this;
+                }
+
+                void operator()(char *buffer) const {
+                    m_buffers->release(buffer);
+                }
+
+            private:
+                std::shared_ptr<Buffers> m_buffers;
+        };
+
+        PacketBufferPool::PacketBufferPool(const uint32_t &bufferSize, const uint32_t &maximumNumberOfIdleBuffers) :
+            m_buffers(new Buffers(bufferSize, maximumNumberOfIdleBuffers)) {}
+
+        PacketBufferPool::~PacketBufferPool() {}
+
+        std::shared_ptr<char> PacketBufferPool::acquire() {
+            return std::shared_ptr<char>(m_buffers->acquire(), ReleaseBuffer(m_buffers));
+        }
+
+        uint32_t PacketBufferPool::getBufferSize() const {
+            return m_buffers->m_bufferSize;
+        }
+
+        uint32_t PacketBufferPool::getNumberOfIdleBuffers() const {
+            return m_buffers->getNumberOfIdleBuffers();
+        }
+
+    }
+} // odcore::io
@@ -24,5 +24,24 @@ namespace odcore {
 
         PacketListener::~PacketListener() {}
 
+        void PacketListener::nextPackets(const std::vector<odcore::data::Packet> &packets) {
+            for (std::vector<odcore::data::Packet>::const_iterator it = packets.begin(); it != packets.end(); ++it) {
+                nextPacket(*it);
+            }
+        }
+
+        void PacketListener::nextSharedPacket(const SharedPacket &p) {
+            nextPacket(p.toPacket());
+        }
+
+        void PacketListener::nextSharedPackets(const std::vector<SharedPacket> &packets) {
+            std::vector<odcore::data::Packet> copies;
+            copies.reserve(packets.size());
+            for (std::vector<SharedPacket>::const_iterator it = packets.begin(); it != packets.end(); ++it) {
+                copies.push_back(it->toPacket());
+            }
+            nextPackets(copies);
+        }
+
     }
 } // odcore::io
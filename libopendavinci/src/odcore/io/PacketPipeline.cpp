@@ -27,13 +27,19 @@ namespace odcore {
         using namespace odcore::base;
         using namespace odcore::data;
 
-        PacketPipeline::PacketPipeline() :
+        PacketPipeline::PacketPipeline(const uint32_t &capacity, const OVERFLOW_POLICY &policy, const uint64_t &maximumNumberOfBytes) :
             Service(),
             PacketObserver(),
             PacketListener(),
             m_queueCondition(),
-            m_queueMutex(),
-            m_queue(),
+            m_queue(capacity, maximumNumberOfBytes),
+            m_consumerWaiting(false),
+            m_spaceCondition(),
+            m_numberOfWaitingProducers(0),
+            m_overflowPolicy(policy),
+            m_numberOfEnqueuedPackets(0),
+            m_numberOfDroppedPackets(0),
+            m_highWaterMark(0),
             m_packetListenerMutex(),
             m_packetListener(NULL) {}
 
@@ -51,60 +57,174 @@ namespace odcore {
             }
         }
 
+        void PacketPipeline::setOverflowPolicy(const OVERFLOW_POLICY &policy) {
+            m_overflowPolicy.store(policy);
+        }
+
+        PacketPipeline::OVERFLOW_POLICY PacketPipeline::getOverflowPolicy() const {
+            return static_cast<OVERFLOW_POLICY>(m_overflowPolicy.load());
+        }
+
+        uint32_t PacketPipeline::getCapacity() const {
+            return m_queue.getCapacity();
+        }
+
+        uint64_t PacketPipeline::getMaximumNumberOfBytes() const {
+            return m_queue.getMaximumNumberOfBytes();
+        }
+
+        uint64_t PacketPipeline::getNumberOfEnqueuedPackets() const {
+            return m_numberOfEnqueuedPackets.load();
+        }
+
+        uint64_t PacketPipeline::getNumberOfDroppedPackets() const {
+            return m_numberOfDroppedPackets.load();
+        }
+
+        uint32_t PacketPipeline::getHighWaterMark() const {
+            return m_highWaterMark.load();
+        }
+
         void PacketPipeline::nextPacket(const Packet &s) {
-            Lock l(m_queueCondition);
+            nextSharedPacket(SharedPacket(s));
+        }
 
-            // Enter new data.
-            {
-                Lock l2(m_queueMutex);
-                m_queue.push(s);
+        void PacketPipeline::nextPackets(const vector<Packet> &packets) {
+            vector<SharedPacket> copies;
+            copies.reserve(packets.size());
+            for (vector<Packet>::const_iterator it = packets.begin(); it != packets.end(); ++it) {
+                copies.push_back(SharedPacket(*it));
             }
+            nextSharedPackets(copies);
+        }
 
-            // Wake awaiting threads.
-            m_queueCondition.wakeAll();
+        void PacketPipeline::nextSharedPacket(const SharedPacket &s) {
+            if (enqueue(s)) {
+                wakeConsumer();
+            }
         }
 
-        void PacketPipeline::processQueue() {
-            uint32_t numberOfEntries = 0;
+        void PacketPipeline::nextSharedPackets(const vector<SharedPacket> &packets) {
+            bool enqueued = false;
+            for (vector<SharedPacket>::const_iterator it = packets.begin(); it != packets.end(); ++it) {
+                enqueued |= enqueue(*it);
+            }
 
-            // Determine the amount of current entries.
-            {
-                Lock l(m_queueMutex);
-                numberOfEntries = static_cast<uint32_t>(m_queue.size());
+            // Wake the distributing thread only once for the entire batch.
+            if (enqueued) {
+                wakeConsumer();
             }
+        }
 
-            Packet entry;
-            for (uint32_t i = 0; i < numberOfEntries; i++) {
-                // Acquire and remove next entry.
-                {
-                    Lock l2(m_queueMutex);
-                    entry = m_queue.front();
-                    m_queue.pop();
+        bool PacketPipeline::enqueue(const SharedPacket &s) {
+            bool enqueued = m_queue.push(s);
+            while (!enqueued) {
+                const OVERFLOW_POLICY POLICY = getOverflowPolicy();
+                if (DROP_NEWEST == POLICY) {
+                    m_numberOfDroppedPackets++;
+                    return false;
+                }
+                else if (DROP_OLDEST == POLICY) {
+                    SharedPacket oldest;
+                    if (m_queue.pop(oldest)) {
+                        m_numberOfDroppedPackets++;
+                    }
+                }
+                else {
+                    // Without a distributing thread, waiting for space would never end.
+                    if (!isRunning()) {
+                        m_numberOfDroppedPackets++;
+                        return false;
+                    }
+
+                    // Make sure that the distributing thread is processing the queue.
+                    wakeConsumer();
+
+                    Lock l(m_spaceCondition);
+                    m_numberOfWaitingProducers++;
+                    const uint64_t MAXIMUM_NUMBER_OF_BYTES = m_queue.getMaximumNumberOfBytes();
+                    if ( (m_queue.getSize() >= m_queue.getCapacity())
+                      || ( (MAXIMUM_NUMBER_OF_BYTES > 0) && !m_queue.isEmpty() && ((m_queue.getNumberOfBytes() + s.getLength()) > MAXIMUM_NUMBER_OF_BYTES) ) ) {
+                        // The timeout avoids missing a notification that was sent meanwhile.
+                        m_spaceCondition.waitOnSignalWithTimeout(1);
+                    }
+                    m_numberOfWaitingProducers--;
+                }
+
+                enqueued = m_queue.push(s);
+            }
+
+            m_numberOfEnqueuedPackets++;
+
+            // Update the high water mark.
+            const uint32_t SIZE = m_queue.getSize();
+            uint32_t highWaterMark = m_highWaterMark.load();
+            while ( (SIZE > highWaterMark) && !m_highWaterMark.compare_exchange_weak(highWaterMark, SIZE) ) {}
+
+            return true;
+        }
+
+        void PacketPipeline::wakeConsumer() {
+            // Pairs with the fence in run(): Either the distributing thread
+            // sees the new packet or we see that it is waiting.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_consumerWaiting.load()) {
+                Lock l(m_queueCondition);
+                m_queueCondition.wakeAll();
+            }
+        }
+
+        void PacketPipeline::processQueue() {
+            vector<SharedPacket> entries;
+            entries.reserve(MAX_BATCH_SIZE);
+
+            while (m_queue.pop(entries, MAX_BATCH_SIZE) > 0) {
+                // Allow blocked producers to continue while distributing the entries.
+                if (m_numberOfWaitingProducers.load() > 0) {
+                    Lock l(m_spaceCondition);
+                    m_spaceCondition.wakeAll();
                 }
 
                 // Read all entries and distribute using the packetListener.
                 {
                     Lock l(m_packetListenerMutex);
                     if (m_packetListener != NULL) {
-                        // Distribute entry to connected listeners while NOT locking the queue.
-                        m_packetListener->nextPacket(entry);
+                        for (vector<SharedPacket>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+                            // Distribute entry to connected listeners while NOT locking the queue.
+                            m_packetListener->nextSharedPacket(*it);
+                        }
                     }
                 }
+
+                entries.clear();
             }
         }
 
         void PacketPipeline::beforeStop() {
             // Wake awaiting threads.
-            Lock l(m_queueCondition);
-            m_queueCondition.wakeAll();
+            {
+                Lock l(m_queueCondition);
+                m_queueCondition.wakeAll();
+            }
+            {
+                Lock l(m_spaceCondition);
+                m_spaceCondition.wakeAll();
+            }
         }
 
         void PacketPipeline::run() {
             serviceReady();
 
             while (isRunning()) {
-                Lock l(m_queueCondition);
-                m_queueCondition.waitOnSignal();
+                {
+                    Lock l(m_queueCondition);
+                    m_consumerWaiting.store(true);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (m_queue.isEmpty() && isRunning()) {
+                        m_queueCondition.waitOnSignal();
+                    }
+                    m_consumerWaiting.store(false);
+                }
 
                 if (isRunning()) {
                     processQueue();
@@ -0,0 +1,187 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <atomic>
+
+#include "opendavinci/odcore/io/PacketRing.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+
+        namespace {
+            enum {
+                CACHE_LINE_SIZE = 64,
+                MINIMUM_CAPACITY = 2
+            };
+        }
+
+        struct PacketRing::Cell {
+            Cell() :
+                m_sequence(0),
+                m_packet() {}
+
+            // Equals the position for a free slot and the position + 1 for a filled slot.
+            std::atomic<uint64_t> m_sequence;
+            SharedPacket m_packet;
+        };
+
+        struct PacketRing::Indices {
+            Indices() :
+                m_tail(0),
+                m_tailPadding(),
+                m_head(0),
+                m_headPadding(),
+                m_numberOfBytes(0) {}
+
+            // Producers and consumers modify separate cache lines.
+            std::atomic<uint64_t> m_tail;
+            char m_tailPadding[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+            std::atomic<uint64_t> m_head;
+            char m_headPadding[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+            std::atomic<uint64_t> m_numberOfBytes;
+        };
+
+        PacketRing::PacketRing(const uint32_t &capacity, const uint64_t &maximumNumberOfBytes) :
+            m_capacity(MINIMUM_CAPACITY),
+            m_mask(0),
+            m_maximumNumberOfBytes(maximumNumberOfBytes),
+            m_cells(NULL),
+            m_indices(NULL) {
+            // Doubling beyond MAXIMUM_CAPACITY would overflow for huge capacities.
+            while ( (m_capacity < capacity) && (m_capacity < MAXIMUM_CAPACITY) ) {
+                m_capacity *= 2;
+            }
+            m_mask = m_capacity - 1;
+
+            m_cells = new Cell[m_capacity];
+            for (uint32_t i = 0; i < m_capacity; i++) {
+                m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+            }
+            m_indices = new Indices();
+        }
+
+        PacketRing::~PacketRing() {
+            OPENDAVINCI_CORE_DELETE_ARRAY(m_cells);
+            OPENDAVINCI_CORE_DELETE_POINTER(m_indices);
+        }
+
+        bool PacketRing::push(const SharedPacket &p) {
+            // Reserve the bytes first; an empty ring accepts any packet.
+            const uint64_t LENGTH = p.getLength();
+            const uint64_t BYTES = m_indices->m_numberOfBytes.fetch_add(LENGTH, std::memory_order_relaxed) + LENGTH;
+            if ( (m_maximumNumberOfBytes > 0) && (BYTES > m_maximumNumberOfBytes) && (BYTES > LENGTH) ) {
+                m_indices->m_numberOfBytes.fetch_sub(LENGTH, std::memory_order_relaxed);
+                return false;
+            }
+
+            uint64_t position = m_indices->m_tail.load(std::memory_order_relaxed);
+            while (true) {
+                Cell &cell = m_cells[position & m_mask];
+                const uint64_t SEQUENCE = cell.m_sequence.load(std::memory_order_acquire);
+                const int64_t DIFFERENCE = static_cast<int64_t>(SEQUENCE) - static_cast<int64_t>(position);
+
+                if (DIFFERENCE == 0) {
+                    // The slot is free; claim it.
+                    if (m_indices->m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        cell.m_packet = p;
+                        cell.m_sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                    // position was updated by compare_exchange_weak.
+                }
+                else if (DIFFERENCE < 0) {
+                    // The slot was not yet consumed, i.e. the ring is full.
+                    m_indices->m_numberOfBytes.fetch_sub(LENGTH, std::memory_order_relaxed);
+                    return false;
+                }
+                else {
+                    // Another producer claimed the slot meanwhile.
+                    position = m_indices->m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool PacketRing::pop(SharedPacket &p) {
+            uint64_t position = m_indices->m_head.load(std::memory_order_relaxed);
+            while (true) {
+                Cell &cell = m_cells[position & m_mask];
+                const uint64_t SEQUENCE = cell.m_sequence.load(std::memory_order_acquire);
+                const int64_t DIFFERENCE = static_cast<int64_t>(SEQUENCE) - static_cast<int64_t>(position + 1);
+
+                if (DIFFERENCE == 0) {
+                    // The slot is filled; claim it.
+                    if (m_indices->m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        p = cell.m_packet;
+
+                        // Release the packet's buffer before freeing the slot for the next round.
+                        cell.m_packet = SharedPacket();
+                        cell.m_sequence.store(position + m_capacity, std::memory_order_release);
+                        m_indices->m_numberOfBytes.fetch_sub(p.getLength(), std::memory_order_relaxed);
+                        return true;
+                    }
+                    // position was updated by compare_exchange_weak.
+                }
+                else if (DIFFERENCE < 0) {
+                    // The slot was not yet filled, i.e. the ring is empty.
+                    return false;
+                }
+                else {
+                    // Another consumer claimed the slot meanwhile.
+                    position = m_indices->m_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        uint32_t PacketRing::pop(vector<SharedPacket> &packets, const uint32_t &maximum) {
+            uint32_t numberOfPackets = 0;
+            SharedPacket p;
+            while ( (numberOfPackets < maximum) && pop(p) ) {
+                packets.push_back(p);
+                numberOfPackets++;
+            }
+            return numberOfPackets;
+        }
+
+        uint32_t PacketRing::getSize() const {
+            const uint64_t HEAD = m_indices->m_head.load(std::memory_order_acquire);
+            const uint64_t TAIL = m_indices->m_tail.load(std::memory_order_acquire);
+            return (TAIL > HEAD) ? static_cast<uint32_t>(TAIL - HEAD) : 0;
+        }
+
+        bool PacketRing::isEmpty() const {
+            return (getSize() == 0);
+        }
+
+        uint32_t PacketRing::getCapacity() const {
+            return m_capacity;
+        }
+
+        uint64_t PacketRing::getNumberOfBytes() const {
+            return m_indices->m_numberOfBytes.load(std::memory_order_relaxed);
+        }
+
+        uint64_t PacketRing::getMaximumNumberOfBytes() const {
+            return m_maximumNumberOfBytes;
+        }
+
+    }
+} // odcore::io
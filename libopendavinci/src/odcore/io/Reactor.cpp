@@ -0,0 +1,43 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/io/Reactor.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+        using namespace odcore::base;
+
+        Mutex Reactor::m_numberOfThreadsMutex;
+        uint32_t Reactor::m_numberOfThreads = 0;
+
+        void Reactor::setNumberOfThreads(const uint32_t &numberOfThreads) {
+            Lock l(Reactor::m_numberOfThreadsMutex);
+            Reactor::m_numberOfThreads = numberOfThreads;
+        }
+
+        uint32_t Reactor::getNumberOfThreads() {
+            Lock l(Reactor::m_numberOfThreadsMutex);
+            return Reactor::m_numberOfThreads;
+        }
+
+    }
+} // odcore::io
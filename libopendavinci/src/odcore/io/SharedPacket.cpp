@@ -0,0 +1,177 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <cstring>
+#include <sstream>
+
+#include "opendavinci/odcore/io/SharedPacket.h"
+
+namespace odcore {
+    namespace io {
+
+        using namespace std;
+        using namespace odcore::data;
+
+        namespace {
+            /**
+             * This function parses an IPv4 address in dotted notation.
+             *
+             * @param address Address to parse.
+             * @param value Address in host byte order.
+             * @return true if the address could be parsed.
+             */
+            bool parseAddress(const string &address, uint32_t &value) {
+                uint32_t result = 0;
+                uint32_t octet = 0;
+                uint32_t digits = 0;
+                uint32_t octets = 0;
+                for (string::const_iterator it = address.begin(); it != address.end(); ++it) {
+                    if ( (*it >= '0') && (*it <= '9') && (digits < 3) ) {
+                        octet = octet * 10 + static_cast<uint32_t>(*it - '0');
+                        digits++;
+                    }
+                    else if ( (*it == '.') && (digits > 0) && (octets < 3) ) {
+                        if (octet > 255) {
+                            return false;
+                        }
+                        result = (result << 8) | octet;
+                        octet = 0;
+                        digits = 0;
+                        octets++;
+                    }
+                    else {
+                        return false;
+                    }
+                }
+                if ( (digits == 0) || (octets != 3) || (octet > 255) ) {
+                    return false;
+                }
+                value = (result << 8) | octet;
+                return true;
+            }
+        }
+
+        SharedPacket::SharedPacket() :
+            m_buffer(),
+            m_length(0),
+            m_sender(),
+            m_senderAddress(0),
+            m_senderPort(0),
+            m_received() {}
+
+        SharedPacket::SharedPacket(const std::shared_ptr<char> &buffer, const uint32_t &length,
+                                   const uint32_t &senderAddress, const uint16_t &senderPort,
+                                   const TimeStamp &received) :
+            m_buffer(buffer),
+            m_length(length),
+            m_sender(),
+            m_senderAddress(senderAddress),
+            m_senderPort(senderPort),
+            m_received(received) {}
+
+        SharedPacket::SharedPacket(const char *data, const uint32_t &length,
+                                   const uint32_t &senderAddress, const uint16_t &senderPort,
+                                   const TimeStamp &received) :
+            m_buffer(new char[length + 1], std::default_delete<char[]>()),
+            m_length(length),
+            m_sender(),
+            m_senderAddress(senderAddress),
+            m_senderPort(senderPort),
+            m_received(received) {
+            memcpy(m_buffer.get(), data, m_length);
+        }
+
+        SharedPacket::SharedPacket(const Packet &p) :
+            m_buffer(),
+            m_length(0),
+            m_sender(),
+            m_senderAddress(0),
+            m_senderPort(0),
+            m_received(p.getReceived()) {
+            if (!parseAddress(p.getSender(), m_senderAddress) || (m_senderAddress == 0)) {
+                m_sender = p.getSender();
+            }
+
+            const string &data = p.getData();
+            m_length = static_cast<uint32_t>(data.size());
+            m_buffer = std::shared_ptr<char>(new char[m_length + 1], std::default_delete<char[]>());
+            memcpy(m_buffer.get(), data.data(), m_length);
+        }
+
+        SharedPacket::SharedPacket(const SharedPacket &obj) :
+            m_buffer(obj.m_buffer),
+            m_length(obj.m_length),
+            m_sender(obj.m_sender),
+            m_senderAddress(obj.m_senderAddress),
+            m_senderPort(obj.m_senderPort),
+            m_received(obj.m_received) {}
+
+        SharedPacket::~SharedPacket() {}
+
+        SharedPacket& SharedPacket::operator=(const SharedPacket &obj) {
+            m_buffer = obj.m_buffer;
+            m_length = obj.m_length;
+            m_sender = obj.m_sender;
+            m_senderAddress = obj.m_senderAddress;
+            m_senderPort = obj.m_senderPort;
+            m_received = obj.m_received;
+
+            return (*this);
+        }
+
+        const char* SharedPacket::getData() const {
+            return m_buffer.get();
+        }
+
+        uint32_t SharedPacket::getLength() const {
+            return m_length;
+        }
+
+        const string SharedPacket::getSender() const {
+            if (!m_sender.empty() || ((m_senderAddress == 0) && (m_senderPort == 0))) {
+                return m_sender;
+            }
+
+            stringstream sstr;
+            sstr << ((m_senderAddress >> 24) & 0xFF) << "."
+                 << ((m_senderAddress >> 16) & 0xFF) << "."
+                 << ((m_senderAddress >> 8) & 0xFF) << "."
+                 << (m_senderAddress & 0xFF);
+            return sstr.str();
+        }
+
+        uint32_t SharedPacket::getSenderAddress() const {
+            return m_senderAddress;
+        }
+
+        uint16_t SharedPacket::getSenderPort() const {
+            return m_senderPort;
+        }
+
+        const TimeStamp SharedPacket::getReceived() const {
+            return m_received;
+        }
+
+        Packet SharedPacket::toPacket() const {
+            return Packet(getSender(), (m_length > 0) ? string(m_buffer.get(), m_length) : string(), m_received);
+        }
+
+    }
+} // odcore::io
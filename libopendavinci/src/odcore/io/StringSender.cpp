@@ -24,5 +24,20 @@ namespace odcore {
 
         StringSender::~StringSender() {}
 
+        void StringSender::sendBuffers(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers) {
+            uint32_t length = 0;
+            for (uint32_t i = 0; i < numberOfBuffers; i++) {
+                length += lengths[i];
+            }
+
+            string data;
+            data.reserve(length);
+            for (uint32_t i = 0; i < numberOfBuffers; i++) {
+                data.append(buffers[i], lengths[i]);
+            }
+
+            send(data);
+        }
+
     }
 }
@@ -18,11 +18,11 @@
  */
 
 #include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
 
-namespace odcore { namespace data { class Container; } }
-
 namespace odcore {
     namespace io {
         namespace conference {
@@ -35,7 +35,11 @@ namespace odcore {
                 m_containerListenerMutex(),
                 m_containerListener(NULL),
                 m_senderStampMutex(),
-                m_senderStamp(0) {}
+                m_senderStamp(0),
+                m_subscriptionsMutex(),
+                m_subscribedToAll(false),
+                m_subscriptions(),
+                m_droppedContainers() {}
 
             ContainerConference::~ContainerConference() {}
 
@@ -49,6 +53,53 @@ namespace odcore {
                 return m_containerListener;
             }
 
+            void ContainerConference::send(Container &&container) const {
+                send(container);
+            }
+
+            void ContainerConference::sendBatch(vector<Container> &containers) const {
+                for (vector<Container>::iterator it = containers.begin(); it != containers.end(); ++it) {
+                    send(*it);
+                }
+            }
+
+            void ContainerConference::setSendCoalescingDeadline(const uint32_t &/*flushDeadline*/) {}
+
+            void ContainerConference::subscribe(const int32_t &dataType) {
+                Lock l(m_subscriptionsMutex);
+                m_subscriptions.insert(dataType);
+            }
+
+            void ContainerConference::subscribeAll() {
+                Lock l(m_subscriptionsMutex);
+                m_subscribedToAll = true;
+            }
+
+            void ContainerConference::setSubscriptions(const set<int32_t> &dataTypes) {
+                Lock l(m_subscriptionsMutex);
+                m_subscribedToAll = false;
+                m_subscriptions = dataTypes;
+            }
+
+            bool ContainerConference::isSubscribed(const int32_t &dataType) const {
+                Lock l(m_subscriptionsMutex);
+                return (m_subscribedToAll || m_subscriptions.empty() || (m_subscriptions.count(dataType) > 0));
+            }
+
+            map<int32_t, uint64_t> ContainerConference::getNumberOfDroppedContainers() const {
+                Lock l(m_subscriptionsMutex);
+                return m_droppedContainers;
+            }
+
+            bool ContainerConference::accept(const int32_t &dataType) {
+                Lock l(m_subscriptionsMutex);
+                if (m_subscribedToAll || m_subscriptions.empty() || (m_subscriptions.count(dataType) > 0)) {
+                    return true;
+                }
+                m_droppedContainers[dataType]++;
+                return false;
+            }
+
             void ContainerConference::setSenderStamp(const uint32_t &senderStamp) {
                 Lock l(m_senderStampMutex);
                 m_senderStamp = senderStamp;
@@ -59,6 +110,22 @@ namespace odcore {
                 return m_senderStamp;
             }
 
+            void ContainerConference::stamp(Container &container) const {
+                // Set sending time stamp.
+                container.setSentTimeStamp(TimeStamp());
+
+                // If sample time stamp is unset, use sent time stamp.
+                if (container.getSampleTimeStamp().toMicroseconds() == 0) {
+                    container.setSampleTimeStamp(container.getSentTimeStamp());
+                }
+
+                // If the container's senderStamp field is unset, set it
+                // to this conference's senderStamp.
+                if (container.getSenderStamp() == 0) {
+                    container.setSenderStamp(getSenderStamp());
+                }
+            }
+
             bool ContainerConference::hasContainerListener() const {
                 bool hasListener = false;
                 {
@@ -19,7 +19,12 @@
 
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
+#include <sstream>
+
 #include "opendavinci/odcore/io/conference/ContainerConferenceFactory.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerConference.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerHub.h"
+#include "opendavinci/odcore/io/conference/SharedMemoryContainerConference.h"
 #include "opendavinci/odcore/io/conference/UDPMultiCastContainerConference.h"
 
 namespace odcore {
@@ -33,7 +38,14 @@ namespace odcore {
             Mutex ContainerConferenceFactory::m_singletonMutex;
             ContainerConferenceFactory* ContainerConferenceFactory::m_singleton = NULL;
 
-            ContainerConferenceFactory::ContainerConferenceFactory() {}
+            ContainerConferenceFactory::ContainerConferenceFactory() :
+                m_sharedMemoryAddressesMutex(),
+                m_sharedMemoryAddresses(),
+                m_inProcessMutex(),
+                m_inProcessAddresses(),
+                m_inProcessHubs(),
+                m_topicPartitioningMutex(),
+                m_topicPartitioning() {}
 
             ContainerConferenceFactory::~ContainerConferenceFactory() {
                 setSingleton(NULL);
@@ -55,7 +67,83 @@ namespace odcore {
             }
 
             std::shared_ptr<ContainerConference> ContainerConferenceFactory::getContainerConference(const string &address, const uint32_t &port) {
-                return std::shared_ptr<ContainerConference>(new UDPMultiCastContainerConference(address, port));
+                if (isInProcessEnabled(address)) {
+                    stringstream sstr;
+                    sstr << address << ":" << port;
+                    const string key = sstr.str();
+
+                    // All modules in this process share one hub per conference.
+                    Lock l(m_inProcessMutex);
+                    std::shared_ptr<InProcessContainerHub> hub = m_inProcessHubs[key].lock();
+                    if (hub.get() == NULL) {
+                        hub = std::shared_ptr<InProcessContainerHub>(new InProcessContainerHub(getNetworkConference(address, port)));
+                        m_inProcessHubs[key] = hub;
+                    }
+                    return std::shared_ptr<ContainerConference>(new InProcessContainerConference(hub));
+                }
+
+                return getNetworkConference(address, port);
+            }
+
+            std::shared_ptr<ContainerConference> ContainerConferenceFactory::getNetworkConference(const string &address, const uint32_t &port) {
+                if (isSharedMemoryEnabled(address)) {
+                    std::shared_ptr<SharedMemoryContainerConference> conference(new SharedMemoryContainerConference(address, port));
+                    if (conference->isValid()) {
+                        return conference;
+                    }
+                    // Fall back to UDP multicast without shared memory.
+                }
+
+                return std::shared_ptr<ContainerConference>(new UDPMultiCastContainerConference(address, port, getTopicPartitioning(address)));
+            }
+
+            void ContainerConferenceFactory::setSharedMemoryEnabled(const string &address, const bool &enabled) {
+                Lock l(m_sharedMemoryAddressesMutex);
+                if (enabled) {
+                    m_sharedMemoryAddresses.insert(address);
+                }
+                else {
+                    m_sharedMemoryAddresses.erase(address);
+                }
+            }
+
+            bool ContainerConferenceFactory::isSharedMemoryEnabled(const string &address) const {
+                Lock l(m_sharedMemoryAddressesMutex);
+                return (m_sharedMemoryAddresses.count(address) > 0);
+            }
+
+            void ContainerConferenceFactory::setInProcessEnabled(const string &address, const bool &enabled) {
+                Lock l(m_inProcessMutex);
+                if (enabled) {
+                    m_inProcessAddresses.insert(address);
+                }
+                else {
+                    m_inProcessAddresses.erase(address);
+                }
+            }
+
+            bool ContainerConferenceFactory::isInProcessEnabled(const string &address) const {
+                Lock l(m_inProcessMutex);
+                return (m_inProcessAddresses.count(address) > 0);
+            }
+
+            void ContainerConferenceFactory::setTopicPartitioning(const string &address, const TopicPartitioning &partitioning) {
+                Lock l(m_topicPartitioningMutex);
+                if (partitioning.isEnabled()) {
+                    m_topicPartitioning[address] = partitioning;
+                }
+                else {
+                    m_topicPartitioning.erase(address);
+                }
+            }
+
+            TopicPartitioning ContainerConferenceFactory::getTopicPartitioning(const string &address) const {
+                Lock l(m_topicPartitioningMutex);
+                map<string, TopicPartitioning>::const_iterator it = m_topicPartitioning.find(address);
+                if (it != m_topicPartitioning.end()) {
+                    return it->second;
+                }
+                return TopicPartitioning();
             }
 
         }
@@ -0,0 +1,131 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerConference.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerHub.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+            using namespace base;
+            using namespace data;
+
+            InProcessContainerConference::InProcessContainerConference(std::shared_ptr<InProcessContainerHub> hub) :
+                m_hub(hub),
+                m_queueCondition(),
+                m_queue(),
+                m_numberOfOverruns(0) {
+                // Start delivering before joining the hub.
+                start();
+                m_hub->add(this);
+            }
+
+            InProcessContainerConference::~InProcessContainerConference() {
+                // No more containers are handed to us after leaving the hub.
+                m_hub->remove(this);
+                stop();
+            }
+
+            void InProcessContainerConference::setContainerListener(ContainerListener *cl) {
+                ContainerConference::setContainerListener(cl);
+                m_hub->setListening(this, (cl != NULL));
+            }
+
+            std::shared_ptr<InProcessContainerHub> InProcessContainerConference::getHub() const {
+                return m_hub;
+            }
+
+            uint64_t InProcessContainerConference::getNumberOfOverruns() const {
+                Lock l(m_queueCondition);
+                return m_numberOfOverruns;
+            }
+
+            void InProcessContainerConference::send(Container &container) const {
+                stamp(container);
+                m_hub->send(container, this);
+            }
+
+            void InProcessContainerConference::send(Container &&container) const {
+                send(container);
+            }
+
+            void InProcessContainerConference::setSendCoalescingDeadline(const uint32_t &flushDeadline) {
+                m_hub->setSendCoalescingDeadline(flushDeadline);
+            }
+
+            void InProcessContainerConference::subscribe(const int32_t &dataType) {
+                ContainerConference::subscribe(dataType);
+                m_hub->subscribe(this, dataType);
+            }
+
+            void InProcessContainerConference::subscribeAll() {
+                ContainerConference::subscribeAll();
+                m_hub->subscribeAll(this);
+            }
+
+            void InProcessContainerConference::enqueue(const std::shared_ptr<const Container> &container) {
+                // The ContainerListener is not checked here as a slow one holds its
+                // mutex while receiving; containers without listener are discarded in run().
+                if (accept(container->getDataType())) {
+                    Lock l(m_queueCondition);
+                    if (m_queue.size() >= MAX_QUEUE_SIZE) {
+                        // Drop the oldest container for a slow ContainerListener.
+                        m_queue.pop_front();
+                        m_numberOfOverruns++;
+                    }
+                    m_queue.push_back(container);
+                    m_queueCondition.wakeAll();
+                }
+            }
+
+            void InProcessContainerConference::beforeStop() {
+                Lock l(m_queueCondition);
+                m_queueCondition.wakeAll();
+            }
+
+            void InProcessContainerConference::run() {
+                serviceReady();
+
+                deque<std::shared_ptr<const Container> > containers;
+                while (isRunning()) {
+                    {
+                        Lock l(m_queueCondition);
+                        while (m_queue.empty() && isRunning()) {
+                            m_queueCondition.waitOnSignal();
+                        }
+                        containers.swap(m_queue);
+                    }
+
+                    while (!containers.empty()) {
+                        // The copy shares the payload with the other participants.
+                        Container c(*containers.front());
+                        containers.pop_front();
+                        receive(c);
+                    }
+                }
+            }
+
+        }
+    }
+} // odcore::io::conference
@@ -0,0 +1,175 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <algorithm>
+
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/io/conference/ContainerConference.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerConference.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerHub.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+            using namespace base;
+            using namespace data;
+
+            InProcessContainerHub::InProcessContainerHub(std::shared_ptr<ContainerConference> network) :
+                m_network(network),
+                m_conferencesMutex(),
+                m_conferences(),
+                m_subscriptionsMutex(),
+                m_subscriptions(),
+                m_subscribedToAll(),
+                m_listening(),
+                m_networkSubscriptions() {
+                if (m_network.get() != NULL) {
+                    m_network->setContainerListener(this);
+                }
+            }
+
+            InProcessContainerHub::~InProcessContainerHub() {
+                if (m_network.get() != NULL) {
+                    m_network->setContainerListener(NULL);
+                }
+            }
+
+            void InProcessContainerHub::add(InProcessContainerConference *conference) {
+                {
+                    Lock l(m_conferencesMutex);
+                    m_conferences.push_back(conference);
+                }
+
+                // A new participant is considered once it subscribes or listens.
+                Lock l(m_subscriptionsMutex);
+                m_subscriptions[conference];
+            }
+
+            void InProcessContainerHub::remove(InProcessContainerConference *conference) {
+                {
+                    Lock l(m_conferencesMutex);
+                    m_conferences.erase(std::remove(m_conferences.begin(), m_conferences.end(), conference), m_conferences.end());
+                }
+
+                Lock l(m_subscriptionsMutex);
+                m_subscriptions.erase(conference);
+                m_subscribedToAll.erase(conference);
+                m_listening.erase(conference);
+                updateNetworkSubscriptions();
+            }
+
+            std::shared_ptr<ContainerConference> InProcessContainerHub::getNetworkConference() const {
+                return m_network;
+            }
+
+            void InProcessContainerHub::send(Container &container, const InProcessContainerConference *sender) {
+                distribute(container, sender);
+
+                if (m_network.get() != NULL) {
+                    m_network->send(container);
+                }
+            }
+
+            void InProcessContainerHub::setSendCoalescingDeadline(const uint32_t &flushDeadline) {
+                if (m_network.get() != NULL) {
+                    m_network->setSendCoalescingDeadline(flushDeadline);
+                }
+            }
+
+            void InProcessContainerHub::subscribe(const InProcessContainerConference *conference, const int32_t &dataType) {
+                Lock l(m_subscriptionsMutex);
+                m_subscriptions[conference].insert(dataType);
+                updateNetworkSubscriptions();
+            }
+
+            void InProcessContainerHub::subscribeAll(const InProcessContainerConference *conference) {
+                Lock l(m_subscriptionsMutex);
+                m_subscribedToAll.insert(conference);
+                updateNetworkSubscriptions();
+            }
+
+            void InProcessContainerHub::setListening(const InProcessContainerConference *conference, const bool &listening) {
+                Lock l(m_subscriptionsMutex);
+                if (listening) {
+                    m_listening.insert(conference);
+                }
+                else {
+                    m_listening.erase(conference);
+                }
+                updateNetworkSubscriptions();
+            }
+
+            void InProcessContainerHub::updateNetworkSubscriptions() {
+                if (m_network.get() == NULL) {
+                    return;
+                }
+
+                bool unfiltered = false;
+                set<int32_t> dataTypes;
+                map<const InProcessContainerConference*, set<int32_t> >::const_iterator it = m_subscriptions.begin();
+                while ( (it != m_subscriptions.end()) && !unfiltered ) {
+                    if (m_subscribedToAll.count(it->first) > 0) {
+                        unfiltered = true;
+                    }
+                    else if (it->second.empty()) {
+                        // Participants still in setUp() do not receive anything yet.
+                        unfiltered = (m_listening.count(it->first) > 0);
+                    }
+                    dataTypes.insert(it->second.begin(), it->second.end());
+                    ++it;
+                }
+
+                // An empty set lets the network conference receive all data types.
+                if (unfiltered) {
+                    dataTypes.clear();
+                }
+                if (dataTypes != m_networkSubscriptions) {
+                    m_network->setSubscriptions(dataTypes);
+                    m_networkSubscriptions = dataTypes;
+                }
+            }
+
+            void InProcessContainerHub::nextContainer(Container &c) {
+                // Containers from remote peers are handed to all local participants.
+                distribute(c, NULL);
+            }
+
+            void InProcessContainerHub::distribute(const Container &container, const InProcessContainerConference *sender) {
+                // All participants share the same container and its payload.
+                std::shared_ptr<Container> shared(new Container(container));
+                if (sender != NULL) {
+                    shared->setReceivedTimeStamp(TimeStamp());
+                }
+
+                Lock l(m_conferencesMutex);
+                for (vector<InProcessContainerConference*>::iterator it = m_conferences.begin(); it != m_conferences.end(); ++it) {
+                    if (*it != sender) {
+                        (*it)->enqueue(shared);
+                    }
+                }
+            }
+
+        }
+    }
+} // odcore::io::conference
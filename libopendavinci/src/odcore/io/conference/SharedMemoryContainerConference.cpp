@@ -0,0 +1,458 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <cstring>
+#include <iomanip>
+#include <iosfwd>
+#include <iostream>
+#include <sstream>
+
+#include "opendavinci/odcore/base/Condition.h"
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Thread.h"
+#include "opendavinci/odcore/base/module/AbstractCIDModule.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/ContainerHeaderView.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/exceptions/Exceptions.h"
+#include "opendavinci/odcore/io/conference/ContainerConferenceFactory.h"
+#include "opendavinci/odcore/io/conference/SharedMemoryContainerConference.h"
+#include "opendavinci/odcore/io/conference/UDPMultiCastContainerConference.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
+#include "opendavinci/odcore/serialization/SerializationFactory.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
+#include "opendavinci/odcore/wrapper/SharedMemory.h"
+#include "opendavinci/odcore/wrapper/SharedMemoryFactory.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+            using namespace base;
+            using namespace data;
+            using namespace exceptions;
+
+            namespace {
+                /**
+                 * This class serializes a container directly into the ring.
+                 */
+                class ContainerEntryWriter : public BroadcastRing::EntryWriter {
+                    private:
+                        ContainerEntryWriter(const ContainerEntryWriter &);
+                        ContainerEntryWriter& operator=(const ContainerEntryWriter &);
+
+                    public:
+                        ContainerEntryWriter(const Container &container) :
+                            m_container(container) {}
+
+                        virtual void write(char *buffer, const uint32_t &length) const {
+                            odcore::serialization::ByteWriter out(buffer, length);
+                            m_container.serializeTo(out);
+                        }
+
+                    private:
+                        const Container &m_container;
+                };
+
+                /**
+                 * This class copies already serialized data into the ring.
+                 */
+                class StringEntryWriter : public BroadcastRing::EntryWriter {
+                    private:
+                        StringEntryWriter(const StringEntryWriter &);
+                        StringEntryWriter& operator=(const StringEntryWriter &);
+
+                    public:
+                        StringEntryWriter(const string &data) :
+                            m_data(data) {}
+
+                        virtual void write(char *buffer, const uint32_t &length) const {
+                            memcpy(buffer, m_data.data(), length);
+                        }
+
+                    private:
+                        const string &m_data;
+                };
+            }
+
+            /**
+             * This class lets the creator of the ring signal regularly
+             * independently from distributing containers.
+             */
+            class SharedMemoryContainerConference::Heartbeat : public Service {
+                private:
+                    Heartbeat(const Heartbeat &);
+                    Heartbeat& operator=(const Heartbeat &);
+
+                public:
+                    Heartbeat(SharedMemoryContainerConference &conference) :
+                        m_conference(conference),
+                        m_condition() {}
+
+                    virtual ~Heartbeat() {}
+
+                protected:
+                    virtual void beforeStop() {
+                        Lock l(m_condition);
+                        m_condition.wakeAll();
+                    }
+
+                    virtual void run() {
+                        serviceReady();
+
+                        while (isRunning()) {
+                            m_conference.heartbeat();
+
+                            Lock l(m_condition);
+                            if (isRunning()) {
+                                m_condition.waitOnSignalWithTimeout(HEARTBEAT_INTERVAL);
+                            }
+                        }
+                    }
+
+                private:
+                    SharedMemoryContainerConference &m_conference;
+                    Condition m_condition;
+            };
+
+            SharedMemoryContainerConference::SharedMemoryContainerConference(const string &address, const uint32_t &port) :
+                m_address(address),
+                m_port(port),
+                m_name(getSharedMemoryName(address, port)),
+                m_ringMutex(),
+                m_sharedMemory(),
+                m_ring(),
+                m_creator(false),
+                m_origin(0),
+                m_cursor(0),
+                m_network(),
+                m_overrunsMutex(),
+                m_numberOfOverruns(0),
+                m_heartbeat() {
+                {
+                    Lock l(m_ringMutex);
+                    connect();
+                }
+
+                // Start reading from the ring.
+                start();
+
+                m_heartbeat = std::shared_ptr<Heartbeat>(new Heartbeat(*this));
+                m_heartbeat->start();
+            }
+
+            SharedMemoryContainerConference::~SharedMemoryContainerConference() {
+                m_heartbeat->stop();
+                stop();
+
+                // Stop bridging before the ring is closed.
+                std::shared_ptr<UDPMultiCastContainerConference> network;
+                {
+                    Lock l(m_ringMutex);
+                    network = m_network;
+                    m_network.reset();
+                }
+                if (network.get() != NULL) {
+                    network->setContainerListener(NULL);
+                    network.reset();
+                }
+
+                Lock l(m_ringMutex);
+                if ( m_creator && (m_ring.get() != NULL) ) {
+                    // Let the remaining participants reconnect.
+                    m_ring->close();
+                }
+                m_ring.reset();
+                m_sharedMemory.reset();
+            }
+
+            string SharedMemoryContainerConference::getSharedMemoryName(const string &address, const uint32_t &port) {
+                // Names of shared memory segments are short on some platforms; thus, use a hash (FNV-1a).
+                stringstream sstr;
+                sstr << address << ":" << port;
+                const string conference = sstr.str();
+
+                uint32_t hash = 2166136261u;
+                for (uint32_t i = 0; i < conference.size(); i++) {
+                    hash ^= static_cast<uint8_t>(conference.at(i));
+                    hash *= 16777619u;
+                }
+
+                stringstream name;
+                name << "odc" << hex << setw(8) << setfill('0') << hash;
+                return name.str();
+            }
+
+            bool SharedMemoryContainerConference::connect() {
+                // Release a ring that was closed by its creator.
+                m_ring.reset();
+                m_sharedMemory.reset();
+                m_creator = false;
+                m_origin = 0;
+
+                std::shared_ptr<odcore::wrapper::SharedMemory> memory;
+                std::shared_ptr<BroadcastRing> ring;
+                bool creator = false;
+                for (uint32_t attempt = 0; (attempt < CONNECT_ATTEMPTS) && (ring.get() == NULL); attempt++) {
+                    if (attempt > 0) {
+                        Thread::usleepFor(RETRY_INTERVAL);
+                    }
+
+                    // Try to join an existing ring first.
+                    memory = odcore::wrapper::SharedMemoryFactory::attachToSharedMemory(m_name);
+                    if ( (memory.get() != NULL) && memory->isValid() ) {
+                        ring = std::shared_ptr<BroadcastRing>(new BroadcastRing(memory->getSharedMemory(), memory->getSize()));
+                        if (!ring->attach(ATTACH_TIMEOUT)) {
+                            if (ring->hasBeenClosed()) {
+                                // Nobody uses a closed ring anymore; release its name for a new one.
+                                memory->remove();
+                            }
+                            ring.reset();
+                        }
+                    }
+
+                    // Only one of the participants that connect concurrently
+                    // creates the ring; the others attach to it next time.
+                    if (ring.get() == NULL) {
+                        memory = odcore::wrapper::SharedMemoryFactory::createSharedMemoryExclusively(m_name, BroadcastRing::getRequiredSize(NUMBER_OF_SLOTS, SLOT_SIZE));
+                        if ( (memory.get() != NULL) && memory->isValid() ) {
+                            ring = std::shared_ptr<BroadcastRing>(new BroadcastRing(memory->getSharedMemory(), memory->getSize()));
+                            creator = ring->create(NUMBER_OF_SLOTS, SLOT_SIZE);
+                            if (!creator) {
+                                ring.reset();
+                            }
+                        }
+                    }
+                }
+
+                if (ring.get() == NULL) {
+                    return false;
+                }
+
+                m_ring = ring;
+                m_sharedMemory = memory;
+                m_creator = creator;
+                m_origin = m_ring->registerParticipant();
+                m_cursor = m_ring->getWriteSequence();
+
+                if (m_creator) {
+                    // The creator relays between the ring and remote peers.
+                    try {
+                        m_network = std::shared_ptr<UDPMultiCastContainerConference>(new UDPMultiCastContainerConference(m_address, m_port, ContainerConferenceFactory::getInstance().getTopicPartitioning(m_address)));
+                        // The data types of interest to the other participants are unknown.
+                        m_network->subscribeAll();
+                        m_network->setContainerListener(this);
+                    }
+                    catch (ConferenceException &ce) {
+                        CLOG3 << "[core::io::conference::SharedMemoryContainerConference] Bridging to the network failed: " << ce.getMessage() << endl;
+                    }
+                }
+
+                return true;
+            }
+
+            void SharedMemoryContainerConference::heartbeat() {
+                Lock l(m_ringMutex);
+                if ( m_creator && (m_ring.get() != NULL) ) {
+                    m_ring->heartbeat();
+                }
+            }
+
+            bool SharedMemoryContainerConference::isValid() const {
+                Lock l(m_ringMutex);
+                return (m_ring.get() != NULL);
+            }
+
+            bool SharedMemoryContainerConference::isBridge() const {
+                Lock l(m_ringMutex);
+                return (m_network.get() != NULL);
+            }
+
+            uint64_t SharedMemoryContainerConference::getNumberOfOverruns() const {
+                Lock l(m_overrunsMutex);
+                return m_numberOfOverruns;
+            }
+
+            void SharedMemoryContainerConference::send(Container &container) const {
+                stamp(container);
+                write(container, 0);
+            }
+
+            void SharedMemoryContainerConference::send(Container &&container) const {
+                // The container is serialized directly; thus, no copy is required.
+                send(container);
+            }
+
+            void SharedMemoryContainerConference::nextContainer(Container &c) {
+                // Publish containers from remote peers to all local participants.
+                write(c, FROM_NETWORK);
+            }
+
+            void SharedMemoryContainerConference::write(const Container &container, const uint32_t &flags) const {
+                std::shared_ptr<odcore::wrapper::SharedMemory> memory;
+                std::shared_ptr<BroadcastRing> ring;
+                uint32_t origin = 0;
+                {
+                    Lock l(m_ringMutex);
+                    memory = m_sharedMemory;
+                    ring = m_ring;
+                    origin = m_origin;
+                }
+
+                if (ring.get() == NULL) {
+                    return;
+                }
+
+                bool written = false;
+                if (odcore::serialization::SerializationFactory::getInstance().usesDefaultSerialization()) {
+                    ContainerEntryWriter writer(container);
+                    written = ring->write(container.getSerializedSize(), origin, flags, writer);
+                }
+                else {
+                    stringstream stringstreamValue;
+                    stringstreamValue << container;
+                    const string data = stringstreamValue.str();
+                    StringEntryWriter writer(data);
+                    written = ring->write(data.size(), origin, flags, writer);
+                }
+
+                if (!written) {
+                    CLOG3 << "[core::io::conference::SharedMemoryContainerConference] Container could not be written." << endl;
+                }
+            }
+
+            void SharedMemoryContainerConference::beforeStop() {}
+
+            void SharedMemoryContainerConference::run() {
+                serviceReady();
+
+                std::shared_ptr<BroadcastRing> ring;
+                std::shared_ptr<odcore::wrapper::SharedMemory> memory;
+                std::shared_ptr<UDPMultiCastContainerConference> network;
+                uint64_t cursor = 0;
+                uint32_t origin = 0;
+
+                while (isRunning()) {
+                    std::shared_ptr<UDPMultiCastContainerConference> replacedNetwork;
+                    {
+                        Lock l(m_ringMutex);
+                        if ( (m_ring.get() != NULL) && !m_creator ) {
+                            m_ring->closeIfAbandoned(TimeStamp(), CREATOR_TIMEOUT);
+                        }
+                        if ( (m_ring.get() == NULL) || m_ring->isClosed() ) {
+                            // Join again after the creator left or after another
+                            // participant replaced the ring of this stalled creator.
+                            replacedNetwork = m_network;
+                            m_network.reset();
+
+                            // The closed ring must not be kept attached while connecting.
+                            ring.reset();
+                            memory.reset();
+                            connect();
+                        }
+                        if (ring != m_ring) {
+                            ring = m_ring;
+                            memory = m_sharedMemory;
+                            cursor = m_cursor;
+                        }
+                        origin = m_origin;
+                        network = m_network;
+                    }
+
+                    // Stop the replaced bridge outside of m_ringMutex as nextContainer acquires it.
+                    if (replacedNetwork.get() != NULL) {
+                        replacedNetwork->setContainerListener(NULL);
+                        replacedNetwork.reset();
+                    }
+
+                    if (ring.get() == NULL) {
+                        Thread::usleepFor(WAIT_TIMEOUT);
+                        continue;
+                    }
+
+                    distribute(*ring, cursor, origin, network);
+                }
+            }
+
+            void SharedMemoryContainerConference::distribute(BroadcastRing &ring, uint64_t &cursor, const uint32_t &origin, std::shared_ptr<UDPMultiCastContainerConference> network) {
+                BroadcastRing::Entry e;
+                const BroadcastRing::STATUS STATUS = ring.read(cursor, e);
+
+                if (BroadcastRing::AVAILABLE == STATUS) {
+                    // Containers sent by ourselves are not delivered to ourselves,
+                    // and containers from the network are not sent back.
+                    const bool IS_FROM_NETWORK = (FROM_NETWORK == (e.m_flags & FROM_NETWORK));
+                    const bool FORWARD = (network.get() != NULL) && !IS_FROM_NETWORK;
+                    bool deliver = ((e.m_origin != origin) || IS_FROM_NETWORK) && hasContainerListener();
+                    if (deliver) {
+                        // Drop containers of unsubscribed data types before decoding them.
+                        const ContainerHeaderView view(e.m_data, e.m_length);
+                        deliver = !view.isValid() || accept(view.getDataType());
+                    }
+
+                    Container container;
+                    if (deliver) {
+                        odcore::serialization::SpanStreamBuffer buffer(e.m_data, e.m_length);
+                        istream in(&buffer);
+                        in >> container;
+                    }
+
+                    string data;
+                    if (FORWARD) {
+                        data.assign(e.m_data, e.m_length);
+                    }
+
+                    // Discard the container if it was overwritten while reading.
+                    if (ring.release(cursor, e)) {
+                        // Containers in other formats can only be filtered after decoding.
+                        if (deliver && accept(container.getDataType())) {
+                            if (!IS_FROM_NETWORK) {
+                                container.setReceivedTimeStamp(TimeStamp());
+                            }
+                            receive(container);
+                        }
+
+                        if (FORWARD) {
+                            try {
+                                network->forward(data);
+                            }
+                            catch (string &s) {
+                                CLOG3 << "[core::io::conference::SharedMemoryContainerConference] Forwarding failed: " << s << endl;
+                            }
+                        }
+                    }
+                }
+                else if (BroadcastRing::OVERRUN == STATUS) {
+                    Lock l(m_overrunsMutex);
+                    m_numberOfOverruns++;
+                }
+                else if (BroadcastRing::EMPTY == STATUS) {
+                    ring.waitForData(cursor, WAIT_TIMEOUT);
+                }
+                else {
+                    // The ring was closed; reconnect in the next cycle.
+                    Thread::usleepFor(1000);
+                }
+            }
+
+        }
+    }
+} // odcore::io::conference
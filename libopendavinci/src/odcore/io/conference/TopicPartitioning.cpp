@@ -0,0 +1,137 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <sstream>
+
+#include "opendavinci/odcore/io/conference/TopicPartitioning.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+
+            TopicPartitioning::TopicPartitioning() :
+                m_ranges(),
+                m_highestConfiguredGroup(0),
+                m_numberOfHashedGroups(0) {}
+
+            TopicPartitioning::TopicPartitioning(const TopicPartitioning &obj) :
+                m_ranges(obj.m_ranges),
+                m_highestConfiguredGroup(obj.m_highestConfiguredGroup),
+                m_numberOfHashedGroups(obj.m_numberOfHashedGroups) {}
+
+            TopicPartitioning::~TopicPartitioning() {}
+
+            TopicPartitioning& TopicPartitioning::operator=(const TopicPartitioning &obj) {
+                m_ranges = obj.m_ranges;
+                m_highestConfiguredGroup = obj.m_highestConfiguredGroup;
+                m_numberOfHashedGroups = obj.m_numberOfHashedGroups;
+
+                return (*this);
+            }
+
+            bool TopicPartitioning::addRange(const int32_t &firstDataType, const int32_t &lastDataType, const uint32_t &group) {
+                if ( (firstDataType > lastDataType) || (group == 0) ) {
+                    return false;
+                }
+
+                // Remove overlapping ranges.
+                map<int32_t, pair<int32_t, uint32_t> >::iterator it = m_ranges.begin();
+                while (it != m_ranges.end()) {
+                    if ( (it->first <= lastDataType) && (it->second.first >= firstDataType) ) {
+                        m_ranges.erase(it++);
+                    }
+                    else {
+                        ++it;
+                    }
+                }
+                m_ranges[firstDataType] = make_pair(lastDataType, group);
+
+                m_highestConfiguredGroup = 0;
+                for (it = m_ranges.begin(); it != m_ranges.end(); ++it) {
+                    if (it->second.second > m_highestConfiguredGroup) {
+                        m_highestConfiguredGroup = it->second.second;
+                    }
+                }
+
+                return true;
+            }
+
+            void TopicPartitioning::setNumberOfHashedGroups(const uint32_t &numberOfHashedGroups) {
+                m_numberOfHashedGroups = numberOfHashedGroups;
+            }
+
+            bool TopicPartitioning::isEnabled() const {
+                return (getNumberOfGroups() > 0);
+            }
+
+            uint32_t TopicPartitioning::getGroup(const int32_t &dataType) const {
+                // Find the last range starting at or before the data type.
+                map<int32_t, pair<int32_t, uint32_t> >::const_iterator it = m_ranges.upper_bound(dataType);
+                if (it != m_ranges.begin()) {
+                    --it;
+                    if (dataType <= it->second.first) {
+                        return it->second.second;
+                    }
+                }
+
+                if (m_numberOfHashedGroups > 0) {
+                    return m_highestConfiguredGroup + 1 + (static_cast<uint32_t>(dataType) % m_numberOfHashedGroups);
+                }
+
+                return 0;
+            }
+
+            uint32_t TopicPartitioning::getNumberOfGroups() const {
+                return m_highestConfiguredGroup + m_numberOfHashedGroups;
+            }
+
+            string TopicPartitioning::getAddress(const string &address, const uint32_t &group) {
+                // Parse the dotted decimal notation.
+                stringstream sstr(address);
+                uint64_t value = 0;
+                for (uint32_t i = 0; i < 4; i++) {
+                    uint32_t octet = 0;
+                    char separator = '.';
+                    if (i > 0) {
+                        sstr >> separator;
+                    }
+                    sstr >> octet;
+                    if (sstr.fail() || (separator != '.') || (octet > 255)) {
+                        return "";
+                    }
+                    value = (value << 8) | octet;
+                }
+
+                // Groups are placed in the second octet to not collide with the
+                // conferences of other CIDs, which differ in the last octet.
+                if ((((value >> 16) & 0xFF) + group) > 0xFF) {
+                    return "";
+                }
+                value += static_cast<uint64_t>(group) << 16;
+
+                stringstream result;
+                result << ((value >> 24) & 0xFF) << "." << ((value >> 16) & 0xFF) << "." << ((value >> 8) & 0xFF) << "." << (value & 0xFF);
+                return result.str();
+            }
+
+        }
+    }
+} // odcore::io::conference
@@ -18,10 +18,17 @@
  */
 
 #include <iosfwd>
+#include <iostream>
 #include <sstream>
 
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/module/AbstractCIDModule.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
 #include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odcore/serialization/SerializationFactory.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/ContainerHeaderView.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/io/conference/UDPMultiCastContainerConference.h"
 #include "opendavinci/odcore/io/udp/UDPFactory.h"
@@ -36,9 +43,27 @@ namespace odcore {
             using namespace data;
             using namespace exceptions;
 
-            UDPMultiCastContainerConference::UDPMultiCastContainerConference(const string &address, const uint32_t &port) throw (ConferenceException) :
+            UDPMultiCastContainerConference::UDPMultiCastContainerConference(const string &address, const uint32_t &port, const TopicPartitioning &partitioning) throw (ConferenceException) :
+                m_address(address),
+                m_port(port),
+                m_partitioning(partitioning),
                 m_sender(NULL),
-                m_receiver(NULL) {
+                m_receiver(NULL),
+                m_sendBufferMutex(),
+                m_sendBuffer(),
+                m_coalescingSender(),
+                m_nextMessageId(0),
+                m_flushDeadline(0),
+                m_groupSenders(),
+                m_groupCoalescingSenders(),
+                m_groupReceiversMutex(),
+                m_groupReceivers(),
+                m_reassembler(MAX_PENDING_FRAGMENT_BYTES, FRAGMENT_TIMEOUT, MAX_FRAGMENTS_PER_CONTAINER, MAX_PENDING_CONTAINERS) {
+                if ( m_partitioning.isEnabled()
+                  && (TopicPartitioning::getAddress(address, m_partitioning.getNumberOfGroups()) == "") ) {
+                    OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, "Invalid address for partitioned multicast groups.");
+                }
+
                 try {
                     m_sender = odcore::io::udp::UDPFactory::createUDPSender(address, port);
                 }
@@ -50,6 +75,8 @@ namespace odcore {
                     m_receiver = odcore::io::udp::UDPFactory::createUDPReceiver(address, port);
                     // Disable circular receiving of data sent by ourselves.
                     m_receiver->setSenderPortToIgnore(m_sender->getPort());
+                    // Receive several datagrams per system call if supported.
+                    m_receiver->setReceiveBatchSize(RECEIVE_BATCH_SIZE);
                 }
                 catch (string &s) {
                     OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, s);
@@ -63,50 +90,334 @@ namespace odcore {
             }
 
             UDPMultiCastContainerConference::~UDPMultiCastContainerConference() {
+                // Send any pending containers.
+                setSendCoalescingDeadline(0);
+
                 // Stop receiving.
                 m_receiver->stop();
 
                 // Unregister ourselves.
                 m_receiver->setStringListener(NULL);
+
+                Lock l(m_groupReceiversMutex);
+                map<uint32_t, std::shared_ptr<odcore::io::udp::UDPReceiver> >::iterator it = m_groupReceivers.begin();
+                while (it != m_groupReceivers.end()) {
+                    it->second->stop();
+                    it->second->setPacketListener(NULL);
+                    ++it;
+                }
+                m_groupReceivers.clear();
+            }
+
+            void UDPMultiCastContainerConference::subscribe(const int32_t &dataType) {
+                ContainerConference::subscribe(dataType);
+
+                if (m_partitioning.isEnabled()) {
+                    join(m_partitioning.getGroup(dataType));
+                }
+            }
+
+            void UDPMultiCastContainerConference::subscribeAll() {
+                ContainerConference::subscribeAll();
+
+                for (uint32_t group = 1; group <= m_partitioning.getNumberOfGroups(); group++) {
+                    join(group);
+                }
+            }
+
+            void UDPMultiCastContainerConference::setSubscriptions(const set<int32_t> &dataTypes) {
+                ContainerConference::setSubscriptions(dataTypes);
+
+                if (dataTypes.empty()) {
+                    for (uint32_t group = 1; group <= m_partitioning.getNumberOfGroups(); group++) {
+                        join(group);
+                    }
+                }
+                else if (m_partitioning.isEnabled()) {
+                    for (set<int32_t>::const_iterator it = dataTypes.begin(); it != dataTypes.end(); ++it) {
+                        join(m_partitioning.getGroup(*it));
+                    }
+                }
+            }
+
+            void UDPMultiCastContainerConference::join(const uint32_t &group) {
+                // Group 0 is always joined.
+                if (group == 0) {
+                    return;
+                }
+
+                Lock l(m_groupReceiversMutex);
+                if (m_groupReceivers.count(group) > 0) {
+                    return;
+                }
+
+                try {
+                    // Our own sender for this group needs to be known to ignore its data.
+                    std::shared_ptr<odcore::io::udp::UDPSender> sender;
+                    std::shared_ptr<odcore::io::udp::CoalescingUDPSender> coalescingSender;
+                    {
+                        Lock l2(m_sendBufferMutex);
+                        getSenders(group, sender, coalescingSender);
+                    }
+
+                    std::shared_ptr<odcore::io::udp::UDPReceiver> receiver = odcore::io::udp::UDPFactory::createUDPReceiver(TopicPartitioning::getAddress(m_address, group), m_port);
+                    receiver->setSenderPortToIgnore(sender->getPort());
+                    receiver->setReceiveBatchSize(RECEIVE_BATCH_SIZE);
+                    receiver->setPacketListener(this);
+                    receiver->start();
+
+                    m_groupReceivers[group] = receiver;
+                }
+                catch (string &s) {
+                    CLOG3 << "[core::io::conference::UDPMultiCastContainerConference] Joining multicast group " << group << " failed: " << s << endl;
+                }
+            }
+
+            uint32_t UDPMultiCastContainerConference::getGroup(const string &data) const {
+                if (!m_partitioning.isEnabled()) {
+                    return 0;
+                }
+
+                // Containers in other formats than the default one remain on group 0.
+                const ContainerHeaderView view(data.data(), static_cast<uint32_t>(data.size()));
+                return view.isValid() ? m_partitioning.getGroup(view.getDataType()) : 0;
+            }
+
+            void UDPMultiCastContainerConference::getSenders(const uint32_t &group, std::shared_ptr<odcore::io::udp::UDPSender> &sender, std::shared_ptr<odcore::io::udp::CoalescingUDPSender> &coalescingSender) const {
+                if (group == 0) {
+                    sender = m_sender;
+                    coalescingSender = m_coalescingSender;
+                    return;
+                }
+
+                sender = m_groupSenders[group];
+                if (sender.get() == NULL) {
+                    sender = odcore::io::udp::UDPFactory::createUDPSender(TopicPartitioning::getAddress(m_address, group), m_port);
+                    m_groupSenders[group] = sender;
+                }
+
+                coalescingSender.reset();
+                if (m_flushDeadline > 0) {
+                    coalescingSender = m_groupCoalescingSenders[group];
+                    if (coalescingSender.get() == NULL) {
+                        coalescingSender = std::shared_ptr<odcore::io::udp::CoalescingUDPSender>(new odcore::io::udp::CoalescingUDPSender(sender, m_flushDeadline, COALESCED_DATAGRAM_SIZE));
+                        coalescingSender->start();
+                        m_groupCoalescingSenders[group] = coalescingSender;
+                    }
+                }
             }
 
             void UDPMultiCastContainerConference::nextPacket(const Packet &p) {
+                nextSharedPacket(odcore::io::SharedPacket(p));
+            }
+
+            void UDPMultiCastContainerConference::nextSharedPacket(const odcore::io::SharedPacket &p) {
                 if (hasContainerListener()) {
-                    Container container;
+                    // The containers are decoded directly from the receive buffer.
+                    if (odcore::io::udp::FragmentReassembler::isFragment(p.getData(), p.getLength())) {
+                        // Distribute the container once all fragments are received.
+                        string message;
+                        if (m_reassembler.add(p.getSenderAddress(), p.getSenderPort(), p.getData(), p.getLength(), TimeStamp(), message)) {
+                            receiveContainers(message.data(), static_cast<uint32_t>(message.size()), p.getReceived());
+                        }
+                    }
+                    else {
+                        receiveContainers(p.getData(), p.getLength(), p.getReceived());
+                    }
+                }
+            }
+
+            void UDPMultiCastContainerConference::nextSharedPackets(const vector<odcore::io::SharedPacket> &packets) {
+                for (vector<odcore::io::SharedPacket>::const_iterator it = packets.begin(); it != packets.end(); ++it) {
+                    nextSharedPacket(*it);
+                }
+            }
+
+            void UDPMultiCastContainerConference::receiveContainers(const char *data, const uint32_t &length, const TimeStamp &received) {
+                // A datagram might contain several coalesced containers.
+                uint32_t offset = 0;
+                while (offset < length) {
+                    const uint32_t REMAINING = length - offset;
+                    const ContainerHeaderView view(data + offset, REMAINING);
+                    const uint32_t LENGTH = view.isValid() ? view.getSize() : REMAINING;
+
+                    // Drop containers of unsubscribed data types before decoding them.
+                    if (view.isValid() && !accept(view.getDataType())) {
+                        offset += LENGTH;
+                        continue;
+                    }
 
-                    stringstream stringstreamData(p.getData());
-                    stringstreamData >> container;
+                    Container container;
+                    odcore::serialization::SpanStreamBuffer buffer(data + offset, LENGTH);
+                    istream in(&buffer);
+                    in >> container;
 
                     // Set received time stamp based on information from packet.
-                    container.setReceivedTimeStamp(TimeStamp(p.getReceived()));
+                    container.setReceivedTimeStamp(received);
+
+                    // Use superclass to distribute any received containers;
+                    // containers in other formats can only be filtered now.
+                    if (view.isValid() || accept(container.getDataType())) {
+                        receive(container);
+                    }
 
-                    // Use superclass to distribute any received containers.
-                    receive(container);
+                    offset += LENGTH;
                 }
             }
 
+            uint64_t UDPMultiCastContainerConference::getNumberOfDroppedFragments() const {
+                return m_reassembler.getNumberOfDroppedFragments();
+            }
+
+            bool UDPMultiCastContainerConference::appendDatagrams(const string &data, vector<string> &datagrams) const {
+                if (data.size() <= MAX_DATAGRAM_SIZE) {
+                    datagrams.push_back(data);
+                    return true;
+                }
+
+                // The sender's port identifies this conference at the receivers.
+                vector<string> fragments;
+                if ( !odcore::io::udp::FragmentReassembler::fragment(data, m_sender->getPort(), m_nextMessageId++, MAX_DATAGRAM_SIZE, fragments)
+                  || (fragments.size() > MAX_FRAGMENTS_PER_CONTAINER) ) {
+                    // Only this container is dropped; other containers of a batch are still sent.
+                    CLOG3 << "[core::io::conference::UDPMultiCastContainerConference] Container is too large to be sent (" << data.size() << " bytes)." << endl;
+                    return false;
+                }
+                datagrams.insert(datagrams.end(), fragments.begin(), fragments.end());
+                return true;
+            }
+
+            void UDPMultiCastContainerConference::sendFragments(const vector<string> &fragments, std::shared_ptr<odcore::io::udp::UDPSender> sender, std::shared_ptr<odcore::io::udp::CoalescingUDPSender> coalescingSender) const {
+                // Preserve the order of containers that are still pending.
+                if (coalescingSender.get() != NULL) {
+                    coalescingSender->flush();
+                }
+                sender->sendBatch(fragments);
+            }
+
+            void UDPMultiCastContainerConference::serialize(const Container &container, string &buffer) const {
+                if (!odcore::serialization::SerializationFactory::getInstance().usesDefaultSerialization()) {
+                    stringstream stringstreamValue;
+                    stringstreamValue << container;
+                    buffer = stringstreamValue.str();
+                    return;
+                }
+
+                // Serialize the container into the given buffer; its
+                // capacity only grows for containers larger than before.
+                buffer.resize(container.getSerializedSize());
+                odcore::serialization::ByteWriter out(&buffer[0], buffer.size());
+                container.serializeTo(out);
+            }
+
             void UDPMultiCastContainerConference::send(Container &container) const {
-                // Set sending time stamp.
-                container.setSentTimeStamp(TimeStamp());
+                stamp(container);
 
-                // If sample time stamp is unset, use sent time stamp.
-                if (container.getSampleTimeStamp().toMicroseconds() == 0) {
-                    container.setSampleTimeStamp(container.getSentTimeStamp());
+                Lock l(m_sendBufferMutex);
+                serialize(container, m_sendBuffer);
+                sendSerialized(m_sendBuffer);
+            }
+
+            void UDPMultiCastContainerConference::forward(const string &data) const {
+                Lock l(m_sendBufferMutex);
+                sendSerialized(data);
+            }
+
+            void UDPMultiCastContainerConference::sendSerialized(const string &data) const {
+                std::shared_ptr<odcore::io::udp::UDPSender> sender;
+                std::shared_ptr<odcore::io::udp::CoalescingUDPSender> coalescingSender;
+                getSenders(getGroup(data), sender, coalescingSender);
+
+                if (data.size() > MAX_DATAGRAM_SIZE) {
+                    // Send large containers in fragments.
+                    vector<string> fragments;
+                    if (appendDatagrams(data, fragments)) {
+                        sendFragments(fragments, sender, coalescingSender);
+                    }
+                    return;
+                }
+
+                // Containers in other formats than the default one cannot
+                // be split by the receiver; thus, they are sent directly.
+                if ( (coalescingSender.get() != NULL)
+                  && odcore::serialization::SerializationFactory::getInstance().usesDefaultSerialization() ) {
+                    coalescingSender->send(data);
+                }
+                else {
+                    // Send data.
+                    sender->send(data);
+                }
+            }
+
+            void UDPMultiCastContainerConference::send(Container &&container) const {
+                // The container is serialized directly; thus, no copy is required.
+                send(container);
+            }
+
+            void UDPMultiCastContainerConference::sendBatch(vector<Container> &containers) const {
+                Lock l(m_sendBufferMutex);
+
+                if (m_partitioning.isEnabled()) {
+                    // Containers of different data types are sent to different groups.
+                    for (uint32_t i = 0; i < containers.size(); i++) {
+                        stamp(containers[i]);
+                        serialize(containers[i], m_sendBuffer);
+                        sendSerialized(m_sendBuffer);
+                    }
+                    return;
                 }
 
-                // If the container's senderStamp field is unset, set it
-                // to this conference's senderStamp.
-                if (container.getSenderStamp() == 0) {
-                    container.setSenderStamp(getSenderStamp());
+                const bool COALESCE = (m_coalescingSender.get() != NULL)
+                                   && odcore::serialization::SerializationFactory::getInstance().usesDefaultSerialization();
+
+                vector<string> datagrams;
+                datagrams.reserve(containers.size());
+                for (uint32_t i = 0; i < containers.size(); i++) {
+                    stamp(containers[i]);
+                    serialize(containers[i], m_sendBuffer);
+
+                    if (COALESCE && (m_sendBuffer.size() > MAX_DATAGRAM_SIZE)) {
+                        // Fragments must not be coalesced with the following containers.
+                        vector<string> fragments;
+                        if (appendDatagrams(m_sendBuffer, fragments)) {
+                            m_coalescingSender->sendBatch(datagrams);
+                            datagrams.clear();
+                            sendFragments(fragments, m_sender, m_coalescingSender);
+                        }
+                    }
+                    else {
+                        appendDatagrams(m_sendBuffer, datagrams);
+                    }
                 }
 
-                stringstream stringstreamValue;
-                stringstreamValue << container;
+                if (COALESCE) {
+                    m_coalescingSender->sendBatch(datagrams);
+                }
+                else {
+                    m_sender->sendBatch(datagrams);
+                }
+            }
 
-                string stringValue = stringstreamValue.str();
+            void UDPMultiCastContainerConference::setSendCoalescingDeadline(const uint32_t &flushDeadline) {
+                Lock l(m_sendBufferMutex);
 
-                // Send data.
-                m_sender->send(stringValue);
+                // Stopping the current coalescing sender sends pending containers.
+                if (m_coalescingSender.get() != NULL) {
+                    m_coalescingSender->stop();
+                    m_coalescingSender.reset();
+                }
+                map<uint32_t, std::shared_ptr<odcore::io::udp::CoalescingUDPSender> >::iterator it = m_groupCoalescingSenders.begin();
+                while (it != m_groupCoalescingSenders.end()) {
+                    it->second->stop();
+                    ++it;
+                }
+                m_groupCoalescingSenders.clear();
+                m_flushDeadline = flushDeadline;
+
+                if (flushDeadline > 0) {
+                    m_coalescingSender = std::shared_ptr<odcore::io::udp::CoalescingUDPSender>(new odcore::io::udp::CoalescingUDPSender(m_sender, flushDeadline, COALESCED_DATAGRAM_SIZE));
+                    m_coalescingSender->start();
+                }
             }
 
         }
@@ -49,6 +49,15 @@ namespace odcore {
                 }
             }
 
+            void AbstractProtocol::sendByStringSender(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers) {
+                if (numberOfBuffers > 0) {
+                    Lock l(m_stringSenderMutex);
+                    if (m_stringSender != NULL) {
+                        m_stringSender->sendBuffers(buffers, lengths, numberOfBuffers);
+                    }
+                }
+            }
+
         }
     }
 }
@@ -17,7 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <cstdlib>
+#include <cstring>
 
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/io/StringListener.h"
@@ -34,7 +34,13 @@ namespace odcore {
                 m_stringListenerMutex(),
                 m_stringListener(NULL),
                 m_partialDataMutex(),
-                m_partialData() {}
+                m_partialData(INITIAL_BUFFER_SIZE),
+                m_begin(0),
+                m_end(0),
+                m_state(READING_LENGTH),
+                m_lengthOfPayload(0),
+                m_parsedBytes(0),
+                m_payload() {}
 
             NetstringsProtocol::~NetstringsProtocol() {
                 setStringListener(NULL);
@@ -47,85 +53,129 @@ namespace odcore {
 
             void NetstringsProtocol::send(const string& data) {
                 if (data.length() > 0) {
-                    stringstream netstring;
-
-                    netstring << static_cast<uint32_t>(data.length()) << ":" << data << ",";
-
-                    sendByStringSender(netstring.str());
+                    // Encode the size followed by ':'; a uint32_t has at most ten digits.
+                    char header[11];
+                    uint32_t position = sizeof(header);
+                    header[--position] = ':';
+                    uint32_t length = static_cast<uint32_t>(data.length());
+                    do {
+                        header[--position] = static_cast<char>('0' + (length % 10));
+                        length /= 10;
+                    } while (length > 0);
+
+                    // Send size, payload, and ',' without copying the payload.
+                    const char *buffers[] = { header + position, data.c_str(), "," };
+                    const uint32_t lengths[] = { static_cast<uint32_t>(sizeof(header) - position), static_cast<uint32_t>(data.length()), 1 };
+                    sendByStringSender(buffers, lengths, 3);
                 }
             }
 
             void NetstringsProtocol::nextString(const string &s) {
                 Lock l(m_partialDataMutex);
-                m_partialData.write(s.c_str(), s.length());
+                append(s.c_str(), static_cast<uint32_t>(s.length()));
                 decodeNetstring();
+            }
+
+            void NetstringsProtocol::append(const char *data, const uint32_t &length) {
+                if (length == 0) {
+                    return;
+                }
+
+                if (m_end + length > m_partialData.size()) {
+                    // Move the pending bytes to the beginning of the buffer.
+                    const uint32_t PENDING = m_end - m_begin;
+                    if (PENDING > 0) {
+                        memmove(&m_partialData[0], &m_partialData[m_begin], PENDING);
+                    }
+                    m_begin = 0;
+                    m_end = PENDING;
+
+                    // Enlarge the buffer if compacting is not sufficient.
+                    if (m_end + length > m_partialData.size()) {
+                        uint32_t size = static_cast<uint32_t>(m_partialData.size());
+                        while (m_end + length > size) {
+                            size *= 2;
+                        }
+                        m_partialData.resize(size);
+                    }
+                }
 
-                // After using str() to set the remaining string, the write pointer
-                // points to the beginning of the stream and further receivedString() calls
-                // would override existing data. So the write pointer has to point to the
-                // end of the stream.
-                m_partialData.seekp(0, ios_base::end);
+                memcpy(&m_partialData[m_end], data, length);
+                m_end += length;
+            }
+
+            void NetstringsProtocol::resetDecoder() {
+                m_begin = 0;
+                m_end = 0;
+                m_state = READING_LENGTH;
+                m_lengthOfPayload = 0;
+                m_parsedBytes = 0;
             }
 
             void NetstringsProtocol::decodeNetstring(void) {
                 // Netstrings have the following format:
                 // ASCII Number representing the length of the payload + ':' + payload + ','
-
-                bool checkForMoreNetstrings = true;
-                while (checkForMoreNetstrings) {
-                    m_partialData.seekg(0, ios_base::end);
-                    uint32_t lengthOfBuffer = m_partialData.tellg();
-                    m_partialData.seekg(0, ios_base::beg);
-
-                    if (lengthOfBuffer >= 3) {
-                        // On WIN32, the .str() returns a temporary object that is destroyed after the expression.
-                        // The reference keeps its existence instead.
-                        const string &m_partialDataString = m_partialData.str();
-                        const char *receiveBuffer = m_partialDataString.c_str();
-                        char *colonSign = NULL;
-                        uint32_t lengthOfPayload = strtol(receiveBuffer, &colonSign, 10);
-                        if (lengthOfPayload == 0) {
-                            // Remove empty Netstring: "0:," (size is 3).
-                            m_partialData.str(m_partialData.str().substr(3));
-                            checkForMoreNetstrings = true;
-                            continue; // Try to decode next Netstring if any.
+                //
+                // m_parsedBytes counts the bytes of the current Netstring that
+                // have already been processed, i.e. the length is not parsed again
+                // when further data arrives.
+
+                while (m_begin + m_parsedBytes < m_end) {
+                    if (READING_LENGTH == m_state) {
+                        const char c = m_partialData[m_begin + m_parsedBytes];
+                        if ( (c >= '0') && (c <= '9') ) {
+                            const uint32_t DIGIT = static_cast<uint32_t>(c - '0');
+                            if (m_lengthOfPayload > (0xFFFFFFFFu - DIGIT) / 10) {
+                                // The length does not fit into 32 bits; reset buffer.
+                                resetDecoder();
+                                return;
+                            }
+                            m_lengthOfPayload = m_lengthOfPayload * 10 + DIGIT;
+                            m_parsedBytes++;
                         }
-
-                        if (lengthOfPayload > lengthOfBuffer) {
+                        else if ( (':' == c) && (m_parsedBytes > 0) ) {
+                            m_parsedBytes++;
+                            m_state = READING_PAYLOAD;
+                        }
+                        else {
+                            // The received data seems to be corrupted; reset buffer.
+                            resetDecoder();
+                            return;
+                        }
+                    }
+                    else {
+                        // Size of the Netstring: "<lengthOfPayload> : <payload> ,"
+                        const uint64_t LENGTH_OF_NETSTRING = static_cast<uint64_t>(m_parsedBytes) + m_lengthOfPayload + 1;
+                        if (static_cast<uint64_t>(m_end - m_begin) < LENGTH_OF_NETSTRING) {
                             // Incomplete Netstring received. Wait for more data.
-                            checkForMoreNetstrings = false;
-                            continue;
+                            return;
                         }
 
-                        // Check for colon.
-                        if (*colonSign == ':') {
-                            // Found colon sign. Now, check if (receiveBuffer + 1 + lengthOfPayload) == ','.
-                            if ((colonSign[1 + lengthOfPayload]) == ',') {
-                                // Successfully found a complete Netstring.
-                                string receivedPayload = m_partialData.str().substr((colonSign + 1) - receiveBuffer, lengthOfPayload);
-
-                                invokeStringListener(receivedPayload);
-
-                                // Calculate size of decoded Netstring: "<lengthOfPayload> : <payload> ,"
-                                const uint32_t lengthOfNetstring = (colonSign + 1 + lengthOfPayload + 1) - receiveBuffer;
-
-                                // Remove the decoded Netstring from the buffer.
-                                m_partialData.str(m_partialData.str().substr(lengthOfNetstring));
+                        if (',' != m_partialData[m_begin + LENGTH_OF_NETSTRING - 1]) {
+                            // The received data seems to be corrupted; reset buffer.
+                            resetDecoder();
+                            return;
+                        }
 
-                                checkForMoreNetstrings = true;
-                                continue;
-                            }
+                        // Empty Netstrings ("0:,") are skipped.
+                        if (m_lengthOfPayload > 0) {
+                            m_payload.assign(&m_partialData[m_begin + m_parsedBytes], m_lengthOfPayload);
+                            invokeStringListener(m_payload);
                         }
 
-                        // We should never get here as the received data might be corrupted; reset buffer.
-                        m_partialData.str("");
-                        checkForMoreNetstrings = false;
-                    }
-                    else {
-                        // We need to wait for more data.
-                        checkForMoreNetstrings = false;
+                        // Remove the decoded Netstring from the buffer.
+                        m_begin += static_cast<uint32_t>(LENGTH_OF_NETSTRING);
+                        m_state = READING_LENGTH;
+                        m_lengthOfPayload = 0;
+                        m_parsedBytes = 0;
                     }
                 }
+
+                if (m_begin == m_end) {
+                    // Start from the beginning as all data has been consumed.
+                    m_begin = 0;
+                    m_end = 0;
+                }
             }
 
             void NetstringsProtocol::invokeStringListener(const string& data) {
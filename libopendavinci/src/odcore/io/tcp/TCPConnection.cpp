@@ -19,6 +19,7 @@
  */
 
 #include <iostream>
+#include <vector>
 
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/io/ConnectionListener.h"
@@ -70,14 +71,42 @@ namespace odcore {
             }
 
             void TCPConnection::send(const string& data) {
-                stringstream dataStream;
-                if (!isRaw()) {
-                    const uint32_t dataSize = htonl(data.length());
-                    dataStream.write(reinterpret_cast<const char*>(&dataSize), sizeof(uint32_t));
+                const char *buffers[] = { data.data() };
+                const uint32_t lengths[] = { static_cast<uint32_t>(data.length()) };
+                sendBuffers(buffers, lengths, 1);
+            }
+
+            void TCPConnection::sendBuffers(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers) {
+                if (isRaw()) {
+                    sendBuffersImplementation(buffers, lengths, numberOfBuffers);
+                    return;
                 }
-                dataStream << data;
 
-                sendImplementation(dataStream.str());
+                // Prepend the size information as separate buffer.
+                uint32_t length = 0;
+                for (uint32_t i = 0; i < numberOfBuffers; i++) {
+                    length += lengths[i];
+                }
+                const uint32_t dataSize = htonl(length);
+
+                vector<const char*> allBuffers(numberOfBuffers + 1);
+                vector<uint32_t> allLengths(numberOfBuffers + 1);
+                allBuffers[0] = reinterpret_cast<const char*>(&dataSize);
+                allLengths[0] = sizeof(uint32_t);
+                for (uint32_t i = 0; i < numberOfBuffers; i++) {
+                    allBuffers[i + 1] = buffers[i];
+                    allLengths[i + 1] = lengths[i];
+                }
+
+                sendBuffersImplementation(&allBuffers[0], &allLengths[0], numberOfBuffers + 1);
+            }
+
+            void TCPConnection::sendBuffersImplementation(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers) {
+                string data;
+                for (uint32_t i = 0; i < numberOfBuffers; i++) {
+                    data.append(buffers[i], lengths[i]);
+                }
+                sendImplementation(data);
             }
 
             void TCPConnection::setRaw(const bool &raw) {
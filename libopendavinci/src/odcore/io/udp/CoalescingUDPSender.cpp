@@ -0,0 +1,160 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Thread.h"
+#include "opendavinci/odcore/io/udp/CoalescingUDPSender.h"
+
+namespace odcore {
+    namespace io {
+        namespace udp {
+
+            using namespace std;
+            using namespace odcore::base;
+
+            CoalescingUDPSender::CoalescingUDPSender(std::shared_ptr<UDPSender> sender, const uint32_t &flushDeadline, const uint32_t &maxDatagramSize) :
+                Service(),
+                UDPSender(),
+                m_sender(sender),
+                m_flushDeadline(flushDeadline),
+                m_maxDatagramSize(maxDatagramSize),
+                m_pendingCondition(),
+                m_pendingMutex(),
+                m_sendMutex(),
+                m_currentDatagram(),
+                m_datagrams() {}
+
+            CoalescingUDPSender::~CoalescingUDPSender() {
+                // Stopping sends any pending payloads.
+                stop();
+            }
+
+            uint16_t CoalescingUDPSender::getPort() const {
+                return m_sender->getPort();
+            }
+
+            void CoalescingUDPSender::send(const string &data) const {
+                if (data.length() > m_maxDatagramSize) {
+                    // Preserve the order and send large payloads directly.
+                    Lock l(m_sendMutex);
+                    sendPending();
+                    m_sender->send(data);
+                    return;
+                }
+
+                if (append(data)) {
+                    wakeUp();
+                }
+            }
+
+            void CoalescingUDPSender::sendBatch(const vector<string> &data) const {
+                bool wasEmpty = false;
+                for (vector<string>::const_iterator it = data.begin(); it != data.end(); ++it) {
+                    if (it->length() > m_maxDatagramSize) {
+                        Lock l(m_sendMutex);
+                        sendPending();
+                        m_sender->send(*it);
+                    }
+                    else {
+                        wasEmpty |= append(*it);
+                    }
+                }
+
+                if (wasEmpty) {
+                    wakeUp();
+                }
+            }
+
+            bool CoalescingUDPSender::append(const string &data) const {
+                Lock l(m_pendingMutex);
+
+                const bool WAS_EMPTY = m_currentDatagram.empty() && m_datagrams.empty();
+
+                // Complete the current datagram if the payload does not fit.
+                if ( !m_currentDatagram.empty() && ((m_currentDatagram.length() + data.length()) > m_maxDatagramSize) ) {
+                    m_datagrams.push_back(string());
+                    m_datagrams.back().swap(m_currentDatagram);
+                }
+                m_currentDatagram.append(data);
+
+                return WAS_EMPTY;
+            }
+
+            void CoalescingUDPSender::wakeUp() const {
+                Lock l(m_pendingCondition);
+                m_pendingCondition.wakeAll();
+            }
+
+            void CoalescingUDPSender::flush() const {
+                Lock l(m_sendMutex);
+                sendPending();
+            }
+
+            void CoalescingUDPSender::sendPending() const {
+                vector<string> datagrams;
+                {
+                    Lock l(m_pendingMutex);
+                    if (!m_currentDatagram.empty()) {
+                        m_datagrams.push_back(string());
+                        m_datagrams.back().swap(m_currentDatagram);
+                    }
+                    datagrams.swap(m_datagrams);
+                }
+
+                if (!datagrams.empty()) {
+                    m_sender->sendBatch(datagrams);
+                }
+            }
+
+            void CoalescingUDPSender::beforeStop() {
+                // Wake awaiting threads.
+                wakeUp();
+            }
+
+            void CoalescingUDPSender::run() {
+                serviceReady();
+
+                while (isRunning()) {
+                    {
+                        Lock l(m_pendingCondition);
+                        bool hasPendingData = false;
+                        {
+                            Lock l2(m_pendingMutex);
+                            hasPendingData = !(m_currentDatagram.empty() && m_datagrams.empty());
+                        }
+                        if (!hasPendingData) {
+                            m_pendingCondition.waitOnSignal();
+                        }
+                    }
+
+                    // Collect further payloads until the deadline has passed.
+                    if (isRunning()) {
+                        Thread::usleepFor(m_flushDeadline);
+                    }
+                    flush();
+                }
+
+                // Send any remaining payloads before shutting down.
+                flush();
+            }
+
+        }
+    }
+} // odcore::io::udp
@@ -0,0 +1,291 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <cstring>
+
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/io/udp/FragmentReassembler.h"
+
+namespace odcore {
+    namespace io {
+        namespace udp {
+
+            using namespace std;
+            using namespace odcore::base;
+            using namespace odcore::data;
+
+            namespace {
+                const uint8_t MARKER_0 = 0x0D;
+                const uint8_t MARKER_1 = 0xA5;
+
+                void writeUInt32(string &out, const uint32_t &value) {
+                    const uint32_t v = htole32(value);
+                    out.append(reinterpret_cast<const char*>(&v), sizeof(uint32_t));
+                }
+
+                void writeUInt16(string &out, const uint16_t &value) {
+                    const uint16_t v = htole16(value);
+                    out.append(reinterpret_cast<const char*>(&v), sizeof(uint16_t));
+                }
+
+                uint32_t readUInt32(const char *data) {
+                    uint32_t value = 0;
+                    memcpy(&value, data, sizeof(uint32_t));
+                    return le32toh(value);
+                }
+
+                uint16_t readUInt16(const char *data) {
+                    uint16_t value = 0;
+                    memcpy(&value, data, sizeof(uint16_t));
+                    return le16toh(value);
+                }
+            }
+
+            FragmentReassembler::Key::Key() :
+                m_senderAddress(0),
+                m_senderPort(0),
+                m_origin(0),
+                m_messageId(0) {}
+
+            FragmentReassembler::Key::Key(const uint32_t &senderAddress, const uint16_t &senderPort, const uint32_t &origin, const uint32_t &messageId) :
+                m_senderAddress(senderAddress),
+                m_senderPort(senderPort),
+                m_origin(origin),
+                m_messageId(messageId) {}
+
+            bool FragmentReassembler::Key::operator<(const Key &other) const {
+                if (m_origin != other.m_origin) {
+                    return m_origin < other.m_origin;
+                }
+                if (m_messageId != other.m_messageId) {
+                    return m_messageId < other.m_messageId;
+                }
+                if (m_senderAddress != other.m_senderAddress) {
+                    return m_senderAddress < other.m_senderAddress;
+                }
+                return m_senderPort < other.m_senderPort;
+            }
+
+            FragmentReassembler::PendingMessage::PendingMessage() :
+                m_firstFragment(0),
+                m_numberOfReceivedFragments(0),
+                m_numberOfBytes(0),
+                m_received(),
+                m_fragments() {}
+
+            FragmentReassembler::FragmentReassembler(const uint32_t &maxPendingBytes, const uint32_t &timeout, const uint32_t &maxNumberOfFragments, const uint32_t &maxPendingMessages) :
+                m_maxPendingBytes(maxPendingBytes),
+                m_timeout(timeout),
+                m_maxNumberOfFragments(maxNumberOfFragments),
+                m_maxPendingMessages(maxPendingMessages),
+                m_mutex(),
+                m_pendingMessages(),
+                m_numberOfPendingBytes(0),
+                m_numberOfDroppedFragments(0),
+                m_numberOfEvictedMessages(0) {}
+
+            FragmentReassembler::~FragmentReassembler() {}
+
+            uint32_t FragmentReassembler::getOverhead(const uint32_t &numberOfFragments) {
+                return sizeof(Key) + sizeof(PendingMessage)
+                     + numberOfFragments * sizeof(string)
+                     + (numberOfFragments + 7) / 8;
+            }
+
+            bool FragmentReassembler::fragment(const string &data, const uint32_t &origin, const uint32_t &messageId, const uint32_t &maxDatagramSize, vector<string> &fragments) {
+                fragments.clear();
+                if (maxDatagramSize <= HEADER_SIZE) {
+                    return false;
+                }
+
+                const uint32_t PAYLOAD_SIZE = maxDatagramSize - HEADER_SIZE;
+                const uint64_t COUNT = (data.size() + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE;
+                if ( (COUNT == 0) || (COUNT > MAX_NUMBER_OF_FRAGMENTS) ) {
+                    return false;
+                }
+
+                fragments.resize(COUNT);
+                for (uint32_t i = 0; i < COUNT; i++) {
+                    const uint32_t OFFSET = i * PAYLOAD_SIZE;
+                    const uint32_t LENGTH = min(PAYLOAD_SIZE, static_cast<uint32_t>(data.size()) - OFFSET);
+
+                    string &f = fragments[i];
+                    f.reserve(HEADER_SIZE + LENGTH);
+                    f.push_back(static_cast<char>(MARKER_0));
+                    f.push_back(static_cast<char>(MARKER_1));
+                    writeUInt32(f, origin);
+                    writeUInt32(f, messageId);
+                    writeUInt16(f, static_cast<uint16_t>(i));
+                    writeUInt16(f, static_cast<uint16_t>(COUNT));
+                    f.append(data, OFFSET, LENGTH);
+                }
+
+                return true;
+            }
+
+            bool FragmentReassembler::isFragment(const char *data, const uint32_t &length) {
+                return (data != NULL) && (length >= HEADER_SIZE)
+                    && (MARKER_0 == static_cast<uint8_t>(data[0]))
+                    && (MARKER_1 == static_cast<uint8_t>(data[1]));
+            }
+
+            bool FragmentReassembler::add(const uint32_t &senderAddress, const uint16_t &senderPort, const char *data, const uint32_t &length, const TimeStamp &now, string &message) {
+                Lock l(m_mutex);
+
+                const int64_t NOW = now.toMicroseconds();
+                evictExpired(NOW);
+
+                if (!isFragment(data, length)) {
+                    m_numberOfDroppedFragments++;
+                    return false;
+                }
+
+                const uint32_t ORIGIN = readUInt32(data + 2);
+                const uint32_t MESSAGE_ID = readUInt32(data + 6);
+                const uint16_t INDEX = readUInt16(data + 10);
+                const uint16_t COUNT = readUInt16(data + 12);
+                const uint32_t PAYLOAD_LENGTH = length - HEADER_SIZE;
+
+                // Empty fragments are never sent and would complete a message without its data.
+                if ( (COUNT == 0) || (COUNT > m_maxNumberOfFragments) || (INDEX >= COUNT) || (PAYLOAD_LENGTH == 0) ) {
+                    m_numberOfDroppedFragments++;
+                    return false;
+                }
+
+                // Messages consisting of one fragment are complete already.
+                if (COUNT == 1) {
+                    message.assign(data + HEADER_SIZE, PAYLOAD_LENGTH);
+                    return true;
+                }
+
+                const Key KEY(senderAddress, senderPort, ORIGIN, MESSAGE_ID);
+                map<Key, PendingMessage>::iterator it = m_pendingMessages.find(KEY);
+                const bool IS_NEW = (it == m_pendingMessages.end());
+                if (!IS_NEW) {
+                    const PendingMessage &pm = it->second;
+                    if ( (pm.m_fragments.size() != COUNT) || pm.m_received[INDEX] ) {
+                        // Inconsistent or duplicated fragment.
+                        m_numberOfDroppedFragments++;
+                        return false;
+                    }
+                }
+
+                const uint64_t REQUIRED = PAYLOAD_LENGTH + (IS_NEW ? getOverhead(COUNT) : 0);
+                if (REQUIRED > m_maxPendingBytes) {
+                    m_numberOfDroppedFragments++;
+                    return false;
+                }
+
+                // Evict the oldest messages until the new fragment fits.
+                while ( ( ((m_numberOfPendingBytes + REQUIRED) > m_maxPendingBytes)
+                       || (IS_NEW && (m_pendingMessages.size() >= m_maxPendingMessages)) )
+                     && !m_pendingMessages.empty() ) {
+                    evictOldest();
+                }
+
+                if (IS_NEW) {
+                    it = m_pendingMessages.insert(make_pair(KEY, PendingMessage())).first;
+                    it->second.m_firstFragment = NOW;
+                    it->second.m_received.resize(COUNT, false);
+                    it->second.m_fragments.resize(COUNT);
+                    m_numberOfPendingBytes += getOverhead(COUNT);
+                }
+                else {
+                    it = m_pendingMessages.find(KEY);
+                    if (it == m_pendingMessages.end()) {
+                        // The message itself was evicted.
+                        m_numberOfDroppedFragments++;
+                        return false;
+                    }
+                }
+
+                PendingMessage &current = it->second;
+                current.m_fragments[INDEX].assign(data + HEADER_SIZE, PAYLOAD_LENGTH);
+                current.m_received[INDEX] = true;
+                current.m_numberOfReceivedFragments++;
+                current.m_numberOfBytes += PAYLOAD_LENGTH;
+                m_numberOfPendingBytes += PAYLOAD_LENGTH;
+
+                if (current.m_numberOfReceivedFragments < COUNT) {
+                    return false;
+                }
+
+                // All fragments are available.
+                message.clear();
+                message.reserve(current.m_numberOfBytes);
+                for (vector<string>::const_iterator jt = current.m_fragments.begin(); jt != current.m_fragments.end(); ++jt) {
+                    message.append(*jt);
+                }
+
+                m_numberOfPendingBytes -= current.m_numberOfBytes + getOverhead(COUNT);
+                m_pendingMessages.erase(it);
+
+                return true;
+            }
+
+            void FragmentReassembler::evictExpired(const int64_t &now) {
+                map<Key, PendingMessage>::iterator it = m_pendingMessages.begin();
+                while (it != m_pendingMessages.end()) {
+                    if ((now - it->second.m_firstFragment) > m_timeout) {
+                        evict(it++);
+                    }
+                    else {
+                        ++it;
+                    }
+                }
+            }
+
+            void FragmentReassembler::evictOldest() {
+                map<Key, PendingMessage>::iterator oldest = m_pendingMessages.begin();
+                for (map<Key, PendingMessage>::iterator it = m_pendingMessages.begin(); it != m_pendingMessages.end(); ++it) {
+                    if (it->second.m_firstFragment < oldest->second.m_firstFragment) {
+                        oldest = it;
+                    }
+                }
+                if (oldest != m_pendingMessages.end()) {
+                    evict(oldest);
+                }
+            }
+
+            void FragmentReassembler::evict(map<Key, PendingMessage>::iterator it) {
+                m_numberOfDroppedFragments += it->second.m_numberOfReceivedFragments;
+                m_numberOfPendingBytes -= it->second.m_numberOfBytes + getOverhead(it->second.m_fragments.size());
+                m_numberOfEvictedMessages++;
+                m_pendingMessages.erase(it);
+            }
+
+            uint64_t FragmentReassembler::getNumberOfDroppedFragments() const {
+                Lock l(m_mutex);
+                return m_numberOfDroppedFragments;
+            }
+
+            uint64_t FragmentReassembler::getNumberOfEvictedMessages() const {
+                Lock l(m_mutex);
+                return m_numberOfEvictedMessages;
+            }
+
+            uint32_t FragmentReassembler::getNumberOfPendingBytes() const {
+                Lock l(m_mutex);
+                return m_numberOfPendingBytes;
+            }
+
+        }
+    }
+} // odcore::io::udp
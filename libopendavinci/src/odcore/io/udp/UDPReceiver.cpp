@@ -20,7 +20,6 @@
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/io/StringListener.h"
 #include "opendavinci/odcore/io/udp/UDPReceiver.h"
-#include "opendavinci/generated/odcore/data/Packet.h"
 
 namespace odcore { namespace io { class StringListener; } }
 
@@ -57,19 +56,47 @@ namespace odcore {
                 m_synchronousPacketListener = pl;
             }
 
-            void UDPReceiver::nextPacket(const odcore::data::Packet &p) {
+            void UDPReceiver::setReceiveBatchSize(const uint32_t &/*batchSize*/) {}
+
+            void UDPReceiver::setPacketPipelineOverflowPolicy(const PacketPipeline::OVERFLOW_POLICY &policy) {
+                m_packetPipeline.setOverflowPolicy(policy);
+            }
+
+            const PacketPipeline& UDPReceiver::getPacketPipeline() const {
+                return m_packetPipeline;
+            }
+
+            void UDPReceiver::nextPacket(const SharedPacket &p) {
                 Lock l(m_listenerMutex);
 
                 // Pass packet either to string listner, the synchronous packet
                 // listener, or to packet pipeline.
                 if (m_stringListener != NULL) {
-                    m_stringListener->nextString(p.getData());
+                    m_stringListener->nextString(string(p.getData(), p.getLength()));
+                }
+                else if (m_synchronousPacketListener != NULL) {
+                    m_synchronousPacketListener->nextSharedPacket(p);
+                }
+                else {
+                    m_packetPipeline.nextSharedPacket(p);
+                }
+            }
+
+            void UDPReceiver::nextPackets(const vector<SharedPacket> &packets) {
+                Lock l(m_listenerMutex);
+
+                // Pass packets either to string listner, the synchronous packet
+                // listener, or to packet pipeline.
+                if (m_stringListener != NULL) {
+                    for (vector<SharedPacket>::const_iterator it = packets.begin(); it != packets.end(); ++it) {
+                        m_stringListener->nextString(string(it->getData(), it->getLength()));
+                    }
                 }
                 else if (m_synchronousPacketListener != NULL) {
-                    m_synchronousPacketListener->nextPacket(p);
+                    m_synchronousPacketListener->nextSharedPackets(packets);
                 }
                 else {
-                    m_packetPipeline.nextPacket(p);
+                    m_packetPipeline.nextSharedPackets(packets);
                 }
             }
 
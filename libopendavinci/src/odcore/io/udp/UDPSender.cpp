@@ -25,6 +25,12 @@ namespace odcore {
 
             UDPSender::~UDPSender() {}
 
+            void UDPSender::sendBatch(const vector<string> &data) const {
+                for (vector<string>::const_iterator it = data.begin(); it != data.end(); ++it) {
+                    send(*it);
+                }
+            }
+
         }
     }
 } // odcore::io::udp
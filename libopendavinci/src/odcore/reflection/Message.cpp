@@ -40,7 +40,8 @@ namespace odcore {
             m_ID(0),
             m_shortName(),
             m_longName(),
-            m_fields() {}
+            m_fields(),
+            m_fieldIndex() {}
 
         Message::Message(const Message &obj) : 
             SerializableData(obj),
@@ -48,7 +49,8 @@ namespace odcore {
             m_ID(obj.m_ID),
             m_shortName(obj.m_shortName),
             m_longName(obj.m_longName),
-            m_fields(obj.m_fields) {}
+            m_fields(obj.m_fields),
+            m_fieldIndex(obj.m_fieldIndex) {}
 
         Message::~Message() {}
 
@@ -57,10 +59,15 @@ namespace odcore {
             m_shortName = obj.m_shortName;
             m_longName = obj.m_longName;
             m_fields = obj.m_fields;
+            m_fieldIndex = obj.m_fieldIndex;
             return *this;
         }
 
         void Message::addField(const std::shared_ptr<odcore::data::reflection::AbstractField> &f) {
+            if (f.get() != NULL) {
+                // Keep the first field for an identifier like a sequential search would find.
+                m_fieldIndex.insert(make_pair(f->getFieldIdentifier(), static_cast<uint32_t>(m_fields.size())));
+            }
             m_fields.push_back(f);
         }
 
@@ -220,21 +227,23 @@ namespace odcore {
             v.endVisit();
         }
 
+        std::shared_ptr<odcore::data::reflection::AbstractField> Message::getFieldByIndex(const uint32_t &index) const {
+            std::shared_ptr<odcore::data::reflection::AbstractField> field;
+            if (index < m_fields.size()) {
+                field = m_fields[index];
+            }
+            return field;
+        }
+
         std::shared_ptr<odcore::data::reflection::AbstractField> Message::getFieldByIdentifier(const uint32_t &id, bool &found) {
-            bool retVal = false;
             std::shared_ptr<odcore::data::reflection::AbstractField> field;
 
-            vector<std::shared_ptr<AbstractField> >::iterator it = m_fields.begin();
-            while (it != m_fields.end()) {
-                if ( (*it)->getFieldIdentifier() == id ) {
-                    retVal = true;
-                    field = (*it);
-                    break;
-                }
-                ++it;
+            map<uint32_t, uint32_t>::const_iterator it = m_fieldIndex.find(id);
+            found = (it != m_fieldIndex.end());
+            if (found) {
+                field = m_fields[it->second];
             }
 
-            found = retVal;
             return field;
         }
 
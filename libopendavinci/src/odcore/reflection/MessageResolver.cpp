@@ -17,14 +17,21 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 
 #ifdef HAVE_DL
     #include <dlfcn.h>
     #include <experimental/filesystem>
 #endif
 
+#include "opendavinci/odcore/reflection/Field.h"
+#include "opendavinci/odcore/reflection/MessagePrettyPrinterVisitor.h"
 #include "opendavinci/odcore/reflection/MessageResolver.h"
+#include "opendavinci/odcore/serialization/ProtoDecoder.h"
+#include "opendavinci/odcore/serialization/ProtoEncoder.h"
+#include "opendavinci/odcore/serialization/SerializationFactory.h"
 #include "opendavinci/odcore/strings/StringToolbox.h"
 #include "opendavinci/GeneratedHeaders_OpenDaVINCI_Helper.h"
 
@@ -34,6 +41,237 @@ namespace odcore {
         using namespace std;
         using namespace odcore::base;
         using namespace odcore::data;
+        using namespace odcore::data::reflection;
+        using namespace odcore::serialization;
+
+        namespace {
+            /**
+             * This method decodes the current field of the given decoder
+             * into a copy of the prototype field.
+             */
+            template<typename T>
+            bool decodeField(const ProtoDecoder &d, const std::shared_ptr<AbstractField> &prototype, std::shared_ptr<AbstractField> &field) {
+                const Field<T> *p = dynamic_cast<const Field<T>*>(prototype.get());
+                if ( (p == NULL) || (d.getType() != ProtoEncoder::getType<T>()) ) {
+                    return false;
+                }
+
+                T value = T();
+                d.read(value);
+                Field<T> *f = new Field<T>(*p);
+                f->setValue(value);
+                field = std::shared_ptr<AbstractField>(f);
+                return true;
+            }
+
+            /**
+             * @return Helper for the messages from OpenDaVINCI.
+             */
+            Helper& getOpenDaVINCIHelper() {
+                static GeneratedHeaders_OpenDaVINCI_Helper helper;
+                return helper;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+
+        DecodePlan::DecodePlan() :
+            m_valid(false),
+            m_messageID(0),
+            m_shortName(),
+            m_longName(),
+            m_fields(),
+            m_positionsById(),
+            m_nestedPlans() {}
+
+        DecodePlan::DecodePlan(const Message &prototype) :
+            m_valid(true),
+            m_messageID(prototype.getID()),
+            m_shortName(prototype.getShortName()),
+            m_longName(prototype.getLongName()),
+            m_fields(),
+            m_positionsById(),
+            m_nestedPlans() {
+            const uint32_t numberOfFields = prototype.getNumberOfFields();
+            for (uint32_t i = 0; (i < numberOfFields) && m_valid; i++) {
+                std::shared_ptr<AbstractField> f = prototype.getFieldByIndex(i);
+                std::shared_ptr<DecodePlan> nestedPlan;
+
+                switch (f->getFieldDataType()) {
+                    case AbstractField::SERIALIZABLE_T:
+                    {
+                        Field<Message> *nested = dynamic_cast<Field<Message>*>(f.get());
+                        if (nested != NULL) {
+                            nestedPlan = std::make_shared<DecodePlan>(nested->getValue());
+                        }
+                        m_valid = (nestedPlan.get() != NULL) && nestedPlan->isValid();
+                    }
+                    break;
+                    case AbstractField::BOOL_T:
+                    case AbstractField::CHAR_T:
+                    case AbstractField::UCHAR_T:
+                    case AbstractField::INT8_T:
+                    case AbstractField::UINT8_T:
+                    case AbstractField::INT16_T:
+                    case AbstractField::UINT16_T:
+                    case AbstractField::INT32_T:
+                    case AbstractField::UINT32_T:
+                    case AbstractField::INT64_T:
+                    case AbstractField::UINT64_T:
+                    case AbstractField::FLOAT_T:
+                    case AbstractField::DOUBLE_T:
+                    case AbstractField::STRING_T:
+                    break;
+                    default:
+                        // Raw data is left to the helpers.
+                        m_valid = false;
+                    break;
+                }
+
+                m_fields.push_back(f);
+                m_nestedPlans.push_back(nestedPlan);
+                m_positionsById.push_back(make_pair(f->getFieldIdentifier(), i));
+            }
+
+            std::sort(m_positionsById.begin(), m_positionsById.end());
+            for (uint32_t i = 1; (i < m_positionsById.size()) && m_valid; i++) {
+                // Identifiers must be unique to map every encoded field to one field of the message.
+                m_valid = (m_positionsById[i - 1].first != m_positionsById[i].first);
+            }
+        }
+
+        DecodePlan::DecodePlan(const DecodePlan &obj) :
+            m_valid(obj.m_valid),
+            m_messageID(obj.m_messageID),
+            m_shortName(obj.m_shortName),
+            m_longName(obj.m_longName),
+            m_fields(obj.m_fields),
+            m_positionsById(obj.m_positionsById),
+            m_nestedPlans(obj.m_nestedPlans) {}
+
+        DecodePlan& DecodePlan::operator=(const DecodePlan &obj) {
+            m_valid = obj.m_valid;
+            m_messageID = obj.m_messageID;
+            m_shortName = obj.m_shortName;
+            m_longName = obj.m_longName;
+            m_fields = obj.m_fields;
+            m_positionsById = obj.m_positionsById;
+            m_nestedPlans = obj.m_nestedPlans;
+            return *this;
+        }
+
+        DecodePlan::~DecodePlan() {}
+
+        bool DecodePlan::isValid() const {
+            return m_valid;
+        }
+
+        bool DecodePlan::decode(const ByteSpan &payload, Message &msg) const {
+            if (!m_valid) {
+                return false;
+            }
+
+            vector<std::shared_ptr<AbstractField> > fields(m_fields.size());
+
+            ProtoDecoder d(payload);
+            while (d.next()) {
+                vector<pair<uint32_t, uint32_t> >::const_iterator it = std::lower_bound(m_positionsById.begin(), m_positionsById.end(), make_pair(d.getFieldId(), static_cast<uint32_t>(0)));
+                if ( (it == m_positionsById.end()) || (it->first != d.getFieldId()) ) {
+                    // Fields that are not visited by the message, e.g. lists, are skipped.
+                    continue;
+                }
+
+                const uint32_t position = it->second;
+                const std::shared_ptr<AbstractField> &prototype = m_fields[position];
+                bool decoded = false;
+                switch (prototype->getFieldDataType()) {
+                    case AbstractField::SERIALIZABLE_T:
+                    {
+                        const Field<Message> *p = dynamic_cast<const Field<Message>*>(prototype.get());
+                        Message nested;
+                        decoded = (p != NULL) &&
+                                  (d.getType() == ProtoSerializer::LENGTH_DELIMITED) &&
+                                  m_nestedPlans[position]->decode(d.getValue(), nested);
+                        if (decoded) {
+                            Field<Message> *f = new Field<Message>(*p);
+                            f->setValue(nested);
+                            fields[position] = std::shared_ptr<AbstractField>(f);
+                        }
+                    }
+                    break;
+                    case AbstractField::BOOL_T:
+                        decoded = decodeField<bool>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::CHAR_T:
+                        decoded = decodeField<char>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::UCHAR_T:
+                        decoded = decodeField<unsigned char>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::INT8_T:
+                        decoded = decodeField<int8_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::UINT8_T:
+                        decoded = decodeField<uint8_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::INT16_T:
+                        decoded = decodeField<int16_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::UINT16_T:
+                        decoded = decodeField<uint16_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::INT32_T:
+                        decoded = decodeField<int32_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::UINT32_T:
+                        decoded = decodeField<uint32_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::INT64_T:
+                        decoded = decodeField<int64_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::UINT64_T:
+                        decoded = decodeField<uint64_t>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::FLOAT_T:
+                        decoded = decodeField<float>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::DOUBLE_T:
+                        decoded = decodeField<double>(d, prototype, fields[position]);
+                    break;
+                    case AbstractField::STRING_T:
+                        decoded = decodeField<string>(d, prototype, fields[position]);
+                        if (decoded) {
+                            fields[position]->setSize(d.getValue().getLength());
+                        }
+                    break;
+                    default:
+                    break;
+                }
+
+                if (!decoded) {
+                    return false;
+                }
+            }
+
+            if (!d.isGood()) {
+                return false;
+            }
+
+            Message retVal;
+            retVal.setID(m_messageID);
+            retVal.setShortName(m_shortName);
+            retVal.setLongName(m_longName);
+            for (vector<std::shared_ptr<AbstractField> >::const_iterator it = fields.begin(); it != fields.end(); ++it) {
+                if ((*it).get() == NULL) {
+                    // A field was not encoded; let the helper provide its default value.
+                    return false;
+                }
+                retVal.addField(*it);
+            }
+            msg = retVal;
+
+            return true;
+        }
 
         ////////////////////////////////////////////////////////////////////////
 
@@ -65,7 +303,8 @@ namespace odcore {
             m_librarySuffixToMatch(librarySuffixToMatch),
             m_listOfLibrariesToLoad(),
             m_listOfHelpers(),
-            m_previouslyMatchedHelper() {
+            m_previouslyMatchedHelper(),
+            m_decodePlans() {
             m_listOfLibrariesToLoad = getListOfLibrariesToLoad(listOfAbsolutePathsToSearch);
             findAndLoadSharedLibraries();
         }
@@ -74,6 +313,7 @@ namespace odcore {
             unloadSharedLibraries();
             m_listOfHelpers.clear();
             m_previouslyMatchedHelper.clear();
+            m_decodePlans.clear();
         }
 
         vector<string> MessageResolver::getListOfLibrariesToLoad(const vector<string> &paths) {
@@ -176,33 +416,69 @@ namespace odcore {
 #endif
         }
 
+        const string MessageResolver::getPrettyPrinted(Message &msg) {
+            MessagePrettyPrinterVisitor mppv;
+            msg.accept(mppv);
+            stringstream sstr;
+            mppv.getOutput(sstr);
+            return sstr.str();
+        }
+
         Message MessageResolver::resolve(Container &c, bool &successfullyMapped) {
             // Assuming that the resolving will fail.
             successfullyMapped = false;
             odcore::reflection::Message retVal;
+            const int32_t dataType = c.getDataType();
+
+            // Check if this container type has been decoded successfully previously.
+            map<int32_t, DecodePlan>::const_iterator plan = m_decodePlans.find(dataType);
+            if ( (plan != m_decodePlans.end()) && plan->second.isValid() && SerializationFactory::getInstance().usesDefaultSerialization() ) {
+                successfullyMapped = plan->second.decode(c.getPayload(), retVal);
+                if (successfullyMapped) {
+                    return retVal;
+                }
+            }
 
             // Check if this container type has been resolved successfully previously.
-            if (m_previouslyMatchedHelper.count(c.getDataType()) > 0) {
-                retVal = m_previouslyMatchedHelper[c.getDataType()].m_helper->map(c, successfullyMapped);
+            map<int32_t, HelperEntry>::iterator previouslyMatched = m_previouslyMatchedHelper.find(dataType);
+            if (previouslyMatched != m_previouslyMatchedHelper.end()) {
+                retVal = previouslyMatched->second.m_helper->map(c, successfullyMapped);
             }
             else {
                 // First, try to decode a regular OpenDaVINCI message.
-                retVal = GeneratedHeaders_OpenDaVINCI_Helper::__map(c, successfullyMapped);
-
-                if (!successfullyMapped) {
+                retVal = getOpenDaVINCIHelper().map(c, successfullyMapped);
+                if (successfullyMapped) {
+                    HelperEntry e;
+                    e.m_helper = &getOpenDaVINCIHelper();
+                    m_previouslyMatchedHelper[dataType] = e;
+                }
+                else {
                     // Try dynamically loaded libraries next.
                     auto it = m_listOfHelpers.begin();
                     while ( (!successfullyMapped) && (it != m_listOfHelpers.end())) {
                         HelperEntry e = *it;
                         retVal = e.m_helper->map(c, successfullyMapped);
                         if (successfullyMapped) {
-                            m_previouslyMatchedHelper[c.getDataType()] = e;
+                            m_previouslyMatchedHelper[dataType] = e;
                         }
                         it++;
                     }
                 }
             }
 
+            if (successfullyMapped && (plan == m_decodePlans.end())) {
+                // Compile the plan once from the first resolved message and
+                // keep it only if it decodes the same payload to the same
+                // message; payloads that are not encoded in Protobuf (e.g.
+                // messages declared as flat) are left to the helpers.
+                DecodePlan p(retVal);
+                Message decoded;
+                if (!p.decode(c.getPayload(), decoded) || (getPrettyPrinted(decoded) != getPrettyPrinted(retVal))) {
+                    p = DecodePlan();
+                }
+                m_decodePlans[dataType] = p;
+            }
+
             return retVal;
         }
 
@@ -0,0 +1,65 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "opendavinci/odcore/serialization/ByteSpan.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        ByteSpan::ByteSpan() :
+            m_data(NULL),
+            m_length(0) {}
+
+        ByteSpan::ByteSpan(const char *data, const uint32_t &length) :
+            m_data(data),
+            m_length((data != NULL) ? length : 0) {}
+
+        ByteSpan::ByteSpan(const string &data) :
+            m_data(data.data()),
+            m_length(static_cast<uint32_t>(data.size())) {}
+
+        ByteSpan::ByteSpan(const ByteSpan &obj) :
+            m_data(obj.m_data),
+            m_length(obj.m_length) {}
+
+        ByteSpan::~ByteSpan() {}
+
+        ByteSpan& ByteSpan::operator=(const ByteSpan &obj) {
+            m_data = obj.m_data;
+            m_length = obj.m_length;
+
+            return (*this);
+        }
+
+        const char* ByteSpan::getData() const {
+            return m_data;
+        }
+
+        uint32_t ByteSpan::getLength() const {
+            return m_length;
+        }
+
+        bool ByteSpan::isEmpty() const {
+            return (0 == m_length);
+        }
+
+    }
+} // odcore::serialization
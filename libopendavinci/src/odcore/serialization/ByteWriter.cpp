@@ -0,0 +1,127 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+
+#include "opendavinci/odcore/serialization/ByteWriter.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        ByteWriter::ByteWriter(char *buffer, const uint32_t &capacity) :
+            m_buffer(buffer),
+            m_capacity((buffer != NULL) ? capacity : 0),
+            m_position(0),
+            m_good(true) {}
+
+        ByteWriter::~ByteWriter() {}
+
+        void ByteWriter::writeByte(const uint8_t &value) {
+            if (m_position < m_capacity) {
+                m_buffer[m_position++] = static_cast<char>(value);
+            }
+            else {
+                m_good = false;
+            }
+        }
+
+        void ByteWriter::writeBytes(const void *data, const uint32_t &length) {
+            if (length > (m_capacity - m_position)) {
+                m_good = false;
+                return;
+            }
+            if (length > 0) {
+                memcpy(m_buffer + m_position, data, length);
+                m_position += length;
+            }
+        }
+
+        void ByteWriter::writeVarInt(uint64_t value) {
+            // Encode into a local buffer first to check the capacity only once.
+            char bytes[VarInt::MAX_SIZE];
+            writeBytes(bytes, VarInt::encode(value, bytes));
+        }
+
+        void ByteWriter::writeFixed32(const uint32_t &value) {
+            const uint32_t _value = htole32(value);
+            writeBytes(&_value, sizeof(uint32_t));
+        }
+
+        void ByteWriter::writeFixed64(const uint64_t &value) {
+            const uint64_t _value = htole64(value);
+            writeBytes(&_value, sizeof(uint64_t));
+        }
+
+        void ByteWriter::writeFixed32Array(const void *values, const uint32_t &count) {
+            if (htole32(1) == 1) {
+                if (count > ((m_capacity - m_position) / sizeof(uint32_t))) {
+                    m_good = false;
+                    return;
+                }
+                writeBytes(values, count * sizeof(uint32_t));
+            }
+            else {
+                const char *_values = static_cast<const char*>(values);
+                for (uint32_t i = 0; i < count; i++) {
+                    uint32_t value = 0;
+                    memcpy(&value, _values + i * sizeof(uint32_t), sizeof(uint32_t));
+                    writeFixed32(value);
+                }
+            }
+        }
+
+        void ByteWriter::writeFixed64Array(const void *values, const uint32_t &count) {
+            if (htole64(1) == 1) {
+                if (count > ((m_capacity - m_position) / sizeof(uint64_t))) {
+                    m_good = false;
+                    return;
+                }
+                writeBytes(values, count * sizeof(uint64_t));
+            }
+            else {
+                const char *_values = static_cast<const char*>(values);
+                for (uint32_t i = 0; i < count; i++) {
+                    uint64_t value = 0;
+                    memcpy(&value, _values + i * sizeof(uint64_t), sizeof(uint64_t));
+                    writeFixed64(value);
+                }
+            }
+        }
+
+        uint32_t ByteWriter::getPosition() const {
+            return m_position;
+        }
+
+        uint32_t ByteWriter::getCapacity() const {
+            return m_capacity;
+        }
+
+        const char* ByteWriter::getData() const {
+            return m_buffer;
+        }
+
+        bool ByteWriter::isGood() const {
+            return m_good;
+        }
+
+    }
+} // odcore::serialization
@@ -113,6 +113,13 @@ class Serializable;
             o << m_buffer.str();
         }
 
+        void LCMSerializerVisitor::reset() {
+            m_channelName = "";
+            m_hash = 0x12345678;
+            m_buffer.str("");
+            m_buffer.clear();
+        }
+
         void LCMSerializerVisitor::write(const uint32_t &/*id*/, const Serializable &/*v*/) {}
 
         void LCMSerializerVisitor::write(const uint32_t &/*id*/, const bool &v) {
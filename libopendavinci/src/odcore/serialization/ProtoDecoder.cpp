@@ -0,0 +1,170 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "opendavinci/odcore/serialization/ProtoDecoder.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        ProtoDecoder::ProtoDecoder() :
+            m_position(NULL),
+            m_end(NULL),
+            m_good(true),
+            m_id(0),
+            m_type(ProtoSerializer::UNUSED_7),
+            m_varIntValue(0),
+            m_data(NULL),
+            m_length(0) {}
+
+        ProtoDecoder::ProtoDecoder(const ByteSpan &in) :
+            m_position(in.getData()),
+            m_end(in.getData() + in.getLength()),
+            m_good(true),
+            m_id(0),
+            m_type(ProtoSerializer::UNUSED_7),
+            m_varIntValue(0),
+            m_data(NULL),
+            m_length(0) {}
+
+        ProtoDecoder::ProtoDecoder(const ProtoDecoder &obj) :
+            m_position(obj.m_position),
+            m_end(obj.m_end),
+            m_good(obj.m_good),
+            m_id(obj.m_id),
+            m_type(obj.m_type),
+            m_varIntValue(obj.m_varIntValue),
+            m_data(obj.m_data),
+            m_length(obj.m_length) {}
+
+        ProtoDecoder::~ProtoDecoder() {}
+
+        ProtoDecoder& ProtoDecoder::operator=(const ProtoDecoder &obj) {
+            m_position = obj.m_position;
+            m_end = obj.m_end;
+            m_good = obj.m_good;
+            m_id = obj.m_id;
+            m_type = obj.m_type;
+            m_varIntValue = obj.m_varIntValue;
+            m_data = obj.m_data;
+            m_length = obj.m_length;
+
+            return (*this);
+        }
+
+        bool ProtoDecoder::next() {
+            if ( !m_good || (m_position >= m_end) ) {
+                return false;
+            }
+
+            const char *pos = m_position;
+            uint64_t key = 0;
+            if (!VarInt::decode(pos, m_end, key)) {
+                m_good = false;
+                return false;
+            }
+
+            m_id = static_cast<uint32_t>(key >> 3);
+            m_type = static_cast<ProtoSerializer::PROTOBUF_TYPE>(key & 0x7);
+            m_varIntValue = 0;
+            m_data = pos;
+            m_length = 0;
+
+            uint64_t length = 0;
+            switch (m_type) {
+                case ProtoSerializer::VARINT:
+                    if (!VarInt::decode(pos, m_end, m_varIntValue)) {
+                        m_good = false;
+                        return false;
+                    }
+                    m_data = pos;
+                    m_position = pos;
+                    return true;
+                case ProtoSerializer::EIGHT_BYTES:
+                    length = sizeof(uint64_t);
+                break;
+                case ProtoSerializer::FOUR_BYTES:
+                    length = sizeof(uint32_t);
+                break;
+                case ProtoSerializer::LENGTH_DELIMITED:
+                    if (!VarInt::decode(pos, m_end, length)) {
+                        m_good = false;
+                        return false;
+                    }
+                break;
+                default:
+                    m_good = false;
+                    return false;
+            }
+
+            if (length > static_cast<uint64_t>(m_end - pos)) {
+                m_good = false;
+                return false;
+            }
+            m_data = pos;
+            m_length = static_cast<uint32_t>(length);
+            m_position = pos + length;
+            return true;
+        }
+
+        bool ProtoDecoder::isGood() const {
+            return m_good;
+        }
+
+        uint32_t ProtoDecoder::getFieldId() const {
+            return m_id;
+        }
+
+        ProtoSerializer::PROTOBUF_TYPE ProtoDecoder::getType() const {
+            return m_type;
+        }
+
+        ByteSpan ProtoDecoder::getValue() const {
+            return ByteSpan(m_data, m_length);
+        }
+
+        ByteSpan ProtoDecoder::getRemainingBytes(istream &in, string &buffer) {
+            SpanStreamBuffer *span = dynamic_cast<SpanStreamBuffer*>(in.rdbuf());
+            if (span != NULL) {
+                // Use the remaining bytes in place and consume them from the stream.
+                const char *begin = span->getPosition();
+                const uint32_t length = static_cast<uint32_t>(span->getEnd() - begin);
+                span->consume();
+                in.setstate(ios_base::eofbit | ios_base::failbit);
+                return ByteSpan(begin, length);
+            }
+
+            // Copy the remaining bytes once into a contiguous buffer.
+            buffer.clear();
+            const streamsize available = (in.rdbuf() != NULL) ? in.rdbuf()->in_avail() : 0;
+            if (available > 0) {
+                buffer.reserve(available);
+            }
+            const uint32_t BYTES_TO_READ_INTO_BUFFER = 1024;
+            char bytes[BYTES_TO_READ_INTO_BUFFER];
+            while (in.good()) {
+                in.read(bytes, BYTES_TO_READ_INTO_BUFFER);
+                buffer.append(bytes, in.gcount());
+            }
+            return ByteSpan(buffer);
+        }
+
+    }
+} // odcore::serialization
@@ -24,6 +24,8 @@
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/serialization/ProtoDeserializer.h"
 #include "opendavinci/odcore/serialization/ProtoDeserializerVisitor.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
 #include "opendavinci/odcore/base/Visitable.h"
 #include "opendavinci/odcore/reflection/MessageFromVisitableVisitor.h"
 #include "opendavinci/odcore/reflection/Message.h"
@@ -124,123 +126,99 @@ class Serializable;
 
         ProtoDeserializer::ProtoDeserializer() :
             m_buffer(),
-            m_mapOfKeyValues() {}
+            m_data(),
+            m_decoder(),
+            m_fieldTable(),
+            m_useFieldTable(false) {}
 
         ProtoDeserializer::ProtoDeserializer(istream &i) :
             m_buffer(),
-            m_mapOfKeyValues() {
+            m_data(),
+            m_decoder(),
+            m_fieldTable(),
+            m_useFieldTable(false) {
             deserializeDataFrom(i);
         }
 
+        ProtoDeserializer::ProtoDeserializer(const char *data, const uint32_t &length) :
+            m_buffer(),
+            m_data(),
+            m_decoder(),
+            m_fieldTable(),
+            m_useFieldTable(false) {
+            deserializeDataFrom(data, length);
+        }
+
         ProtoDeserializer::~ProtoDeserializer() {}
 
         void ProtoDeserializer::deserializeDataFrom(istream &in) {
-            // Reset internal states as this deserializer could be reused.
-            m_buffer.str("");
-            m_mapOfKeyValues.clear();
-
-            while (in.good()) {
-                // First stage: Read keyFieldType (encoded as VarInt).
-                uint64_t keyFieldType = 0;
-                uint8_t bytesRead = decodeVarInt(in, keyFieldType);
-
-                if (bytesRead > 0) {
-                    // Succeeded to read keyFieldType entry; extract information.
-                    const uint32_t fieldId = static_cast<uint32_t>(keyFieldType >> 3);
-                    const ProtoSerializer::PROTOBUF_TYPE protoType = static_cast<ProtoSerializer::PROTOBUF_TYPE>(keyFieldType & 0x7);
-
-                    if (protoType == ProtoSerializer::VARINT) {
-                        // Read VarInt value directly.
-                        uint64_t value = 0;
-                        bytesRead = decodeVarInt(in, value);
-                        ProtoKeyValue pkv(fieldId, value);
-                        m_mapOfKeyValues[fieldId] = pkv;
-                    }
-
-                    if (protoType == ProtoSerializer::EIGHT_BYTES) {
-                        const uint8_t BYTES_TO_READ_INTO_BUFFER = sizeof(double);
-                        uint8_t bytesToRead = BYTES_TO_READ_INTO_BUFFER;
-                        uint32_t bufferPosition = 0;
-
-                        // Create map entry here...
-                        ProtoKeyValue pkv(fieldId, ProtoSerializer::EIGHT_BYTES, BYTES_TO_READ_INTO_BUFFER);
-                        // ...to avoid copying data later.
-                        vector<char> &buffer = pkv.getRawBuffer();
-
-                        while (in.good() && (bytesToRead > 0)) {
-                            in.read(&buffer[bufferPosition], (bytesToRead > BYTES_TO_READ_INTO_BUFFER) ? BYTES_TO_READ_INTO_BUFFER : bytesToRead);
-                            const streamsize extractedBytes = in.gcount();
-                            bufferPosition += extractedBytes;
-                            bytesToRead -= extractedBytes;
-                        }
-
-                        // Store map entry.
-                        m_mapOfKeyValues[fieldId] = pkv;
-                    }
-
-                    if (protoType == ProtoSerializer::FOUR_BYTES) {
-                        const uint8_t BYTES_TO_READ_INTO_BUFFER = sizeof(float);
-                        uint8_t bytesToRead = BYTES_TO_READ_INTO_BUFFER;
-                        uint32_t bufferPosition = 0;
-
-                        // Create map entry here...
-                        ProtoKeyValue pkv(fieldId, ProtoSerializer::FOUR_BYTES, BYTES_TO_READ_INTO_BUFFER);
-                        // ...to avoid copying data later.
-                        vector<char> &buffer = pkv.getRawBuffer();
-
-                        while (in.good() && (bytesToRead > 0)) {
-                            in.read(&buffer[bufferPosition], (bytesToRead > BYTES_TO_READ_INTO_BUFFER) ? BYTES_TO_READ_INTO_BUFFER : bytesToRead);
-                            const streamsize extractedBytes = in.gcount();
-                            bufferPosition += extractedBytes;
-                            bytesToRead -= extractedBytes;
-                        }
-
-                        // Store map entry.
-                        m_mapOfKeyValues[fieldId] = pkv;
-                    }
-
-                    if (protoType == ProtoSerializer::LENGTH_DELIMITED) {
-                        const uint16_t BYTES_TO_READ_INTO_BUFFER = 1024;
-
-                        uint64_t length = 0;
-                        bytesRead = decodeVarInt(in, length);
-                        uint64_t bytesToRead = length;
-
-                        uint32_t bufferPosition = 0;
-
-                        // Create map entry here...
-                        ProtoKeyValue pkv(fieldId, ProtoSerializer::LENGTH_DELIMITED, length);
-                        // ...to avoid copying data later.
-                        vector<char> &buffer = pkv.getRawBuffer();
-
-                        while (in.good() && (bytesToRead > 0)) {
-                            in.read(&buffer[bufferPosition], (bytesToRead > BYTES_TO_READ_INTO_BUFFER) ? BYTES_TO_READ_INTO_BUFFER : bytesToRead);
-                            const streamsize extractedBytes = in.gcount();
-                            bufferPosition += extractedBytes;
-                            bytesToRead -= extractedBytes;
-                        }
-
-                        // Store map entry.
-                        m_mapOfKeyValues[fieldId] = pkv;
-                    }
+            // Bytes from a SpanStreamBuffer are used in place; otherwise, they are copied once.
+            const ByteSpan data = ProtoDecoder::getRemainingBytes(in, m_buffer);
+            deserializeDataFrom(data.getData(), data.getLength());
+        }
+
+        void ProtoDeserializer::deserializeDataFrom(const char *data, const uint32_t &length) {
+            m_data = ByteSpan(data, length);
+            m_decoder = ProtoDecoder(m_data);
+            m_fieldTable.clear();
+            m_useFieldTable = false;
+
+            // Protobuf uses the last occurrence of a field. Fields with
+            // strictly increasing identifiers cannot occur twice; thus,
+            // the in-order lookup can be used. Otherwise, all fields are
+            // located at once to find the last occurrence.
+            if (!hasStrictlyIncreasingFieldIds()) {
+                buildFieldTable();
+            }
+        }
+
+        bool ProtoDeserializer::hasStrictlyIncreasingFieldIds() const {
+            ProtoDecoder decoder(m_data);
+            uint32_t previousId = 0;
+            while (decoder.next()) {
+                if (decoder.getFieldId() <= previousId) {
+                    return false;
                 }
+                previousId = decoder.getFieldId();
             }
+            return true;
         }
 
-        uint8_t ProtoDeserializer::decodeVarInt(istream &in, uint64_t &value) {
-            value = 0;
-            uint8_t size = 0;
-            char c = 0;
-            while (in.good()) {
-                c = in.get();
-                value |= static_cast<unsigned int>( (c & 0x7f) << (0x7 * size++) );
-                if ( !(c & 0x80) ) break;
+        void ProtoDeserializer::buildFieldTable() {
+            m_fieldTable.clear();
+            ProtoDecoder decoder(m_data);
+            while (decoder.next()) {
+                m_fieldTable.push_back(decoder);
             }
+            m_useFieldTable = true;
+        }
 
-            // Protobuf's VarInt is based on little endian.
-            value = le64toh(value);
+        bool ProtoDeserializer::findField(const uint32_t &id, ProtoDecoder &field) {
+            if (!m_useFieldTable) {
+                // Fields are usually read in the order they were written
+                // and no field occurs twice.
+                field = m_decoder;
+                if (field.next() && (field.getFieldId() == id)) {
+                    m_decoder = field;
+                    return true;
+                }
 
-            return size;
+                // Out-of-order or missing field: Locate all fields once.
+                buildFieldTable();
+            }
+
+            // The last occurrence of a field is used.
+            for (vector<ProtoDecoder>::const_reverse_iterator it = m_fieldTable.rbegin(); it != m_fieldTable.rend(); ++it) {
+                if (it->getFieldId() == id) {
+                    field = *it;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        uint8_t ProtoDeserializer::decodeVarInt(istream &in, uint64_t &value) {
+            return static_cast<uint8_t>(VarInt::decode(in, value));
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -286,18 +264,26 @@ class Serializable;
             uint64_t length = 0;
             bytesRead += decodeVarInt(i, length);
 
-            // Create contiguous buffer.
-            vector<char> buffer(length);
-
-            // Read data from stream.
-            i.read(&buffer[0], length);
+            SpanStreamBuffer *span = dynamic_cast<SpanStreamBuffer*>(i.rdbuf());
+            if ( (span != NULL) && (length <= static_cast<uint64_t>(span->getEnd() - span->getPosition())) ) {
+                // Read Serializable in place.
+                SpanStreamBuffer buffer(span->getPosition(), length);
+                istream in(&buffer);
+                in >> v;
+                i.ignore(length);
+            }
+            else {
+                // Create contiguous buffer.
+                string buffer(length, '\0');
+                i.read(&buffer[0], length);
+
+                // Read Serializable from buffer.
+                SpanStreamBuffer bufferIn(buffer.data(), i.gcount());
+                istream in(&bufferIn);
+                in >> v;
+            }
             bytesRead += length;
 
-            // Read Serializable from buffer.
-            stringstream sstr;
-            sstr.rdbuf()->pubsetbuf(&buffer[0], length);
-            sstr >> v;
-
             return bytesRead;
         }
 
@@ -396,16 +382,14 @@ class Serializable;
             uint64_t length = 0;
             bytesRead += decodeVarInt(i, length);
 
-            // Create contiguous buffer.
-            vector<char> buffer(length);
-
-            // Read data from stream.
-            i.read(&buffer[0], length);
+            // Read data from stream directly into the string.
+            v.resize(length);
+            if (length > 0) {
+                i.read(&v[0], length);
+                v.resize(i.gcount());
+            }
             bytesRead += length;
 
-            // Create string from buffer.
-            v = string(&buffer[0], &buffer[length]);
-
             return bytesRead;
         }
 
@@ -416,15 +400,14 @@ class Serializable;
             uint64_t length = 0;
             bytesRead += decodeVarInt(i, length);
 
-            // Read data.
-            char *_data = new char[length];
-            i.read(_data, length);
-            bytesRead += length;
-
-            // Move data.
+            // Read data directly into the destination and skip the remainder.
             memset(data, 0, size);
-            memcpy(data, _data, (size < length ? size : length));
-            OPENDAVINCI_CORE_DELETE_ARRAY(_data);
+            const uint64_t bytesToCopy = (size < length ? size : length);
+            i.read(static_cast<char*>(data), bytesToCopy);
+            if (length > bytesToCopy) {
+                i.ignore(length - bytesToCopy);
+            }
+            bytesRead += length;
 
             return bytesRead;
         }
@@ -432,108 +415,107 @@ class Serializable;
         ///////////////////////////////////////////////////////////////////////
 
         void ProtoDeserializer::read(const uint32_t &id, Serializable &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                vector<char> &value = const_cast<vector<char>&>(m_mapOfKeyValues[id].getValue());
-                stringstream sstr;
-                sstr.rdbuf()->pubsetbuf(&value[0], value.size());
-                sstr >> v;
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, bool &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<bool>(_v);
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, char &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<char>(_v);
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, unsigned char &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<unsigned char>(_v);
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, int8_t &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<int8_t>(decodeZigZag8(_v));
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, int16_t &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<int16_t>(decodeZigZag16(_v));
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, uint16_t &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<uint16_t>(_v);
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, int32_t &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<int32_t>(decodeZigZag32(_v));
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, uint32_t &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<uint32_t>(_v);
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, int64_t &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                uint64_t _v = m_mapOfKeyValues[id].getValueAsVarInt();
-                v = static_cast<int64_t>(decodeZigZag64(_v));
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, uint64_t &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                v = m_mapOfKeyValues[id].getValueAsVarInt();
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, float &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                v = m_mapOfKeyValues[id].getValueAsFloat();
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, double &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                v = m_mapOfKeyValues[id].getValueAsDouble();
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, string &v) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                v = m_mapOfKeyValues[id].getValueAsString();
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(v);
             }
         }
 
         void ProtoDeserializer::read(const uint32_t &id, void *data, const uint32_t &size) {
-            if (m_mapOfKeyValues.count(id) > 0) {
-                const vector<char> &value = m_mapOfKeyValues[id].getValue();
-                memcpy(data, &value[0], (size < value.size() ? size : value.size()));
-                if (size > value.size()) {
-                    memset((char*)data + value.size(), 0, (size - value.size()));
-                }
+            ProtoDecoder field;
+            if (findField(id, field)) {
+                field.read(data, size);
             }
         }
 
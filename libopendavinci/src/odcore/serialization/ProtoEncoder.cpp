@@ -0,0 +1,139 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "opendavinci/odcore/serialization/ProtoEncoder.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        namespace {
+            // Flag whether the calling thread's reused cache is in use.
+            thread_local bool threadCacheInUse = false;
+        }
+
+        ProtoEncoder::EncodingCache::EncodingCache() :
+            m_lengths(),
+            m_nextLength(0),
+            m_bytes(),
+            m_nextBytes(0),
+            m_writing(false) {}
+
+        void ProtoEncoder::EncodingCache::clear() {
+            m_lengths.clear();
+            m_nextLength = 0;
+            m_bytes.clear();
+            m_nextBytes = 0;
+            m_writing = false;
+        }
+
+        void ProtoEncoder::EncodingCache::startWriting() {
+            m_writing = true;
+        }
+
+        bool ProtoEncoder::EncodingCache::isWriting() const {
+            return m_writing;
+        }
+
+        uint32_t ProtoEncoder::EncodingCache::reserveLength() {
+            m_lengths.push_back(0);
+            return static_cast<uint32_t>(m_lengths.size() - 1);
+        }
+
+        uint32_t ProtoEncoder::EncodingCache::setLength(const uint32_t &slot, const uint32_t &length) {
+            m_lengths[slot] = length;
+            return length;
+        }
+
+        uint32_t ProtoEncoder::EncodingCache::getNextLength() {
+            return m_lengths[m_nextLength++];
+        }
+
+        uint32_t ProtoEncoder::EncodingCache::addBytes(string &bytes) {
+            const uint32_t length = static_cast<uint32_t>(bytes.size());
+            m_bytes.push_back(string());
+            m_bytes.back().swap(bytes);
+            return length;
+        }
+
+        const string& ProtoEncoder::EncodingCache::getNextBytes() {
+            return m_bytes[m_nextBytes++];
+        }
+
+        ProtoEncoder::EncodingScope::EncodingScope(const bool &enableCache) :
+            m_previousCache(getCurrentCache()),
+            m_cache(NULL),
+            m_usesThreadCache(false),
+            m_ownCache() {
+            if (enableCache) {
+                // Nested calls to encode() need a cache of their own.
+                m_cache = acquireThreadCache();
+                m_usesThreadCache = (m_cache != NULL);
+                if (!m_usesThreadCache) {
+                    m_cache = &m_ownCache;
+                }
+                m_cache->clear();
+            }
+            getCurrentCache() = m_cache;
+        }
+
+        ProtoEncoder::EncodingScope::~EncodingScope() {
+            if (m_usesThreadCache) {
+                releaseThreadCache();
+            }
+            getCurrentCache() = m_previousCache;
+        }
+
+        void ProtoEncoder::EncodingScope::startWriting() {
+            if (m_cache != NULL) {
+                m_cache->startWriting();
+            }
+        }
+
+        ProtoEncoder::EncodingCache*& ProtoEncoder::getCurrentCache() {
+            static thread_local EncodingCache *currentCache = NULL;
+            return currentCache;
+        }
+
+        ProtoEncoder::EncodingCache* ProtoEncoder::acquireThreadCache() {
+            static thread_local EncodingCache threadCache;
+            if (threadCacheInUse) {
+                return NULL;
+            }
+            threadCacheInUse = true;
+            return &threadCache;
+        }
+
+        void ProtoEncoder::releaseThreadCache() {
+            threadCacheInUse = false;
+        }
+
+        ProtoEncoder::EncodingCache* ProtoEncoder::getSizingCache() {
+            EncodingCache *cache = getCurrentCache();
+            return ( (cache != NULL) && !cache->isWriting() ) ? cache : NULL;
+        }
+
+        ProtoEncoder::EncodingCache* ProtoEncoder::getWritingCache() {
+            EncodingCache *cache = getCurrentCache();
+            return ( (cache != NULL) && cache->isWriting() ) ? cache : NULL;
+        }
+
+    }
+} // odcore::serialization
@@ -20,6 +20,7 @@
 #include <sstream>
 
 #include "opendavinci/odcore/serialization/ProtoSerializer.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
 #include "opendavinci/odcore/base/Visitable.h"
 
 namespace odcore {
@@ -42,7 +43,13 @@ class Serializable;
         }
 
         void ProtoSerializer::getSerializedData(ostream &o) {
-            o.write(m_buffer.str().c_str(), m_buffer.str().size());
+            const string buffer = m_buffer.str();
+            o.write(buffer.c_str(), buffer.size());
+        }
+
+        void ProtoSerializer::reset() {
+            m_buffer.str("");
+            m_buffer.clear();
         }
 
         uint64_t ProtoSerializer::getKey(const uint32_t &fieldNumber, const uint8_t &protoType) {
@@ -166,28 +173,15 @@ class Serializable;
             return static_cast<uint64_t>((value << 1) ^ (value >> 63));
         }
 
-        uint8_t ProtoSerializer::encodeVarInt(ostream &out, uint64_t value) {
-            // We will write at least one byte.
-            uint8_t size = 1;
-
-            // Protobuf's VarInt is based on little endian.
-            value = htole64(value);
-
-            char byte = 0;
-            while (value > 0x7f) {
-                // If the value to be written occupies more than 7 bits, we need to encode it using the MSB flag.
-                byte = (static_cast<uint8_t>(value & 0x7f)) | 0x80;
-                out.put(byte);
-                // Remove the seven bits that we have already written.
-                value >>= 7;
-                // Start next byte.
-                size++;
-            }
-            // Write final value.
-            byte = (static_cast<uint8_t>(value)) & 0x7f;
-            out.put(byte);
+        uint32_t ProtoSerializer::getVarIntSize(const uint64_t &value) {
+            return VarInt::getSize(value);
+        }
 
-            return size;
+        uint8_t ProtoSerializer::encodeVarInt(ostream &out, uint64_t value) {
+            char bytes[VarInt::MAX_SIZE];
+            const uint32_t size = VarInt::encode(value, bytes);
+            out.write(bytes, size);
+            return static_cast<uint8_t>(size);
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -17,10 +17,14 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "opendavinci/odcore/serialization/QueryableNetstringsDeserializerABCF.h"
 #include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
 #include "opendavinci/odcore/base/module/AbstractCIDModule.h"
 #include "opendavinci/odcore/opendavinci.h"
 
@@ -31,11 +35,13 @@ namespace odcore {
 
         QueryableNetstringsDeserializerABCF::QueryableNetstringsDeserializerABCF() :
             m_buffer(),
-            m_values() {}
+            m_payload(),
+            m_fields() {}
 
         QueryableNetstringsDeserializerABCF::QueryableNetstringsDeserializerABCF(istream &in) :
             m_buffer(),
-            m_values() {
+            m_payload(),
+            m_fields() {
             deserializeDataFrom(in);
         }
 
@@ -47,29 +53,13 @@ namespace odcore {
         }
 
         uint8_t QueryableNetstringsDeserializerABCF::decodeVarUInt(istream &in, uint64_t &value) {
-            value = 0;
-            uint8_t size = 0;
-            while (in.good()) {
-                char c = 0;
-                in.read(&c, sizeof(char));
-                value |= static_cast<unsigned int>( (c & 0x7f) << (0x7 * size++) );
-                if ( !(c & 0x80) ) break;
-            }
-            // Decode as little endian like in Protobuf's case.
-            value = le64toh(value);
-
-            return size;
+            return static_cast<uint8_t>(VarInt::decode(in, value));
         }
 
         void QueryableNetstringsDeserializerABCF::deserializeDataFrom(istream &in) {
-            // Reset any existing data in our hashmap.
-            m_values.clear();
-            m_buffer.clear();
-            m_buffer.str("");
-
-            // Initialize the stringstream for getting valid positions when calling tellp().
-            // This MUST be a blank (Win32 has a *special* implementation...)!
-            m_buffer << " ";
+            // Reset any existing data in our table.
+            m_fields.clear();
+            m_payload = ByteSpan();
 
             // Stream contents:
             // Header:
@@ -101,43 +91,99 @@ namespace odcore {
                 uint64_t length = 0;
                 decodeVarUInt(in, length);
 
-                // Decode payload consisting of: *(ID SIZE PAYLOAD).
                 char c = 0;
+                SpanStreamBuffer *span = dynamic_cast<SpanStreamBuffer*>(in.rdbuf());
+                if ( (span != NULL) && (length < static_cast<uint64_t>(span->getEnd() - span->getPosition())) ) {
+                    // Use the payload in place.
+                    m_payload = ByteSpan(span->getPosition(), static_cast<uint32_t>(length));
+                    in.ignore(length);
+                }
+                else {
+                    // Copy the payload once; read it in chunks to not trust a corrupt length.
+                    m_buffer.clear();
+                    const uint32_t MAX_SIZE_CHUNK = 65535;
+                    while (in.good() && (m_buffer.size() < length)) {
+                        const uint32_t offset = m_buffer.size();
+                        const uint32_t chunk = static_cast<uint32_t>(std::min<uint64_t>(length - offset, MAX_SIZE_CHUNK));
+                        m_buffer.resize(offset + chunk);
+                        in.read(&m_buffer[offset], chunk);
+                        m_buffer.resize(offset + in.gcount());
+                    }
+                    m_payload = ByteSpan(m_buffer);
+                }
+
+                // Decode payload consisting of: *(ID SIZE PAYLOAD).
+                buildFieldTable(m_payload);
+
+                // Check for trailing ','
+                in.read(&c, sizeof(char));
+                if (c != ',') {
+                    CLOG2 << "Stream corrupt: trailing ',' missing,  found: '" << c << "'" << endl;
+                }
+            }
+        }
+
+        void QueryableNetstringsDeserializerABCF::buildFieldTable(const ByteSpan &payload) {
+            const char *begin = payload.getData();
+            const char *end = begin + payload.getLength();
+            const char *pos = begin;
+
+            while (pos < end) {
                 uint64_t tokenIdentifier = 0;
                 uint64_t lengthOfPayload = 0;
+                if ( !VarInt::decode(pos, end, tokenIdentifier) ||
+                     !VarInt::decode(pos, end, lengthOfPayload) ||
+                     (lengthOfPayload > static_cast<uint64_t>(end - pos)) ) {
+                    CLOG2 << "Stream corrupt: field exceeds payload." << endl;
+                    break;
+                }
 
-                // Buffer to store payload "en bloc"; length is identical to UDP payload.
-                const uint32_t MAX_SIZE_PAYLOAD = 65535;
-                char buffer[MAX_SIZE_PAYLOAD];
+                Field f;
+                f.m_id = static_cast<uint32_t>(tokenIdentifier);
+                f.m_offset = static_cast<uint32_t>(pos - begin);
+                f.m_length = static_cast<uint32_t>(lengthOfPayload);
+                m_fields.push_back(f);
 
-                while (in.good() && (length > 0)) {
-                    // Start of next token by reading ID.
-                    length -= decodeVarUInt(in, tokenIdentifier);
+                pos += lengthOfPayload;
+            }
 
-                    // Read length of payload and adjust loop.
-                    lengthOfPayload = 0;
-                    length -= decodeVarUInt(in, lengthOfPayload);
+            // Fields are mostly written in ascending order; the first occurrence of an ID wins.
+            std::stable_sort(m_fields.begin(), m_fields.end());
+        }
 
-                    // Create new (tokenIdentifier, m_buffer) hashmap entry.
-                    m_values.insert(make_pair(tokenIdentifier, m_buffer.tellp()));
+        bool QueryableNetstringsDeserializerABCF::getField(const uint32_t &id, ByteSpan &value) const {
+            Field key;
+            key.m_id = id;
+            key.m_offset = 0;
+            key.m_length = 0;
 
-                    // Decode payload.
-                    if (lengthOfPayload > 0) {
-                        // Read data "en bloc".
-                        in.read(buffer, lengthOfPayload);
-                        m_buffer.write(buffer, lengthOfPayload);
+            vector<Field>::const_iterator it = std::lower_bound(m_fields.begin(), m_fields.end(), key);
+            if ( (it != m_fields.end()) && (it->m_id == id) ) {
+                value = ByteSpan(m_payload.getData() + it->m_offset, it->m_length);
+                return true;
+            }
+            return false;
+        }
 
-                        // Update amount of processed data.
-                        length -= lengthOfPayload;
-                    }
-                }
+        bool QueryableNetstringsDeserializerABCF::readVarUInt(const uint32_t &id, uint64_t &value) const {
+            ByteSpan field;
+            if (getField(id, field)) {
+                const char *pos = field.getData();
+                uint64_t tmp = 0;
+                VarInt::decode(pos, field.getData() + field.getLength(), tmp);
+                value = tmp;
+                return true;
+            }
+            return false;
+        }
 
-                // Check for trailing ','
-                in.read(&c, sizeof(char));
-                if (c != ',') {
-                    CLOG2 << "Stream corrupt: trailing ',' missing,  found: '" << c << "'" << endl;
-                }
+        bool QueryableNetstringsDeserializerABCF::readVarInt(const uint32_t &id, int64_t &value) const {
+            uint64_t uvalue = 0;
+            if (readVarUInt(id, uvalue)) {
+                value = static_cast<int64_t>( uvalue & 1 ? ~(uvalue >> 1) : (uvalue >> 1) );
+                return true;
             }
+            return false;
         }
 
         QueryableNetstringsDeserializerABCF::~QueryableNetstringsDeserializerABCF() {}
@@ -167,17 +213,7 @@ namespace odcore {
             if (magicNumber == 0xABCF) {
                 // Decode size of payload (encoded as varint).
                 uint64_t value = 0;
-                uint8_t size = 0;
-                {
-                    while (buffer.good()) {
-                        char c = 0;
-                        buffer.read(&c, sizeof(char));
-                        value |= static_cast<unsigned int>( (c & 0x7f) << (0x7 * size++) );
-                        if ( !(c & 0x80) ) break;
-                    }
-                    // Decode as little endian like in Protobuf's case.
-                    value = le64toh(value);
-                }
+                const uint8_t size = static_cast<uint8_t>(VarInt::decode(buffer, value));
 
                 bytesToRead = (value // This is the length of the payload.
                                - (sizeof(uint64_t) // We have already read this amount of bytes while peeking the header.
@@ -208,11 +244,28 @@ namespace odcore {
         ///////////////////////////////////////////////////////////////////////
 
         uint32_t QueryableNetstringsDeserializerABCF::readValue(istream &i, Serializable &v) {
-            string str_buffer;
-            uint32_t bytesRead = readValue(i, str_buffer);
-
-            stringstream sstr_str_buffer(str_buffer);
-            sstr_str_buffer >> v;
+            uint64_t length = 0;
+            uint32_t bytesRead = decodeVarUInt(i, length);
+
+            SpanStreamBuffer *span = dynamic_cast<SpanStreamBuffer*>(i.rdbuf());
+            if ( (span != NULL) && (length <= static_cast<uint64_t>(span->getEnd() - span->getPosition())) ) {
+                // Read Serializable in place.
+                SpanStreamBuffer buffer(span->getPosition(), static_cast<uint32_t>(length));
+                istream in(&buffer);
+                in >> v;
+                i.ignore(length);
+            }
+            else {
+                // Create contiguous buffer.
+                string buffer(length, '\0');
+                i.read(&buffer[0], length);
+
+                // Read Serializable from buffer.
+                SpanStreamBuffer bufferIn(buffer.data(), static_cast<uint32_t>(i.gcount()));
+                istream in(&bufferIn);
+                in >> v;
+            }
+            bytesRead += length;
 
             return bytesRead;
         }
@@ -408,144 +461,124 @@ namespace odcore {
         ///////////////////////////////////////////////////////////////////////
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, Serializable &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-
-                // Read string for serialized Serializable.
-                string str_buffer;
-                readValue(m_buffer, str_buffer);
-
-                // Read Serializable from string.
-                stringstream sstr_buffer(str_buffer);
-                sstr_buffer >> v;
+            ByteSpan field;
+            if (getField(id, field)) {
+                const char *pos = field.getData();
+                const char *end = pos + field.getLength();
+                uint64_t length = 0;
+                if (VarInt::decode(pos, end, length) && (length <= static_cast<uint64_t>(end - pos))) {
+                    // Read Serializable from its sub-span without copying.
+                    SpanStreamBuffer buffer(pos, static_cast<uint32_t>(length));
+                    istream in(&buffer);
+                    in >> v;
+                }
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, bool &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            uint64_t tmp = 0;
+            if (readVarUInt(id, tmp)) {
+                v = (tmp != 0);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, char &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            int64_t tmp = 0;
+            if (readVarInt(id, tmp)) {
+                v = static_cast<char>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, unsigned char &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            uint64_t tmp = 0;
+            if (readVarUInt(id, tmp)) {
+                v = static_cast<unsigned char>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, int8_t &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            int64_t tmp = 0;
+            if (readVarInt(id, tmp)) {
+                v = static_cast<int8_t>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, int16_t &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            int64_t tmp = 0;
+            if (readVarInt(id, tmp)) {
+                v = static_cast<int16_t>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, uint16_t &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            uint64_t tmp = 0;
+            if (readVarUInt(id, tmp)) {
+                v = static_cast<uint16_t>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, int32_t &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            int64_t tmp = 0;
+            if (readVarInt(id, tmp)) {
+                v = static_cast<int32_t>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, uint32_t &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            uint64_t tmp = 0;
+            if (readVarUInt(id, tmp)) {
+                v = static_cast<uint32_t>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, int64_t &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            int64_t tmp = 0;
+            if (readVarInt(id, tmp)) {
+                v = static_cast<int64_t>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, uint64_t &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            uint64_t tmp = 0;
+            if (readVarUInt(id, tmp)) {
+                v = static_cast<uint64_t>(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, float &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            ByteSpan field;
+            if (getField(id, field) && (field.getLength() >= sizeof(float))) {
+                float tmp = 0;
+                memcpy(&tmp, field.getData(), sizeof(float));
+                v = Deserializer::ntohf(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, double &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            ByteSpan field;
+            if (getField(id, field) && (field.getLength() >= sizeof(double))) {
+                double tmp = 0;
+                memcpy(&tmp, field.getData(), sizeof(double));
+                v = Deserializer::ntohd(tmp);
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, string &v) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, v);
+            ByteSpan field;
+            if (getField(id, field)) {
+                const char *pos = field.getData();
+                const char *end = pos + field.getLength();
+                uint64_t length = 0;
+                if (VarInt::decode(pos, end, length) && (length <= static_cast<uint64_t>(end - pos))) {
+                    v.assign(pos, static_cast<size_t>(length));
+                }
             }
         }
 
         void QueryableNetstringsDeserializerABCF::read(const uint32_t &id, const string &/*longName*/, const string &/*shortName*/, void *data, const uint32_t &size) {
-            map<uint32_t, streampos>::iterator it = m_values.find(id);
-
-            if (it != m_values.end()) {
-                m_buffer.seekg(it->second);
-                readValue(m_buffer, data, size);
+            ByteSpan field;
+            if (getField(id, field)) {
+                memcpy(data, field.getData(), std::min(size, field.getLength()));
             }
         }
     }
@@ -49,6 +49,12 @@ class Serializable;
             m_serializer->getSerializedData(o);
         }
 
+        void QueryableNetstringsSerializer::reset() {
+            m_aacf.reset();
+            m_abcf.reset();
+            m_serializer = &m_abcf;
+        }
+
         ///////////////////////////////////////////////////////////////////////
 
         uint32_t QueryableNetstringsSerializer::writeValue(ostream &o, const Serializable &v) {
@@ -48,6 +48,11 @@ namespace odcore {
             o << ",";
         }
 
+        void QueryableNetstringsSerializerAACF::reset() {
+            m_buffer.str("");
+            m_buffer.clear();
+        }
+
         ///////////////////////////////////////////////////////////////////////
 
         uint32_t QueryableNetstringsSerializerAACF::writeValue(ostream &o, const Serializable &v) {
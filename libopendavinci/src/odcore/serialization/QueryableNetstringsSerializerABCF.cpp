@@ -19,6 +19,7 @@
 
 #include "opendavinci/odcore/serialization/QueryableNetstringsSerializerABCF.h"
 #include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
 
 namespace odcore {
     namespace serialization {
@@ -36,25 +37,10 @@ namespace odcore {
         }
 
         uint8_t QueryableNetstringsSerializerABCF::encodeVarUInt(ostream &out, uint64_t value) {
-            // We will write at least one byte.
-            uint8_t size = 1;
-
-            value = htole64(value);
-
-            char byte = 0;
-            while (value > 0x7f) {
-                // If the value to be written occupies more than 7 bits, we need to encode it using the MSB flag.
-                byte = (static_cast<uint8_t>(value & 0x7f)) | 0x80;
-                out.put(byte);
-                // Remove the seven bits that we have already written.
-                value >>= 7;
-                // Start next byte.
-                size++;
-            }
-            // Write final value.
-            byte = (static_cast<uint8_t>(value)) & 0x7f;
-            out.put(byte);
-            return size;
+            char bytes[VarInt::MAX_SIZE];
+            const uint32_t size = VarInt::encode(value, bytes);
+            out.write(bytes, size);
+            return static_cast<uint8_t>(size);
         }
 
         void QueryableNetstringsSerializerABCF::getSerializedData(ostream &o) {
@@ -75,6 +61,11 @@ namespace odcore {
             o << ",";
         }
 
+        void QueryableNetstringsSerializerABCF::reset() {
+            m_buffer.str("");
+            m_buffer.clear();
+        }
+
         ///////////////////////////////////////////////////////////////////////
 
         uint32_t QueryableNetstringsSerializerABCF::writeValue(ostream &o, const Serializable &v) {
@@ -53,6 +53,13 @@ class Serializable;
             o << m_buffer.str();
         }
 
+        void ROSSerializerVisitor::reset() {
+            m_messageId = 0;
+            m_size = 0;
+            m_buffer.str("");
+            m_buffer.clear();
+        }
+
         void ROSSerializerVisitor::write(const uint32_t &/*id*/, const Serializable &/*v*/) {}
 
         void ROSSerializerVisitor::write(const uint32_t &/*id*/, const bool &v) {
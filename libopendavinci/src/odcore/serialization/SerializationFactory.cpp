@@ -17,12 +17,27 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
 #include "opendavinci/odcore/serialization/Deserializer.h"
 #include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Visitor.h"
+#include "opendavinci/odcore/serialization/LCMDeserializerVisitor.h"
+#include "opendavinci/odcore/serialization/LCMSerializerVisitor.h"
 #include "opendavinci/odcore/serialization/ProtoDeserializer.h"
+#include "opendavinci/odcore/serialization/ProtoDeserializerVisitor.h"
 #include "opendavinci/odcore/serialization/ProtoSerializer.h"
+#include "opendavinci/odcore/serialization/ProtoSerializerVisitor.h"
 #include "opendavinci/odcore/serialization/QueryableNetstringsDeserializer.h"
+#include "opendavinci/odcore/serialization/QueryableNetstringsDeserializerVisitor.h"
 #include "opendavinci/odcore/serialization/QueryableNetstringsSerializer.h"
+#include "opendavinci/odcore/serialization/QueryableNetstringsSerializerVisitor.h"
+#include "opendavinci/odcore/serialization/ROSDeserializerVisitor.h"
+#include "opendavinci/odcore/serialization/ROSSerializerVisitor.h"
 #include "opendavinci/odcore/serialization/SerializationFactory.h"
 #include "opendavinci/odcore/serialization/Serializer.h"
 
@@ -31,6 +46,184 @@ namespace odcore {
 
         using namespace std;
 
+        namespace {
+
+            template<typename T> class Pool;
+
+            /**
+             * An entry of a Pool holding one instance and the memory for
+             * the control block of the shared_ptr that is handed out.
+             */
+            template<typename T>
+            class Slot {
+                private:
+                    Slot(const Slot &);
+                    Slot& operator=(const Slot &);
+
+                public:
+                    // Enough for the control blocks of libstdc++ and libc++; larger ones are allocated.
+                    enum { CONTROL_BLOCK_SIZE = 128 };
+
+                    Slot(Pool<T> &pool) :
+                        m_instance(),
+                        m_controlBlock(),
+                        m_pool(&pool) {}
+
+                    T m_instance;
+                    typename std::aligned_storage<CONTROL_BLOCK_SIZE>::type m_controlBlock;
+                    Pool<T> *m_pool;
+            };
+
+            /**
+             * This class keeps serializers or deserializers of one type
+             * for reuse. The pool grows to the number of instances that
+             * are used concurrently and never shrinks.
+             */
+            template<typename T>
+            class Pool {
+                private:
+                    Pool(const Pool &);
+                    Pool& operator=(const Pool &);
+
+                public:
+                    Pool() :
+                        m_mutex(),
+                        m_idle() {}
+
+                    Slot<T>* acquire() {
+                        odcore::base::Lock l(m_mutex);
+                        if (m_idle.empty()) {
+                            // Reserve room for returning the new instance to avoid allocating later.
+                            m_idle.reserve(m_idle.capacity() + 1);
+                            return new Slot<T>(*this);
+                        }
+                        Slot<T> *slot = m_idle.back();
+                        m_idle.pop_back();
+                        return slot;
+                    }
+
+                    void release(Slot<T> *slot) {
+                        odcore::base::Lock l(m_mutex);
+                        m_idle.push_back(slot);
+                    }
+
+                private:
+                    odcore::base::Mutex m_mutex;
+                    vector<Slot<T>*> m_idle;
+            };
+
+            /**
+             * This allocator places the control block of a shared_ptr into
+             * its Slot; the Slot is returned to its Pool once the control
+             * block is destroyed, i.e. after the deleter was called.
+             */
+            template<typename U, typename T>
+            class SlotAllocator {
+                public:
+                    typedef U value_type;
+
+                    SlotAllocator(Slot<T> &slot) :
+                        m_slot(&slot) {}
+
+                    SlotAllocator(const SlotAllocator &obj) :
+                        m_slot(obj.m_slot) {}
+
+                    template<typename V>
+                    SlotAllocator(const SlotAllocator<V, T> &obj) :
+                        m_slot(obj.getSlot()) {}
+
+                    SlotAllocator& operator=(const SlotAllocator &obj) {
+                        m_slot = obj.m_slot;
+                        return *this;
+                    }
+
+                    U* allocate(std::size_t n) {
+                        if ( (n * sizeof(U)) <= sizeof(m_slot->m_controlBlock) ) {
+                            return reinterpret_cast<U*>(&m_slot->m_controlBlock);
+                        }
+                        return static_cast<U*>(::operator new(n * sizeof(U)));
+                    }
+
+                    void deallocate(U *p, std::size_t /*n*/) {
+                        if (reinterpret_cast<void*>(p) != reinterpret_cast<void*>(&m_slot->m_controlBlock)) {
+                            ::operator delete(p);
+                        }
+                        m_slot->m_pool->release(m_slot);
+                    }
+
+                    Slot<T>* getSlot() const {
+                        return m_slot;
+                    }
+
+                private:
+                    Slot<T> *m_slot;
+            };
+
+            template<typename U, typename V, typename T>
+            bool operator==(const SlotAllocator<U, T> &a, const SlotAllocator<V, T> &b) {
+                return a.getSlot() == b.getSlot();
+            }
+
+            template<typename U, typename V, typename T>
+            bool operator!=(const SlotAllocator<U, T> &a, const SlotAllocator<V, T> &b) {
+                return a.getSlot() != b.getSlot();
+            }
+
+            /**
+             * Deleter writing the serialized data to the stream given by
+             * the caller and resetting the serializer for reuse.
+             */
+            template<typename T>
+            class FlushAndReset {
+                public:
+                    FlushAndReset(ostream &out) :
+                        m_out(&out) {}
+
+                    FlushAndReset(const FlushAndReset &obj) :
+                        m_out(obj.m_out) {}
+
+                    FlushAndReset& operator=(const FlushAndReset &obj) {
+                        m_out = obj.m_out;
+                        return *this;
+                    }
+
+                    void operator()(T *serializer) const {
+                        serializer->getSerializedData(*m_out);
+                        serializer->reset();
+                    }
+
+                private:
+                    ostream *m_out; // The caller is responsible for the lifecycle of the stream.
+            };
+
+            /**
+             * Deleter for deserializers; they are reset when data is
+             * deserialized the next time.
+             */
+            template<typename T>
+            class Keep {
+                public:
+                    void operator()(T* /*deserializer*/) const {}
+            };
+
+            template<typename B, typename T>
+            std::shared_ptr<B> leaseSerializer(ostream &out) {
+                // The pools are never destroyed as instances might be in use during shutdown.
+                static Pool<T> *pool = new Pool<T>();
+                Slot<T> *slot = pool->acquire();
+                return std::shared_ptr<B>(&slot->m_instance, FlushAndReset<T>(out), SlotAllocator<T, T>(*slot));
+            }
+
+            template<typename B, typename T>
+            std::shared_ptr<B> leaseDeserializer(istream &in) {
+                // The pools are never destroyed as instances might be in use during shutdown.
+                static Pool<T> *pool = new Pool<T>();
+                Slot<T> *slot = pool->acquire();
+                slot->m_instance.deserializeDataFrom(in);
+                return std::shared_ptr<B>(&slot->m_instance, Keep<T>(), SlotAllocator<T, T>(*slot));
+            }
+        }
+
         odcore::base::Mutex SerializationFactory::m_singletonMutex;
         SerializationFactory* SerializationFactory::m_singleton = NULL;
 
@@ -62,19 +255,51 @@ namespace odcore {
         }
 
         std::shared_ptr<Serializer> SerializationFactory::getSerializer(ostream &out) const {
-            return std::shared_ptr<Serializer>(new ProtoSerializer(out));
+            return leaseSerializer<Serializer, ProtoSerializer>(out);
         }
 
         std::shared_ptr<Deserializer> SerializationFactory::getDeserializer(istream &in) const {
-            return std::shared_ptr<Deserializer>(new ProtoDeserializer(in));
+            return leaseDeserializer<Deserializer, ProtoDeserializer>(in);
         }
 
         std::shared_ptr<Serializer> SerializationFactory::getQueryableNetstringsSerializer(ostream &out) const {
-            return std::shared_ptr<Serializer>(new QueryableNetstringsSerializer(out));
+            return leaseSerializer<Serializer, QueryableNetstringsSerializer>(out);
         }
 
         std::shared_ptr<Deserializer> SerializationFactory::getQueryableNetstringsDeserializer(istream &in) const {
-            return std::shared_ptr<Deserializer>(new QueryableNetstringsDeserializer(in));
+            return leaseDeserializer<Deserializer, QueryableNetstringsDeserializer>(in);
+        }
+
+        std::shared_ptr<odcore::base::Visitor> SerializationFactory::getSerializerVisitor(const WIRE_FORMAT &format, ostream &out) const {
+            switch (format) {
+                case QUERYABLE_NETSTRINGS:
+                    return leaseSerializer<odcore::base::Visitor, QueryableNetstringsSerializerVisitor>(out);
+                case LCM:
+                    return leaseSerializer<odcore::base::Visitor, LCMSerializerVisitor>(out);
+                case ROS:
+                    return leaseSerializer<odcore::base::Visitor, ROSSerializerVisitor>(out);
+                case PROTO:
+                default:
+                    return leaseSerializer<odcore::base::Visitor, ProtoSerializerVisitor>(out);
+            }
+        }
+
+        std::shared_ptr<odcore::base::Visitor> SerializationFactory::getDeserializerVisitor(const WIRE_FORMAT &format, istream &in) const {
+            switch (format) {
+                case QUERYABLE_NETSTRINGS:
+                    return leaseDeserializer<odcore::base::Visitor, QueryableNetstringsDeserializerVisitor>(in);
+                case LCM:
+                    return leaseDeserializer<odcore::base::Visitor, LCMDeserializerVisitor>(in);
+                case ROS:
+                    return leaseDeserializer<odcore::base::Visitor, ROSDeserializerVisitor>(in);
+                case PROTO:
+                default:
+                    return leaseDeserializer<odcore::base::Visitor, ProtoDeserializerVisitor>(in);
+            }
+        }
+
+        bool SerializationFactory::usesDefaultSerialization() const {
+            return (typeid(*this) == typeid(SerializationFactory));
         }
 
     }
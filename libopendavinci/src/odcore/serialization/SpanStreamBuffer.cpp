@@ -0,0 +1,75 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        SpanStreamBuffer::SpanStreamBuffer(const char *data, const uint32_t &length) :
+            std::streambuf() {
+            // The get area is only read from; thus, removing const is safe.
+            char *begin = const_cast<char*>(data);
+            setg(begin, begin, begin + ((data != NULL) ? length : 0));
+        }
+
+        SpanStreamBuffer::~SpanStreamBuffer() {}
+
+        const char* SpanStreamBuffer::getPosition() const {
+            return gptr();
+        }
+
+        const char* SpanStreamBuffer::getEnd() const {
+            return egptr();
+        }
+
+        void SpanStreamBuffer::consume() {
+            setg(eback(), egptr(), egptr());
+        }
+
+        SpanStreamBuffer::pos_type SpanStreamBuffer::seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which) {
+            if (!(which & ios_base::in)) {
+                return pos_type(off_type(-1));
+            }
+
+            char *position = gptr();
+            if (ios_base::beg == dir) {
+                position = eback();
+            }
+            else if (ios_base::end == dir) {
+                position = egptr();
+            }
+
+            if ( (off < (eback() - position)) || (off > (egptr() - position)) ) {
+                return pos_type(off_type(-1));
+            }
+
+            position += off;
+            setg(eback(), position, egptr());
+            return pos_type(off_type(position - eback()));
+        }
+
+        SpanStreamBuffer::pos_type SpanStreamBuffer::seekpos(pos_type pos, ios_base::openmode which) {
+            return seekoff(off_type(pos), ios_base::beg, which);
+        }
+
+    }
+} // odcore::serialization
@@ -0,0 +1,162 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#include <streambuf>
+
+#include "opendavinci/odcore/serialization/VarInt.h"
+
+namespace odcore {
+    namespace serialization {
+
+        using namespace std;
+
+        const uint32_t VarInt::MAX_SIZE;
+
+        /**
+         * This function checks the window of bytes at the given position
+         * at once for bytes with MSB set.
+         *
+         * @param pos Current position.
+         * @param end Pointer behind the last available byte.
+         * @param allSingleByteValues true if the window contains only single byte values.
+         * @return Size of the checked window or 0 if no window could be checked.
+         */
+        static inline uint32_t checkWindow(const char *pos, const char *end, bool &allSingleByteValues) {
+#if defined(__AVX2__)
+            if ((end - pos) >= 32) {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+                allSingleByteValues = (0 == _mm256_movemask_epi8(chunk));
+                return 32;
+            }
+#elif defined(__SSE2__)
+            if ((end - pos) >= 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+                allSingleByteValues = (0 == _mm_movemask_epi8(chunk));
+                return 16;
+            }
+#else
+            (void)pos;
+            (void)end;
+#endif
+            allSingleByteValues = false;
+            return 0;
+        }
+
+        uint32_t VarInt::getSize(const uint64_t &value) {
+            // Each byte carries seven bits of the value.
+            uint32_t size = 1;
+            uint64_t v = value;
+            while (v > 0x7f) {
+                v >>= 7;
+                size++;
+            }
+            return size;
+        }
+
+        uint32_t VarInt::encode(uint64_t value, char *out) {
+            uint32_t size = 0;
+            while (value > 0x7f) {
+                // If the value to be written occupies more than 7 bits, we need to encode it using the MSB flag.
+                out[size++] = static_cast<char>((value & 0x7f) | 0x80);
+                // Remove the seven bits that we have already written.
+                value >>= 7;
+            }
+            // Write final value.
+            out[size++] = static_cast<char>(value);
+            return size;
+        }
+
+        bool VarInt::decodeSlow(const char *&pos, const char *end, uint64_t &value) {
+            const char *p = pos;
+            uint64_t v = 0;
+            uint32_t shift = 0;
+            while ( (p < end) && (shift < (7 * MAX_SIZE)) ) {
+                const uint8_t byte = static_cast<uint8_t>(*p++);
+                v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (0 == (byte & 0x80)) {
+                    value = v;
+                    pos = p;
+                    return true;
+                }
+                shift += 7;
+            }
+            return false;
+        }
+
+        uint32_t VarInt::decode(istream &in, uint64_t &value) {
+            value = 0;
+            uint32_t size = 0;
+            if (in.good() && (in.rdbuf() != NULL)) {
+                // Read from the stream buffer directly to avoid constructing a sentry per byte.
+                streambuf *buffer = in.rdbuf();
+                while (size < MAX_SIZE) {
+                    const int c = buffer->sbumpc();
+                    if (streambuf::traits_type::eof() == c) {
+                        in.setstate(ios_base::eofbit | ios_base::failbit);
+                        break;
+                    }
+                    value |= static_cast<uint64_t>(c & 0x7f) << (7 * size++);
+                    if (0 == (c & 0x80)) {
+                        break;
+                    }
+                }
+            }
+            return size;
+        }
+
+        uint32_t VarInt::decodePacked(const char *&pos, const char *end, uint64_t *values, const uint32_t &capacity) {
+            uint32_t count = 0;
+            const char *p = pos;
+            bool complete = true;
+            while ( complete && (count < capacity) && (p < end) ) {
+                bool allSingleByteValues = false;
+                const uint32_t window = checkWindow(p, end, allSingleByteValues);
+                if (allSingleByteValues && (window <= (capacity - count))) {
+                    // Widen the complete window at once.
+                    for (uint32_t i = 0; i < window; i++) {
+                        values[count + i] = static_cast<uint8_t>(p[i]);
+                    }
+                    count += window;
+                    p += window;
+                }
+                else {
+                    // Decode the values within the window (or the next value) one by one.
+                    const char *windowEnd = p + ((window > 0) ? window : 1);
+                    while ( (p < windowEnd) && (count < capacity) ) {
+                        uint64_t value = 0;
+                        complete = decode(p, end, value);
+                        if (!complete) {
+                            break;
+                        }
+                        values[count++] = value;
+                    }
+                }
+            }
+            pos = p;
+            return count;
+        }
+
+    }
+} // odcore::serialization
@@ -0,0 +1,283 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+#endif
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/io/Reactor.h"
+#include "opendavinci/odcore/wrapper/ConcurrencyFactory.h"
+#include "opendavinci/odcore/wrapper/POSIX/POSIXReactor.h"
+#include "opendavinci/odcore/wrapper/Thread.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace POSIX {
+
+            using namespace std;
+            using namespace odcore::base;
+
+            // Initialize singleton instance.
+            odcore::base::Mutex POSIXReactor::m_singletonMutex;
+            POSIXReactor* POSIXReactor::m_singleton = NULL;
+
+            POSIXReactor::Handler::~Handler() {}
+
+            POSIXReactor::Worker::Worker(POSIXReactor &reactor) :
+                m_reactor(reactor),
+                m_thread() {
+                m_thread = unique_ptr<Thread>(ConcurrencyFactory::createThread(*this));
+                if (m_thread.get() == NULL) {
+                    stringstream s;
+                    s << "[core::wrapper::POSIXReactor] Error creating thread: " << strerror(errno);
+                    throw s.str();
+                }
+            }
+
+            POSIXReactor::Worker::~Worker() {
+                stop();
+            }
+
+            void POSIXReactor::Worker::start() {
+                m_thread->start();
+            }
+
+            void POSIXReactor::Worker::stop() {
+                m_thread->stop();
+            }
+
+            bool POSIXReactor::Worker::isRunning() {
+                return m_thread->isRunning();
+            }
+
+            void POSIXReactor::Worker::run() {
+                m_reactor.serve(*this);
+            }
+
+            POSIXReactor::Registration::Registration() :
+                m_fileDescriptor(-1),
+                m_handler(NULL),
+                m_dispatching(false),
+                m_removed(false),
+                m_dispatcher() {}
+
+            POSIXReactor::Registration::Registration(const int32_t &fileDescriptor, Handler *handler) :
+                m_fileDescriptor(fileDescriptor),
+                m_handler(handler),
+                m_dispatching(false),
+                m_removed(false),
+                m_dispatcher() {}
+
+            POSIXReactor::POSIXReactor() :
+                m_epollFileDescriptor(-1),
+                m_wakeUpFileDescriptor(-1),
+                m_workersMutex(),
+                m_workers(),
+                m_registrationsCondition(),
+                m_nextRegistration(0),
+                m_registrations() {
+#ifdef __linux__
+                m_epollFileDescriptor = epoll_create1(EPOLL_CLOEXEC);
+                m_wakeUpFileDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+                if (m_wakeUpFileDescriptor >= 0) {
+                    // The wake up event is identified by registration 0.
+                    struct epoll_event event;
+                    memset(&event, 0, sizeof(event));
+                    event.events = EPOLLIN;
+                    event.data.u64 = 0;
+                    epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_ADD, m_wakeUpFileDescriptor, &event);
+                }
+#endif
+            }
+
+            POSIXReactor::~POSIXReactor() {
+                // Let all workers return from waiting; the wake up event
+                // remains signaled until all workers are stopped.
+                if (m_wakeUpFileDescriptor >= 0) {
+                    const uint64_t ONE = 1;
+                    if (write(m_wakeUpFileDescriptor, &ONE, sizeof(ONE)) < 0) {
+                        // Workers will recognize being stopped on their next event.
+                    }
+                }
+
+                {
+                    Lock l(m_workersMutex);
+                    m_workers.clear();
+                }
+
+                if (m_wakeUpFileDescriptor >= 0) {
+                    close(m_wakeUpFileDescriptor);
+                }
+                if (m_epollFileDescriptor >= 0) {
+                    close(m_epollFileDescriptor);
+                }
+            }
+
+            POSIXReactor& POSIXReactor::getInstance() {
+                {
+                    Lock l(POSIXReactor::m_singletonMutex);
+                    if (POSIXReactor::m_singleton == NULL) {
+                        POSIXReactor::m_singleton = new POSIXReactor();
+                    }
+                }
+
+                return (*POSIXReactor::m_singleton);
+            }
+
+            uint64_t POSIXReactor::add(const int32_t &fileDescriptor, Handler *handler) {
+                const uint32_t NUMBER_OF_THREADS = odcore::io::Reactor::getNumberOfThreads();
+                if ( (NUMBER_OF_THREADS == 0) || (m_epollFileDescriptor < 0) || (handler == NULL) ) {
+                    return 0;
+                }
+
+                {
+                    Lock l(m_workersMutex);
+                    while (m_workers.size() < NUMBER_OF_THREADS) {
+                        std::shared_ptr<Worker> worker(new Worker(*this));
+                        worker->start();
+                        m_workers.push_back(worker);
+                    }
+                }
+
+                uint64_t registration = 0;
+#ifdef __linux__
+                Lock l(m_registrationsCondition);
+                registration = ++m_nextRegistration;
+                m_registrations[registration] = Registration(fileDescriptor, handler);
+
+                // Sockets are disarmed after each event so that only one
+                // thread at a time handles a socket.
+                struct epoll_event event;
+                memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN | EPOLLONESHOT;
+                event.data.u64 = registration;
+                if (epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_ADD, fileDescriptor, &event) < 0) {
+                    m_registrations.erase(registration);
+                    registration = 0;
+                }
+#endif
+                return registration;
+            }
+
+            void POSIXReactor::remove(const uint64_t &registration) {
+                Lock l(m_registrationsCondition);
+                map<uint64_t, Registration>::iterator it = m_registrations.find(registration);
+                if (it == m_registrations.end()) {
+                    return;
+                }
+
+#ifdef __linux__
+                struct epoll_event event;
+                memset(&event, 0, sizeof(event));
+                epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_DEL, it->second.m_fileDescriptor, &event);
+#endif
+
+                if (!it->second.m_dispatching) {
+                    m_registrations.erase(it);
+                    return;
+                }
+
+                // The dispatching thread erases the registration.
+                it->second.m_removed = true;
+                if (pthread_equal(it->second.m_dispatcher, pthread_self())) {
+                    return;
+                }
+
+                while (m_registrations.count(registration) > 0) {
+                    m_registrationsCondition.waitOnSignal();
+                }
+            }
+
+            uint32_t POSIXReactor::getNumberOfThreads() const {
+                Lock l(m_workersMutex);
+                return static_cast<uint32_t>(m_workers.size());
+            }
+
+            void POSIXReactor::serve(Worker &worker) {
+#ifdef __linux__
+                struct epoll_event events[MAX_EVENTS];
+
+                while (worker.isRunning()) {
+                    const int32_t numberOfEvents = epoll_wait(m_epollFileDescriptor, events, MAX_EVENTS, -1);
+                    for (int32_t i = 0; i < numberOfEvents; i++) {
+                        if (events[i].data.u64 != 0) {
+                            dispatch(events[i].data.u64);
+                        }
+                    }
+                }
+#else
+                (void)worker;
+#endif
+            }
+
+            void POSIXReactor::dispatch(const uint64_t &registration) {
+                Handler *handler = NULL;
+                {
+                    Lock l(m_registrationsCondition);
+                    map<uint64_t, Registration>::iterator it = m_registrations.find(registration);
+                    if (it == m_registrations.end()) {
+                        return;
+                    }
+                    it->second.m_dispatching = true;
+                    it->second.m_dispatcher = pthread_self();
+                    handler = it->second.m_handler;
+                }
+
+                const bool CONTINUE = handler->onReadable();
+
+                Lock l(m_registrationsCondition);
+                map<uint64_t, Registration>::iterator it = m_registrations.find(registration);
+                if (it == m_registrations.end()) {
+                    return;
+                }
+                it->second.m_dispatching = false;
+
+                if (it->second.m_removed || !CONTINUE) {
+#ifdef __linux__
+                    if (!it->second.m_removed) {
+                        struct epoll_event event;
+                        memset(&event, 0, sizeof(event));
+                        epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_DEL, it->second.m_fileDescriptor, &event);
+                    }
+#endif
+                    m_registrations.erase(it);
+                    m_registrationsCondition.wakeAll();
+                    return;
+                }
+
+#ifdef __linux__
+                // Re-arm the socket for the next event.
+                struct epoll_event event;
+                memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN | EPOLLONESHOT;
+                event.data.u64 = registration;
+                epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_MOD, it->second.m_fileDescriptor, &event);
+#endif
+            }
+
+        }
+    }
+} // odcore::wrapper::POSIX
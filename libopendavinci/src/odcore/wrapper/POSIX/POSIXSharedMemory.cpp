@@ -38,10 +38,11 @@ namespace odcore {
 
             using namespace std;
 
-            POSIXSharedMemory::POSIXSharedMemory(const string &name, const uint32_t &size) :
+            POSIXSharedMemory::POSIXSharedMemory(const string &name, const uint32_t &size, const bool &exclusive) :
                 m_name(name),
                 m_internalName(name),
                 m_releaseSharedMemory(true),
+                m_exclusive(exclusive),
                 m_shmID(0),
                 m_mutexSharedMemory(NULL),
                 m_sharedMemory(NULL),
@@ -61,10 +62,13 @@ namespace odcore {
                         m_internalName.resize(MAX_NAME_LENGTH);
                     }
 
-                    // 1. Try to cleanup a potentially uncleanly existing semaphore.
-                    int retVal = sem_unlink(m_internalName.c_str());
-                    if ( (0 != retVal) && (EACCES == errno) ) {
-                        CLOG3 << "[POSIXSharedMemory] Semaphore could not be created, errno: " << errno << "; " << ::strerror(errno) << endl;
+                    // 1. Try to cleanup a potentially uncleanly existing semaphore; it might still be in use when creating exclusively.
+                    int retVal = 0;
+                    if (!m_exclusive) {
+                        retVal = sem_unlink(m_internalName.c_str());
+                        if ( (0 != retVal) && (EACCES == errno) ) {
+                            CLOG3 << "[POSIXSharedMemory] Semaphore could not be created, errno: " << errno << "; " << ::strerror(errno) << endl;
+                        }
                     }
 
                     // 2. Create semaphore with the given name.
@@ -80,7 +84,7 @@ namespace odcore {
 
                         // 3. Try to find an uncleanly existing shared memory segment to be removed.
                         retVal = 0;
-                        m_shmID = shmget(hash, size + sizeof(uint32_t), S_IRUSR | S_IWUSR);
+                        m_shmID = m_exclusive ? -1 : shmget(hash, size + sizeof(uint32_t), S_IRUSR | S_IWUSR);
                         if (!(m_shmID < 0)) {
                             clog << "[POSIXSharedMemory] Found existing shared memory; trying to remove...";
                             // Remove shared memory if released by other processes.
@@ -94,8 +98,14 @@ namespace odcore {
 
                         // 4. Create the requested shared memory segment with this name.
                         if (0 == retVal) {
-                            m_shmID = shmget(hash, size + sizeof(uint32_t), IPC_CREAT | S_IRUSR | S_IWUSR);
-                            if (m_shmID < 0) {
+                            m_shmID = shmget(hash, size + sizeof(uint32_t), IPC_CREAT | (m_exclusive ? IPC_EXCL : 0) | S_IRUSR | S_IWUSR);
+                            if ( (m_shmID < 0) && m_exclusive && (EEXIST == errno) ) {
+                                // Another process created the shared memory already.
+                                sem_close(m_mutexSharedMemory);
+                                m_mutexSharedMemory = NULL;
+                                m_releaseSharedMemory = false;
+                            }
+                            else if (m_shmID < 0) {
                                 CLOG3 << "[POSIXSharedMemory] Shared memory could not be requested, errno: " << errno << "; " << ::strerror(errno) << endl;
                                 sem_unlink(m_internalName.c_str());
                                 m_mutexSharedMemory = NULL;
@@ -114,6 +124,7 @@ namespace odcore {
                 m_name(name),
                 m_internalName(name),
                 m_releaseSharedMemory(false),
+                m_exclusive(false),
                 m_shmID(0),
                 m_mutexSharedMemory(NULL),
                 m_sharedMemory(NULL),
@@ -177,8 +188,10 @@ namespace odcore {
                         sem_close(m_mutexSharedMemory);
                     }
 
-                    // Remove semaphore.
-                    sem_unlink(m_internalName.c_str());
+                    // Remove semaphore unless another process might have replaced the exclusively created shared memory meanwhile.
+                    if (!m_exclusive) {
+                        sem_unlink(m_internalName.c_str());
+                    }
 
                     // Detach shared memory.
                     shmdt(m_sharedMemory);
@@ -195,6 +208,13 @@ namespace odcore {
                 return ((m_mutexSharedMemory != NULL) && (m_sharedMemory != NULL));
             }
 
+            void POSIXSharedMemory::remove() {
+                if (m_sharedMemory != NULL) {
+                    // The shared memory is destroyed after the last process detached.
+                    shmctl(m_shmID, IPC_RMID, 0);
+                }
+            }
+
             const string POSIXSharedMemory::getName() const {
                 return m_name;
             }
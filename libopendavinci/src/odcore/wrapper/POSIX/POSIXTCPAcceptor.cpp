@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <fcntl.h>
 #include <netinet/in.h>
 #include <sys/select.h>
 #include <sys/socket.h>
@@ -43,6 +44,7 @@ namespace odcore {
 
             POSIXTCPAcceptor::POSIXTCPAcceptor(const uint32_t &port) :
                 m_thread(),
+                m_registration(0),
                 m_listenerMutex(),
                 m_listener(NULL),
                 m_fileDescriptor(0),
@@ -105,6 +107,7 @@ namespace odcore {
 
             POSIXTCPAcceptor::~POSIXTCPAcceptor() {
                 setAcceptorListener(NULL);
+                stop();
                 close(m_fileDescriptor);
             }
 
@@ -126,10 +129,24 @@ namespace odcore {
             }
 
             void POSIXTCPAcceptor::start() {
-                m_thread->start();
+                // A shared I/O thread must not block in accept if the pending connection vanished meanwhile.
+                fcntl(m_fileDescriptor, F_SETFL, fcntl(m_fileDescriptor, F_GETFL) | O_NONBLOCK);
+
+                m_registration = POSIXReactor::getInstance().add(m_fileDescriptor, this);
+                if (m_registration == 0) {
+                    m_thread->start();
+                }
             }
 
             void POSIXTCPAcceptor::stop() {
+                if (m_registration != 0) {
+                    POSIXReactor::getInstance().remove(m_registration);
+                    m_registration = 0;
+
+                    // Mirror the end of run().
+                    close(m_fileDescriptor);
+                    m_fileDescriptor = -1;
+                }
                 m_thread->stop();
             }
 
@@ -151,18 +168,27 @@ namespace odcore {
                     select(m_fileDescriptor + 1, &rfds, NULL, NULL, &timeout);
 
                     if (FD_ISSET(m_fileDescriptor, &rfds)) {
-                        sockaddr clientsock;
-                        socklen_t csize = sizeof(clientsock);
-
-                        int32_t client = accept(m_fileDescriptor, &clientsock, &csize);
-                        if (client >= 0) {
-                            invokeAcceptorListener(std::shared_ptr<odcore::io::tcp::TCPConnection>(new POSIXTCPConnection(client)));
-                        }
+                        acceptConnection();
                     }
                 }
                 close(m_fileDescriptor);
             }
 
+            bool POSIXTCPAcceptor::onReadable() {
+                acceptConnection();
+                return true;
+            }
+
+            void POSIXTCPAcceptor::acceptConnection() {
+                sockaddr clientsock;
+                socklen_t csize = sizeof(clientsock);
+
+                int32_t client = accept(m_fileDescriptor, &clientsock, &csize);
+                if (client >= 0) {
+                    invokeAcceptorListener(std::shared_ptr<odcore::io::tcp::TCPConnection>(new POSIXTCPConnection(client)));
+                }
+            }
+
         }
     }
 }
@@ -20,9 +20,13 @@
 #include <netdb.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "opendavinci/odcore/wrapper/ConcurrencyFactory.h"
 #include "opendavinci/odcore/wrapper/Mutex.h"
@@ -38,6 +42,7 @@ namespace odcore {
 
             POSIXTCPConnection::POSIXTCPConnection(const int32_t &fileDescriptor) :
                 m_thread(),
+                m_registration(0),
                 m_socketMutex(),
                 m_fileDescriptor(fileDescriptor),
                 m_buffer(),
@@ -48,6 +53,7 @@ namespace odcore {
 
             POSIXTCPConnection::POSIXTCPConnection(const std::string &ip, const uint32_t &port) :
                 m_thread(),
+                m_registration(0),
                 m_socketMutex(),
                 m_fileDescriptor(-1),
                 m_buffer(),
@@ -99,10 +105,17 @@ namespace odcore {
             }
 
             void POSIXTCPConnection::start() {
-                m_thread->start();
+                m_registration = POSIXReactor::getInstance().add(m_fileDescriptor, this);
+                if (m_registration == 0) {
+                    m_thread->start();
+                }
             }
 
             void POSIXTCPConnection::stop() {
+                if (m_registration != 0) {
+                    POSIXReactor::getInstance().remove(m_registration);
+                    m_registration = 0;
+                }
                 m_thread->stop();
             }
 
@@ -125,22 +138,35 @@ namespace odcore {
                     select(m_fileDescriptor + 1, &rfds, NULL, NULL, &timeout);
 
                     if (FD_ISSET(m_fileDescriptor, &rfds)) {
-                        int32_t numBytes = recv(m_fileDescriptor, m_buffer, BUFFER_SIZE, 0);
+                        ready = receive();
+                    }
+                }
+            }
 
-                        if (numBytes > 0 ) {
-                            // Get data.
-                            string stringData(m_buffer, numBytes);
+            bool POSIXTCPConnection::onReadable() {
+                // Returning false deregisters this connection from the reactor.
+                return receive();
+            }
 
-                            // Process data in higher layers.
-                            receivedString(stringData);
-                        }
-                        else if (numBytes <= 0) {
-                            // Handle error: numBytes == 0 if peer shut down, numBytes < 0 in any case of error.
-                            invokeConnectionListener();
-                            ready = false;
-                        }
-                    }
+            bool POSIXTCPConnection::receive() {
+                int32_t numBytes = recv(m_fileDescriptor, m_buffer, BUFFER_SIZE, MSG_DONTWAIT);
+
+                if (numBytes > 0 ) {
+                    // Get data.
+                    string stringData(m_buffer, numBytes);
+
+                    // Process data in higher layers.
+                    receivedString(stringData);
+                }
+                else if ( (numBytes < 0) && ( (errno == EAGAIN) || (errno == EINTR) ) ) {
+                    // Spurious wake up; try again later.
+                }
+                else {
+                    // Handle error: numBytes == 0 if peer shut down, numBytes < 0 in any case of error.
+                    invokeConnectionListener();
+                    return false;
                 }
+                return true;
             }
 
             void POSIXTCPConnection::sendImplementation(const std::string& data) {
@@ -154,6 +180,42 @@ namespace odcore {
                 m_socketMutex->unlock();
             }
 
+            void POSIXTCPConnection::sendBuffersImplementation(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers) {
+                vector<struct iovec> iov(numberOfBuffers);
+                for (uint32_t i = 0; i < numberOfBuffers; i++) {
+                    iov[i].iov_base = const_cast<char*>(buffers[i]);
+                    iov[i].iov_len = lengths[i];
+                }
+
+                m_socketMutex->lock();
+                {
+                    // Write all buffers at once and continue after partial writes.
+                    uint32_t first = 0;
+                    while (first < numberOfBuffers) {
+                        const ssize_t numBytes = ::writev(m_fileDescriptor, &iov[first], static_cast<int>(min<uint32_t>(numberOfBuffers - first, IOV_MAX)));
+                        if (numBytes == -1) {
+                            if (errno == EINTR) {
+                                continue;
+                            }
+                            // Handle error.
+                            invokeConnectionListener();
+                            break;
+                        }
+
+                        size_t written = static_cast<size_t>(numBytes);
+                        while ( (first < numberOfBuffers) && (written >= iov[first].iov_len) ) {
+                            written -= iov[first].iov_len;
+                            first++;
+                        }
+                        if (written > 0) {
+                            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+                            iov[first].iov_len -= written;
+                        }
+                    }
+                }
+                m_socketMutex->unlock();
+            }
+
 
             void POSIXTCPConnection::initialize() {
                 m_thread = unique_ptr<Thread>(ConcurrencyFactory::createThread(*this));
@@ -33,9 +33,11 @@
     #include <ifaddrs.h>
 #endif
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/wrapper/ConcurrencyFactory.h"
@@ -56,15 +58,20 @@ namespace odcore {
                 m_address(),
                 m_mreq(),
                 m_fd(),
-                m_buffer(NULL),
-                m_thread() {
-                m_buffer = new char[BUFFER_SIZE];
-                if (m_buffer == NULL) {
-                    stringstream s;
-                    s << "[POSIXUDPReceiver] Error while allocating memory for buffer: " << strerror(errno);
-                    throw s.str();
-                }
-
+                m_bufferPool(BUFFER_SIZE, NUMBER_OF_IDLE_BUFFERS),
+                m_receiveBatchSize(1),
+                m_thread(),
+#ifdef __linux__
+                m_registration(0),
+                m_batchBuffers(),
+                m_batchControls(),
+                m_batchRemotes(),
+                m_batchIOVecs(),
+                m_batchMessages(),
+                m_batchPackets() {
+#else
+                m_registration(0) {
+#endif
                 // Create socket for sending.
                 m_fd = socket(PF_INET, SOCK_DGRAM, 0);
                 if (m_fd < 0) {
@@ -125,11 +132,6 @@ namespace odcore {
 
                 // Close file descriptor.
                 close(m_fd);
-
-                if (m_buffer != NULL) {
-                    delete [] m_buffer;
-                }
-                m_buffer = NULL;
             }
 
             void POSIXUDPReceiver::getIPAddresses() {
@@ -158,15 +160,13 @@ namespace odcore {
                 m_portToIgnore = portToIgnore;
             }
 
+            void POSIXUDPReceiver::setReceiveBatchSize(const uint32_t &batchSize) {
+                m_receiveBatchSize = std::max(static_cast<uint32_t>(1), std::min(batchSize, static_cast<uint32_t>(MAX_RECEIVE_BATCH_SIZE)));
+            }
+
             void POSIXUDPReceiver::run() {
                 fd_set rfds;
                 struct timeval timeout;
-#ifdef __linux__
-                struct timeval socketTimeStamp;
-#endif
-                int32_t nbytes = 0;
-
-                struct sockaddr_storage remote;
 
                 while (isRunning()) {
                     timeout.tv_sec = 1;
@@ -178,47 +178,165 @@ namespace odcore {
                     select(m_fd + 1, &rfds, NULL, NULL, &timeout);
 
                     if (FD_ISSET(m_fd, &rfds)) {
-                        // Get data and sender address.
-                        size_t addrLength = sizeof(remote);
-                        nbytes = recvfrom(m_fd, m_buffer, BUFFER_SIZE, 0, reinterpret_cast<struct sockaddr *>(&remote), reinterpret_cast<socklen_t*>(&addrLength));
-
-                        if (nbytes > 0) {
-                            // Get IP address and port from sender.
-                            const unsigned long RECVFROM_IP_ADDRESS = (reinterpret_cast<struct sockaddr_in*>(&remote))->sin_addr.s_addr;
-                            const uint16_t RECVFROM_PORT = ntohs(reinterpret_cast<struct sockaddr_in*>(&remote)->sin_port);
-
-                            // Forward packet if (a) it is NOT sent from the same machine that is receiving (i.e. over network),
-                            // or, if sent from the same machine as the one used for receiving, if the data was not sent from a
-                            // port that shall be ignored.
-                            const bool ACCEPT_PACKET = (0 == m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS))
-                                                    || ((m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS) > 0) && (m_portToIgnore != RECVFROM_PORT));
-                            if (ACCEPT_PACKET) {
-                                // Get sender address.
-                                const uint32_t MAX_ADDR_SIZE = 1024;
-                                char remoteAddr[MAX_ADDR_SIZE];
-                                inet_ntop(remote.ss_family, &((reinterpret_cast<struct sockaddr_in*>(&remote))->sin_addr), remoteAddr, sizeof(remoteAddr));
-
-                                // -----     -----------------  v (remote address)--v (data)------------------v (time stamp)
+                        receive();
+                    }
+                }
+            }
+
+            bool POSIXUDPReceiver::onReadable() {
+                receive();
+                return true;
+            }
+
+            void POSIXUDPReceiver::receive() {
+#ifdef __linux__
+                if (m_receiveBatchSize > 1) {
+                    receiveDatagrams();
+                    return;
+                }
+#endif
+                receiveDatagram();
+            }
+
+            void POSIXUDPReceiver::receiveDatagram() {
 #ifdef __linux__
-                                if (0 != ioctl(m_fd, SIOCGSTAMP, &socketTimeStamp)) {
-                                    // In case the ioctl failed, use traditional vsariant.
-                                    const odcore::data::TimeStamp now;
-                                    socketTimeStamp.tv_sec = now.getSeconds();
-                                    socketTimeStamp.tv_usec = now.getMicroseconds();
-                                }
-                                odcore::data::TimeStamp now(socketTimeStamp.tv_sec, socketTimeStamp.tv_usec);
+                struct timeval socketTimeStamp;
+#endif
+                struct sockaddr_storage remote;
+
+                // The buffer is returned to the pool once all listeners released the packet.
+                std::shared_ptr<char> buffer = m_bufferPool.acquire();
+
+                // Get data and sender address.
+                size_t addrLength = sizeof(remote);
+                const int32_t nbytes = recvfrom(m_fd, buffer.get(), BUFFER_SIZE, MSG_DONTWAIT, reinterpret_cast<struct sockaddr *>(&remote), reinterpret_cast<socklen_t*>(&addrLength));
+
+                if (nbytes > 0) {
+                    // Get IP address and port from sender.
+                    const unsigned long RECVFROM_IP_ADDRESS = (reinterpret_cast<struct sockaddr_in*>(&remote))->sin_addr.s_addr;
+                    const uint16_t RECVFROM_PORT = ntohs(reinterpret_cast<struct sockaddr_in*>(&remote)->sin_port);
+
+                    // Forward packet if (a) it is NOT sent from the same machine that is receiving (i.e. over network),
+                    // or, if sent from the same machine as the one used for receiving, if the data was not sent from a
+                    // port that shall be ignored.
+                    const bool ACCEPT_PACKET = (0 == m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS))
+                                            || ((m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS) > 0) && (m_portToIgnore != RECVFROM_PORT));
+                    if (ACCEPT_PACKET) {
+#ifdef __linux__
+                        if (0 != ioctl(m_fd, SIOCGSTAMP, &socketTimeStamp)) {
+                            // In case the ioctl failed, use traditional vsariant.
+                            const odcore::data::TimeStamp now;
+                            socketTimeStamp.tv_sec = now.getSeconds();
+                            socketTimeStamp.tv_usec = now.getMicroseconds();
+                        }
+                        odcore::data::TimeStamp now(socketTimeStamp.tv_sec, socketTimeStamp.tv_usec);
 #else
-                                const odcore::data::TimeStamp now;
+                        const odcore::data::TimeStamp now;
 #endif
-                                nextPacket(odcore::data::Packet(string(remoteAddr), string(m_buffer, nbytes), now));
+                        // The sender's address is only converted to text if a listener asks for it;
+                        // small datagrams are copied to return the receive buffer to the pool at once.
+                        if (nbytes <= MAX_COPIED_DATAGRAM_SIZE) {
+                            nextPacket(odcore::io::SharedPacket(buffer.get(), nbytes, ntohl(RECVFROM_IP_ADDRESS), RECVFROM_PORT, now));
+                        }
+                        else {
+                            nextPacket(odcore::io::SharedPacket(buffer, nbytes, ntohl(RECVFROM_IP_ADDRESS), RECVFROM_PORT, now));
+                        }
+                    }
+                }
+            }
+
+#ifdef __linux__
+            void POSIXUDPReceiver::receiveDatagrams() {
+                const uint32_t BATCH_SIZE = m_receiveBatchSize;
+
+                if (m_batchMessages.size() != BATCH_SIZE) {
+                    m_batchBuffers.resize(BATCH_SIZE);
+                    m_batchControls.resize(BATCH_SIZE * CONTROL_SIZE);
+                    m_batchRemotes.resize(BATCH_SIZE);
+                    m_batchIOVecs.resize(BATCH_SIZE);
+                    m_batchMessages.resize(BATCH_SIZE);
+                    m_batchPackets.reserve(BATCH_SIZE);
+                }
+
+                // The headers need to be reset as the kernel modifies the lengths.
+                for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+                    if (m_batchBuffers[i].get() == NULL) {
+                        m_batchBuffers[i] = m_bufferPool.acquire();
+                    }
+                    m_batchIOVecs[i].iov_base = m_batchBuffers[i].get();
+                    m_batchIOVecs[i].iov_len = BUFFER_SIZE;
+
+                    memset(&m_batchMessages[i], 0, sizeof(struct mmsghdr));
+                    m_batchMessages[i].msg_hdr.msg_name = &m_batchRemotes[i];
+                    m_batchMessages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+                    m_batchMessages[i].msg_hdr.msg_iov = &m_batchIOVecs[i];
+                    m_batchMessages[i].msg_hdr.msg_iovlen = 1;
+                    m_batchMessages[i].msg_hdr.msg_control = &m_batchControls[i * CONTROL_SIZE];
+                    m_batchMessages[i].msg_hdr.msg_controllen = CONTROL_SIZE;
+                }
+
+                // Get all pending datagrams without blocking.
+                const int32_t received = recvmmsg(m_fd, &m_batchMessages[0], BATCH_SIZE, MSG_DONTWAIT, NULL);
+
+                for (int32_t i = 0; i < received; i++) {
+                    const uint32_t nbytes = m_batchMessages[i].msg_len;
+                    if (nbytes == 0) {
+                        continue;
+                    }
+
+                    // Get IP address and port from sender.
+                    const unsigned long RECVFROM_IP_ADDRESS = m_batchRemotes[i].sin_addr.s_addr;
+                    const uint16_t RECVFROM_PORT = ntohs(m_batchRemotes[i].sin_port);
+
+                    // Same filtering as for receiving single datagrams.
+                    const bool ACCEPT_PACKET = (0 == m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS))
+                                            || ((m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS) > 0) && (m_portToIgnore != RECVFROM_PORT));
+                    if (ACCEPT_PACKET) {
+                        // Use the kernel's time stamp if available.
+                        odcore::data::TimeStamp now;
+                        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&m_batchMessages[i].msg_hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&m_batchMessages[i].msg_hdr, cmsg)) {
+                            if ( (SOL_SOCKET == cmsg->cmsg_level) && (SCM_TIMESTAMPNS == cmsg->cmsg_type) ) {
+                                struct timespec socketTimeStamp;
+                                memcpy(&socketTimeStamp, CMSG_DATA(cmsg), sizeof(socketTimeStamp));
+                                now = odcore::data::TimeStamp(socketTimeStamp.tv_sec, socketTimeStamp.tv_nsec / 1000);
                             }
                         }
+
+                        if (nbytes <= MAX_COPIED_DATAGRAM_SIZE) {
+                            // Copy small datagrams and keep the buffer for the next batch.
+                            m_batchPackets.push_back(odcore::io::SharedPacket(m_batchBuffers[i].get(), nbytes, ntohl(RECVFROM_IP_ADDRESS), RECVFROM_PORT, now));
+                        }
+                        else {
+                            // Hand the buffer over to the packet.
+                            m_batchPackets.push_back(odcore::io::SharedPacket(m_batchBuffers[i], nbytes, ntohl(RECVFROM_IP_ADDRESS), RECVFROM_PORT, now));
+                            m_batchBuffers[i].reset();
+                        }
                     }
                 }
+
+                if (!m_batchPackets.empty()) {
+                    nextPackets(m_batchPackets);
+
+                    // Release the buffers held by the packets.
+                    m_batchPackets.clear();
+                }
             }
+#endif
 
             void POSIXUDPReceiver::start() {
-                m_thread->start();
+#ifdef __linux__
+                if (m_receiveBatchSize > 1) {
+                    // Let the kernel deliver the time stamps as control messages.
+                    int32_t yes = 1;
+                    setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &yes, sizeof(yes));
+                }
+#endif
+
+                // Use the shared I/O threads if configured.
+                m_registration = POSIXReactor::getInstance().add(m_fd, this);
+                if (m_registration == 0) {
+                    m_thread->start();
+                }
             }
 
             void POSIXUDPReceiver::stop() {
@@ -227,6 +345,11 @@ namespace odcore {
                     setsockopt(m_fd, IPPROTO_IP, IP_DROP_MEMBERSHIP, &m_mreq, sizeof(m_mreq));
                 }
 
+                if (m_registration != 0) {
+                    POSIXReactor::getInstance().remove(m_registration);
+                    m_registration = 0;
+                }
+
                 // Interrupt socket.
                 shutdown(m_fd, SHUT_RDWR);
 
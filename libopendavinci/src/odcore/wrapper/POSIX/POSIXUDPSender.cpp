@@ -19,9 +19,11 @@
 
 #include <sys/socket.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "opendavinci/odcore/wrapper/Mutex.h"
 #include "opendavinci/odcore/wrapper/MutexFactory.h"
@@ -109,6 +111,54 @@ namespace odcore {
                 m_socketMutex->unlock();
             }
 
+            void POSIXUDPSender::sendBatch(const vector<string> &data) const {
+                for (vector<string>::const_iterator it = data.begin(); it != data.end(); ++it) {
+                    if (it->length() > POSIXUDPSender::MAX_UDP_PACKET_SIZE) {
+                        stringstream s;
+                        s << "[core::wrapper::POSIXUDPSender] Data to be sent is too large (" << it->length() << " > " << POSIXUDPSender::MAX_UDP_PACKET_SIZE << ").";
+                        throw s.str();
+                    }
+                }
+
+#ifdef __linux__
+                // Send up to MAX_SEND_BATCH_SIZE datagrams per system call.
+                struct iovec iovecs[MAX_SEND_BATCH_SIZE];
+                struct mmsghdr messages[MAX_SEND_BATCH_SIZE];
+
+                m_socketMutex->lock();
+                {
+                    uint32_t sent = 0;
+                    while (sent < data.size()) {
+                        const uint32_t BATCH_SIZE = std::min(static_cast<uint32_t>(data.size() - sent), static_cast<uint32_t>(MAX_SEND_BATCH_SIZE));
+                        for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+                            iovecs[i].iov_base = const_cast<char*>(data[sent + i].c_str());
+                            iovecs[i].iov_len = data[sent + i].length();
+
+                            memset(&messages[i], 0, sizeof(struct mmsghdr));
+                            messages[i].msg_hdr.msg_name = const_cast<struct sockaddr_in*>(&m_address);
+                            messages[i].msg_hdr.msg_namelen = sizeof(m_address);
+                            messages[i].msg_hdr.msg_iov = &iovecs[i];
+                            messages[i].msg_hdr.msg_iovlen = 1;
+                        }
+
+                        const int32_t retVal = sendmmsg(m_fd, messages, BATCH_SIZE, 0);
+                        if (retVal <= 0) {
+                            // Skip the datagram that could not be sent as sendto does.
+                            sent++;
+                        }
+                        else {
+                            sent += retVal;
+                        }
+                    }
+                }
+                m_socketMutex->unlock();
+#else
+                for (vector<string>::const_iterator it = data.begin(); it != data.end(); ++it) {
+                    send(*it);
+                }
+#endif
+            }
+
         }
     }
 } // odcore::wrapper::POSIX
@@ -38,6 +38,11 @@ namespace odcore {
             return SharedMemoryFactoryWorker<configuration::value>::createSharedMemory(name, size);
         }
 
+        std::shared_ptr<SharedMemory> SharedMemoryFactory::createSharedMemoryExclusively(const string &name, const uint32_t &size) {
+            typedef ConfigurationTraits<SystemLibraryProducts>::configuration configuration;
+            return SharedMemoryFactoryWorker<configuration::value>::createSharedMemoryExclusively(name, size);
+        }
+
         std::shared_ptr<SharedMemory> SharedMemoryFactory::attachToSharedMemory(const string &name) {
             typedef ConfigurationTraits<SystemLibraryProducts>::configuration configuration;
             return SharedMemoryFactoryWorker<configuration::value>::attachToSharedMemory(name);
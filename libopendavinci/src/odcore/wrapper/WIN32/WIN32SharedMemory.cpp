@@ -30,7 +30,7 @@ namespace odcore {
 
             using namespace std;
 
-            WIN32SharedMemory::WIN32SharedMemory(const string &name, const uint32_t &size) :
+            WIN32SharedMemory::WIN32SharedMemory(const string &name, const uint32_t &size, const bool &exclusive) :
                     m_name(name),
                     m_internalName(name),
                     m_shmID(0),
@@ -67,7 +67,14 @@ namespace odcore {
                             0,                       // maximum object size (high-order DWORD)
                             size + sizeof(uint32_t), // maximum object size (low-order DWORD)
                             s.c_str());              // name of mapping object
-                        if (m_shmID == NULL) {
+                        if ( (m_shmID != NULL) && exclusive && (GetLastError() == ERROR_ALREADY_EXISTS) ) {
+                            // Another process created the shared memory already.
+                            CloseHandle(m_shmID);
+                            m_shmID = NULL;
+                            CloseHandle(m_mutexSharedMemory);
+                            m_mutexSharedMemory = NULL;
+                        }
+                        else if (m_shmID == NULL) {
                             const int retcode = GetLastError();
                             CLOG3 << "Shared memory could not be requested: " << retcode << endl;
                             CloseHandle(m_mutexSharedMemory);
@@ -210,6 +217,10 @@ namespace odcore {
                 return ((m_mutexSharedMemory != NULL) && (m_sharedMemory != NULL));
             }
 
+            void WIN32SharedMemory::remove() {
+                // Named file mappings are removed after the last handle was closed.
+            }
+
             const string WIN32SharedMemory::getName() const {
                 return m_name;
             }
@@ -20,6 +20,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/wrapper/ConcurrencyFactory.h"
 #include "opendavinci/odcore/wrapper/MutexFactory.h"
@@ -173,6 +174,23 @@ namespace odcore {
                 m_socketMutex->unlock();
             }
 
+            void WIN32TCPConnection::sendBuffersImplementation(const char *buffers[], const uint32_t lengths[], const uint32_t &numberOfBuffers) {
+                vector<WSABUF> wsaBuffers(numberOfBuffers);
+                for (uint32_t i = 0; i < numberOfBuffers; i++) {
+                    wsaBuffers[i].buf = const_cast<CHAR*>(buffers[i]);
+                    wsaBuffers[i].len = lengths[i];
+                }
+
+                m_socketMutex->lock();
+                    // Write all buffers at once.
+                    DWORD numBytes = 0;
+                    if (::WSASend(m_fileDescriptor, &wsaBuffers[0], numberOfBuffers, &numBytes, 0, NULL, NULL) == SOCKET_ERROR) {
+                        // Handle error.
+                        invokeConnectionListener();
+                    }
+                m_socketMutex->unlock();
+            }
+
 
             void WIN32TCPConnection::initialize() {
                 m_thread = unique_ptr<Thread>(ConcurrencyFactory::createThread(*this));
@@ -108,8 +108,7 @@ namespace odtools {
                 Lock l(m_mapOfRecorderDelegatesMutex);
                 auto delegate = m_mapOfRecorderDelegates.find(c.getDataType());
                 if (delegate != m_mapOfRecorderDelegates.end()) {
-                    Container replacementContainer = delegate->second->process(c);
-                    getFIFO().enter(replacementContainer);
+                    getFIFO().enter(delegate->second->process(c));
                     recordQueueEntries();
 
                     // Return from this call as a delegated RecorderDelegate has
@@ -124,8 +123,11 @@ namespace odtools {
                  (c.getDataType() != odcore::data::SharedData::ID())  &&
                  (c.getDataType() != odcore::data::SharedPointCloud::ID())  &&
                  (c.getDataType() != odcore::data::image::SharedImage::ID()) ) {
-                getFIFO().enter(c);
+                // The container is not needed anymore; thus, move it into the queue.
+                getFIFO().enter(std::move(c));
                 recordQueueEntries();
+
+                return;
             }
 
             if (m_dumpSharedData) {
@@ -228,6 +228,10 @@ namespace odtools {
             CLOG2 << "IN: " << m_bufferIn.getSize() << ", " << "OUT: " << m_bufferOut.getSize() << ", " << "DROPPED: " << m_droppedSharedMemories << endl;
         }
 
+        void SharedDataListener::add(Container &&container) {
+            add(container);
+        }
+
         void SharedDataListener::clear() {}
 
         uint32_t SharedDataListener::getSize() const {
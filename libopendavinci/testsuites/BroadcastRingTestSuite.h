@@ -0,0 +1,275 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_BROADCASTRINGTESTSUITE_H_
+#define CORE_BROADCASTRINGTESTSUITE_H_
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/base/BroadcastRing.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+
+using namespace std;
+using namespace odcore::base;
+using namespace odcore::data;
+
+class BroadcastRingTestStringWriter : public BroadcastRing::EntryWriter {
+    private:
+        BroadcastRingTestStringWriter(const BroadcastRingTestStringWriter &);
+        BroadcastRingTestStringWriter& operator=(const BroadcastRingTestStringWriter &);
+
+    public:
+        BroadcastRingTestStringWriter(const string &data) :
+            m_data(data) {}
+
+        virtual void write(char *buffer, const uint32_t &length) const {
+            memcpy(buffer, m_data.data(), length);
+        }
+
+    private:
+        const string &m_data;
+};
+
+class BroadcastRingTestStallingWriter : public BroadcastRing::EntryWriter {
+    private:
+        BroadcastRingTestStallingWriter(const BroadcastRingTestStallingWriter &);
+        BroadcastRingTestStallingWriter& operator=(const BroadcastRingTestStallingWriter &);
+
+    public:
+        BroadcastRingTestStallingWriter(BroadcastRing &ring, const uint32_t &numberOfEntries) :
+            m_ring(ring),
+            m_numberOfEntries(numberOfEntries),
+            m_numberOfWrittenEntries(0) {}
+
+        virtual void write(char *buffer, const uint32_t &length) const {
+            memset(buffer, 'S', length);
+
+            // Other producers write while this one stalls.
+            for (uint32_t i = 1; i <= m_numberOfEntries; i++) {
+                string data(10, '\0');
+                for (uint32_t j = 0; j < data.size(); j++) {
+                    data[j] = static_cast<char>((j + i) % 251);
+                }
+                BroadcastRingTestStringWriter w(data);
+                if (m_ring.write(data.size(), 2, 0, w)) {
+                    m_numberOfWrittenEntries++;
+                }
+            }
+        }
+
+        uint32_t getNumberOfWrittenEntries() const {
+            return m_numberOfWrittenEntries;
+        }
+
+    private:
+        BroadcastRing &m_ring;
+        const uint32_t m_numberOfEntries;
+        mutable uint32_t m_numberOfWrittenEntries;
+};
+
+class BroadcastRingTest : public CxxTest::TestSuite {
+    private:
+        static bool write(BroadcastRing &ring, const string &data, const uint32_t &origin, const uint32_t &flags) {
+            BroadcastRingTestStringWriter w(data);
+            return ring.write(data.size(), origin, flags, w);
+        }
+
+        static string createData(const uint32_t &length, const uint32_t &seed) {
+            string data(length, '\0');
+            for (uint32_t i = 0; i < length; i++) {
+                data[i] = static_cast<char>((i + seed) % 251);
+            }
+            return data;
+        }
+
+    public:
+        void testWriteAndRead() {
+            vector<char> memory(BroadcastRing::getRequiredSize(8, 64));
+            BroadcastRing ring(&memory[0], memory.size());
+            TS_ASSERT(!ring.isValid());
+            TS_ASSERT(ring.create(8, 64));
+            TS_ASSERT(ring.isValid());
+            TS_ASSERT(!ring.isClosed());
+            TS_ASSERT(ring.getMaximumLength() == 4 * 64);
+
+            uint64_t cursor = ring.getWriteSequence();
+            BroadcastRing::Entry e;
+            TS_ASSERT(BroadcastRing::EMPTY == ring.read(cursor, e));
+
+            TS_ASSERT(write(ring, "Hello World", 3, 1));
+
+            TS_ASSERT(BroadcastRing::AVAILABLE == ring.read(cursor, e));
+            TS_ASSERT(string(e.m_data, e.m_length) == "Hello World");
+            TS_ASSERT(e.m_origin == 3);
+            TS_ASSERT(e.m_flags == 1);
+            TS_ASSERT(ring.release(cursor, e));
+            TS_ASSERT(cursor == 1);
+
+            TS_ASSERT(BroadcastRing::EMPTY == ring.read(cursor, e));
+        }
+
+        void testEntriesSpanningSeveralSlots() {
+            vector<char> memory(BroadcastRing::getRequiredSize(8, 64));
+            BroadcastRing ring(&memory[0], memory.size());
+            TS_ASSERT(ring.create(8, 64));
+
+            uint64_t cursor = ring.getWriteSequence();
+
+            // Entries of three slots do not wrap around the end of the ring
+            // but are read in place after padding.
+            for (uint32_t i = 0; i < 20; i++) {
+                const string data = createData(150, i);
+                TS_ASSERT(write(ring, data, 1, 0));
+
+                BroadcastRing::Entry e;
+                TS_ASSERT(BroadcastRing::AVAILABLE == ring.read(cursor, e));
+                TS_ASSERT(e.m_numberOfSlots == 3);
+                TS_ASSERT((e.m_sequence % 8) + e.m_numberOfSlots <= 8);
+                TS_ASSERT(e.m_data >= &memory[0]);
+                TS_ASSERT(e.m_data + e.m_length <= &memory[0] + memory.size());
+                TS_ASSERT(string(e.m_data, e.m_length) == data);
+                TS_ASSERT(ring.release(cursor, e));
+            }
+            // Every third entry is preceded by two slots of padding.
+            TS_ASSERT(cursor == 78);
+
+            // Entries must not exceed half of the ring.
+            TS_ASSERT(!write(ring, createData(ring.getMaximumLength() + 1, 0), 1, 0));
+        }
+
+        void testOverrunConsumer() {
+            vector<char> memory(BroadcastRing::getRequiredSize(8, 64));
+            BroadcastRing ring(&memory[0], memory.size());
+            TS_ASSERT(ring.create(8, 64));
+
+            uint64_t cursor = ring.getWriteSequence();
+            BroadcastRing::Entry e;
+
+            // Read the first entry but release it after it was overwritten.
+            TS_ASSERT(write(ring, createData(10, 0), 1, 0));
+            TS_ASSERT(BroadcastRing::AVAILABLE == ring.read(cursor, e));
+            for (uint32_t i = 1; i < 20; i++) {
+                TS_ASSERT(write(ring, createData(10, i), 1, 0));
+            }
+            TS_ASSERT(!ring.release(cursor, e));
+
+            TS_ASSERT(BroadcastRing::OVERRUN == ring.read(cursor, e));
+            TS_ASSERT(cursor == 20);
+            TS_ASSERT(BroadcastRing::EMPTY == ring.read(cursor, e));
+
+            TS_ASSERT(write(ring, createData(10, 20), 1, 0));
+            TS_ASSERT(BroadcastRing::AVAILABLE == ring.read(cursor, e));
+            TS_ASSERT(string(e.m_data, e.m_length) == createData(10, 20));
+            TS_ASSERT(ring.release(cursor, e));
+        }
+
+        void testAttachAndClose() {
+            vector<char> memory(BroadcastRing::getRequiredSize(16, 128));
+
+            // Rings must be created before attaching.
+            BroadcastRing uninitialized(&memory[0], memory.size());
+            TS_ASSERT(!uninitialized.attach(0));
+            TS_ASSERT(!uninitialized.hasBeenClosed());
+
+            BroadcastRing creator(&memory[0], memory.size());
+            TS_ASSERT(creator.create(16, 128));
+
+            BroadcastRing participant(&memory[0], memory.size());
+            TS_ASSERT(participant.attach(0));
+            TS_ASSERT(participant.getMaximumLength() == creator.getMaximumLength());
+
+            const uint32_t ORIGIN1 = creator.registerParticipant();
+            const uint32_t ORIGIN2 = participant.registerParticipant();
+            TS_ASSERT(ORIGIN1 != ORIGIN2);
+
+            uint64_t cursor = participant.getWriteSequence();
+            TS_ASSERT(write(creator, "Shared", ORIGIN1, 0));
+
+            BroadcastRing::Entry e;
+            TS_ASSERT(BroadcastRing::AVAILABLE == participant.read(cursor, e));
+            TS_ASSERT(string(e.m_data, e.m_length) == "Shared");
+            TS_ASSERT(e.m_origin == ORIGIN1);
+            TS_ASSERT(participant.release(cursor, e));
+
+            creator.close();
+            TS_ASSERT(participant.isClosed());
+            TS_ASSERT(BroadcastRing::CLOSED == participant.read(cursor, e));
+            TS_ASSERT(!write(participant, "Closed", ORIGIN2, 0));
+
+            // Waiting returns immediately for closed rings.
+            participant.waitForData(cursor, 10 * 1000 * 1000);
+
+            BroadcastRing late(&memory[0], memory.size());
+            TS_ASSERT(!late.attach(0));
+        }
+
+        void testCloseAbandonedRing() {
+            vector<char> memory(BroadcastRing::getRequiredSize(8, 64));
+            BroadcastRing creator(&memory[0], memory.size());
+            TS_ASSERT(creator.create(8, 64));
+
+            BroadcastRing participant(&memory[0], memory.size());
+            TS_ASSERT(participant.attach(0));
+
+            // The creator signals regularly.
+            TS_ASSERT(!participant.closeIfAbandoned(TimeStamp(10, 0), 1000));
+            creator.heartbeat();
+            TS_ASSERT(!participant.closeIfAbandoned(TimeStamp(10, 900), 1000));
+            creator.heartbeat();
+            TS_ASSERT(!participant.closeIfAbandoned(TimeStamp(10, 1800), 1000));
+            TS_ASSERT(!participant.closeIfAbandoned(TimeStamp(10, 2700), 1000));
+            TS_ASSERT(!participant.isClosed());
+
+            // The creator stopped signaling.
+            TS_ASSERT(participant.closeIfAbandoned(TimeStamp(10, 2900), 1000));
+            TS_ASSERT(participant.isClosed());
+            TS_ASSERT(creator.isClosed());
+            TS_ASSERT(!participant.closeIfAbandoned(TimeStamp(10, 5000), 1000));
+        }
+
+        void testStalledProducerAbandonsRing() {
+            vector<char> memory(BroadcastRing::getRequiredSize(8, 64));
+            BroadcastRing ring(&memory[0], memory.size());
+            TS_ASSERT(ring.create(8, 64));
+
+            uint64_t cursor = ring.getWriteSequence();
+
+            // While the first producer writes, others lap the ring and wait for its slot.
+            BroadcastRingTestStallingWriter stalled(ring, 8);
+            TS_ASSERT(!ring.write(10, 1, 0, stalled));
+            TS_ASSERT(stalled.getNumberOfWrittenEntries() == 7);
+
+            // Instead of taking over the slot, the ring was abandoned.
+            TS_ASSERT(ring.isClosed());
+            TS_ASSERT(ring.hasBeenClosed());
+            BroadcastRing::Entry e;
+            TS_ASSERT(BroadcastRing::CLOSED == ring.read(cursor, e));
+            TS_ASSERT(!write(ring, createData(10, 9), 2, 0));
+
+            BroadcastRing late(&memory[0], memory.size());
+            TS_ASSERT(!late.attach(0));
+            TS_ASSERT(late.hasBeenClosed());
+        }
+};
+
+#endif /*CORE_BROADCASTRINGTESTSUITE_H_*/
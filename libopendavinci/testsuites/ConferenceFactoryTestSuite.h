@@ -20,22 +20,39 @@
 #ifndef CONTEXT_CONFERENCEFACTORYTESTSUITE_H_
 #define CONTEXT_CONFERENCEFACTORYTESTSUITE_H_
 
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>                       // for operator==, basic_string, etc
+#include <vector>                       // for vector
 
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
 #include "opendavinci/odcontext/base/BlockableContainerReceiver.h"
 #include "opendavinci/odcontext/base/ControlledContainerConferenceFactory.h"
 #include "opendavinci/odcontext/base/ControlledContainerConferenceForSystemUnderTest.h"
+#include "opendavinci/odcore/base/Condition.h"        // for Condition
 #include "opendavinci/odcore/base/FIFOQueue.h"        // for FIFOQueue
+#include "opendavinci/odcore/base/Lock.h"             // for Lock
+#include "opendavinci/odcore/base/Mutex.h"            // for Mutex
+#include "opendavinci/odcore/base/Service.h"          // for Service
+#include "opendavinci/odcore/base/Thread.h"           // for Thread
 #include "opendavinci/odcore/data/Container.h"        // for Container, etc
 #include "opendavinci/odcore/data/TimeStamp.h"        // for TimeStamp
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
 #include "opendavinci/odcore/io/conference/ContainerConferenceFactory.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerConference.h"
+#include "opendavinci/odcore/io/conference/InProcessContainerHub.h"
+#include "opendavinci/odcore/io/conference/SharedMemoryContainerConference.h"
+#include "opendavinci/odcore/io/conference/TopicPartitioning.h"
 #include "opendavinci/odcore/io/conference/UDPMultiCastContainerConference.h"
+#include "opendavinci/odcore/io/PacketListener.h"
+#include "opendavinci/odcore/io/udp/FragmentReassembler.h"
+#include "opendavinci/odcore/io/udp/UDPFactory.h"
+#include "opendavinci/odcore/io/udp/UDPReceiver.h"
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/generated/odcore/data/Packet.h"
 
 using namespace std;
 using namespace odcore::base;
@@ -82,6 +99,115 @@ class ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest : p
         FIFOQueue m_fifo;
 };
 
+class ConferenceFactoryTestBlockingContainerListener : public ContainerListener {
+    public:
+        ConferenceFactoryTestBlockingContainerListener() :
+            m_mutex(),
+            m_blocked(true),
+            m_waiting(false),
+            m_fifo() {}
+
+        virtual ~ConferenceFactoryTestBlockingContainerListener() {}
+
+        virtual void nextContainer(Container &c) {
+            m_fifo.add(c);
+            while (isBlocked()) {
+                {
+                    Lock l(m_mutex);
+                    m_waiting = true;
+                }
+                Thread::usleepFor(1000);
+            }
+        }
+
+        bool isBlocked() {
+            Lock l(m_mutex);
+            return m_blocked;
+        }
+
+        bool isWaiting() {
+            Lock l(m_mutex);
+            return m_waiting;
+        }
+
+        void unblock() {
+            Lock l(m_mutex);
+            m_blocked = false;
+        }
+
+        FIFOQueue& getFIFO() {
+            return m_fifo;
+        }
+
+    private:
+        Mutex m_mutex;
+        bool m_blocked;
+        bool m_waiting;
+        FIFOQueue m_fifo;
+};
+
+class ConferenceFactoryTestPacketListener : public PacketListener {
+    public:
+        ConferenceFactoryTestPacketListener() :
+            m_mutex(),
+            m_packets() {}
+
+        virtual ~ConferenceFactoryTestPacketListener() {}
+
+        virtual void nextPacket(const Packet &p) {
+            Lock l(m_mutex);
+            m_packets.push_back(p);
+        }
+
+        vector<Packet> getPackets() {
+            Lock l(m_mutex);
+            return m_packets;
+        }
+
+    private:
+        Mutex m_mutex;
+        vector<Packet> m_packets;
+};
+
+class ConferenceFactoryTestConferenceStarter : public Service {
+    private:
+        ConferenceFactoryTestConferenceStarter(const ConferenceFactoryTestConferenceStarter &);
+        ConferenceFactoryTestConferenceStarter& operator=(const ConferenceFactoryTestConferenceStarter &);
+
+    public:
+        ConferenceFactoryTestConferenceStarter(const string &group, Condition &startCondition, bool &started) :
+            m_group(group),
+            m_startCondition(startCondition),
+            m_started(started),
+            m_conference() {}
+
+        std::shared_ptr<ContainerConference> getContainerConference() const {
+            return m_conference;
+        }
+
+    protected:
+        virtual void beforeStop() {}
+
+        virtual void run() {
+            serviceReady();
+
+            {
+                Lock l(m_startCondition);
+                while (!m_started) {
+                    m_startCondition.waitOnSignal();
+                }
+            }
+
+            m_conference = ContainerConferenceFactory::getInstance().getContainerConference(m_group);
+        }
+
+    private:
+        const string m_group;
+        Condition &m_startCondition;
+        bool &m_started;
+        std::shared_ptr<ContainerConference> m_conference;
+};
+
 class ConferenceFactoryTest : public CxxTest::TestSuite {
     public:
         void testControlledContainerFactoryTestSuite() {
@@ -165,6 +291,836 @@ class ConferenceFactoryTest : public CxxTest::TestSuite {
                 TS_ASSERT(tsCheckReceivedTimeStampFromApplication.toString() == tsSendFromApplicationToContainerConference.toString());
             }
         }
+
+        void testUDPMultiCastContainerConferenceCoalescing() {
+            // Destroy any existing ContainerConferenceFactory to use UDP multicast.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.201";
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            TS_ASSERT(sender.get());
+            TS_ASSERT(receiver.get());
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            receiver->setContainerListener(&listener);
+
+            // Coalesce containers for 200us.
+            sender->setSendCoalescingDeadline(200);
+
+            const uint32_t NUMBER_OF_SINGLE_CONTAINERS = 20;
+            for (uint32_t i = 0; i < NUMBER_OF_SINGLE_CONTAINERS; i++) {
+                Container c(TimeStamp(i, 0));
+                sender->send(c);
+            }
+
+            const uint32_t NUMBER_OF_BATCHED_CONTAINERS = 5;
+            vector<Container> batch;
+            for (uint32_t i = 0; i < NUMBER_OF_BATCHED_CONTAINERS; i++) {
+                batch.push_back(Container(TimeStamp(NUMBER_OF_SINGLE_CONTAINERS + i, 0)));
+            }
+            sender->sendBatch(batch);
+
+            // Wait for at most two seconds.
+            const uint32_t NUMBER_OF_CONTAINERS = NUMBER_OF_SINGLE_CONTAINERS + NUMBER_OF_BATCHED_CONTAINERS;
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < NUMBER_OF_CONTAINERS); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+
+            receiver->setContainerListener(NULL);
+
+            TS_ASSERT(listener.getFIFO().getSize() == NUMBER_OF_CONTAINERS);
+            for (uint32_t i = 0; (i < NUMBER_OF_CONTAINERS) && !listener.getFIFO().isEmpty(); i++) {
+                Container c = listener.getFIFO().leave();
+                TS_ASSERT(c.getDataType() == TimeStamp::ID());
+                TS_ASSERT(c.getData<TimeStamp>().getSeconds() == static_cast<int32_t>(i));
+            }
+
+            sender.reset();
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testUDPMultiCastContainerConferenceFragmentation() {
+            // Destroy any existing ContainerConferenceFactory to use UDP multicast.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.202";
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            TS_ASSERT(sender.get());
+            TS_ASSERT(receiver.get());
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            receiver->setContainerListener(&listener);
+            // Give the network stack some time to join the multicast group.
+            Thread::usleepFor(100 * 1000);
+
+            // The payload exceeds one UDP datagram.
+            string data(100000, '\0');
+            for (uint32_t i = 0; i < data.size(); i++) {
+                data[i] = static_cast<char>(i % 251);
+            }
+            Packet p("Sender", data, TimeStamp());
+            Container c(p);
+            sender->send(c);
+
+            // Wait for at most two seconds.
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < 1); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+
+            receiver->setContainerListener(NULL);
+
+            TS_ASSERT(listener.getFIFO().getSize() == 1);
+            if (!listener.getFIFO().isEmpty()) {
+                Container received = listener.getFIFO().leave();
+                TS_ASSERT(received.getDataType() == Packet::ID());
+                TS_ASSERT(received.getData<Packet>().getData() == data);
+            }
+
+            UDPMultiCastContainerConference *udpReceiver = dynamic_cast<UDPMultiCastContainerConference*>(receiver.get());
+            TS_ASSERT(udpReceiver != NULL);
+            if (udpReceiver != NULL) {
+                TS_ASSERT(udpReceiver->getNumberOfDroppedFragments() == 0);
+            }
+
+            sender.reset();
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testUDPMultiCastContainerConferenceDoesNotCoalesceFragments() {
+            // Destroy any existing ContainerConferenceFactory to use UDP multicast.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            // Capture the datagrams as sent over the network.
+            const string group = "225.0.0.211";
+            ConferenceFactoryTestPacketListener datagrams;
+            std::shared_ptr<odcore::io::udp::UDPReceiver> wire = odcore::io::udp::UDPFactory::createUDPReceiver(group, ContainerConferenceFactory::MULTICAST_PORT);
+            wire->setPacketListener(&datagrams);
+            wire->start();
+
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference("225.0.0.212");
+            UDPMultiCastContainerConference *udpReceiver = dynamic_cast<UDPMultiCastContainerConference*>(receiver.get());
+            TS_ASSERT(udpReceiver != NULL);
+            if (udpReceiver == NULL) {
+                return;
+            }
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            receiver->setContainerListener(&listener);
+            // Give the network stack some time to join the multicast group.
+            Thread::usleepFor(100 * 1000);
+
+            // The last fragment of the large container fits into a coalesced datagram.
+            sender->setSendCoalescingDeadline(10 * 1000);
+            vector<Container> containers;
+            containers.push_back(Container(TimeStamp(1, 0)));
+            containers.push_back(Container(Packet("Sender", string(66000, 'x'), TimeStamp())));
+            containers.push_back(Container(TimeStamp(2, 0)));
+            containers.push_back(Container(TimeStamp(3, 0)));
+            sender->sendBatch(containers);
+
+            // Wait for at most two seconds.
+            for (uint32_t i = 0; (i < 200) && (datagrams.getPackets().size() < 4); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            wire->stop();
+            wire->setPacketListener(NULL);
+
+            // Deliver all datagrams except for the first fragment.
+            const vector<Packet> packets = datagrams.getPackets();
+            TS_ASSERT(packets.size() == 4);
+            bool droppedFragment = false;
+            for (vector<Packet>::const_iterator it = packets.begin(); it != packets.end(); ++it) {
+                const string &data = it->getData();
+                if (!droppedFragment && odcore::io::udp::FragmentReassembler::isFragment(data.data(), data.size())) {
+                    droppedFragment = true;
+                    continue;
+                }
+                udpReceiver->nextPacket(*it);
+            }
+            TS_ASSERT(droppedFragment);
+
+            // The small containers are received although the large one is incomplete.
+            receiver->setContainerListener(NULL);
+            TS_ASSERT(listener.getFIFO().getSize() == 3);
+            for (int32_t i = 1; (i <= 3) && !listener.getFIFO().isEmpty(); i++) {
+                Container c = listener.getFIFO().leave();
+                TS_ASSERT(c.getDataType() == TimeStamp::ID());
+                if (c.getDataType() == TimeStamp::ID()) {
+                    TS_ASSERT(c.getData<TimeStamp>().getSeconds() == i);
+                }
+            }
+
+            sender.reset();
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testUDPMultiCastContainerConferenceDropsOnlyOversizedContainers() {
+            // Destroy any existing ContainerConferenceFactory to use UDP multicast.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.213";
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            receiver->setContainerListener(&listener);
+            // Give the network stack some time to join the multicast group.
+            Thread::usleepFor(100 * 1000);
+
+            // The second container requires more than MAX_FRAGMENTS_PER_CONTAINER fragments.
+            vector<Container> containers;
+            containers.push_back(Container(TimeStamp(1, 0)));
+            containers.push_back(Container(Packet("Sender", string(17 * 1024 * 1024, 'x'), TimeStamp())));
+            containers.push_back(Container(TimeStamp(2, 0)));
+            sender->sendBatch(containers);
+
+            // Wait for at most two seconds.
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < 2); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            receiver->setContainerListener(NULL);
+
+            TS_ASSERT(listener.getFIFO().getSize() == 2);
+            for (int32_t i = 1; (i <= 2) && !listener.getFIFO().isEmpty(); i++) {
+                Container c = listener.getFIFO().leave();
+                TS_ASSERT(c.getDataType() == TimeStamp::ID());
+                if (c.getDataType() == TimeStamp::ID()) {
+                    TS_ASSERT(c.getData<TimeStamp>().getSeconds() == i);
+                }
+            }
+
+            sender.reset();
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testSharedMemoryContainerConference() {
+            // Destroy any existing ContainerConferenceFactory to use shared memory.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.203";
+            ContainerConferenceFactory::getInstance().setSharedMemoryEnabled(group, true);
+            TS_ASSERT(ContainerConferenceFactory::getInstance().isSharedMemoryEnabled(group));
+
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(group);
+
+            SharedMemoryContainerConference *shmSender = dynamic_cast<SharedMemoryContainerConference*>(sender.get());
+            SharedMemoryContainerConference *shmReceiver = dynamic_cast<SharedMemoryContainerConference*>(receiver.get());
+            TS_ASSERT(shmSender != NULL);
+            TS_ASSERT(shmReceiver != NULL);
+            if ( (shmSender == NULL) || (shmReceiver == NULL) ) {
+                return;
+            }
+
+            // The creator of the shared memory bridges to the network.
+            TS_ASSERT(shmSender->isBridge());
+            TS_ASSERT(!shmReceiver->isBridge());
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            receiver->setContainerListener(&listener);
+
+            const uint32_t NUMBER_OF_CONTAINERS = 20;
+            for (uint32_t i = 0; i < NUMBER_OF_CONTAINERS; i++) {
+                Container c(TimeStamp(i, 0));
+                sender->send(c);
+            }
+
+            // Wait for at most two seconds.
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < NUMBER_OF_CONTAINERS); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+
+            TS_ASSERT(listener.getFIFO().getSize() == NUMBER_OF_CONTAINERS);
+            for (uint32_t i = 0; (i < NUMBER_OF_CONTAINERS) && !listener.getFIFO().isEmpty(); i++) {
+                Container c = listener.getFIFO().leave();
+                TS_ASSERT(c.getDataType() == TimeStamp::ID());
+                TS_ASSERT(c.getData<TimeStamp>().getSeconds() == static_cast<int32_t>(i));
+            }
+
+            // Remote peers use UDP multicast.
+            ContainerConferenceFactory::getInstance().setSharedMemoryEnabled(group, false);
+            std::shared_ptr<ContainerConference> remote = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            TS_ASSERT(dynamic_cast<UDPMultiCastContainerConference*>(remote.get()) != NULL);
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest remoteListener;
+            remote->setContainerListener(&remoteListener);
+
+            Container toRemote(TimeStamp(100, 0));
+            sender->send(toRemote);
+            for (uint32_t i = 0; (i < 200) && (remoteListener.getFIFO().getSize() < 1); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(remoteListener.getFIFO().getSize() == 1);
+            if (!remoteListener.getFIFO().isEmpty()) {
+                Container c = remoteListener.getFIFO().leave();
+                TS_ASSERT(c.getData<TimeStamp>().getSeconds() == 100);
+            }
+
+            Container fromRemote(TimeStamp(200, 0));
+            remote->send(fromRemote);
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < 2); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(listener.getFIFO().getSize() == 2);
+            if (listener.getFIFO().getSize() == 2) {
+                TS_ASSERT(listener.getFIFO().leave().getData<TimeStamp>().getSeconds() == 100);
+                TS_ASSERT(listener.getFIFO().leave().getData<TimeStamp>().getSeconds() == 200);
+            }
+
+            remote->setContainerListener(NULL);
+            remote.reset();
+
+            // Another participant takes over when the creator leaves.
+            sender.reset();
+            for (uint32_t i = 0; (i < 200) && !shmReceiver->isBridge(); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(shmReceiver->isBridge());
+
+            receiver->setContainerListener(NULL);
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testSharedMemoryContainerConferencesStartingConcurrently() {
+            // Destroy any existing ContainerConferenceFactory to use shared memory.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.214";
+            ContainerConferenceFactory::getInstance().setSharedMemoryEnabled(group, true);
+
+            // Both participants try to create the shared memory at the same time.
+            Condition startCondition;
+            bool started = false;
+            ConferenceFactoryTestConferenceStarter starter1(group, startCondition, started);
+            ConferenceFactoryTestConferenceStarter starter2(group, startCondition, started);
+            starter1.start();
+            starter2.start();
+            {
+                Lock l(startCondition);
+                started = true;
+                startCondition.wakeAll();
+            }
+            starter1.stop();
+            starter2.stop();
+
+            std::shared_ptr<ContainerConference> participant1 = starter1.getContainerConference();
+            std::shared_ptr<ContainerConference> participant2 = starter2.getContainerConference();
+            SharedMemoryContainerConference *shm1 = dynamic_cast<SharedMemoryContainerConference*>(participant1.get());
+            SharedMemoryContainerConference *shm2 = dynamic_cast<SharedMemoryContainerConference*>(participant2.get());
+            TS_ASSERT(shm1 != NULL);
+            TS_ASSERT(shm2 != NULL);
+            if ( (shm1 == NULL) || (shm2 == NULL) ) {
+                return;
+            }
+
+            // Exactly one participant created the ring and bridges to the network.
+            TS_ASSERT(shm1->isBridge() != shm2->isBridge());
+
+            // Both participants use the same ring.
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            participant2->setContainerListener(&listener);
+
+            const uint32_t NUMBER_OF_CONTAINERS = 5;
+            for (uint32_t i = 0; i < NUMBER_OF_CONTAINERS; i++) {
+                Container c(TimeStamp(i, 0));
+                participant1->send(c);
+            }
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < NUMBER_OF_CONTAINERS); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(listener.getFIFO().getSize() == NUMBER_OF_CONTAINERS);
+
+            participant2->setContainerListener(NULL);
+            participant1.reset();
+            participant2.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testSharedMemoryCreatorWithSlowContainerListener() {
+            // Destroy any existing ContainerConferenceFactory to use shared memory.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.215";
+            ContainerConferenceFactory::getInstance().setSharedMemoryEnabled(group, true);
+
+            std::shared_ptr<ContainerConference> creator = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> participant = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            SharedMemoryContainerConference *shmCreator = dynamic_cast<SharedMemoryContainerConference*>(creator.get());
+            SharedMemoryContainerConference *shmParticipant = dynamic_cast<SharedMemoryContainerConference*>(participant.get());
+            TS_ASSERT(shmCreator != NULL);
+            TS_ASSERT(shmParticipant != NULL);
+            if ( (shmCreator == NULL) || (shmParticipant == NULL) ) {
+                return;
+            }
+            TS_ASSERT(shmCreator->isBridge());
+
+            ConferenceFactoryTestBlockingContainerListener listener;
+            creator->setContainerListener(&listener);
+
+            Container c(TimeStamp(1, 0));
+            participant->send(c);
+            for (uint32_t i = 0; (i < 200) && !listener.isWaiting(); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(listener.isWaiting());
+
+            // The creator still signals while its ContainerListener blocks for longer than the timeout.
+            Thread::usleepFor(1500 * 1000);
+            TS_ASSERT(shmCreator->isBridge());
+            TS_ASSERT(!shmParticipant->isBridge());
+
+            listener.unblock();
+            creator->setContainerListener(NULL);
+            creator.reset();
+            participant.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testInProcessContainerConference() {
+            // Destroy any existing ContainerConferenceFactory to use in-process conferences.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.204";
+            ContainerConferenceFactory::getInstance().setInProcessEnabled(group, true);
+            TS_ASSERT(ContainerConferenceFactory::getInstance().isInProcessEnabled(group));
+
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver1 = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver2 = ContainerConferenceFactory::getInstance().getContainerConference(group);
+
+            InProcessContainerConference *inProcessSender = dynamic_cast<InProcessContainerConference*>(sender.get());
+            InProcessContainerConference *inProcessReceiver = dynamic_cast<InProcessContainerConference*>(receiver1.get());
+            TS_ASSERT(inProcessSender != NULL);
+            TS_ASSERT(inProcessReceiver != NULL);
+            if ( (inProcessSender == NULL) || (inProcessReceiver == NULL) ) {
+                return;
+            }
+
+            // All modules in this process share the same hub.
+            TS_ASSERT(inProcessSender->getHub() == inProcessReceiver->getHub());
+            TS_ASSERT(inProcessSender->getHub()->getNetworkConference().get() != NULL);
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest senderListener;
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener1;
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener2;
+            sender->setContainerListener(&senderListener);
+            receiver1->setContainerListener(&listener1);
+            receiver2->setContainerListener(&listener2);
+
+            sender->setSenderStamp(7);
+            const uint32_t NUMBER_OF_CONTAINERS = 20;
+            for (uint32_t i = 0; i < NUMBER_OF_CONTAINERS; i++) {
+                Container c(TimeStamp(i, 0));
+                sender->send(c);
+            }
+
+            // Wait for at most two seconds.
+            for (uint32_t i = 0; (i < 200) && ((listener1.getFIFO().getSize() < NUMBER_OF_CONTAINERS) || (listener2.getFIFO().getSize() < NUMBER_OF_CONTAINERS)); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+
+            TS_ASSERT(senderListener.getFIFO().getSize() == 0);
+            TS_ASSERT(listener1.getFIFO().getSize() == NUMBER_OF_CONTAINERS);
+            TS_ASSERT(listener2.getFIFO().getSize() == NUMBER_OF_CONTAINERS);
+            for (uint32_t i = 0; (i < NUMBER_OF_CONTAINERS) && !listener1.getFIFO().isEmpty() && !listener2.getFIFO().isEmpty(); i++) {
+                Container c1 = listener1.getFIFO().leave();
+                Container c2 = listener2.getFIFO().leave();
+                TS_ASSERT(c1.getDataType() == TimeStamp::ID());
+                TS_ASSERT(c1.getSenderStamp() == 7);
+                TS_ASSERT(c1.getData<TimeStamp>().getSeconds() == static_cast<int32_t>(i));
+
+                // The payload is shared instead of being copied.
+                TS_ASSERT(c1.getPayload().getData() == c2.getPayload().getData());
+            }
+
+            // Remote peers are reached via the network.
+            ContainerConferenceFactory::getInstance().setInProcessEnabled(group, false);
+            std::shared_ptr<ContainerConference> remote = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            TS_ASSERT(dynamic_cast<UDPMultiCastContainerConference*>(remote.get()) != NULL);
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest remoteListener;
+            remote->setContainerListener(&remoteListener);
+
+            Container toRemote(TimeStamp(100, 0));
+            sender->send(toRemote);
+            for (uint32_t i = 0; (i < 200) && (remoteListener.getFIFO().getSize() < 1); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(remoteListener.getFIFO().getSize() == 1);
+
+            // Containers from remote peers are delivered to all local modules.
+            Container fromRemote(TimeStamp(200, 0));
+            remote->send(fromRemote);
+            for (uint32_t i = 0; (i < 200) && (senderListener.getFIFO().getSize() < 1); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(senderListener.getFIFO().getSize() == 1);
+            if (!senderListener.getFIFO().isEmpty()) {
+                TS_ASSERT(senderListener.getFIFO().leave().getData<TimeStamp>().getSeconds() == 200);
+            }
+
+            remote->setContainerListener(NULL);
+            sender->setContainerListener(NULL);
+            receiver1->setContainerListener(NULL);
+            receiver2->setContainerListener(NULL);
+            remote.reset();
+            sender.reset();
+            receiver1.reset();
+            receiver2.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testInProcessContainerConferenceDropsOldestForSlowListener() {
+            // Destroy any existing ContainerConferenceFactory to use in-process conferences.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.209";
+            ContainerConferenceFactory::getInstance().setInProcessEnabled(group, true);
+
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            InProcessContainerConference *inProcessReceiver = dynamic_cast<InProcessContainerConference*>(receiver.get());
+            TS_ASSERT(inProcessReceiver != NULL);
+            if (inProcessReceiver == NULL) {
+                return;
+            }
+
+            ConferenceFactoryTestBlockingContainerListener listener;
+            receiver->setContainerListener(&listener);
+
+            // The listener blocks in the first container.
+            Container first(TimeStamp(0, 0));
+            sender->send(first);
+            for (uint32_t i = 0; (i < 200) && !listener.isWaiting(); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            TS_ASSERT(listener.isWaiting());
+
+            const uint32_t NUMBER_OF_DROPPED = 10;
+            const uint32_t NUMBER_OF_CONTAINERS = InProcessContainerConference::MAX_QUEUE_SIZE + NUMBER_OF_DROPPED;
+            for (uint32_t i = 1; i <= NUMBER_OF_CONTAINERS; i++) {
+                Container c(TimeStamp(i, 0));
+                sender->send(c);
+            }
+            TS_ASSERT(inProcessReceiver->getNumberOfOverruns() == NUMBER_OF_DROPPED);
+
+            listener.unblock();
+            const uint32_t NUMBER_OF_DELIVERED = 1 + InProcessContainerConference::MAX_QUEUE_SIZE;
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < NUMBER_OF_DELIVERED); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            receiver->setContainerListener(NULL);
+
+            // The oldest queued containers were dropped.
+            TS_ASSERT(listener.getFIFO().getSize() == NUMBER_OF_DELIVERED);
+            if (listener.getFIFO().getSize() == NUMBER_OF_DELIVERED) {
+                TS_ASSERT(listener.getFIFO().leave().getData<TimeStamp>().getSeconds() == 0);
+                TS_ASSERT(listener.getFIFO().leave().getData<TimeStamp>().getSeconds() == static_cast<int32_t>(NUMBER_OF_DROPPED + 1));
+            }
+
+            ContainerConferenceFactory::getInstance().setInProcessEnabled(group, false);
+            sender.reset();
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testInProcessContainerHubSubscribesUnionOfParticipants() {
+            // Destroy any existing ContainerConferenceFactory to use in-process conferences.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.210";
+            ContainerConferenceFactory::getInstance().setInProcessEnabled(group, true);
+
+            std::shared_ptr<ContainerConference> participant1 = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> participant2 = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            InProcessContainerConference *inProcessParticipant = dynamic_cast<InProcessContainerConference*>(participant1.get());
+            TS_ASSERT(inProcessParticipant != NULL);
+            if (inProcessParticipant == NULL) {
+                return;
+            }
+            std::shared_ptr<ContainerConference> network = inProcessParticipant->getHub()->getNetworkConference();
+            TS_ASSERT(network.get() != NULL);
+            if (network.get() == NULL) {
+                return;
+            }
+
+            // Participants that neither subscribed nor listen yet are not considered.
+            participant1->subscribe(TimeStamp::ID());
+            TS_ASSERT(participant1->isSubscribed(TimeStamp::ID()));
+            TS_ASSERT(!participant1->isSubscribed(Packet::ID()));
+            TS_ASSERT(network->isSubscribed(TimeStamp::ID()));
+            TS_ASSERT(!network->isSubscribed(Packet::ID()));
+            TS_ASSERT(!network->isSubscribed(Container::UNDEFINEDDATA));
+
+            // The network conference receives all data types while one participant does.
+            ConferenceFactoryTestContainerListener listener;
+            participant2->setContainerListener(&listener);
+            TS_ASSERT(network->isSubscribed(Packet::ID()));
+            TS_ASSERT(network->isSubscribed(Container::UNDEFINEDDATA));
+
+            // Once all participants are filtered, the network conference receives their union.
+            participant2->subscribe(Packet::ID());
+            TS_ASSERT(network->isSubscribed(TimeStamp::ID()));
+            TS_ASSERT(network->isSubscribed(Packet::ID()));
+            TS_ASSERT(!network->isSubscribed(Container::UNDEFINEDDATA));
+
+            // A new participant is considered once it listens.
+            std::shared_ptr<ContainerConference> participant3 = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            TS_ASSERT(!network->isSubscribed(Container::UNDEFINEDDATA));
+            participant3->setContainerListener(&listener);
+            TS_ASSERT(network->isSubscribed(Container::UNDEFINEDDATA));
+            participant3->setContainerListener(NULL);
+            TS_ASSERT(!network->isSubscribed(Container::UNDEFINEDDATA));
+
+            // Subscriptions are narrowed again when participants leave.
+            participant2->setContainerListener(NULL);
+            participant2.reset();
+            TS_ASSERT(network->isSubscribed(TimeStamp::ID()));
+            TS_ASSERT(!network->isSubscribed(Packet::ID()));
+
+            ContainerConferenceFactory::getInstance().setInProcessEnabled(group, false);
+            network.reset();
+            participant1.reset();
+            participant2.reset();
+            participant3.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testTopicPartitioning() {
+            TopicPartitioning tp;
+            TS_ASSERT(!tp.isEnabled());
+            TS_ASSERT(tp.getGroup(42) == 0);
+
+            TS_ASSERT(tp.addRange(10, 19, 1));
+            TS_ASSERT(tp.addRange(30, 30, 2));
+            TS_ASSERT(!tp.addRange(20, 10, 3));
+            TS_ASSERT(!tp.addRange(40, 40, 0));
+            TS_ASSERT(tp.isEnabled());
+            TS_ASSERT(tp.getGroup(9) == 0);
+            TS_ASSERT(tp.getGroup(10) == 1);
+            TS_ASSERT(tp.getGroup(19) == 1);
+            TS_ASSERT(tp.getGroup(20) == 0);
+            TS_ASSERT(tp.getGroup(30) == 2);
+            TS_ASSERT(tp.getNumberOfGroups() == 2);
+
+            // Overlapping ranges replace previous ones.
+            TS_ASSERT(tp.addRange(15, 30, 1));
+            TS_ASSERT(tp.getGroup(10) == 0);
+            TS_ASSERT(tp.getGroup(30) == 1);
+            TS_ASSERT(tp.getNumberOfGroups() == 1);
+
+            // Unmapped data types are spread after the configured groups.
+            tp.setNumberOfHashedGroups(3);
+            TS_ASSERT(tp.getNumberOfGroups() == 4);
+            TS_ASSERT(tp.getGroup(20) == 1);
+            TS_ASSERT(tp.getGroup(9) == 2);
+            TS_ASSERT(tp.getGroup(10) == 3);
+            TS_ASSERT(tp.getGroup(11) == 4);
+
+            TS_ASSERT(TopicPartitioning::getAddress("225.0.0.205", 0) == "225.0.0.205");
+            TS_ASSERT(TopicPartitioning::getAddress("225.0.0.205", 2) == "225.2.0.205");
+            TS_ASSERT(TopicPartitioning::getAddress("225.0.0.255", 1) == "225.1.0.255");
+            TS_ASSERT(TopicPartitioning::getAddress("225.0.0.205", 255) == "225.255.0.205");
+            TS_ASSERT(TopicPartitioning::getAddress("225.0.0.205", 256) == "");
+            TS_ASSERT(TopicPartitioning::getAddress("225.0.0", 1) == "");
+            TS_ASSERT(TopicPartitioning::getAddress("255.255.255.255", 1) == "");
+
+            // The groups of one CID do not overlap the conferences of other CIDs.
+            for (uint32_t cid = 0; cid < 255; cid++) {
+                stringstream conference;
+                conference << "225.0.0." << cid;
+                stringstream nextConference;
+                nextConference << "225.0.0." << (cid + 1);
+                for (uint32_t group = 1; group <= 255; group++) {
+                    const string address = TopicPartitioning::getAddress(conference.str(), group);
+                    TS_ASSERT(address != "");
+                    TS_ASSERT(address != nextConference.str());
+                    TS_ASSERT(address.find("225.0.0.") != 0);
+                    TS_ASSERT(address != TopicPartitioning::getAddress(nextConference.str(), group));
+                }
+            }
+        }
+
+        void testUDPMultiCastContainerConferenceTopicPartitioning() {
+            // Destroy any existing ContainerConferenceFactory to use UDP multicast.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            // TimeStamps are sent to 225.0.0.206 and Packets to 225.0.0.207.
+            const string group = "225.0.0.205";
+            TopicPartitioning tp;
+            tp.addRange(TimeStamp::ID(), TimeStamp::ID(), 1);
+            tp.addRange(Packet::ID(), Packet::ID(), 2);
+            ContainerConferenceFactory::getInstance().setTopicPartitioning(group, tp);
+            TS_ASSERT(ContainerConferenceFactory::getInstance().getTopicPartitioning(group).getNumberOfGroups() == 2);
+
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            TS_ASSERT(sender.get());
+            TS_ASSERT(receiver.get());
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            receiver->setContainerListener(&listener);
+            receiver->subscribe(Packet::ID());
+            // The unmapped data type remains on the conference's group.
+            const int32_t UNMAPPED = 4711;
+            receiver->subscribe(UNMAPPED);
+            // Give the network stack some time to join the multicast group.
+            Thread::usleepFor(100 * 1000);
+
+            Packet p("Sender", "Data", TimeStamp());
+            Container c1(TimeStamp(100, 0));
+            Container c2(p);
+            Container c3(p, UNMAPPED);
+            sender->send(c1);
+            sender->send(c2);
+            sender->send(c3);
+
+            // Wait for at most two seconds.
+            for (uint32_t i = 0; (i < 200) && (listener.getFIFO().getSize() < 2); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            // Wait for any unexpected container.
+            Thread::usleepFor(100 * 1000);
+
+            receiver->setContainerListener(NULL);
+
+            TS_ASSERT(listener.getFIFO().getSize() == 2);
+            bool receivedPacket = false;
+            bool receivedUnmapped = false;
+            while (!listener.getFIFO().isEmpty()) {
+                Container received = listener.getFIFO().leave();
+                TS_ASSERT(received.getDataType() != TimeStamp::ID());
+                receivedPacket |= (received.getDataType() == Packet::ID());
+                receivedUnmapped |= (received.getDataType() == UNMAPPED);
+            }
+            TS_ASSERT(receivedPacket);
+            TS_ASSERT(receivedUnmapped);
+
+            sender.reset();
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
+
+        void testUDPMultiCastContainerConferenceSubscriptionFiltering() {
+            // Destroy any existing ContainerConferenceFactory to use UDP multicast.
+            ContainerConferenceFactory &ccf = ContainerConferenceFactory::getInstance();
+            ContainerConferenceFactory *ccf2 = &ccf;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+
+            const string group = "225.0.0.208";
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(group);
+            TS_ASSERT(sender.get());
+            TS_ASSERT(receiver.get());
+
+            // Without any subscription, all data types are received.
+            TS_ASSERT(receiver->isSubscribed(TimeStamp::ID()));
+            TS_ASSERT(receiver->isSubscribed(Packet::ID()));
+
+            receiver->subscribe(TimeStamp::ID());
+            TS_ASSERT(receiver->isSubscribed(TimeStamp::ID()));
+            TS_ASSERT(!receiver->isSubscribed(Packet::ID()));
+
+            ConferenceFactoryTestContainerListenerForContainerFromSystemsUnderTest listener;
+            receiver->setContainerListener(&listener);
+            // Give the network stack some time to join the multicast group.
+            Thread::usleepFor(100 * 1000);
+
+            Packet p("Sender", "Data", TimeStamp());
+            Container c1(p);
+            Container c2(TimeStamp(100, 0));
+            Container c3(p);
+            sender->send(c1);
+            sender->send(c2);
+            sender->send(c3);
+
+            // Wait for at most two seconds.
+            for (uint32_t i = 0; (i < 200) && (receiver->getNumberOfDroppedContainers()[Packet::ID()] < 2); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+
+            receiver->setContainerListener(NULL);
+
+            TS_ASSERT(listener.getFIFO().getSize() == 1);
+            if (!listener.getFIFO().isEmpty()) {
+                TS_ASSERT(listener.getFIFO().leave().getData<TimeStamp>().getSeconds() == 100);
+            }
+            map<int32_t, uint64_t> dropped = receiver->getNumberOfDroppedContainers();
+            TS_ASSERT(dropped.size() == 1);
+            TS_ASSERT(dropped[Packet::ID()] == 2);
+
+            // Subscribing to all data types disables the filtering.
+            receiver->subscribeAll();
+            TS_ASSERT(receiver->isSubscribed(Packet::ID()));
+
+            sender.reset();
+            receiver.reset();
+
+            ContainerConferenceFactory &ccfDestroy = ContainerConferenceFactory::getInstance();
+            ccf2 = &ccfDestroy;
+            OPENDAVINCI_CORE_DELETE_POINTER(ccf2);
+        }
 };
 
 #endif /*CONTEXT_CONFERENCEFACTORYTESTSUITE_H_*/
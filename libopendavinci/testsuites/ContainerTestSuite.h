@@ -22,11 +22,15 @@
 
 #include <sstream>                      // for stringstream, etc
 #include <string>                       // for operator==, basic_string
+#include <vector>                       // for vector
 
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
+#include "opendavinci/odcore/serialization/ByteWriter.h"     // for ByteWriter
+#include "opendavinci/odcore/serialization/ProtoSerializer.h"     // for ProtoSerializer
 #include "opendavinci/odcore/serialization/Serializable.h"     // for operator<<, operator>>
 #include "opendavinci/odcore/data/Container.h"        // for Container, etc
+#include "opendavinci/odcore/data/ContainerHeaderView.h"
 #include "opendavinci/odcore/data/TimeStamp.h"        // for TimeStamp
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
 #include "opendavinci/odcore/io/conference/ContainerListenerFork.h"
@@ -163,6 +167,208 @@ class ContainerTest : public CxxTest::TestSuite {
             TS_ASSERT(c2.getSampleTimeStamp().toString() == c1.getSampleTimeStamp().toString());
         }
 
+        void testCopiesShareImmutablePayload() {
+            TimeStamp ts(12, 34);
+            Container c1(ts);
+            c1.setSenderStamp(5);
+
+            Container c2(c1);
+            Container c3;
+            c3 = c2;
+
+            // Replacing the original container must not affect its copies.
+            TimeStamp ts2(56, 78);
+            c1 = Container(ts2);
+
+            TS_ASSERT(c2.getData<TimeStamp>().toMicroseconds() == ts.toMicroseconds());
+            TS_ASSERT(c3.getData<TimeStamp>().toMicroseconds() == ts.toMicroseconds());
+            TS_ASSERT(c1.getData<TimeStamp>().toMicroseconds() == ts2.toMicroseconds());
+            TS_ASSERT(c3.getSenderStamp() == 5);
+
+            // Decoding the payload several times must yield the same result.
+            TS_ASSERT(c3.getData<TimeStamp>().toMicroseconds() == ts.toMicroseconds());
+
+            // An empty container must still be serializable.
+            Container c4;
+            stringstream s;
+            s << c4;
+            s.flush();
+
+            Container c5(ts);
+            s >> c5;
+            TS_ASSERT(c5.getDataType() == Container::UNDEFINEDDATA);
+        }
+
+        void testEnvelopeV2() {
+            TimeStamp ts(9, 10);
+            Container c1(ts);
+            c1.setSentTimeStamp(TimeStamp(1, 2));
+            c1.setReceivedTimeStamp(TimeStamp(3, 4));
+            c1.setSampleTimeStamp(TimeStamp(5, 6));
+            c1.setSenderStamp(7);
+            c1.setEnvelope(Container::ENVELOPE_V2);
+
+            stringstream s;
+            s << c1;
+            s.flush();
+
+            const string data = s.str();
+            TS_ASSERT(data.size() > ContainerHeaderView::V2_HEADER_SIZE);
+            TS_ASSERT(static_cast<uint8_t>(data.at(0)) == 0x0D);
+            TS_ASSERT(static_cast<uint8_t>(data.at(1)) == 0xA4);
+            TS_ASSERT(static_cast<uint8_t>(data.at(5)) == ContainerHeaderView::V2_MARKER);
+
+            Container c2;
+            s >> c2;
+            TS_ASSERT(c2.getEnvelope() == Container::ENVELOPE_V2);
+            TS_ASSERT(c2.getDataType() == ts.getID());
+            TS_ASSERT(c2.getSenderStamp() == 7);
+            TS_ASSERT(c2.getData<TimeStamp>().toString() == ts.toString());
+            TS_ASSERT(c2.getSentTimeStamp().toString() == c1.getSentTimeStamp().toString());
+            TS_ASSERT(c2.getReceivedTimeStamp().toString() == c1.getReceivedTimeStamp().toString());
+            TS_ASSERT(c2.getSampleTimeStamp().toString() == c1.getSampleTimeStamp().toString());
+        }
+
+        /**
+         * This method encodes a Container like the Serializer-based
+         * encoder did before the fixed-layout envelope was introduced;
+         * the v2 envelope is encoded field by field.
+         */
+        string encodeWithLegacyEncoder(const Container &c, const string &payload) {
+            stringstream bufferOut;
+            if (Container::ENVELOPE_V2 == c.getEnvelope()) {
+                const uint32_t values[] = { static_cast<uint32_t>(c.getDataType()), c.getSenderStamp(),
+                                            static_cast<uint32_t>(c.getSentTimeStamp().getSeconds()), static_cast<uint32_t>(c.getSentTimeStamp().getMicroseconds()),
+                                            static_cast<uint32_t>(c.getReceivedTimeStamp().getSeconds()), static_cast<uint32_t>(c.getReceivedTimeStamp().getMicroseconds()),
+                                            static_cast<uint32_t>(c.getSampleTimeStamp().getSeconds()), static_cast<uint32_t>(c.getSampleTimeStamp().getMicroseconds()) };
+                const char marker[] = { static_cast<char>(ContainerHeaderView::V2_MARKER), 0, 0, 0 };
+                bufferOut.write(marker, sizeof(marker));
+                for (uint32_t i = 0; i < sizeof(values)/sizeof(values[0]); i++) {
+                    const uint32_t value = htole32(values[i]);
+                    bufferOut.write(reinterpret_cast<const char*>(&value), sizeof(uint32_t));
+                }
+                bufferOut << payload;
+            }
+            else {
+                odcore::serialization::ProtoSerializer s(bufferOut);
+                int32_t dataType = c.getDataType();
+                s.write(1, dataType);
+                s.write(2, payload);
+                s.write(3, c.getSentTimeStamp());
+                s.write(4, c.getReceivedTimeStamp());
+                s.write(5, c.getSampleTimeStamp());
+                uint32_t senderStamp = c.getSenderStamp();
+                s.write(6, senderStamp);
+            }
+
+            const string fields = bufferOut.str();
+            const char byte0 = 0x0D;
+            const uint32_t length = htole32((static_cast<uint32_t>(fields.size()) << 8) | 0xA4);
+
+            stringstream out;
+            out.write(&byte0, sizeof(byte0));
+            out.write(reinterpret_cast<const char*>(&length), sizeof(uint32_t));
+            out << fields;
+            return out.str();
+        }
+
+        void testSerializeToBuffer() {
+            TimeStamp ts(-9, 10);
+            Container c1(ts);
+            c1.setSentTimeStamp(TimeStamp(1, -2));
+            c1.setReceivedTimeStamp(TimeStamp(300000, 4));
+            c1.setSampleTimeStamp(TimeStamp(5, 999999));
+            c1.setSenderStamp(0xFFFFFFFF);
+
+            stringstream payload;
+            payload << ts;
+            const string expectedPayload = payload.str();
+
+            for (uint32_t envelope = Container::ENVELOPE_V1; envelope <= Container::ENVELOPE_V2; envelope++) {
+                c1.setEnvelope(static_cast<Container::ENVELOPE>(envelope));
+
+                stringstream s;
+                s << c1;
+                const string data = s.str();
+
+                // Compare with the byte sequence produced by the legacy encoder.
+                TS_ASSERT(data == encodeWithLegacyEncoder(c1, expectedPayload));
+
+                vector<char> buffer(c1.getSerializedSize());
+                TS_ASSERT(buffer.size() == data.size());
+
+                odcore::serialization::ByteWriter out(&buffer[0], buffer.size());
+                c1.serializeTo(out);
+                TS_ASSERT(out.isGood());
+                TS_ASSERT(out.getPosition() == data.size());
+                TS_ASSERT(string(&buffer[0], buffer.size()) == data);
+
+                Container c2;
+                stringstream s2(string(&buffer[0], buffer.size()));
+                s2 >> c2;
+                TS_ASSERT(c2.getEnvelope() == c1.getEnvelope());
+                TS_ASSERT(c2.getDataType() == ts.getID());
+                TS_ASSERT(c2.getSenderStamp() == 0xFFFFFFFF);
+                TS_ASSERT(c2.getData<TimeStamp>().toString() == ts.toString());
+                TS_ASSERT(c2.getSentTimeStamp().toString() == c1.getSentTimeStamp().toString());
+                TS_ASSERT(c2.getReceivedTimeStamp().toString() == c1.getReceivedTimeStamp().toString());
+                TS_ASSERT(c2.getSampleTimeStamp().toString() == c1.getSampleTimeStamp().toString());
+
+                // Human readable representations are available for both envelopes.
+                TS_ASSERT(c2.getReceivedTimeStamp().getYear() == 1970);
+                TS_ASSERT(c2.getReceivedTimeStamp().getYYYYMMDD_HHMMSS() == c1.getReceivedTimeStamp().getYYYYMMDD_HHMMSS());
+
+                // A too small buffer is not overrun.
+                odcore::serialization::ByteWriter tooSmall(&buffer[0], buffer.size() - 1);
+                c1.serializeTo(tooSmall);
+                TS_ASSERT(!tooSmall.isGood());
+            }
+        }
+
+        void testContainerHeaderView() {
+            TimeStamp ts(9, 10);
+            Container c1(ts, 1234);
+            c1.setSentTimeStamp(TimeStamp(1, -2));
+            c1.setReceivedTimeStamp(TimeStamp(3, 4));
+            c1.setSampleTimeStamp(TimeStamp(5, 6));
+            c1.setSenderStamp(7);
+
+            stringstream payload;
+            payload << ts;
+            const string expectedPayload = payload.str();
+
+            for (uint32_t envelope = Container::ENVELOPE_V1; envelope <= Container::ENVELOPE_V2; envelope++) {
+                c1.setEnvelope(static_cast<Container::ENVELOPE>(envelope));
+
+                stringstream s;
+                s << c1;
+                const string data = s.str();
+
+                ContainerHeaderView view(data.c_str(), data.size());
+                TS_ASSERT(view.isValid());
+                TS_ASSERT(view.getEnvelope() == envelope);
+                TS_ASSERT(view.getSize() == data.size());
+                TS_ASSERT(view.getDataType() == 1234);
+                TS_ASSERT(view.getSenderStamp() == 7);
+                TS_ASSERT(view.getSentTimeStamp().toString() == c1.getSentTimeStamp().toString());
+                TS_ASSERT(view.getReceivedTimeStamp().toString() == c1.getReceivedTimeStamp().toString());
+                TS_ASSERT(view.getSampleTimeStamp().toString() == c1.getSampleTimeStamp().toString());
+                TS_ASSERT(string(view.getPayload(), view.getPayloadLength()) == expectedPayload);
+
+                // Only the prefix is available.
+                ContainerHeaderView prefix(data.c_str(), ContainerHeaderView::PREFIX_SIZE);
+                TS_ASSERT(!prefix.isValid());
+                TS_ASSERT(prefix.getSize() == data.size());
+
+                // Corrupt magic.
+                string corrupt = data;
+                corrupt[0] = 0x0E;
+                ContainerHeaderView invalid(corrupt.c_str(), corrupt.size());
+                TS_ASSERT(!invalid.isValid());
+                TS_ASSERT(invalid.getSize() == 0);
+            }
+        }
+
         void testContainerListenerFork() {
             ContainerListenerFork clf;
 
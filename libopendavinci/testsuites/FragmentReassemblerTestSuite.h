@@ -0,0 +1,261 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2015 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_FRAGMENTREASSEMBLERTESTSUITE_H_
+#define CORE_FRAGMENTREASSEMBLERTESTSUITE_H_
+
+#include <string>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/io/udp/FragmentReassembler.h"
+
+using namespace std;
+using namespace odcore::data;
+using namespace odcore::io::udp;
+
+class FragmentReassemblerTest : public CxxTest::TestSuite {
+    private:
+        enum {
+            SENDER_ADDRESS = 0x7F000001, // 127.0.0.1
+            SENDER_PORT = 12345
+        };
+
+        static string createData(const uint32_t &length) {
+            string data(length, '\0');
+            for (uint32_t i = 0; i < length; i++) {
+                data[i] = static_cast<char>(i % 251);
+            }
+            return data;
+        }
+
+    public:
+        void testFragmentAndReassemble() {
+            const string data = createData(10000);
+
+            vector<string> fragments;
+            TS_ASSERT(FragmentReassembler::fragment(data, 1, 2, 1000, fragments));
+            TS_ASSERT(fragments.size() == 11);
+            for (uint32_t i = 0; i < fragments.size(); i++) {
+                TS_ASSERT(fragments[i].size() <= 1000);
+                TS_ASSERT(FragmentReassembler::isFragment(fragments[i].data(), fragments[i].size()));
+            }
+
+            FragmentReassembler r(1024 * 1024, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            for (uint32_t i = 0; i < fragments.size() - 1; i++) {
+                TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[i].data(), fragments[i].size(), TimeStamp(), message));
+            }
+            TS_ASSERT(r.getNumberOfPendingBytes() > 0);
+            TS_ASSERT(r.add(SENDER_ADDRESS, SENDER_PORT, fragments.back().data(), fragments.back().size(), TimeStamp(), message));
+            TS_ASSERT(message == data);
+            TS_ASSERT(r.getNumberOfPendingBytes() == 0);
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 0);
+        }
+
+        void testReassembleOutOfOrderAndInterleaved() {
+            const string data1 = createData(5000);
+            const string data2 = createData(3000);
+
+            vector<string> fragments1;
+            vector<string> fragments2;
+            TS_ASSERT(FragmentReassembler::fragment(data1, 1, 1, 1000, fragments1));
+            TS_ASSERT(FragmentReassembler::fragment(data2, 1, 2, 1000, fragments2));
+
+            FragmentReassembler r(1024 * 1024, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            uint32_t completed = 0;
+            for (int32_t i = static_cast<int32_t>(fragments1.size()) - 1; i >= 0; i--) {
+                if (static_cast<uint32_t>(i) < fragments2.size()) {
+                    if (r.add(SENDER_ADDRESS, SENDER_PORT, fragments2[i].data(), fragments2[i].size(), TimeStamp(), message)) {
+                        TS_ASSERT(message == data2);
+                        completed++;
+                    }
+                }
+                if (r.add(SENDER_ADDRESS, SENDER_PORT, fragments1[i].data(), fragments1[i].size(), TimeStamp(), message)) {
+                    TS_ASSERT(message == data1);
+                    completed++;
+                }
+            }
+            TS_ASSERT(completed == 2);
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 0);
+        }
+
+        void testDropDuplicatedAndInvalidFragments() {
+            vector<string> fragments;
+            TS_ASSERT(FragmentReassembler::fragment(createData(3000), 1, 1, 1000, fragments));
+
+            FragmentReassembler r(1024 * 1024, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[0].data(), fragments[0].size(), TimeStamp(), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[0].data(), fragments[0].size(), TimeStamp(), message));
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 1);
+
+            const string invalid = "No fragment";
+            TS_ASSERT(!FragmentReassembler::isFragment(invalid.data(), invalid.size()));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, invalid.data(), invalid.size(), TimeStamp(), message));
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 2);
+
+            // Index beyond count.
+            string corrupt = fragments[1];
+            corrupt[10] = static_cast<char>(0x10);
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, corrupt.data(), corrupt.size(), TimeStamp(), message));
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 3);
+        }
+
+        void testEvictExpiredMessages() {
+            vector<string> fragments;
+            TS_ASSERT(FragmentReassembler::fragment(createData(3000), 1, 1, 1000, fragments));
+
+            FragmentReassembler r(1024 * 1024, 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[0].data(), fragments[0].size(), TimeStamp(10, 0), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[1].data(), fragments[1].size(), TimeStamp(10, 500), message));
+
+            // The last fragment arrives too late.
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[2].data(), fragments[2].size(), TimeStamp(10, 2000), message));
+            TS_ASSERT(r.getNumberOfEvictedMessages() == 1);
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 2);
+        }
+
+        void testEvictOldestMessageWhenMemoryIsExhausted() {
+            vector<string> fragments1;
+            vector<string> fragments2;
+            TS_ASSERT(FragmentReassembler::fragment(createData(2900), 1, 1, 1000, fragments1));
+            TS_ASSERT(FragmentReassembler::fragment(createData(2900), 1, 2, 1000, fragments2));
+
+            // Two fragments of each message plus the bookkeeping of two messages do not fit.
+            FragmentReassembler r(3500, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments1[0].data(), fragments1[0].size(), TimeStamp(10, 0), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments1[1].data(), fragments1[1].size(), TimeStamp(10, 0), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments2[0].data(), fragments2[0].size(), TimeStamp(10, 1), message));
+            TS_ASSERT(r.getNumberOfEvictedMessages() == 0);
+
+            // The oldest message is evicted to make room.
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments2[1].data(), fragments2[1].size(), TimeStamp(10, 2), message));
+            TS_ASSERT(r.getNumberOfEvictedMessages() == 1);
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 2);
+            TS_ASSERT(r.getNumberOfPendingBytes() <= 3500);
+
+            TS_ASSERT(r.add(SENDER_ADDRESS, SENDER_PORT, fragments2[2].data(), fragments2[2].size(), TimeStamp(10, 3), message));
+            TS_ASSERT(message == createData(2900));
+            TS_ASSERT(r.getNumberOfPendingBytes() == 0);
+        }
+
+        void testSeparateSenders() {
+            vector<string> fragments;
+            TS_ASSERT(FragmentReassembler::fragment(createData(2000), 1, 1, 1000, fragments));
+            TS_ASSERT(fragments.size() == 3);
+
+            FragmentReassembler r(1024 * 1024, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[0].data(), fragments[0].size(), TimeStamp(), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT + 1, fragments[1].data(), fragments[1].size(), TimeStamp(), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[2].data(), fragments[2].size(), TimeStamp(), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT + 1, fragments[0].data(), fragments[0].size(), TimeStamp(), message));
+            TS_ASSERT(r.add(SENDER_ADDRESS, SENDER_PORT, fragments[1].data(), fragments[1].size(), TimeStamp(), message));
+            TS_ASSERT(message == createData(2000));
+        }
+        void testEvictOldestMessageWhenTooManyArePending() {
+            vector<string> fragments1;
+            vector<string> fragments2;
+            vector<string> fragments3;
+            TS_ASSERT(FragmentReassembler::fragment(createData(2000), 1, 1, 1000, fragments1));
+            TS_ASSERT(FragmentReassembler::fragment(createData(2000), 1, 2, 1000, fragments2));
+            TS_ASSERT(FragmentReassembler::fragment(createData(2000), 1, 3, 1000, fragments3));
+
+            FragmentReassembler r(1024 * 1024, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 2);
+            string message;
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments1[0].data(), fragments1[0].size(), TimeStamp(10, 0), message));
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments2[0].data(), fragments2[0].size(), TimeStamp(10, 1), message));
+            TS_ASSERT(r.getNumberOfEvictedMessages() == 0);
+
+            // The third message replaces the oldest one.
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments3[0].data(), fragments3[0].size(), TimeStamp(10, 2), message));
+            TS_ASSERT(r.getNumberOfEvictedMessages() == 1);
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 1);
+
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments2[1].data(), fragments2[1].size(), TimeStamp(10, 3), message));
+            TS_ASSERT(r.add(SENDER_ADDRESS, SENDER_PORT, fragments2[2].data(), fragments2[2].size(), TimeStamp(10, 3), message));
+            TS_ASSERT(message == createData(2000));
+            TS_ASSERT(r.getNumberOfEvictedMessages() == 1);
+        }
+
+        void testDropEmptyFragments() {
+            const string data = createData(2000);
+            vector<string> fragments;
+            TS_ASSERT(FragmentReassembler::fragment(data, 1, 1, 1000, fragments));
+            TS_ASSERT(fragments.size() == 3);
+
+            FragmentReassembler r(1024 * 1024, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[0].data(), fragments[0].size(), TimeStamp(), message));
+
+            // Fragments without payload neither occupy an index nor complete the message.
+            for (uint32_t i = 1; i < fragments.size(); i++) {
+                const string empty = fragments[i].substr(0, FragmentReassembler::HEADER_SIZE);
+                TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, empty.data(), empty.size(), TimeStamp(), message));
+            }
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 2);
+
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[1].data(), fragments[1].size(), TimeStamp(), message));
+            TS_ASSERT(r.add(SENDER_ADDRESS, SENDER_PORT, fragments[2].data(), fragments[2].size(), TimeStamp(), message));
+            TS_ASSERT(message == data);
+        }
+
+        void testDropFragmentsExceedingTheNumberOfFragments() {
+            vector<string> fragments;
+            TS_ASSERT(FragmentReassembler::fragment(createData(3000), 1, 1, 1000, fragments));
+            TS_ASSERT(fragments.size() == 4);
+
+            FragmentReassembler r(1024 * 1024, 1000 * 1000, 3, 16);
+            string message;
+            for (uint32_t i = 0; i < fragments.size(); i++) {
+                TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[i].data(), fragments[i].size(), TimeStamp(), message));
+            }
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 4);
+            TS_ASSERT(r.getNumberOfPendingBytes() == 0);
+        }
+
+        void testPendingBytesIncludeBookkeeping() {
+            vector<string> fragments;
+            TS_ASSERT(FragmentReassembler::fragment(createData(2000), 1, 1, 1000, fragments));
+
+            FragmentReassembler r(64 * 1024, 1000 * 1000, FragmentReassembler::MAX_NUMBER_OF_FRAGMENTS, 16);
+            string message;
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, fragments[0].data(), fragments[0].size(), TimeStamp(), message));
+            TS_ASSERT(r.getNumberOfPendingBytes() > (fragments[0].size() - FragmentReassembler::HEADER_SIZE));
+
+            // A fragment announcing 65535 fragments needs more bookkeeping than available.
+            string announcing = fragments[0];
+            announcing[6] = static_cast<char>(0x02);
+            announcing[12] = static_cast<char>(0xFF);
+            announcing[13] = static_cast<char>(0xFF);
+            const uint32_t PENDING = r.getNumberOfPendingBytes();
+            TS_ASSERT(!r.add(SENDER_ADDRESS, SENDER_PORT, announcing.data(), announcing.size(), TimeStamp(), message));
+            TS_ASSERT(r.getNumberOfPendingBytes() == PENDING);
+            TS_ASSERT(r.getNumberOfDroppedFragments() == 1);
+            TS_ASSERT(r.getNumberOfEvictedMessages() == 0);
+        }
+};
+
+#endif /*CORE_FRAGMENTREASSEMBLERTESTSUITE_H_*/
@@ -39,8 +39,11 @@
 #include "opendavinci/odcore/reflection/Message.h"    // for Message
 #include "opendavinci/odcore/reflection/MessageFromVisitableVisitor.h"
 #include "opendavinci/odcore/reflection/MessagePrettyPrinterVisitor.h"
+#include "opendavinci/odcore/reflection/MessageResolver.h"
 #include "opendavinci/odcore/reflection/MessageToVisitableVisitor.h"
 #include "opendavinci/odcore/strings/StringToolbox.h"  // for StringToolbox
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/generated/odcore/data/dmcp/ModuleStatistic.h"
 
 using namespace std;
 using namespace odcore;
@@ -365,6 +368,92 @@ class FieldTest : public CxxTest::TestSuite {
             found = true; extracted = true; value = msg.getValueFromScalarField<double>(6, found, extracted);
             TS_ASSERT(!found); TS_ASSERT(!extracted);
         }
+
+        void testMessageFieldIndex() {
+            Message msg;
+
+            Field<int32_t> *f1 = new Field<int32_t>(1);
+            f1->setFieldIdentifier(7);
+            f1->setFieldDataType(odcore::data::reflection::AbstractField::INT32_T);
+            msg.addField(std::shared_ptr<AbstractField>(f1));
+
+            Field<int32_t> *f2 = new Field<int32_t>(2);
+            f2->setFieldIdentifier(3);
+            f2->setFieldDataType(odcore::data::reflection::AbstractField::INT32_T);
+            msg.addField(std::shared_ptr<AbstractField>(f2));
+
+            // The first field with an identifier is found.
+            Field<int32_t> *f3 = new Field<int32_t>(3);
+            f3->setFieldIdentifier(7);
+            f3->setFieldDataType(odcore::data::reflection::AbstractField::INT32_T);
+            msg.addField(std::shared_ptr<AbstractField>(f3));
+
+            TS_ASSERT(msg.getNumberOfFields() == 3);
+            TS_ASSERT(msg.getFieldByIndex(1)->getFieldIdentifier() == 3);
+            TS_ASSERT(msg.getFieldByIndex(3).get() == NULL);
+
+            bool found = false;
+            bool extracted = false;
+            TS_ASSERT(msg.getValueFromScalarField<int32_t>(7, found, extracted) == 1);
+            TS_ASSERT(found); TS_ASSERT(extracted);
+            TS_ASSERT(msg.getValueFromScalarField<int32_t>(3, found, extracted) == 2);
+            TS_ASSERT(found); TS_ASSERT(extracted);
+
+            // A copy keeps the index.
+            Message msg2(msg);
+            TS_ASSERT(msg2.getValueFromScalarField<int32_t>(7, found, extracted) == 1);
+            TS_ASSERT(found); TS_ASSERT(extracted);
+            msg2.getFieldByIdentifier(4, found);
+            TS_ASSERT(!found);
+        }
+
+        void testMessageResolverUsesDecodePlan() {
+            MessageResolver mr(vector<string>(), "libodvd", ".so");
+
+            for (uint32_t i = 0; i < 3; i++) {
+                odcore::data::dmcp::ModuleDescriptor md;
+                md.setName("Module");
+                md.setIdentifier("Id");
+                md.setVersion("Version");
+                md.setFrequency(10.5f + i);
+                odcore::data::dmcp::RuntimeStatistic rs;
+                rs.setSliceConsumption(0.25 * i);
+                odcore::data::dmcp::ModuleStatistic ms;
+                ms.setModule(md);
+                ms.setRuntimeStatistic(rs);
+
+                // The first message is resolved by the helper; the following ones by the decode plan.
+                Container c(ms);
+                bool successfullyMapped = false;
+                Message msg = mr.resolve(c, successfullyMapped);
+                TS_ASSERT(successfullyMapped);
+                TS_ASSERT(msg.getID() == odcore::data::dmcp::ModuleStatistic::ID());
+                TS_ASSERT(msg.getLongName() == "odcore.data.dmcp.ModuleStatistic");
+                TS_ASSERT(msg.getNumberOfFields() == 2);
+
+                bool found = false;
+                std::shared_ptr<AbstractField> module = msg.getFieldByIdentifier(1, found);
+                TS_ASSERT(found);
+                TS_ASSERT(module->getShortFieldName() == "module");
+                Message moduleMsg = dynamic_cast<Field<Message>*>(module.get())->getValue();
+                TS_ASSERT(moduleMsg.getNumberOfFields() == 4);
+
+                std::shared_ptr<AbstractField> name = moduleMsg.getFieldByIdentifier(1, found);
+                TS_ASSERT(found);
+                TS_ASSERT(dynamic_cast<Field<string>*>(name.get())->getValue() == "Module");
+                TS_ASSERT(name->getSize() == 6);
+
+                bool extracted = false;
+                TS_ASSERT_DELTA(moduleMsg.getValueFromScalarField<float>(4, found, extracted), 10.5f + i, 1e-5);
+                TS_ASSERT(found); TS_ASSERT(extracted);
+
+                std::shared_ptr<AbstractField> runtimeStatistic = msg.getFieldByIdentifier(2, found);
+                TS_ASSERT(found);
+                Message runtimeStatisticMsg = dynamic_cast<Field<Message>*>(runtimeStatistic.get())->getValue();
+                TS_ASSERT_DELTA(runtimeStatisticMsg.getValueFromScalarField<double>(1, found, extracted), 0.25 * i, 1e-5);
+                TS_ASSERT(found); TS_ASSERT(extracted);
+            }
+        }
 };
 
 #endif /*CORE_MESSAGETESTSUITE_H_*/
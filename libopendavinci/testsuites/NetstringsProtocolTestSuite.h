@@ -21,7 +21,9 @@
 #define CORE_NETSTRINGSPROTOCOLTESTSUITE_H_
 
 #include <iostream>                     // for operator<<, basic_ostream, etc
+#include <sstream>                      // for stringstream
 #include <string>                       // for string, char_traits, etc
+#include <vector>                       // for vector
 
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
@@ -34,11 +36,13 @@ using namespace std;
 class NetstringsProtocolTest : public CxxTest::TestSuite, public odcore::io::StringListener, public odcore::io::StringSender {
     private:
         string m_receivedData;
+        vector<string> m_receivedPayloads;
         string m_dataToBeSent;
 
     public:
         NetstringsProtocolTest() :
             m_receivedData(""),
+            m_receivedPayloads(),
             m_dataToBeSent("") {}
 
         void send(const string& data) {
@@ -47,6 +51,7 @@ class NetstringsProtocolTest : public CxxTest::TestSuite, public odcore::io::Str
 
         void nextString(const string &s) {
             m_receivedData = s;
+            m_receivedPayloads.push_back(s);
         }
 
         void testNetstringsProtocolSend() {
@@ -123,6 +128,85 @@ class NetstringsProtocolTest : public CxxTest::TestSuite, public odcore::io::Str
             TS_ASSERT(m_receivedData.compare(testDataToBeSent) == 0); 
         }
 
+        void testNetstringsProtocolReceiveManyNetstrings() {
+            odcore::io::protocol::NetstringsProtocol nsp;
+            nsp.setStringListener(this);
+
+            m_receivedPayloads.clear();
+
+            // Many Netstrings in one chunk exceeding the initial buffer size.
+            stringstream dataStream;
+            for (uint32_t i = 0; i < 1000; i++) {
+                stringstream payload;
+                payload << "Payload" << i;
+                dataStream << payload.str().length() << ":" << payload.str() << ",";
+            }
+            dataStream << "0:,";
+            nsp.nextString(dataStream.str());
+
+            TS_ASSERT(m_receivedPayloads.size() == 1000);
+            if (m_receivedPayloads.size() == 1000) {
+                TS_ASSERT(m_receivedPayloads.at(0) == "Payload0");
+                TS_ASSERT(m_receivedPayloads.at(999) == "Payload999");
+            }
+        }
+
+        void testNetstringsProtocolReceiveBytewise() {
+            odcore::io::protocol::NetstringsProtocol nsp;
+            nsp.setStringListener(this);
+
+            m_receivedPayloads.clear();
+
+            const string payload(10000, 'x');
+            stringstream dataStream;
+            dataStream << payload.length() << ":" << payload << "," << "5:Hello,";
+            const string data = dataStream.str();
+
+            // Feed the data in chunks not aligned to the Netstrings.
+            for (uint32_t i = 0; i < data.length(); i += 7) {
+                nsp.nextString(data.substr(i, 7));
+            }
+
+            TS_ASSERT(m_receivedPayloads.size() == 2);
+            if (m_receivedPayloads.size() == 2) {
+                TS_ASSERT(m_receivedPayloads.at(0) == payload);
+                TS_ASSERT(m_receivedPayloads.at(1) == "Hello");
+            }
+        }
+
+        void testNetstringsProtocolReceiveCorrupted() {
+            odcore::io::protocol::NetstringsProtocol nsp;
+            nsp.setStringListener(this);
+
+            m_receivedPayloads.clear();
+
+            // Missing ',' and missing length discard the buffered data.
+            nsp.nextString("5:Hello;");
+            nsp.nextString(":Hello,");
+            TS_ASSERT(m_receivedPayloads.size() == 0);
+
+            // The decoder recovers with the next Netstring.
+            nsp.nextString("5:Hello,");
+            TS_ASSERT(m_receivedPayloads.size() == 1);
+            if (m_receivedPayloads.size() == 1) {
+                TS_ASSERT(m_receivedPayloads.at(0) == "Hello");
+            }
+        }
+
+        void testNetstringsProtocolSendLongPayload() {
+            odcore::io::protocol::NetstringsProtocol nsp;
+            nsp.setStringSender(this);
+
+            m_dataToBeSent = "";
+            const string payload(1234567, 'y');
+            nsp.send(payload);
+
+            TS_ASSERT(m_dataToBeSent.length() == 7 + 1 + 1234567 + 1);
+            TS_ASSERT(m_dataToBeSent.substr(0, 8) == "1234567:");
+            TS_ASSERT(m_dataToBeSent.substr(8, 1234567) == payload);
+            TS_ASSERT(m_dataToBeSent[m_dataToBeSent.length() - 1] == ',');
+        }
+
 };
 
 #endif /*CORE_NETSTRINGSPROTOCOLTESTSUITE_H_*/
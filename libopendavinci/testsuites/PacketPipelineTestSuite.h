@@ -20,14 +20,21 @@
 #ifndef CORE_PACKETPIPELINETESTSUITE_H_
 #define CORE_PACKETPIPELINETESTSUITE_H_
 
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
 #include "opendavinci/odcore/base/Thread.h"
+#include "opendavinci/odcore/io/PacketBufferPool.h"
 #include "opendavinci/odcore/io/PacketListener.h"
 #include "opendavinci/odcore/io/PacketPipeline.h"
+#include "opendavinci/odcore/io/PacketRing.h"
+#include "opendavinci/odcore/io/SharedPacket.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/generated/odcore/data/Packet.h"
 
@@ -36,6 +43,52 @@ using namespace odcore::base;
 using namespace odcore::io;
 using namespace odcore::data;
 
+class SharedPacketListener : public PacketListener {
+    public:
+        SharedPacketListener() : m_receivedPackets() {}
+
+        virtual void nextPacket(const Packet &/*p*/) {}
+
+        virtual void nextSharedPacket(const SharedPacket &p) {
+            m_receivedPackets.push_back(p);
+        }
+
+        vector<SharedPacket> m_receivedPackets;
+};
+
+class StalledPacketListener : public PacketListener {
+    public:
+        StalledPacketListener(const uint32_t &delay) :
+            m_delay(delay),
+            m_stalled(true),
+            m_numberOfCalls(0),
+            m_receivedData() {}
+
+        virtual void nextPacket(const Packet &p) {
+            m_numberOfCalls++;
+            if (m_delay > 0) {
+                Thread::usleepFor(m_delay);
+            }
+            else {
+                while (m_stalled) {
+                    Thread::usleepFor(100);
+                }
+            }
+            m_receivedData.push_back(p.getData());
+        }
+
+        void waitForFirstCall() {
+            while (m_numberOfCalls == 0) {
+                Thread::usleepFor(100);
+            }
+        }
+
+        uint32_t m_delay;
+        std::atomic<bool> m_stalled;
+        std::atomic<uint32_t> m_numberOfCalls;
+        vector<string> m_receivedData;
+};
+
 class PacketPipelineTest : public CxxTest::TestSuite, PacketListener {
     private:
         vector<Packet> m_receivedData;
@@ -91,6 +144,296 @@ class PacketPipelineTest : public CxxTest::TestSuite, PacketListener {
             m_receivedData.clear();
             TS_ASSERT(m_receivedData.size() == 0);
         }
+
+        void testEnqueueBatchOfPackets() {
+            m_receivedData.clear();
+            TS_ASSERT(m_receivedData.size() == 0);
+
+            PacketPipeline ppl;
+            ppl.setPacketListener(this);
+
+            vector<Packet> batch;
+            batch.push_back(Packet("", "Packet1", TimeStamp()));
+            batch.push_back(Packet("", "Packet2", TimeStamp()));
+            batch.push_back(Packet("", "Packet3", TimeStamp()));
+
+            ppl.start();
+            ppl.nextPackets(batch);
+            Thread::usleepFor(1000); // Allow thread scheduling.
+            ppl.stop();
+            TS_ASSERT(m_receivedData.size() == 3);
+            TS_ASSERT(m_receivedData.at(0).getData() == "Packet1");
+            TS_ASSERT(m_receivedData.at(1).getData() == "Packet2");
+            TS_ASSERT(m_receivedData.at(2).getData() == "Packet3");
+
+            ppl.setPacketListener(NULL);
+            m_receivedData.clear();
+            TS_ASSERT(m_receivedData.size() == 0);
+        }
+
+        void testPacketBufferPoolReusesBuffers() {
+            PacketBufferPool pool(16, 2);
+            TS_ASSERT(pool.getBufferSize() == 16);
+            TS_ASSERT(pool.getNumberOfIdleBuffers() == 0);
+
+            std::shared_ptr<char> a = pool.acquire();
+            const char *A = a.get();
+            a.reset();
+            TS_ASSERT(pool.getNumberOfIdleBuffers() == 1);
+
+            std::shared_ptr<char> b = pool.acquire();
+            TS_ASSERT(b.get() == A);
+            TS_ASSERT(pool.getNumberOfIdleBuffers() == 0);
+
+            // Only two released buffers are kept.
+            std::shared_ptr<char> c = pool.acquire();
+            std::shared_ptr<char> d = pool.acquire();
+            b.reset();
+            c.reset();
+            d.reset();
+            TS_ASSERT(pool.getNumberOfIdleBuffers() == 2);
+        }
+
+        void testSharedPacketsAreNotCopied() {
+            PacketBufferPool pool(16, 2);
+            SharedPacketListener spl;
+
+            PacketPipeline ppl;
+            ppl.setPacketListener(&spl);
+
+            std::shared_ptr<char> buffer = pool.acquire();
+            memcpy(buffer.get(), "Packet1", 7);
+
+            ppl.start();
+            ppl.nextSharedPacket(SharedPacket(buffer, 7, 0x0A000001, 1234, TimeStamp(1, 2)));
+            buffer.reset();
+            Thread::usleepFor(1000); // Allow thread scheduling.
+            ppl.stop();
+
+            TS_ASSERT(spl.m_receivedPackets.size() == 1);
+            if (spl.m_receivedPackets.size() == 1) {
+                const SharedPacket &p = spl.m_receivedPackets.at(0);
+                TS_ASSERT(string(p.getData(), p.getLength()) == "Packet1");
+                TS_ASSERT(p.getSenderAddress() == 0x0A000001);
+                TS_ASSERT(p.getSenderPort() == 1234);
+                TS_ASSERT(p.getSender() == "10.0.0.1");
+                TS_ASSERT(p.getReceived().toMicroseconds() == TimeStamp(1, 2).toMicroseconds());
+
+                const Packet copy = p.toPacket();
+                TS_ASSERT(copy.getData() == "Packet1");
+                TS_ASSERT(copy.getSender() == "10.0.0.1");
+            }
+
+            // The buffer returns to the pool once the last packet is released.
+            TS_ASSERT(pool.getNumberOfIdleBuffers() == 0);
+            spl.m_receivedPackets.clear();
+            TS_ASSERT(pool.getNumberOfIdleBuffers() == 1);
+
+            ppl.setPacketListener(NULL);
+        }
+
+        void testSharedPacketCopiesSmallDatagrams() {
+            PacketBufferPool pool(16, 2);
+            std::shared_ptr<char> buffer = pool.acquire();
+            memcpy(buffer.get(), "Packet1", 7);
+
+            // The copy does not hold the receive buffer.
+            const SharedPacket p(buffer.get(), 7, 0x0A000001, 1234, TimeStamp(1, 2));
+            buffer.reset();
+            TS_ASSERT(pool.getNumberOfIdleBuffers() == 1);
+            TS_ASSERT(string(p.getData(), p.getLength()) == "Packet1");
+            TS_ASSERT(p.getSenderAddress() == 0x0A000001);
+            TS_ASSERT(p.getSenderPort() == 1234);
+
+            // Senders in dotted notation are kept numerically.
+            const SharedPacket fromPacket(Packet("10.0.0.2", "Packet2", TimeStamp()));
+            TS_ASSERT(fromPacket.getSenderAddress() == 0x0A000002);
+            TS_ASSERT(fromPacket.getSender() == "10.0.0.2");
+
+            const SharedPacket fromName(Packet("sender", "Packet3", TimeStamp()));
+            TS_ASSERT(fromName.getSenderAddress() == 0);
+            TS_ASSERT(fromName.getSender() == "sender");
+
+            const SharedPacket fromInvalid(Packet("10.0.0.256", "Packet4", TimeStamp()));
+            TS_ASSERT(fromInvalid.getSenderAddress() == 0);
+            TS_ASSERT(fromInvalid.getSender() == "10.0.0.256");
+        }
+
+        void testPacketRing() {
+            PacketRing ring(3);
+            TS_ASSERT(ring.getCapacity() == 4);
+            TS_ASSERT(ring.isEmpty());
+
+            for (uint32_t i = 0; i < 4; i++) {
+                TS_ASSERT(ring.push(SharedPacket(Packet("", string(1, static_cast<char>('a' + i)), TimeStamp()))));
+            }
+            TS_ASSERT(!ring.push(SharedPacket(Packet("", "e", TimeStamp()))));
+            TS_ASSERT(ring.getSize() == 4);
+
+            SharedPacket p;
+            TS_ASSERT(ring.pop(p));
+            TS_ASSERT(string(p.getData(), p.getLength()) == "a");
+            TS_ASSERT(ring.push(SharedPacket(Packet("", "e", TimeStamp()))));
+
+            vector<SharedPacket> batch;
+            TS_ASSERT(ring.pop(batch, 3) == 3);
+            TS_ASSERT(batch.size() == 3);
+            TS_ASSERT(string(batch.at(0).getData(), batch.at(0).getLength()) == "b");
+            TS_ASSERT(string(batch.at(2).getData(), batch.at(2).getLength()) == "d");
+            TS_ASSERT(ring.pop(batch, 3) == 1);
+            TS_ASSERT(string(batch.at(3).getData(), batch.at(3).getLength()) == "e");
+            TS_ASSERT(ring.isEmpty());
+            TS_ASSERT(!ring.pop(p));
+        }
+
+        void testPacketRingLimits() {
+            // Huge capacities are limited instead of overflowing.
+            PacketRing huge(0xFFFFFFFF);
+            TS_ASSERT(huge.getCapacity() == PacketRing::MAXIMUM_CAPACITY);
+
+            PacketRing ring(16, 10);
+            TS_ASSERT(ring.getMaximumNumberOfBytes() == 10);
+            TS_ASSERT(ring.push(SharedPacket(Packet("", "1234", TimeStamp()))));
+            TS_ASSERT(ring.push(SharedPacket(Packet("", "5678", TimeStamp()))));
+            TS_ASSERT(ring.getNumberOfBytes() == 8);
+            TS_ASSERT(!ring.push(SharedPacket(Packet("", "9AB", TimeStamp()))));
+            TS_ASSERT(ring.getNumberOfBytes() == 8);
+            TS_ASSERT(ring.getSize() == 2);
+
+            SharedPacket p;
+            TS_ASSERT(ring.pop(p));
+            TS_ASSERT(ring.getNumberOfBytes() == 4);
+            TS_ASSERT(ring.push(SharedPacket(Packet("", "9AB", TimeStamp()))));
+            TS_ASSERT(ring.getNumberOfBytes() == 7);
+
+            // A single packet exceeding the limit is only accepted by an empty ring.
+            const string LARGE(20, 'x');
+            TS_ASSERT(!ring.push(SharedPacket(Packet("", LARGE, TimeStamp()))));
+            TS_ASSERT(ring.pop(p));
+            TS_ASSERT(ring.pop(p));
+            TS_ASSERT(ring.getNumberOfBytes() == 0);
+            TS_ASSERT(ring.push(SharedPacket(Packet("", LARGE, TimeStamp()))));
+            TS_ASSERT(ring.getNumberOfBytes() == 20);
+        }
+
+        void testOverflowDropOldestByBytes() {
+            StalledPacketListener spl(0);
+            PacketPipeline ppl(16, PacketPipeline::DROP_OLDEST, 4);
+            TS_ASSERT(ppl.getMaximumNumberOfBytes() == 4);
+            ppl.setPacketListener(&spl);
+
+            ppl.start();
+            ppl.nextPacket(Packet("", "P0", TimeStamp()));
+            spl.waitForFirstCall();
+
+            // The listener is stalled; thus, only four bytes fit into the queue.
+            for (uint32_t i = 1; i < 7; i++) {
+                stringstream sstr;
+                sstr << "P" << i;
+                ppl.nextPacket(Packet("", sstr.str(), TimeStamp()));
+            }
+            TS_ASSERT(ppl.getNumberOfEnqueuedPackets() == 7);
+            TS_ASSERT(ppl.getNumberOfDroppedPackets() == 4);
+
+            spl.m_stalled = false;
+            ppl.stop();
+
+            TS_ASSERT(spl.m_receivedData.size() == 3);
+            if (spl.m_receivedData.size() == 3) {
+                TS_ASSERT(spl.m_receivedData.at(0) == "P0");
+                TS_ASSERT(spl.m_receivedData.at(1) == "P5");
+                TS_ASSERT(spl.m_receivedData.at(2) == "P6");
+            }
+            ppl.setPacketListener(NULL);
+        }
+
+        void testOverflowDropNewest() {
+            StalledPacketListener spl(0);
+            PacketPipeline ppl(4, PacketPipeline::DROP_NEWEST);
+            TS_ASSERT(ppl.getCapacity() == 4);
+            ppl.setPacketListener(&spl);
+
+            ppl.start();
+            ppl.nextPacket(Packet("", "P0", TimeStamp()));
+            spl.waitForFirstCall();
+
+            // The listener is stalled; thus, only four packets fit into the queue.
+            for (uint32_t i = 1; i < 7; i++) {
+                stringstream sstr;
+                sstr << "P" << i;
+                ppl.nextPacket(Packet("", sstr.str(), TimeStamp()));
+            }
+            TS_ASSERT(ppl.getNumberOfEnqueuedPackets() == 5);
+            TS_ASSERT(ppl.getNumberOfDroppedPackets() == 2);
+            TS_ASSERT(ppl.getHighWaterMark() == 4);
+
+            spl.m_stalled = false;
+            ppl.stop();
+
+            TS_ASSERT(spl.m_receivedData.size() == 5);
+            if (spl.m_receivedData.size() == 5) {
+                TS_ASSERT(spl.m_receivedData.at(0) == "P0");
+                TS_ASSERT(spl.m_receivedData.at(1) == "P1");
+                TS_ASSERT(spl.m_receivedData.at(4) == "P4");
+            }
+            ppl.setPacketListener(NULL);
+        }
+
+        void testOverflowDropOldest() {
+            StalledPacketListener spl(0);
+            PacketPipeline ppl(4, PacketPipeline::DROP_OLDEST);
+            ppl.setPacketListener(&spl);
+
+            ppl.start();
+            ppl.nextPacket(Packet("", "P0", TimeStamp()));
+            spl.waitForFirstCall();
+
+            // The listener is stalled; thus, the oldest packets are replaced.
+            for (uint32_t i = 1; i < 7; i++) {
+                stringstream sstr;
+                sstr << "P" << i;
+                ppl.nextPacket(Packet("", sstr.str(), TimeStamp()));
+            }
+            TS_ASSERT(ppl.getNumberOfEnqueuedPackets() == 7);
+            TS_ASSERT(ppl.getNumberOfDroppedPackets() == 2);
+            TS_ASSERT(ppl.getHighWaterMark() == 4);
+
+            spl.m_stalled = false;
+            ppl.stop();
+
+            TS_ASSERT(spl.m_receivedData.size() == 5);
+            if (spl.m_receivedData.size() == 5) {
+                TS_ASSERT(spl.m_receivedData.at(0) == "P0");
+                TS_ASSERT(spl.m_receivedData.at(1) == "P3");
+                TS_ASSERT(spl.m_receivedData.at(4) == "P6");
+            }
+            ppl.setPacketListener(NULL);
+        }
+
+        void testOverflowBlock() {
+            StalledPacketListener spl(1000);
+            PacketPipeline ppl(4, PacketPipeline::BLOCK);
+            ppl.setPacketListener(&spl);
+
+            // The slow listener throttles the producer instead of losing packets.
+            ppl.start();
+            for (uint32_t i = 0; i < 20; i++) {
+                stringstream sstr;
+                sstr << "P" << i;
+                ppl.nextPacket(Packet("", sstr.str(), TimeStamp()));
+            }
+            ppl.stop();
+
+            TS_ASSERT(ppl.getNumberOfEnqueuedPackets() == 20);
+            TS_ASSERT(ppl.getNumberOfDroppedPackets() == 0);
+            TS_ASSERT(ppl.getHighWaterMark() <= 4);
+            TS_ASSERT(spl.m_receivedData.size() == 20);
+            if (spl.m_receivedData.size() == 20) {
+                TS_ASSERT(spl.m_receivedData.at(0) == "P0");
+                TS_ASSERT(spl.m_receivedData.at(19) == "P19");
+            }
+            ppl.setPacketListener(NULL);
+        }
 };
 
 #endif /*CORE_PACKETPIPELINETESTSUITE_H_*/
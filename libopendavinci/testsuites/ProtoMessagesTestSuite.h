@@ -22,6 +22,7 @@
 
 #include <cmath>                        // for fabs
 #include <iostream>                     // for stringstream, operator<<, etc
+#include <map>
 #include <string>                       // for operator==, basic_string, etc
 #include <vector>
 
@@ -29,7 +30,10 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/serialization/SerializationFactory.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
 #include "opendavinci/odcore/serialization/ProtoDeserializer.h"
+#include "opendavinci/odcore/serialization/ProtoEncoder.h"
 #include "opendavinci/odcore/serialization/ProtoSerializer.h"
 #include "opendavinci/odcore/serialization/ProtoDeserializerVisitor.h"
 #include "opendavinci/odcore/serialization/ProtoSerializerVisitor.h"
@@ -69,6 +73,7 @@
 #include "opendavincitestdata/generated/odcore/testdata/TestMessage8.h"
 #include "opendavincitestdata/generated/odcore/testdata/TestMessage9.h"
 #include "opendavincitestdata/generated/odcore/testdata/TestMessage10.h"
+#include "opendavincitestdata/generated/odcore/testdata/TestMessage11.h"
 
 using namespace std;
 using namespace odcore::base;
@@ -209,8 +214,423 @@ class ProtoMessages1SampleDataVersion2Reordered : public odcore::serialization::
         }
 };
 
+// This hand-written Serializable counts how often it is serialized; its
+// nested TestMessage1 is encoded by ProtoEncoder::encode() in the meantime.
+class ProtoMessagesCountingSerializable : public odcore::serialization::Serializable {
+    public:
+        ProtoMessagesCountingSerializable(const int32_t &value) :
+            m_value(value),
+            m_nested(),
+            m_serializations(0) {
+            m_nested.setField1(static_cast<uint8_t>(value));
+        }
+
+        int32_t m_value;
+        TestMessage1 m_nested;
+        mutable uint32_t m_serializations;
+
+        ostream& operator<<(ostream &out) const {
+            m_serializations++;
+
+            SerializationFactory& sf=SerializationFactory::getInstance();
+
+            std::shared_ptr<Serializer> s = sf.getSerializer(out);
+
+            s->write(1, m_value);
+
+            s->write(2, m_nested);
+
+            return out;
+        }
+
+        istream& operator>>(istream &in) {
+            return in;
+        }
+};
+
+// This data structure counts how often its size is computed.
+class ProtoMessagesCountingEncodable : public odcore::serialization::Serializable {
+    public:
+        ProtoMessagesCountingEncodable(const int32_t &value) :
+            m_serializable(value),
+            m_sizings(0) {}
+
+        ProtoMessagesCountingSerializable m_serializable;
+        mutable uint32_t m_sizings;
+
+        uint32_t getEncodedSize() const {
+            m_sizings++;
+            return ProtoEncoder::getSize(1, m_serializable);
+        }
+
+        void encodeTo(ByteWriter &out) const {
+            ProtoEncoder::write(out, 1, m_serializable);
+        }
+
+        ostream& operator<<(ostream &out) const {
+            return ProtoEncoder::encode(out, *this);
+        }
+
+        istream& operator>>(istream &in) {
+            return in;
+        }
+};
+
+// This data structure nests the counting ones at two levels.
+class ProtoMessagesNestedCountingEncodable : public odcore::serialization::Serializable {
+    public:
+        ProtoMessagesNestedCountingEncodable() :
+            m_list(),
+            m_map() {}
+
+        vector<ProtoMessagesCountingEncodable> m_list;
+        map<uint32_t, ProtoMessagesCountingEncodable> m_map;
+
+        uint32_t getEncodedSize() const {
+            return ProtoEncoder::getSize(1, m_list) + ProtoEncoder::getSize(2, m_map);
+        }
+
+        void encodeTo(ByteWriter &out) const {
+            ProtoEncoder::write(out, 1, m_list);
+            ProtoEncoder::write(out, 2, m_map);
+        }
+
+        ostream& operator<<(ostream &out) const {
+            return ProtoEncoder::encode(out, *this);
+        }
+
+        istream& operator>>(istream &in) {
+            return in;
+        }
+};
+
 class ProtoMessageTest : public CxxTest::TestSuite {
+    private:
+        template<class T>
+        string serializeWithSerializer(const T &t) {
+            // Replace default serializer/deserializers to use the virtual interface.
+            SerializationFactoryTestCase tmp;
+            (void)tmp;
+
+            stringstream out;
+            out << t;
+            return out.str();
+        }
+
+        template<class T>
+        string serializeWithEncodeTo(const T &t) {
+            string buffer(t.getEncodedSize(), '\0');
+            ByteWriter w(&buffer[0], buffer.size());
+            t.encodeTo(w);
+            TS_ASSERT(w.isGood());
+            TS_ASSERT(w.getPosition() == buffer.size());
+            return buffer;
+        }
+
+        template<class T>
+        void assertSameEncoding(const T &t) {
+            const string viaSerializer = serializeWithSerializer(t);
+            TS_ASSERT(viaSerializer == serializeWithEncodeTo(t));
+
+            // The default serialization uses encodeTo.
+            stringstream out;
+            out << t;
+            TS_ASSERT(viaSerializer == out.str());
+        }
+
+        template<class T>
+        T decodeWithDecodeFrom(const string &s) {
+            T t;
+            TS_ASSERT(t.decodeFrom(ByteSpan(s)));
+            return t;
+        }
+
     public:
+        void testEncodeToMatchesSerializerForScalars() {
+            TestMessage1 tm1;
+            tm1.setField1(150);
+
+            TestMessage5 tm5;
+            tm5.setField1(3);
+            tm5.setField2(-3);
+            tm5.setField3(103);
+            tm5.setField4(-103);
+            tm5.setField5(10003);
+            tm5.setField6(-10003);
+            tm5.setField7(54321);
+            tm5.setField8(-54321);
+            tm5.setField9(-5.4321);
+            tm5.setField10(-50.4321);
+            tm5.setField11("Hello OpenDaVINCI World!");
+            tm5.setField12(tm1);
+            assertSameEncoding(tm5);
+
+            TestMessage5 tm5_2 = decodeWithDecodeFrom<TestMessage5>(serializeWithSerializer(tm5));
+            TS_ASSERT(tm5_2.getField1() == 3);
+            TS_ASSERT(tm5_2.getField2() == -3);
+            TS_ASSERT(tm5_2.getField3() == 103);
+            TS_ASSERT(tm5_2.getField4() == -103);
+            TS_ASSERT(tm5_2.getField5() == 10003);
+            TS_ASSERT(tm5_2.getField6() == -10003);
+            TS_ASSERT(tm5_2.getField7() == 54321);
+            TS_ASSERT(tm5_2.getField8() == -54321);
+            TS_ASSERT_DELTA(tm5_2.getField9(), -5.4321, 1e-4);
+            TS_ASSERT_DELTA(tm5_2.getField10(), -50.4321, 1e-4);
+            TS_ASSERT(tm5_2.getField11() == "Hello OpenDaVINCI World!");
+            TS_ASSERT(tm5_2.getField12().getField1() == 150);
+
+            // Decoding via the default deserialization uses decodeFrom.
+            stringstream in(serializeWithEncodeTo(tm5));
+            TestMessage5 tm5_3;
+            in >> tm5_3;
+            TS_ASSERT(tm5_3.toString() == tm5.toString());
+        }
+
+        void testEncodeToMatchesSerializerForListsMapsAndArrays() {
+            TestMessage6 tm6;
+            tm6.addTo_ListOfField1(1);
+            tm6.addTo_ListOfField1(300);
+            tm6.addTo_ListOfField1(0xFFFFFFFF);
+            assertSameEncoding(tm6);
+            TS_ASSERT(decodeWithDecodeFrom<TestMessage6>(serializeWithSerializer(tm6)).getListOfField1() == tm6.getListOfField1());
+
+            TestMessage8 tm8;
+            tm8.putTo_MapOfField1(1, 10);
+            tm8.putTo_MapOfField1(300, 3000);
+            assertSameEncoding(tm8);
+            TS_ASSERT(decodeWithDecodeFrom<TestMessage8>(serializeWithSerializer(tm8)).getMapOfField1() == tm8.getMapOfField1());
+
+            TestMessage1 tm1;
+            tm1.setField1(42);
+            TestMessage9 tm9;
+            tm9.putTo_MapOfField1(7, tm1);
+            assertSameEncoding(tm9);
+            TS_ASSERT(decodeWithDecodeFrom<TestMessage9>(serializeWithSerializer(tm9)).getValueForKey_MapOfField1(7).getField1() == 42);
+
+            TestMessage10 tm10;
+            tm10.getMyArray1()[0] = 1;
+            tm10.getMyArray1()[1] = 2;
+            tm10.getMyArray2()[0] = -1.2345;
+            tm10.getMyArray2()[1] = -2.3456;
+            tm10.getMyArray2()[2] = -3.4567;
+            assertSameEncoding(tm10);
+            TestMessage10 tm10_2 = decodeWithDecodeFrom<TestMessage10>(serializeWithSerializer(tm10));
+            TS_ASSERT(tm10_2.getMyArray1()[1] == 2);
+            TS_ASSERT_DELTA(tm10_2.getMyArray2()[2], -3.4567, 1e-4);
+
+            // Lists of nested generated messages and of other Serializables.
+            ModuleDescriptor md("Module", "ID", "Version", 10);
+            ModuleStatistic ms;
+            ms.setModule(md);
+            ModuleStatistics mss;
+            mss.addTo_ListOfModuleStatistics(ms);
+            mss.addTo_ListOfModuleStatistics(ms);
+            assertSameEncoding(mss);
+            TS_ASSERT(decodeWithDecodeFrom<ModuleStatistics>(serializeWithSerializer(mss)).getListOfModuleStatistics().at(1).getModule().getName() == "Module");
+
+            PulseMessage pm;
+            pm.addTo_ListOfContainers(Container(tm1));
+            assertSameEncoding(pm);
+            PulseMessage pm2 = decodeWithDecodeFrom<PulseMessage>(serializeWithSerializer(pm));
+            TS_ASSERT(pm2.getSize_ListOfContainers() == 1);
+            TS_ASSERT(pm2.getListOfContainers().at(0).getData<TestMessage1>().getField1() == 42);
+        }
+
+        void testEncodeToMatchesSerializerForLargeLists() {
+            TestMessage6 tm6;
+            TestMessage7 tm7;
+            for (uint32_t i = 0; i < 10000; i++) {
+                // Mix values occupying one to five bytes.
+                tm6.addTo_ListOfField1((i % 5 == 0) ? (0xFFFFFFFF - i) : (i * i * (i % 7)));
+                tm7.addTo_ListOfField1(static_cast<float>(i) * -1.25f);
+            }
+            assertSameEncoding(tm6);
+            assertSameEncoding(tm7);
+
+            TestMessage6 tm6_2 = decodeWithDecodeFrom<TestMessage6>(serializeWithSerializer(tm6));
+            TS_ASSERT(tm6_2.getListOfField1() == tm6.getListOfField1());
+
+            TestMessage7 tm7_2 = decodeWithDecodeFrom<TestMessage7>(serializeWithSerializer(tm7));
+            TS_ASSERT(tm7_2.getListOfField1() == tm7.getListOfField1());
+        }
+
+        void testConstRefAccessorsForListsAndMaps() {
+            TestMessage6 tm6;
+            tm6.reserve_ListOfField1(3);
+            tm6.emplaceTo_ListOfField1(3);
+            tm6.addTo_ListOfField1(270);
+            tm6.emplaceTo_ListOfField1(86942);
+
+            const vector<uint32_t> &l = tm6.getConstRef_ListOfField1();
+            TS_ASSERT(l.size() == 3);
+            TS_ASSERT(l == tm6.getListOfField1());
+            TS_ASSERT(&l == &tm6.getConstRef_ListOfField1());
+
+            uint32_t sum = 0;
+            pair<vector<uint32_t>::const_iterator, vector<uint32_t>::const_iterator> range = tm6.constIteratorPair_ListOfField1();
+            for (vector<uint32_t>::const_iterator it = range.first; it != range.second; ++it) {
+                sum += *it;
+            }
+            TS_ASSERT(sum == 3 + 270 + 86942);
+
+            TestMessage1 tm1;
+            tm1.setField1(42);
+            TestMessage9 tm9;
+            tm9.emplaceTo_MapOfField1(7, TestMessage1(tm1));
+            tm9.emplaceTo_MapOfField1(7, TestMessage1(tm1));
+            tm9.putTo_MapOfField1(8, tm1);
+
+            const map<uint32_t, TestMessage1> &m = tm9.getConstRef_MapOfField1();
+            TS_ASSERT(m.size() == 2);
+            TS_ASSERT(m.at(7).getField1() == 42);
+            TS_ASSERT(distance(tm9.constIteratorPair_MapOfField1().first, tm9.constIteratorPair_MapOfField1().second) == 2);
+        }
+
+        void testDecodeFromMalformedBytes() {
+            TestMessage5 tm5;
+            const string s = serializeWithSerializer(tm5);
+
+            // Truncated bytes are reported but all complete fields are decoded.
+            TestMessage5 tm5_2;
+            tm5_2.setField1(99);
+            TS_ASSERT(!tm5_2.decodeFrom(ByteSpan(s.data(), s.size() - 1)));
+            TS_ASSERT(tm5_2.getField1() == tm5.getField1());
+        }
+
+        void testEncodeComputesNestedLengthsAndBytesOnce() {
+            ProtoMessagesNestedCountingEncodable n;
+            n.m_list.push_back(ProtoMessagesCountingEncodable(-1));
+            n.m_list.push_back(ProtoMessagesCountingEncodable(300));
+            n.m_map.insert(make_pair(7, ProtoMessagesCountingEncodable(123456)));
+
+            // Without encode(), every level computes the lengths again.
+            const string uncached = serializeWithEncodeTo(n);
+            TS_ASSERT(n.m_list.at(0).m_sizings > 1);
+            TS_ASSERT(n.m_list.at(0).m_serializable.m_serializations > 1);
+            TS_ASSERT(n.m_map.at(7).m_sizings > 1);
+
+            for (uint32_t i = 0; i < n.m_list.size(); i++) {
+                n.m_list.at(i).m_sizings = 0;
+                n.m_list.at(i).m_serializable.m_serializations = 0;
+            }
+            n.m_map.at(7).m_sizings = 0;
+            n.m_map.at(7).m_serializable.m_serializations = 0;
+
+            stringstream out;
+            out << n;
+            TS_ASSERT(out.str() == uncached);
+            for (uint32_t i = 0; i < n.m_list.size(); i++) {
+                TS_ASSERT(n.m_list.at(i).m_sizings == 1);
+                TS_ASSERT(n.m_list.at(i).m_serializable.m_serializations == 1);
+            }
+            TS_ASSERT(n.m_map.at(7).m_sizings == 1);
+            TS_ASSERT(n.m_map.at(7).m_serializable.m_serializations == 1);
+
+            // TimeStamps are encoded in place.
+            TS_ASSERT(ProtoEncoder::HasEncodeTo<TimeStamp>::value);
+            PulseMessage pm;
+            pm.setRealTimeFromSupercomponent(TimeStamp(1234, 5678));
+            pm.setNominalTimeSlice(10);
+            assertSameEncoding(pm);
+        }
+
+        void testDecodeFromReplacesListsAndMaps() {
+            TestMessage6 tm6;
+            tm6.addTo_ListOfField1(1);
+            tm6.addTo_ListOfField1(2);
+            TS_ASSERT(tm6.decodeFrom(ByteSpan(serializeWithEncodeTo(TestMessage6()))));
+            TS_ASSERT(tm6.isEmpty_ListOfField1());
+
+            TestMessage6 tm6_2;
+            tm6_2.addTo_ListOfField1(3);
+            TS_ASSERT(tm6.decodeFrom(ByteSpan(serializeWithEncodeTo(tm6_2))));
+            TS_ASSERT(tm6.getSize_ListOfField1() == 1);
+            TS_ASSERT(tm6.getListOfField1().at(0) == 3);
+
+            TestMessage8 tm8;
+            tm8.putTo_MapOfField1(1, 10);
+            stringstream in(serializeWithEncodeTo(TestMessage8()));
+            in >> tm8;
+            TS_ASSERT(tm8.isEmpty_MapOfField1());
+        }
+
+        void testFlatMessageEncodingAndView() {
+            TestMessage11 tm11;
+            tm11.setField1(true);
+            tm11.setField2(2);
+            tm11.setField3(-3);
+            tm11.setField4(4);
+            tm11.setField5(5.5);
+            tm11.setField6(6.25);
+            tm11.setField7(TestMessage11::ACTIVE);
+
+            // Fields are stored in declaration order in little endian.
+            const char expected[] = { 0x1, 0x2, static_cast<char>(0xfd), static_cast<char>(0xff),
+                                      0x4, 0x0, 0x0, 0x0,
+                                      0x0, 0x0, static_cast<char>(0xb0), 0x40,
+                                      0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x19, 0x40,
+                                      0x1, 0x0, 0x0, 0x0 };
+            TS_ASSERT(TestMessage11::FLAT_SIZE == sizeof(expected));
+            TS_ASSERT(tm11.getEncodedSize() == TestMessage11::FLAT_SIZE);
+
+            stringstream out;
+            out << tm11;
+            const string s = out.str();
+            TS_ASSERT(s == string(expected, sizeof(expected)));
+
+            // Other serializations selected by the SerializationFactory are respected.
+            {
+                SerializationFactoryTestCase tmp;
+                (void)tmp;
+                stringstream out2;
+                out2 << tm11;
+                TS_ASSERT(out2.str() != s);
+
+                TestMessage11 tm11_2;
+                stringstream in2(out2.str());
+                in2 >> tm11_2;
+                TS_ASSERT(tm11_2.getField3() == -3);
+                TS_ASSERT(tm11_2.getField4() == 4);
+                TS_ASSERT(tm11_2.getField7() == TestMessage11::ACTIVE);
+            }
+
+            // Read the fields directly from the buffer.
+            TestMessage11::View v(s.data(), s.size());
+            TS_ASSERT(v.isValid());
+            TS_ASSERT(v.getField1());
+            TS_ASSERT(v.getField2() == 2);
+            TS_ASSERT(v.getField3() == -3);
+            TS_ASSERT(v.getField4() == 4);
+            TS_ASSERT_DELTA(v.getField5(), 5.5, 1e-5);
+            TS_ASSERT_DELTA(v.getField6(), 6.25, 1e-5);
+            TS_ASSERT(v.getField7() == TestMessage11::ACTIVE);
+
+            TestMessage11 tm11_2;
+            TS_ASSERT(tm11_2.decodeFrom(ByteSpan(s)));
+            TS_ASSERT(tm11_2.getField3() == -3);
+            TS_ASSERT(tm11_2.getField7() == TestMessage11::ACTIVE);
+
+            // Plain struct representation.
+            const TestMessage11::Flat f = tm11.toFlat();
+            TS_ASSERT(f.field4 == 4);
+            TestMessage11 tm11_3;
+            tm11_3.fromFlat(f);
+            TS_ASSERT(tm11_3.getField6() == 6.25);
+            TS_ASSERT(tm11_3.getField7() == TestMessage11::ACTIVE);
+
+            // Too short buffers are rejected.
+            TestMessage11::View v2(s.data(), s.size() - 1);
+            TS_ASSERT(!v2.isValid());
+            TS_ASSERT(v2.getField4() == 0);
+            TS_ASSERT(!tm11_2.decodeFrom(ByteSpan(s.data(), s.size() - 1)));
+
+            // Transport within a Container.
+            Container c(tm11);
+            TestMessage11 tm11_4 = c.getData<TestMessage11>();
+            TS_ASSERT(tm11_4.getField2() == 2);
+            TS_ASSERT(tm11_4.getField5() == 5.5);
+        }
+
         void testSerializationDeserializationTestMessage1OneField() {
             TestMessage1 tm1;
             tm1.setField1(13);
@@ -29,7 +29,9 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/serialization/Deserializer.h"     // for Deserializer
+#include "opendavinci/odcore/serialization/ProtoDeserializer.h"
 #include "opendavinci/odcore/serialization/ProtoDeserializerVisitor.h"
+#include "opendavinci/odcore/serialization/ProtoSerializer.h"
 #include "opendavinci/odcore/serialization/ProtoSerializerVisitor.h"
 #include "opendavinci/odcore/serialization/SerializationFactory.h"  // for SerializationFactory
 #include "opendavinci/odcore/serialization/Serializer.h"       // for Serializer
@@ -417,6 +419,103 @@ class ProtoTest : public CxxTest::TestSuite {
             TS_ASSERT(vcRef.getLeftFlashingLights() == vcRef2.getLeftFlashingLights());
             TS_ASSERT(vcRef.getRightFlashingLights() == vcRef2.getRightFlashingLights());
         }
+
+        void testDeserializationFromSpanOutOfOrder() {
+            // Write fields out of order and omit field 4.
+            ProtoSerializer ps;
+            ps.write(3, string("Hello World!"));
+            ps.write(1, static_cast<int32_t>(-42));
+            ps.write(2, static_cast<uint64_t>(0xFEDCBA9876543210ULL));
+            ps.write(5, 1.5);
+            ps.write(1, static_cast<int32_t>(-43));
+
+            stringstream out;
+            ps.getSerializedData(out);
+            const string data = out.str();
+
+            ProtoDeserializer pd(data.data(), data.size());
+
+            int32_t v1 = 0;
+            uint64_t v2 = 0;
+            string v3;
+            uint32_t v4 = 7;
+            double v5 = 0;
+            pd.read(1, v1);
+            pd.read(2, v2);
+            pd.read(3, v3);
+            pd.read(4, v4);
+            pd.read(5, v5);
+
+            // The last occurrence of a field is used; missing fields are untouched.
+            TS_ASSERT(v1 == -43);
+            TS_ASSERT(v2 == 0xFEDCBA9876543210ULL);
+            TS_ASSERT(v3 == "Hello World!");
+            TS_ASSERT(v4 == 7);
+            TS_ASSERT(fabs(v5 - 1.5) < 1e-4);
+        }
+
+        void testDeserializationFromSpanDuplicateIds() {
+            // Concatenated messages repeat their fields in order.
+            ProtoSerializer ps;
+            ps.write(1, static_cast<int32_t>(-42));
+            ps.write(2, string("First"));
+            ps.write(1, static_cast<int32_t>(-43));
+            ps.write(2, string("Second"));
+
+            stringstream out;
+            ps.getSerializedData(out);
+            const string data = out.str();
+
+            // The last occurrence wins for in-order reads...
+            {
+                ProtoDeserializer pd(data.data(), data.size());
+                int32_t v1 = 0;
+                string v2;
+                pd.read(1, v1);
+                pd.read(2, v2);
+                TS_ASSERT(v1 == -43);
+                TS_ASSERT(v2 == "Second");
+            }
+
+            // ...as well as for out-of-order reads.
+            {
+                ProtoDeserializer pd(data.data(), data.size());
+                int32_t v1 = 0;
+                string v2;
+                pd.read(2, v2);
+                pd.read(1, v1);
+                TS_ASSERT(v1 == -43);
+                TS_ASSERT(v2 == "Second");
+            }
+        }
+
+        void testDeserializationFromSpanNested() {
+            ProtoVehicleControl vc;
+            vc.setSpeed(2.5);
+            vc.setSteeringWheelAngle(-0.25);
+            vc.setRightFlashingLights(true);
+
+            ProtoSerializer ps;
+            ps.write(1, vc);
+            ps.write(2, static_cast<uint32_t>(4000000000u));
+
+            stringstream out;
+            ps.getSerializedData(out);
+            const string data = out.str();
+
+            // Read the fields in order; the nested message is decoded in place.
+            ProtoDeserializer pd(data.data(), data.size());
+            ProtoVehicleControl vc2;
+            uint32_t v2 = 0;
+            pd.read(1, vc2);
+            pd.read(2, v2);
+
+            TS_ASSERT(fabs(vc2.getSpeed() - 2.5) < 1e-4);
+            TS_ASSERT(fabs(vc2.getSteeringWheelAngle() + 0.25) < 1e-4);
+            TS_ASSERT(vc2.getRightFlashingLights());
+            TS_ASSERT(!vc2.getLeftFlashingLights());
+            TS_ASSERT(v2 == 4000000000u);
+        }
 };
 
 #endif /*CORE_PROTOTESTSUITE_H_*/
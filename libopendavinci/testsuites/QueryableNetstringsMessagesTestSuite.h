@@ -33,6 +33,7 @@
 #include "opendavinci/odcore/serialization/QueryableNetstringsSerializer.h"
 #include "opendavinci/odcore/serialization/QueryableNetstringsDeserializerVisitor.h"
 #include "opendavinci/odcore/serialization/QueryableNetstringsSerializerVisitor.h"
+#include "opendavinci/odcore/serialization/SpanStreamBuffer.h"
 
 #include "opendavinci/odcore/base/KeyValueConfiguration.h"
 #include "opendavinci/odcore/data/Container.h"
@@ -3326,6 +3327,49 @@ class QueryableNetstringsSerializerMessageTest : public CxxTest::TestSuite {
 
         ///////////////////////////////////////////////////////////////////////
 
+        void testDeserializationFromContiguousMemory() {
+            // Replace default serializer/deserializers.
+            SerializationFactoryTestCase tmp;
+            (void)tmp;
+
+            TestMessage1 tm1;
+            tm1.setField1(150);
+            TestMessage4 tm4;
+            tm4.setField1(tm1);
+            TestMessage3 tm3;
+            tm3.setField1("testing");
+
+            // Two consecutive messages; the first one contains a nested message.
+            stringstream out;
+            out << tm4 << tm3;
+            const string data = out.str();
+
+            // Read in place from the serialized bytes.
+            {
+                SpanStreamBuffer buffer(data.data(), data.size());
+                istream in(&buffer);
+
+                TestMessage4 tm4_2;
+                TestMessage3 tm3_2;
+                in >> tm4_2 >> tm3_2;
+
+                TS_ASSERT(tm4_2.getField1().getField1() == 150);
+                TS_ASSERT(tm3_2.getField1() == "testing");
+            }
+
+            // Read from a regular stream.
+            {
+                stringstream in(data);
+
+                TestMessage4 tm4_2;
+                TestMessage3 tm3_2;
+                in >> tm4_2 >> tm3_2;
+
+                TS_ASSERT(tm4_2.getField1().getField1() == 150);
+                TS_ASSERT(tm3_2.getField1() == "testing");
+            }
+        }
+
 };
 
 #endif /*CORE_QUERYABLENETSTRINGSABCFMESSAGESTESTSUITE_H_*/
@@ -282,6 +282,44 @@ class QueueTest : public CxxTest::TestSuite {
             producer.stop();
         }
 
+        void testMovingContainersThroughQueues() {
+            QueueTestSampleData sampleData;
+
+            FIFOQueue fifo;
+            sampleData.m_int = 10;
+            fifo.enter(Container(sampleData));
+            sampleData.m_int = 20;
+            Container c1(sampleData);
+            fifo.add(std::move(c1));
+
+            TS_ASSERT(fifo.getSize() == 2);
+            TS_ASSERT(fifo.leave().getData<QueueTestSampleData>().m_int == 10);
+            TS_ASSERT(fifo.leave().getData<QueueTestSampleData>().m_int == 20);
+            TS_ASSERT(fifo.isEmpty());
+
+            LIFOQueue lifo;
+            sampleData.m_int = 30;
+            lifo.push(Container(sampleData));
+            sampleData.m_int = 40;
+            Container c2(sampleData);
+            lifo.add(std::move(c2));
+
+            TS_ASSERT(lifo.getSize() == 2);
+            TS_ASSERT(lifo.pop().getData<QueueTestSampleData>().m_int == 40);
+            TS_ASSERT(lifo.pop().getData<QueueTestSampleData>().m_int == 30);
+            TS_ASSERT(lifo.isEmpty());
+
+            BufferedFIFOQueue bufferedFifo(1);
+            sampleData.m_int = 50;
+            bufferedFifo.enter(Container(sampleData));
+            sampleData.m_int = 60;
+            bufferedFifo.enter(Container(sampleData));
+
+            TS_ASSERT(bufferedFifo.getSize() == 1);
+            Container c3 = bufferedFifo.getElementAt(0);
+            TS_ASSERT(c3.getData<QueueTestSampleData>().m_int == 50);
+        }
+
         void testBufferedFIFOAsRegularFIFO() {
             Condition blockTestCase;
             BufferedFIFOQueue bufferedFifo(1000);
@@ -32,6 +32,8 @@
 #include "opendavinci/odcore/serialization/Serializable.h"     // for Serializable, operator<<, etc
 #include "opendavinci/odcore/serialization/SerializationFactory.h"  // for SerializationFactory
 #include "opendavinci/odcore/serialization/Serializer.h"       // for Serializer
+#include "opendavinci/odcore/data/Container.h"                // for Container
+#include "opendavinci/generated/odcore/data/SharedData.h"     // for SharedData
 
 using namespace std;
 using namespace odcore;
@@ -137,6 +139,60 @@ class SerializationTest : public CxxTest::TestSuite {
             TS_ASSERT(sd2.m_string == "This is an example.");
             TS_ASSERT_DELTA(sd2.m_nestedData.m_double, -42.42, 1e-5);
         }
+
+        void testPooledSerializersAreReused() {
+            SerializationFactory& sf = SerializationFactory::getInstance();
+
+            Serializer *first = NULL;
+            stringstream out1;
+            {
+                std::shared_ptr<Serializer> s = sf.getSerializer(out1);
+                first = s.get();
+                s->write(1, 42);
+            }
+
+            stringstream out2;
+            {
+                std::shared_ptr<Serializer> s = sf.getSerializer(out2);
+                // An idle serializer is reused.
+                TS_ASSERT(s.get() == first);
+                s->write(1, 42);
+
+                // Concurrently used serializers are distinct.
+                stringstream out3;
+                std::shared_ptr<Serializer> s2 = sf.getSerializer(out3);
+                TS_ASSERT(s2.get() != s.get());
+            }
+
+            // A reused serializer does not carry data from its previous use.
+            TS_ASSERT(out1.str().size() > 0);
+            TS_ASSERT(out1.str() == out2.str());
+
+            int32_t value = 0;
+            std::shared_ptr<Deserializer> d = sf.getDeserializer(out2);
+            d->read(1, value);
+            TS_ASSERT(value == 42);
+        }
+
+        void testContainerWithWireFormats() {
+            const SerializationFactory::WIRE_FORMAT formats[] = { SerializationFactory::PROTO,
+                                                                  SerializationFactory::QUERYABLE_NETSTRINGS,
+                                                                  SerializationFactory::LCM,
+                                                                  SerializationFactory::ROS };
+
+            for (uint32_t i = 0; i < sizeof(formats)/sizeof(formats[0]); i++) {
+                odcore::data::SharedData sd;
+                sd.setName("Shared");
+                sd.setSize(4096);
+
+                odcore::data::Container c(sd, odcore::data::SharedData::ID(), formats[i]);
+                TS_ASSERT(c.getDataType() == odcore::data::SharedData::ID());
+
+                odcore::data::SharedData sd2 = c.getData<odcore::data::SharedData>(formats[i]);
+                TS_ASSERT(sd2.getName() == "Shared");
+                TS_ASSERT(sd2.getSize() == 4096);
+            }
+        }
 };
 
 #endif /*CORE_SERIALIZATIONTESTSUITE_H_*/
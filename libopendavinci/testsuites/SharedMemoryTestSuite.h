@@ -128,6 +128,37 @@ class SharedMemoryTest : public CxxTest::TestSuite {
             }
         }
 
+        void testSharedMemoryCreatedExclusively() {
+            std::shared_ptr<odcore::wrapper::SharedMemory> memServer = odcore::wrapper::SharedMemoryFactory::createSharedMemoryExclusively("SharedMemoryExclusive", 10);
+            TS_ASSERT(memServer->isValid());
+            TS_ASSERT(memServer->getSize() == 10);
+            for (uint32_t i = 0; i < memServer->getSize(); i++) {
+                *(((char*)(memServer->getSharedMemory())) + i) = ('A' + i);
+            }
+
+            // The existing shared memory is not replaced.
+            std::shared_ptr<odcore::wrapper::SharedMemory> memOther = odcore::wrapper::SharedMemoryFactory::createSharedMemoryExclusively("SharedMemoryExclusive", 10);
+            TS_ASSERT(!memOther->isValid());
+            memOther.reset();
+
+            std::shared_ptr<odcore::wrapper::SharedMemory> memClient = odcore::wrapper::SharedMemoryFactory::attachToSharedMemory("SharedMemoryExclusive");
+            TS_ASSERT(memClient->isValid());
+            TS_ASSERT(memClient->getSize() == 10);
+
+            // After removing its name, a new shared memory can be created.
+            memServer->remove();
+            memOther = odcore::wrapper::SharedMemoryFactory::createSharedMemoryExclusively("SharedMemoryExclusive", 10);
+            TS_ASSERT(memOther->isValid());
+            TS_ASSERT(memOther->getSharedMemory() != memClient->getSharedMemory());
+
+            // Attached processes keep using the removed shared memory.
+            for (uint32_t i = 0; i < memClient->getSize(); i++) {
+                char c = *(((char*)(memClient->getSharedMemory())) + i);
+                TS_ASSERT(c == (char)('A' + i));
+                TS_ASSERT(0 == *(((char*)(memOther->getSharedMemory())) + i));
+            }
+        }
+
 };
 
 #endif /*CORE_SHAREDMEMORYTESTSUITE_H_*/
@@ -26,6 +26,7 @@
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
 #include "opendavinci/odcore/io/Connection.h"
+#include "opendavinci/odcore/io/Reactor.h"
 #include "opendavinci/odcore/io/tcp/TCPAcceptor.h"
 #include "opendavinci/odcore/wrapper/NetworkLibraryProducts.h"
 #include "mocks/ConnectionListenerMock.h"
@@ -198,6 +199,30 @@ class TCPConnectionTestSuite  : public CxxTest::TestSuite
                 >::errorTest();
             #endif
         }
+
+#ifdef __linux__
+        void testTransferUsingReactor()
+        {
+            clog << endl << "TCPConnectionTestSuite::testTransferUsingReactor using NetworkLibraryPosix" << endl;
+            odcore::io::Reactor::setNumberOfThreads(2);
+            TCPConnectionTests
+            <
+                 odcore::wrapper::TCPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>
+            >::transferTest();
+            odcore::io::Reactor::setNumberOfThreads(0);
+        }
+
+        void testErrorUsingReactor()
+        {
+            clog << endl << "TCPConnectionTestSuite::testErrorUsingReactor using NetworkLibraryPosix" << endl;
+            odcore::io::Reactor::setNumberOfThreads(2);
+            TCPConnectionTests
+            <
+                 odcore::wrapper::TCPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>
+            >::errorTest();
+            odcore::io::Reactor::setNumberOfThreads(0);
+        }
+#endif
 };
 
 #endif /*CORE_WRAPPER_TCPCONNECTIONTESTSUITE_H_*/
@@ -99,6 +99,27 @@ class TCPGathererTestSuite : public CxxTest::TestSuite, public odcore::io::tcp::
             TS_ASSERT( mockListener.correctCalled() );
         }
 
+        /**
+         * 4. Test case: Several buffers are sent as one packet.
+         */
+        void testSendBuffers()
+        {
+            clog << endl << "TCPConnectionTestSuite::testSendBuffers" << endl;
+
+            send("The test data");
+            TS_ASSERT(m_sentData == createTestData("The test data"));
+
+            const char *buffers[] = { "The ", "test ", "data" };
+            const uint32_t lengths[] = { 4, 5, 4 };
+            sendBuffers(buffers, lengths, 3);
+            TS_ASSERT(m_sentData == createTestData("The test data"));
+
+            setRaw(true);
+            sendBuffers(buffers, lengths, 3);
+            TS_ASSERT(m_sentData == "The test data");
+            setRaw(false);
+        }
+
         /**
          * 3. Test case: Test data is split and mixed.
          */
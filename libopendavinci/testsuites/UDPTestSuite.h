@@ -22,11 +22,19 @@
 
 #include <iostream>                     // for endl, operator<<, etc
 #include <memory>
+#include <sstream>                      // for stringstream
 #include <string>                       // for string
+#include <vector>                       // for vector
 
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/base/Thread.h"
+#include "opendavinci/odcore/io/PacketListener.h"
+#include "opendavinci/odcore/io/Reactor.h"
+#include "opendavinci/generated/odcore/data/Packet.h"
 #include "mocks/StringListenerMock.h"
 
 namespace odcore { namespace io { namespace udp { class UDPReceiver; } } }
@@ -35,6 +43,7 @@ namespace odcore { namespace io { namespace udp { class UDPSender; } } }
 using namespace std;
 
 #ifndef WIN32
+    #include "opendavinci/odcore/wrapper/POSIX/POSIXReactor.h"
     #include "opendavinci/odcore/wrapper/POSIX/POSIXUDPFactoryWorker.h"
     #include "opendavinci/odcore/wrapper/POSIX/POSIXUDPReceiver.h"
     #include "opendavinci/odcore/wrapper/POSIX/POSIXUDPSender.h"
@@ -70,6 +79,40 @@ using namespace std;
         }
     };
 
+    class BatchedPacketListener : public odcore::io::PacketListener {
+        public:
+            BatchedPacketListener() :
+                m_mutex(),
+                m_packets(),
+                m_numberOfBatches(0) {}
+
+            virtual void nextPacket(const odcore::data::Packet &p) {
+                odcore::base::Lock l(m_mutex);
+                m_packets.push_back(p);
+            }
+
+            virtual void nextPackets(const vector<odcore::data::Packet> &packets) {
+                odcore::base::Lock l(m_mutex);
+                m_packets.insert(m_packets.end(), packets.begin(), packets.end());
+                m_numberOfBatches++;
+            }
+
+            vector<odcore::data::Packet> getPackets() {
+                odcore::base::Lock l(m_mutex);
+                return m_packets;
+            }
+
+            uint32_t getNumberOfBatches() {
+                odcore::base::Lock l(m_mutex);
+                return m_numberOfBatches;
+            }
+
+        private:
+            odcore::base::Mutex m_mutex;
+            vector<odcore::data::Packet> m_packets;
+            uint32_t m_numberOfBatches;
+    };
+
 #endif
 
 #ifdef WIN32
@@ -128,6 +171,155 @@ using namespace std;
                 TS_ASSERT( mock.CALLWAITER_nextString.wasCalled() );
                 TS_ASSERT( mock.correctCalled() );
             }
+
+#ifndef WIN32
+            void testBatchedDataExchange()
+            {
+                const string group = "225.0.0.14";
+                const uint32_t port = 4568;
+                const uint32_t NUMBER_OF_PACKETS = 8;
+
+                BatchedPacketListener listener;
+
+                std::shared_ptr<odcore::io::udp::UDPReceiver> receiver(
+                        odcore::wrapper::UDPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>::createUDPReceiver(group, port));
+
+                std::shared_ptr<odcore::io::udp::UDPSender> sender(
+                        odcore::wrapper::UDPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>::createUDPSender(group, port));
+
+                receiver->setReceiveBatchSize(NUMBER_OF_PACKETS);
+                receiver->setSynchronousPacketListener(&listener);
+                receiver->start();
+
+                for (uint32_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+                    stringstream sstr;
+                    sstr << "Hello batch " << i;
+                    sender->send(sstr.str());
+                }
+
+                // Wait for at most two seconds.
+                for (uint32_t i = 0; (i < 200) && (listener.getPackets().size() < NUMBER_OF_PACKETS); i++) {
+                    odcore::base::Thread::usleepFor(10 * 1000);
+                }
+
+                receiver->setSynchronousPacketListener(NULL);
+                receiver->stop();
+
+                const vector<odcore::data::Packet> packets = listener.getPackets();
+                TS_ASSERT(packets.size() == NUMBER_OF_PACKETS);
+                TS_ASSERT(listener.getNumberOfBatches() > 0);
+                TS_ASSERT(listener.getNumberOfBatches() <= NUMBER_OF_PACKETS);
+                for (uint32_t i = 0; i < packets.size(); i++) {
+                    stringstream sstr;
+                    sstr << "Hello batch " << i;
+                    TS_ASSERT(packets.at(i).getData() == sstr.str());
+                    TS_ASSERT(packets.at(i).getSender().size() > 0);
+                    TS_ASSERT(packets.at(i).getReceived().getSeconds() > 0);
+                }
+            }
+
+            void testSendBatch()
+            {
+                const string group = "225.0.0.15";
+                const uint32_t port = 4569;
+                const uint32_t NUMBER_OF_PACKETS = 8;
+
+                BatchedPacketListener listener;
+
+                std::shared_ptr<odcore::io::udp::UDPReceiver> receiver(
+                        odcore::wrapper::UDPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>::createUDPReceiver(group, port));
+
+                std::shared_ptr<odcore::io::udp::UDPSender> sender(
+                        odcore::wrapper::UDPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>::createUDPSender(group, port));
+
+                receiver->setSynchronousPacketListener(&listener);
+                receiver->start();
+
+                vector<string> batch;
+                for (uint32_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+                    stringstream sstr;
+                    sstr << "Hello sendBatch " << i;
+                    batch.push_back(sstr.str());
+                }
+                sender->sendBatch(batch);
+
+                // Wait for at most two seconds.
+                for (uint32_t i = 0; (i < 200) && (listener.getPackets().size() < NUMBER_OF_PACKETS); i++) {
+                    odcore::base::Thread::usleepFor(10 * 1000);
+                }
+
+                receiver->setSynchronousPacketListener(NULL);
+                receiver->stop();
+
+                const vector<odcore::data::Packet> packets = listener.getPackets();
+                TS_ASSERT(packets.size() == NUMBER_OF_PACKETS);
+                for (uint32_t i = 0; i < packets.size(); i++) {
+                    TS_ASSERT(packets.at(i).getData() == batch.at(i));
+                }
+            }
+
+#ifdef __linux__
+            void testReactorDataExchange()
+            {
+                const string group = "225.0.0.16";
+                const uint32_t port = 4570;
+                const uint32_t NUMBER_OF_PACKETS = 8;
+
+                // Serve the receivers by two shared threads.
+                odcore::io::Reactor::setNumberOfThreads(2);
+
+                BatchedPacketListener listenerA;
+                BatchedPacketListener listenerB;
+
+                std::shared_ptr<odcore::io::udp::UDPReceiver> receiverA(
+                        odcore::wrapper::UDPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>::createUDPReceiver(group, port));
+
+                std::shared_ptr<odcore::io::udp::UDPReceiver> receiverB(
+                        odcore::wrapper::UDPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>::createUDPReceiver(group, port));
+
+                std::shared_ptr<odcore::io::udp::UDPSender> sender(
+                        odcore::wrapper::UDPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>::createUDPSender(group, port));
+
+                receiverA->setSynchronousPacketListener(&listenerA);
+                receiverA->start();
+
+                receiverB->setReceiveBatchSize(4);
+                receiverB->setSynchronousPacketListener(&listenerB);
+                receiverB->start();
+
+                TS_ASSERT(odcore::wrapper::POSIX::POSIXReactor::getInstance().getNumberOfThreads() == 2);
+
+                for (uint32_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+                    stringstream sstr;
+                    sstr << "Hello reactor " << i;
+                    sender->send(sstr.str());
+                }
+
+                // Wait for at most two seconds.
+                for (uint32_t i = 0; (i < 200) && ( (listenerA.getPackets().size() < NUMBER_OF_PACKETS) || (listenerB.getPackets().size() < NUMBER_OF_PACKETS) ); i++) {
+                    odcore::base::Thread::usleepFor(10 * 1000);
+                }
+
+                receiverA->setSynchronousPacketListener(NULL);
+                receiverA->stop();
+                receiverB->setSynchronousPacketListener(NULL);
+                receiverB->stop();
+
+                odcore::io::Reactor::setNumberOfThreads(0);
+
+                const vector<odcore::data::Packet> packetsA = listenerA.getPackets();
+                const vector<odcore::data::Packet> packetsB = listenerB.getPackets();
+                TS_ASSERT(packetsA.size() == NUMBER_OF_PACKETS);
+                TS_ASSERT(packetsB.size() == NUMBER_OF_PACKETS);
+                for (uint32_t i = 0; (i < packetsA.size()) && (i < packetsB.size()); i++) {
+                    stringstream sstr;
+                    sstr << "Hello reactor " << i;
+                    TS_ASSERT(packetsA.at(i).getData() == sstr.str());
+                    TS_ASSERT(packetsB.at(i).getData() == sstr.str());
+                }
+            }
+#endif
+#endif
     };
 
 
@@ -0,0 +1,178 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2016 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_VARINTTESTSUITE_H_
+#define CORE_VARINTTESTSUITE_H_
+
+#include <sstream>                      // for stringstream
+#include <string>                       // for string
+#include <vector>                       // for vector
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/serialization/VarInt.h"
+
+using namespace std;
+using namespace odcore::serialization;
+
+class VarIntTest : public CxxTest::TestSuite {
+    private:
+        /**
+         * Byte-wise decoder as used by ProtoDeserializer before;
+         * it is the reference for the tests below.
+         */
+        static uint8_t decodeBytewise(istream &in, uint64_t &value) {
+            value = 0;
+            uint8_t size = 0;
+            char c = 0;
+            while (in.good()) {
+                c = in.get();
+                value |= static_cast<unsigned int>( (c & 0x7f) << (0x7 * size++) );
+                if ( !(c & 0x80) ) break;
+            }
+            return size;
+        }
+
+        static string encodeAll(const vector<uint64_t> &values) {
+            string s;
+            char bytes[VarInt::MAX_SIZE];
+            for (uint32_t i = 0; i < values.size(); i++) {
+                s.append(bytes, VarInt::encode(values[i], bytes));
+            }
+            return s;
+        }
+
+        static vector<uint64_t> getValues(const uint32_t &count, const uint32_t &maxBits) {
+            // Deterministic pseudo random values with up to maxBits bits.
+            vector<uint64_t> values;
+            uint64_t x = 0x9E3779B97F4A7C15ULL;
+            for (uint32_t i = 0; i < count; i++) {
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                values.push_back((maxBits < 64) ? (x & ((1ULL << maxBits) - 1)) : x);
+            }
+            return values;
+        }
+
+    public:
+        void testEncodeDecodeBoundaries() {
+            const uint64_t values[] = { 0, 1, 0x7f, 0x80, 0x3fff, 0x4000, 0x1fffff, 0x200000,
+                                        0xffffffffULL, 0x100000000ULL, 0x7fffffffffffffffULL, 0xffffffffffffffffULL };
+            const uint32_t sizes[] = { 1, 1, 1, 2, 2, 3, 3, 4, 5, 5, 9, 10 };
+
+            for (uint32_t i = 0; i < sizeof(values)/sizeof(uint64_t); i++) {
+                char bytes[VarInt::MAX_SIZE];
+                const uint32_t size = VarInt::encode(values[i], bytes);
+                TS_ASSERT(size == sizes[i]);
+                TS_ASSERT(VarInt::getSize(values[i]) == sizes[i]);
+
+                // Decode from span.
+                const char *pos = bytes;
+                uint64_t value = 0;
+                TS_ASSERT(VarInt::decode(pos, bytes + size, value));
+                TS_ASSERT(value == values[i]);
+                TS_ASSERT(pos == bytes + size);
+
+                // Decode from stream.
+                stringstream sstr(string(bytes, size));
+                uint64_t value2 = 0;
+                TS_ASSERT(VarInt::decode(sstr, value2) == size);
+                TS_ASSERT(value2 == values[i]);
+                TS_ASSERT(sstr.good());
+            }
+        }
+
+        void testDecodeTruncated() {
+            char bytes[VarInt::MAX_SIZE];
+            const uint32_t size = VarInt::encode(0x123456789ULL, bytes);
+
+            const char *pos = bytes;
+            uint64_t value = 0;
+            TS_ASSERT(!VarInt::decode(pos, bytes + size - 1, value));
+            TS_ASSERT(pos == bytes);
+
+            stringstream sstr(string(bytes, size - 1));
+            TS_ASSERT(VarInt::decode(sstr, value) == size - 1);
+            TS_ASSERT(sstr.eof() && sstr.fail());
+        }
+
+        void testDecodePacked() {
+            // Mix runs of single byte values with larger values.
+            vector<uint64_t> values = getValues(200, 7);
+            const vector<uint64_t> large = getValues(50, 64);
+            values.insert(values.begin() + 40, large.begin(), large.end());
+            values.push_back(0xffffffffffffffffULL);
+
+            const string s = encodeAll(values);
+            vector<uint64_t> decoded(values.size() + 1);
+
+            const char *pos = s.data();
+            TS_ASSERT(VarInt::decodePacked(pos, s.data() + s.size(), &decoded[0], decoded.size()) == values.size());
+            TS_ASSERT(pos == s.data() + s.size());
+            for (uint32_t i = 0; i < values.size(); i++) {
+                TS_ASSERT(decoded[i] == values[i]);
+            }
+
+            // Stop at the given capacity.
+            pos = s.data();
+            TS_ASSERT(VarInt::decodePacked(pos, s.data() + s.size(), &decoded[0], 17) == 17);
+            const char *pos2 = s.data();
+            for (uint32_t i = 0; i < 17; i++) {
+                uint64_t v = 0;
+                VarInt::decode(pos2, s.data() + s.size(), v);
+            }
+            TS_ASSERT(pos == pos2);
+        }
+
+        void testDecodersAgree() {
+            const uint32_t bits[] = { 7, 14, 32, 64 };
+
+            for (uint32_t b = 0; b < sizeof(bits)/sizeof(uint32_t); b++) {
+                const vector<uint64_t> values = getValues(10000, bits[b]);
+                const string s = encodeAll(values);
+
+                // The span decoders must not truncate values above 32 bits.
+                const char *pos = s.data();
+                const char *end = s.data() + s.size();
+                for (uint32_t i = 0; i < values.size(); i++) {
+                    uint64_t v = 0;
+                    TS_ASSERT(VarInt::decode(pos, end, v));
+                    TS_ASSERT(v == values[i]);
+                }
+                TS_ASSERT(pos == end);
+
+                vector<uint64_t> decoded(values.size());
+                pos = s.data();
+                TS_ASSERT(VarInt::decodePacked(pos, end, &decoded[0], decoded.size()) == values.size());
+                TS_ASSERT(decoded == values);
+
+                // The byte-wise decoder is only correct for values up to 28 bits.
+                if (bits[b] <= 28) {
+                    stringstream sstr(s);
+                    for (uint32_t i = 0; i < values.size(); i++) {
+                        uint64_t v = 0;
+                        decodeBytewise(sstr, v);
+                        TS_ASSERT(v == values[i]);
+                    }
+                }
+            }
+        }
+};
+
+#endif /*CORE_VARINTTESTSUITE_H_*/
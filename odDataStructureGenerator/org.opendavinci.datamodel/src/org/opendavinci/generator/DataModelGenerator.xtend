@@ -72,6 +72,21 @@ class DataModelGenerator implements IGenerator {
   							 "bytes"-> "bytes"
   	)
 
+    /* This hashmap defines the number of bytes of the respective type in a message declared as flat. */
+ 	val flatSizeMap = newHashMap("double"-> 8,
+  							 "float"-> 4,
+  							 "int8"-> 1,
+  							 "uint8"-> 1,
+  							 "int16"-> 2,
+  							 "uint16"-> 2,
+  							 "int32"-> 4,
+  							 "uint32"-> 4,
+  							 "int64"-> 8,
+  							 "uint64"-> 8,
+  							 "bool"-> 1,
+  							 "char"-> 1
+  	)
+
     /* This hashmap assigns initializing values to attributes of the respective type. */
  	val initializationMap = newHashMap("double"-> "0.0",
   							 "float"-> "0",
@@ -178,6 +193,15 @@ syntax = "proto2";
 «FOR msg : msgs»
     «var enums = collectEnumsFromMessage(null, msg)»
     // Message identifier: «msg.id».
+    «IF msg.flat»
+    // «msg.message» is declared as flat and hence not encoded in Protobuf but in
+    // the following fixed layout of «msg.getFlatSize(enums)» bytes (little endian, enums as int32):
+    «FOR a : msg.attributes»
+        «IF a.scalar != null»
+    //   Offset «msg.getFlatOffset(a, enums)»: «a.scalar.type» «a.scalar.name» (id = «a.scalar.id»)
+        «ENDIF»
+    «ENDFOR»
+    «ELSE»
     message «msg.message.replaceAll("\\.", "_")» {
         «FOR a : msg.attributes»
             «IF a.scalar != null && protoTypeMap.containsKey(a.scalar.type)»
@@ -200,6 +224,7 @@ syntax = "proto2";
             «ENDIF»
         «ENDFOR»
     }
+    «ENDIF»
 
 «ENDFOR»
 '''
@@ -239,6 +264,8 @@ syntax = "proto2";
 
 #include "opendavinci/odcore/base/Visitable.h"
 #include "opendavinci/odcore/data/SerializableData.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
 
 «FOR a : msg.attributes /*These lines include header files for user generated types used in other messages.*/»
 	«IF a.scalar != null»
@@ -375,6 +402,10 @@ class OPENDAVINCI_API «msg.message.substring(msg.message.lastIndexOf('.') + 1)
 	«FOR a : msg.attributes /* Here, we iterate over the attributes to generate the getter and setter methods. */»
 		«a.generateHeaderGetterSetter(enums)»
 	«ENDFOR»
+	«IF msg.flat /* Here, we generate the fixed layout representation for messages declared as flat. */»
+
+	«generateHeaderFlat(msg, enums)»
+	«ENDIF»
 
 	public:
 		/**
@@ -425,6 +456,31 @@ class OPENDAVINCI_API «msg.message.substring(msg.message.lastIndexOf('.') + 1)
 		virtual ostream& operator<<(ostream &out) const;
 		virtual istream& operator>>(istream &in);
 
+		/**
+		 * This method returns the number of bytes needed to encode
+		 * this message in «IF msg.flat»its flat representation (i.e. FLAT_SIZE)«ELSE»Google's Protobuf format«ENDIF».
+		 *
+		 * @return Number of bytes.
+		 */
+		uint32_t getEncodedSize() const;
+
+		/**
+		 * This method encodes this message in «IF msg.flat»its flat representation«ELSE»Google's Protobuf format«ENDIF»
+		 * into a pre-sized buffer (cf. getEncodedSize()).
+		 *
+		 * @param out ByteWriter to write to.
+		 */
+		void encodeTo(odcore::serialization::ByteWriter &out) const;
+
+		/**
+		 * This method decodes this message from bytes encoded in
+		 * «IF msg.flat»its flat representation«ELSE»Google's Protobuf format«ENDIF».
+		 *
+		 * @param in Bytes to decode from.
+		 * @return true if the bytes were well-formed.
+		 */
+		bool decodeFrom(const odcore::serialization::ByteSpan &in);
+
 		virtual const string toString() const;
 
 	«FOR a : msg.attributes /* Here, we generate the member attributes. */»
@@ -445,6 +501,119 @@ class OPENDAVINCI_API «msg.message.substring(msg.message.lastIndexOf('.') + 1)
 };
 	'''
 	
+	/* This method generates the fixed layout representation for a message declared as flat. */
+	def generateHeaderFlat(Message msg, HashMap<String, EnumDescription> enums) '''
+	public:
+		/**
+		 * Number of bytes of the flat representation.
+		 */
+		static const uint32_t FLAT_SIZE = «msg.getFlatSize(enums)»;
+
+		/**
+		 * This struct contains the attributes of this message in a
+		 * fixed memory layout and can be copied with memcpy.
+		 */
+		struct Flat {
+			«FOR a : msg.attributes»
+				«IF a.scalar != null»
+					«a.getFlatType(enums)» «a.scalar.name»;
+				«ENDIF»
+			«ENDFOR»
+		};
+
+		/**
+		 * This class reads the attributes of this message directly
+		 * from a buffer containing its flat representation without
+		 * decoding or copying the buffer.
+		 */
+		class OPENDAVINCI_API View {
+			public:
+				/**
+				 * Constructor.
+				 *
+				 * @param data Buffer to read from; the caller is responsible for its lifecycle.
+				 * @param length Number of bytes in the buffer.
+				 */
+				View(const char *data, const uint32_t &length);
+
+				/**
+				 * Constructor.
+				 *
+				 * @param in Bytes to read from.
+				 */
+				View(const odcore::serialization::ByteSpan &in);
+
+				/**
+				 * @return true if the buffer contains at least FLAT_SIZE bytes.
+				 */
+				bool isValid() const;
+
+			«FOR a : msg.attributes»
+				«IF a.scalar != null»
+				/**
+				 * @return «a.scalar.name» or its default value if !isValid().
+				 */
+				«a.getFlatType(enums)» get«a.scalar.name.toFirstUpper»() const;
+
+				«ENDIF»
+			«ENDFOR»
+			private:
+				odcore::serialization::ByteSpan m_data;
+		};
+
+		/**
+		 * @return Flat representation of this message.
+		 */
+		Flat toFlat() const;
+
+		/**
+		 * This method sets the attributes from a flat representation.
+		 *
+		 * @param f Flat representation.
+		 */
+		void fromFlat(const Flat &f);
+	'''
+
+	/* This method returns the C++ type of an attribute in a message declared as flat. */
+	def getFlatType(Attribute a, HashMap<String, EnumDescription> enums) {
+		if (enums.containsKey(a.scalar.type)) {
+			return enums.get(a.scalar.type).m_enumName
+		}
+		return typeMap.get(a.scalar.type)
+	}
+
+	/* This method returns the number of bytes of an attribute in a message declared as flat; enums are encoded as int32. */
+	def int getFlatSize(Attribute a, HashMap<String, EnumDescription> enums) {
+		if (a.scalar == null) {
+			return 0
+		}
+		if (enums.containsKey(a.scalar.type)) {
+			return 4
+		}
+		return flatSizeMap.get(a.scalar.type)
+	}
+
+	/* This method returns the number of bytes of a message declared as flat. */
+	def int getFlatSize(Message msg, HashMap<String, EnumDescription> enums) {
+		var size = 0
+		for (a : msg.attributes) {
+			size = size + a.getFlatSize(enums)
+		}
+		return size
+	}
+
+	/* This method returns the offset of an attribute in a message declared as flat. */
+	def int getFlatOffset(Message msg, Attribute attribute, HashMap<String, EnumDescription> enums) {
+		var offset = 0
+		for (a : msg.attributes) {
+			if (a == attribute) {
+				return offset
+			}
+			offset = offset + a.getFlatSize(enums)
+		}
+		return offset
+	}
+
 	/* This method generates the enum declarations. */
 	def generateHeaderFileEnum(Message msg, HashMap<String, EnumDescription> enums) '''
 	«FOR e : enums.entrySet»
@@ -537,6 +706,30 @@ class OPENDAVINCI_API «msg.message.substring(msg.message.lastIndexOf('.') + 1)
 				 * @return Pair of iterators for the begin and end of the list of «a.list.name».
 				 */
 				std::pair<std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::iterator, std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::iterator> iteratorPair_ListOf«a.list.name.toFirstUpper»();
+
+				/**
+				 * @return Reference to «a.list.name» without copying the list.
+				 */
+				const std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>& getConstRef_ListOf«a.list.name.toFirstUpper»() const;
+
+				/**
+				 * @return Pair of const iterators for the begin and end of the list of «a.list.name».
+				 */
+				std::pair<std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::const_iterator, std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::const_iterator> constIteratorPair_ListOf«a.list.name.toFirstUpper»() const;
+
+				/**
+				 * This method reserves memory for the given number of elements in the list of «a.list.name».
+				 *
+				 * @param size Number of elements to reserve memory for.
+				 */
+				void reserve_ListOf«a.list.name.toFirstUpper»(const uint32_t &size);
+
+				/**
+				 * This method moves an element to the end of the list of «a.list.name».
+				 *
+				 * @param val Value to be moved to the end of the list of «a.list.name».
+				 */
+				void emplaceTo_ListOf«a.list.name.toFirstUpper»(«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF» &&val);
 			«ENDIF»
 			«IF a.map != null && a.map.modifier != null && a.map.modifier.length > 0 && a.map.modifier.equalsIgnoreCase("map")»
 				/**
@@ -591,6 +784,24 @@ class OPENDAVINCI_API «msg.message.substring(msg.message.lastIndexOf('.') + 1)
 				 * @return Pair of iterators for the begin and end of the map of «a.map.name».
 				 */
 				std::pair<std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::iterator, std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::iterator> iteratorPair_MapOf«a.map.name.toFirstUpper»();
+
+				/**
+				 * @return Reference to «a.map.name» without copying the map.
+				 */
+				const std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>& getConstRef_MapOf«a.map.name.toFirstUpper»() const;
+
+				/**
+				 * @return Pair of const iterators for the begin and end of the map of «a.map.name».
+				 */
+				std::pair<std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::const_iterator, std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::const_iterator> constIteratorPair_MapOf«a.map.name.toFirstUpper»() const;
+
+				/**
+				 * This method moves an element to the map of «a.map.name».
+				 *
+				 * @param key Key of the key/value pair to be added to the map of «a.map.name».
+				 * @param val Value of the key/value pair to be moved to the map of «a.map.name».
+				 */
+				void emplaceTo_MapOf«a.map.name.toFirstUpper»(const «IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF» &key, «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF» &&val);
 			«ENDIF»
 			«IF a.fixedarray != null»
 				/**
@@ -647,6 +858,9 @@ class OPENDAVINCI_API «msg.message.substring(msg.message.lastIndexOf('.') + 1)
  */
 
 #include <memory>
+«IF msg.flat»
+#include <type_traits>
+«ENDIF»
 «var hasGeneratedAlgorithm = false»
 «var hasGeneratedMacros = false»
 «FOR a : msg.attributes /* If we have lists or maps we need to include the proper header files here. */»
@@ -663,7 +877,14 @@ class OPENDAVINCI_API «msg.message.substring(msg.message.lastIndexOf('.') + 1)
 	«ENDIF»
 «ENDFOR»
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+«IF msg.flat»
+#include <opendavinci/odcore/serialization/FlatCodec.h>
+«ENDIF»
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -863,6 +1084,11 @@ namespace «s.get(i)» {
 		«IF !msg.attributes.empty»
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls«IF msg.flat» in the fixed layout«ENDIF».
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);«IF !hasOtherThanEnumAndConstAttributes»(void)s; // Avoid unused variable warning.«ENDIF»
 
 		«FOR a : msg.attributes»
@@ -876,6 +1102,11 @@ namespace «s.get(i)» {
 		«IF !msg.attributes.empty»
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls«IF msg.flat» from the fixed layout«ENDIF».
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);«IF !hasOtherThanEnumAndConstAttributes»(void)d; // Avoid unused variable warning.«ENDIF»
 
 		«FOR a : msg.attributes»
@@ -884,6 +1115,211 @@ namespace «s.get(i)» {
 		«ENDIF»
 		return in;
 	}
+
+	«IF msg.flat»
+	«generateImplementationFlat(msg, enums)»
+	«ELSE»
+	uint32_t «/* Here, we generate the method to compute the size of the Protobuf encoding. */msg.message.substring(msg.message.lastIndexOf('.') + 1)»::getEncodedSize() const {
+		uint32_t size = 0;
+		«FOR a : msg.attributes»
+			«a.generateAttributeEncodedSize(enums)»
+		«ENDFOR»
+		return size;
+	}
+
+	void «/* Here, we generate the statically typed Protobuf encoding. */msg.message.substring(msg.message.lastIndexOf('.') + 1)»::encodeTo(ByteWriter &out) const {
+		«IF !hasOtherThanEnumAndConstAttributes»
+		(void)out; // Avoid unused parameter warning.
+		«ENDIF»
+		«FOR a : msg.attributes»
+			«a.generateAttributeEncoding(enums)»
+		«ENDFOR»
+	}
+
+	bool «/* Here, we generate the statically typed Protobuf decoding. */msg.message.substring(msg.message.lastIndexOf('.') + 1)»::decodeFrom(const ByteSpan &in) {
+		«FOR a : msg.attributes»
+			«a.generateAttributeDecodingReset»
+		«ENDFOR»
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				«FOR a : msg.attributes»
+					«a.generateAttributeDecoding(enums)»
+				«ENDFOR»
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
+	«ENDIF»
+	'''
+
+	/* This method generates the fixed layout representation for a message declared as flat. */
+	def generateImplementationFlat(Message msg, HashMap<String, EnumDescription> enums) '''
+	const uint32_t «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::FLAT_SIZE;
+
+	static_assert(std::is_pod<«msg.message.substring(msg.message.lastIndexOf('.') + 1)»::Flat>::value, "«msg.message.substring(msg.message.lastIndexOf('.') + 1)»::Flat must be a plain old data type.");
+
+	«msg.message.substring(msg.message.lastIndexOf('.') + 1)»::View::View(const char *data, const uint32_t &length) :
+		m_data(data, length) {}
+
+	«msg.message.substring(msg.message.lastIndexOf('.') + 1)»::View::View(const ByteSpan &in) :
+		m_data(in) {}
+
+	bool «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::View::isValid() const {
+		return (m_data.getLength() >= FLAT_SIZE);
+	}
+	«FOR a : msg.attributes»
+		«IF a.scalar != null»
+
+		«IF enums.containsKey(a.scalar.type)»
+		«enums.get(a.scalar.type).m_enumNameIncludingMessageName.replaceAll("\\.", "::")» «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::View::get«a.scalar.name.toFirstUpper»() const {
+			return isValid() ? static_cast<«enums.get(a.scalar.type).m_enumNameIncludingMessageName.replaceAll("\\.", "::")»>(FlatCodec::read<int32_t>(m_data.getData() + «msg.getFlatOffset(a, enums)»)) : «enums.get(a.scalar.type).m_enumNameIncludingMessageName.replaceAll("\\.", "::")»();
+		}
+		«ELSE»
+		«typeMap.get(a.scalar.type)» «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::View::get«a.scalar.name.toFirstUpper»() const {
+			return isValid() ? FlatCodec::read<«typeMap.get(a.scalar.type)»>(m_data.getData() + «msg.getFlatOffset(a, enums)») : «typeMap.get(a.scalar.type)»();
+		}
+		«ENDIF»
+		«ENDIF»
+	«ENDFOR»
+
+	«msg.message.substring(msg.message.lastIndexOf('.') + 1)»::Flat «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::toFlat() const {
+		Flat f;
+		«FOR a : msg.attributes»
+			«IF a.scalar != null»
+			f.«a.scalar.name» = m_«a.scalar.name»;
+			«ENDIF»
+		«ENDFOR»
+		return f;
+	}
+
+	void «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::fromFlat(const Flat &f) {
+		«IF msg.getFlatSize(enums) == 0»
+		(void)f; // Avoid unused parameter warning.
+		«ENDIF»
+		«FOR a : msg.attributes»
+			«IF a.scalar != null»
+			m_«a.scalar.name» = f.«a.scalar.name»;
+			«ENDIF»
+		«ENDFOR»
+	}
+
+	uint32_t «/* Here, we generate the method to compute the size of the flat encoding. */msg.message.substring(msg.message.lastIndexOf('.') + 1)»::getEncodedSize() const {
+		return FLAT_SIZE;
+	}
+
+	void «/* Here, we generate the flat encoding in declaration order. */msg.message.substring(msg.message.lastIndexOf('.') + 1)»::encodeTo(ByteWriter &out) const {
+		«IF msg.getFlatSize(enums) == 0»
+		(void)out; // Avoid unused parameter warning.
+		«ENDIF»
+		«FOR a : msg.attributes»
+			«IF a.scalar != null»
+			«IF enums.containsKey(a.scalar.type)»
+			FlatCodec::write(out, static_cast<int32_t>(m_«a.scalar.name»));
+			«ELSE»
+			FlatCodec::write(out, m_«a.scalar.name»);
+			«ENDIF»
+			«ENDIF»
+		«ENDFOR»
+	}
+
+	bool «/* Here, we generate the flat decoding. */msg.message.substring(msg.message.lastIndexOf('.') + 1)»::decodeFrom(const ByteSpan &in) {
+		if (in.getLength() < FLAT_SIZE) {
+			return false;
+		}
+
+		«FOR a : msg.attributes»
+			«IF a.scalar != null»
+			«IF enums.containsKey(a.scalar.type)»
+			m_«a.scalar.name» = static_cast<«enums.get(a.scalar.type).m_enumNameIncludingMessageName.replaceAll("\\.", "::")»>(FlatCodec::read<int32_t>(in.getData() + «msg.getFlatOffset(a, enums)»));
+			«ELSE»
+			m_«a.scalar.name» = FlatCodec::read<«typeMap.get(a.scalar.type)»>(in.getData() + «msg.getFlatOffset(a, enums)»);
+			«ENDIF»
+			«ENDIF»
+		«ENDFOR»
+		return true;
+	}
+	'''
+
+	def generateAttributeEncodedSize(Attribute a, HashMap<String, EnumDescription> enums) '''
+		«IF a.scalar != null»
+			«IF enums.containsKey(a.scalar.type)»
+			size += ProtoEncoder::getSize(«a.scalar.id», static_cast<int32_t>(m_«a.scalar.name»));
+			«ELSE»
+			size += ProtoEncoder::getSize(«a.scalar.id», m_«a.scalar.name»);
+			«ENDIF»
+		«ENDIF»
+		«IF a.list != null && a.list.modifier != null && a.list.modifier.length > 0 && a.list.modifier.equalsIgnoreCase("list")»
+			size += ProtoEncoder::getSize(«a.list.id», m_listOf«a.list.name.toFirstUpper»);
+		«ENDIF»
+		«IF a.map != null && a.map.modifier != null && a.map.modifier.length > 0 && a.map.modifier.equalsIgnoreCase("map")»
+			size += ProtoEncoder::getSize(«a.map.id», m_mapOf«a.map.name.toFirstUpper»);
+		«ENDIF»
+		«IF a.fixedarray != null»
+			size += ProtoEncoder::getArraySize(«a.fixedarray.id», m_«a.fixedarray.name», getSize_«a.fixedarray.name.toFirstUpper»());
+		«ENDIF»
+	'''
+
+	def generateAttributeEncoding(Attribute a, HashMap<String, EnumDescription> enums) '''
+		«IF a.scalar != null»
+			«IF enums.containsKey(a.scalar.type)»
+			ProtoEncoder::write(out, «a.scalar.id», static_cast<int32_t>(m_«a.scalar.name»));
+			«ELSE»
+			ProtoEncoder::write(out, «a.scalar.id», m_«a.scalar.name»);
+			«ENDIF»
+		«ENDIF»
+		«IF a.list != null && a.list.modifier != null && a.list.modifier.length > 0 && a.list.modifier.equalsIgnoreCase("list")»
+			ProtoEncoder::write(out, «a.list.id», m_listOf«a.list.name.toFirstUpper»);
+		«ENDIF»
+		«IF a.map != null && a.map.modifier != null && a.map.modifier.length > 0 && a.map.modifier.equalsIgnoreCase("map")»
+			ProtoEncoder::write(out, «a.map.id», m_mapOf«a.map.name.toFirstUpper»);
+		«ENDIF»
+		«IF a.fixedarray != null»
+			ProtoEncoder::writeArray(out, «a.fixedarray.id», m_«a.fixedarray.name», getSize_«a.fixedarray.name.toFirstUpper»());
+		«ENDIF»
+	'''
+
+	/* Lists and maps are not extended but replaced by the decoded data. */
+	def generateAttributeDecodingReset(Attribute a) '''
+		«IF a.list != null && a.list.modifier != null && a.list.modifier.length > 0 && a.list.modifier.equalsIgnoreCase("list")»
+			m_listOf«a.list.name.toFirstUpper».clear();
+		«ENDIF»
+		«IF a.map != null && a.map.modifier != null && a.map.modifier.length > 0 && a.map.modifier.equalsIgnoreCase("map")»
+			m_mapOf«a.map.name.toFirstUpper».clear();
+		«ENDIF»
+	'''
+
+	def generateAttributeDecoding(Attribute a, HashMap<String, EnumDescription> enums) '''
+		«IF a.scalar != null»
+			case «a.scalar.id»:
+			«IF enums.containsKey(a.scalar.type)»
+			{
+				int32_t int32t_«a.scalar.name» = 0;
+				d.read(int32t_«a.scalar.name»);
+				m_«a.scalar.name» = static_cast<«enums.get(a.scalar.type).m_enumNameIncludingMessageName.replaceAll("\\.", "::")»>(int32t_«a.scalar.name»);
+			}
+			«ELSE»
+				d.read(m_«a.scalar.name»);
+			«ENDIF»
+			break;
+		«ENDIF»
+		«IF a.list != null && a.list.modifier != null && a.list.modifier.length > 0 && a.list.modifier.equalsIgnoreCase("list")»
+			case «a.list.id»:
+				d.read(m_listOf«a.list.name.toFirstUpper»);
+			break;
+		«ENDIF»
+		«IF a.map != null && a.map.modifier != null && a.map.modifier.length > 0 && a.map.modifier.equalsIgnoreCase("map")»
+			case «a.map.id»:
+				d.read(m_mapOf«a.map.name.toFirstUpper»);
+			break;
+		«ENDIF»
+		«IF a.fixedarray != null»
+			case «a.fixedarray.id»:
+				d.readArray(m_«a.fixedarray.name», getSize_«a.fixedarray.name.toFirstUpper»());
+			break;
+		«ENDIF»
 	'''
 
 	def generateImplementationFileConstants(Attribute a, Message msg) '''
@@ -1052,6 +1488,22 @@ namespace «s.get(i)» {
 			std::pair<std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::iterator, std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::iterator> «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::iteratorPair_ListOf«a.list.name.toFirstUpper»() {
 				return std::make_pair(m_listOf«a.list.name.toFirstUpper».begin(), m_listOf«a.list.name.toFirstUpper».end());
 			}
+
+			const std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>& «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::getConstRef_ListOf«a.list.name.toFirstUpper»() const {
+				return m_listOf«a.list.name.toFirstUpper»;
+			}
+
+			std::pair<std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::const_iterator, std::vector<«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF»>::const_iterator> «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::constIteratorPair_ListOf«a.list.name.toFirstUpper»() const {
+				return std::make_pair(m_listOf«a.list.name.toFirstUpper».begin(), m_listOf«a.list.name.toFirstUpper».end());
+			}
+
+			void «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::reserve_ListOf«a.list.name.toFirstUpper»(const uint32_t &size) {
+				m_listOf«a.list.name.toFirstUpper».reserve(size);
+			}
+
+			void «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::emplaceTo_ListOf«a.list.name.toFirstUpper»(«IF typeMap.containsKey(a.list.type)»«typeMap.get(a.list.type)»«ELSE»«a.list.type.replaceAll("\\.", "::")»«ENDIF» &&val) {
+				m_listOf«a.list.name.toFirstUpper».emplace_back(std::move(val));
+			}
 		«ENDIF»
 		«IF a.map != null && a.map.modifier != null && a.map.modifier.length > 0 && a.map.modifier.equalsIgnoreCase("map")»
 			std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»> «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::getMapOf«a.map.name.toFirstUpper»() const {
@@ -1089,6 +1541,18 @@ namespace «s.get(i)» {
 			std::pair<std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::iterator, std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::iterator> «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::iteratorPair_MapOf«a.map.name.toFirstUpper»() {
 				return std::make_pair(m_mapOf«a.map.name.toFirstUpper».begin(), m_mapOf«a.map.name.toFirstUpper».end());
 			}
+
+			const std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>& «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::getConstRef_MapOf«a.map.name.toFirstUpper»() const {
+				return m_mapOf«a.map.name.toFirstUpper»;
+			}
+
+			std::pair<std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::const_iterator, std::map<«IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF», «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF»>::const_iterator> «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::constIteratorPair_MapOf«a.map.name.toFirstUpper»() const {
+				return std::make_pair(m_mapOf«a.map.name.toFirstUpper».begin(), m_mapOf«a.map.name.toFirstUpper».end());
+			}
+
+			void «msg.message.substring(msg.message.lastIndexOf('.') + 1)»::emplaceTo_MapOf«a.map.name.toFirstUpper»(const «IF typeMap.containsKey(a.map.primaryType)»«typeMap.get(a.map.primaryType)»«ELSE»«a.map.primaryType.replaceAll("\\.", "::")»«ENDIF» &key, «IF typeMap.containsKey(a.map.secondaryType)»«typeMap.get(a.map.secondaryType)»«ELSE»«a.map.secondaryType.replaceAll("\\.", "::")»«ENDIF» &&val) {
+				m_mapOf«a.map.name.toFirstUpper»[key] = std::move(val);
+			}
 		«ENDIF»
 		«IF a.fixedarray != null»
 			«IF typeMap.containsKey(a.fixedarray.type)»
@@ -24,8 +24,10 @@ import java.io.FileNotFoundException;
 import java.io.FileWriter;
 import java.io.IOException;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.List;
 
+import org.eclipse.emf.common.util.TreeIterator;
 import org.eclipse.emf.common.util.URI;
 import org.eclipse.emf.ecore.EObject;
 import org.eclipse.emf.ecore.EStructuralFeature;
@@ -94,6 +96,42 @@ public class DataStructureGenerator {
 		}
 	}
 	
+	/**
+	 * Messages declared as [flat] are mapped to a plain struct with
+	 * a fixed memory layout; thus, only fixed size scalars, enums
+	 * declared within the same message, and constants are allowed.
+	 */
+	public static boolean hasValidFlatMessagesOnly(Resource resource, String fileName) {
+		final List<String> fixedSizeTypes = Arrays.asList("bool", "char", "int8", "uint8", "int16", "uint16", "int32", "uint32", "float", "double");
+		boolean validFlatMessagesOnly = true;
+		TreeIterator<EObject> it = resource.getAllContents();
+		while (it.hasNext()) {
+			EObject o = it.next();
+			if ( (o instanceof Message) && ((Message)o).isFlat() ) {
+				Message mes = (Message)o;
+				List<String> enumNames = new ArrayList<String>();
+				for(Attribute a : mes.getAttributes()) {
+					if (a.getEnumdec() != null) {
+						enumNames.add(a.getEnumdec().getName());
+					}
+				}
+				for(Attribute a : mes.getAttributes()) {
+					if ( (a.getEnumdec() != null) || (a.getConst() != null) ) {
+						continue;
+					}
+					ScalarDeclaration att = a.getScalar();
+					if ( (att == null) || (att.getIsPointer() != null) ||
+						 (!fixedSizeTypes.contains(att.getType()) && !enumNames.contains(att.getType())) ) {
+						System.err.println("Error while parsing '" + fileName + "': Message " + mes.getMessage().toString() + " is declared as flat but contains an attribute that is not a fixed size scalar.");
+						validFlatMessagesOnly = false;
+						break;
+					}
+				}
+			}
+		}
+		return validFlatMessagesOnly;
+	}
+	
 	public class FileSystemAccessWriter implements IFileSystemAccess {
 		@Override
 		public void generateFile(String fileName, CharSequence contents) {
@@ -771,7 +809,13 @@ public class DataStructureGenerator {
 					        uniqueNames.setHelper(helper);
 					        uniqueNames.doCheckUniqueNames(resource, CancelIndicator.NullImpl);
 					        
-					        if (uniqueNames.hasUniqueNamesOnly()) {
+					        if (!uniqueNames.hasUniqueNamesOnly()) {
+								retVal = -6; // Duplicate names found while processing the given .odvd.
+					        }
+					        else if (!DataStructureGenerator.hasValidFlatMessagesOnly(resource, file.getName())) {
+								retVal = -7; // Message declared as flat contains variable sized attributes.
+					        }
+					        else {
 						        // Setup the generator for the data structure.
 						        IGenerator dataStructureGenerator = injector.getInstance(DataModelGenerator.class);        
 						        dataStructureGenerator.doGenerate(resource, fileAccess);
@@ -790,9 +834,6 @@ public class DataStructureGenerator {
 						        // Generating the .h, .cpp, and CMakeLists.txt was successful.
 						        retVal = 0;
 					        }
-					        else {
-								retVal = -6; // Duplicate names found while processing the given .odvd.
-					        }
 			        	}
 			        	else {
 					        for(Diagnostic diagnostic : resource.getWarnings()) {
@@ -9,7 +9,11 @@
 #include <sstream>
 #include <utility>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -122,6 +126,22 @@
 	std::pair<std::vector<std::string>::iterator, std::vector<std::string>::iterator> Test10::iteratorPair_ListOfMyStringList() {
 		return std::make_pair(m_listOfMyStringList.begin(), m_listOfMyStringList.end());
 	}
+	
+	const std::vector<std::string>& Test10::getConstRef_ListOfMyStringList() const {
+		return m_listOfMyStringList;
+	}
+	
+	std::pair<std::vector<std::string>::const_iterator, std::vector<std::string>::const_iterator> Test10::constIteratorPair_ListOfMyStringList() const {
+		return std::make_pair(m_listOfMyStringList.begin(), m_listOfMyStringList.end());
+	}
+	
+	void Test10::reserve_ListOfMyStringList(const uint32_t &size) {
+		m_listOfMyStringList.reserve(size);
+	}
+	
+	void Test10::emplaceTo_ListOfMyStringList(std::string &&val) {
+		m_listOfMyStringList.emplace_back(std::move(val));
+	}
 	std::vector<Test10Point> Test10::getListOfMyPointList() const {
 		return m_listOfMyPointList;
 	}
@@ -163,6 +183,22 @@
 	std::pair<std::vector<Test10Point>::iterator, std::vector<Test10Point>::iterator> Test10::iteratorPair_ListOfMyPointList() {
 		return std::make_pair(m_listOfMyPointList.begin(), m_listOfMyPointList.end());
 	}
+	
+	const std::vector<Test10Point>& Test10::getConstRef_ListOfMyPointList() const {
+		return m_listOfMyPointList;
+	}
+	
+	std::pair<std::vector<Test10Point>::const_iterator, std::vector<Test10Point>::const_iterator> Test10::constIteratorPair_ListOfMyPointList() const {
+		return std::make_pair(m_listOfMyPointList.begin(), m_listOfMyPointList.end());
+	}
+	
+	void Test10::reserve_ListOfMyPointList(const uint32_t &size) {
+		m_listOfMyPointList.reserve(size);
+	}
+	
+	void Test10::emplaceTo_ListOfMyPointList(Test10Point &&val) {
+		m_listOfMyPointList.emplace_back(std::move(val));
+	}
 	std::map<int32_t, std::string> Test10::getMapOfMyIntStringMap() const {
 		return m_mapOfMyIntStringMap;
 	}
@@ -198,6 +234,18 @@
 	std::pair<std::map<int32_t, std::string>::iterator, std::map<int32_t, std::string>::iterator> Test10::iteratorPair_MapOfMyIntStringMap() {
 		return std::make_pair(m_mapOfMyIntStringMap.begin(), m_mapOfMyIntStringMap.end());
 	}
+	
+	const std::map<int32_t, std::string>& Test10::getConstRef_MapOfMyIntStringMap() const {
+		return m_mapOfMyIntStringMap;
+	}
+	
+	std::pair<std::map<int32_t, std::string>::const_iterator, std::map<int32_t, std::string>::const_iterator> Test10::constIteratorPair_MapOfMyIntStringMap() const {
+		return std::make_pair(m_mapOfMyIntStringMap.begin(), m_mapOfMyIntStringMap.end());
+	}
+	
+	void Test10::emplaceTo_MapOfMyIntStringMap(const int32_t &key, std::string &&val) {
+		m_mapOfMyIntStringMap[key] = std::move(val);
+	}
 	std::map<int32_t, Test10Point> Test10::getMapOfMyIntPointMap() const {
 		return m_mapOfMyIntPointMap;
 	}
@@ -233,6 +281,18 @@
 	std::pair<std::map<int32_t, Test10Point>::iterator, std::map<int32_t, Test10Point>::iterator> Test10::iteratorPair_MapOfMyIntPointMap() {
 		return std::make_pair(m_mapOfMyIntPointMap.begin(), m_mapOfMyIntPointMap.end());
 	}
+	
+	const std::map<int32_t, Test10Point>& Test10::getConstRef_MapOfMyIntPointMap() const {
+		return m_mapOfMyIntPointMap;
+	}
+	
+	std::pair<std::map<int32_t, Test10Point>::const_iterator, std::map<int32_t, Test10Point>::const_iterator> Test10::constIteratorPair_MapOfMyIntPointMap() const {
+		return std::make_pair(m_mapOfMyIntPointMap.begin(), m_mapOfMyIntPointMap.end());
+	}
+	
+	void Test10::emplaceTo_MapOfMyIntPointMap(const int32_t &key, Test10Point &&val) {
+		m_mapOfMyIntPointMap[key] = std::move(val);
+	}
 
 	void Test10::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -253,6 +313,11 @@
 	ostream& Test10::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		// Store elements from m_listOfMyStringList into a string.
@@ -333,6 +398,11 @@
 	istream& Test10::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into m_listOfMyStringList.
@@ -437,3 +507,46 @@
 		}
 		return in;
 	}
+
+	uint32_t Test10::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_listOfMyStringList);
+		size += ProtoEncoder::getSize(2, m_listOfMyPointList);
+		size += ProtoEncoder::getSize(3, m_mapOfMyIntStringMap);
+		size += ProtoEncoder::getSize(4, m_mapOfMyIntPointMap);
+		return size;
+	}
+
+	void Test10::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_listOfMyStringList);
+		ProtoEncoder::write(out, 2, m_listOfMyPointList);
+		ProtoEncoder::write(out, 3, m_mapOfMyIntStringMap);
+		ProtoEncoder::write(out, 4, m_mapOfMyIntPointMap);
+	}
+
+	bool Test10::decodeFrom(const ByteSpan &in) {
+		m_listOfMyStringList.clear();
+		m_listOfMyPointList.clear();
+		m_mapOfMyIntStringMap.clear();
+		m_mapOfMyIntPointMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_listOfMyStringList);
+				break;
+				case 2:
+					d.read(m_listOfMyPointList);
+				break;
+				case 3:
+					d.read(m_mapOfMyIntStringMap);
+				break;
+				case 4:
+					d.read(m_mapOfMyIntPointMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
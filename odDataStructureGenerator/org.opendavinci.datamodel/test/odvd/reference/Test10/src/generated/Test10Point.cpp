@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -108,6 +112,11 @@
 	ostream& Test10Point::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		s->write(1,
@@ -120,6 +129,11 @@
 	istream& Test10Point::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		d->read(1,
@@ -128,3 +142,32 @@
 				m_y);
 		return in;
 	}
+
+	uint32_t Test10Point::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_x);
+		size += ProtoEncoder::getSize(2, m_y);
+		return size;
+	}
+
+	void Test10Point::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_x);
+		ProtoEncoder::write(out, 2, m_y);
+	}
+
+	bool Test10Point::decodeFrom(const ByteSpan &in) {
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_x);
+				break;
+				case 2:
+					d.read(m_y);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
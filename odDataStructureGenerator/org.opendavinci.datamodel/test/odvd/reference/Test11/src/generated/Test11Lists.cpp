@@ -9,7 +9,11 @@
 #include <sstream>
 #include <utility>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -137,6 +141,22 @@
 	std::pair<std::vector<bool>::iterator, std::vector<bool>::iterator> Test11Lists::iteratorPair_ListOfMyBoolList() {
 		return std::make_pair(m_listOfMyBoolList.begin(), m_listOfMyBoolList.end());
 	}
+	
+	const std::vector<bool>& Test11Lists::getConstRef_ListOfMyBoolList() const {
+		return m_listOfMyBoolList;
+	}
+	
+	std::pair<std::vector<bool>::const_iterator, std::vector<bool>::const_iterator> Test11Lists::constIteratorPair_ListOfMyBoolList() const {
+		return std::make_pair(m_listOfMyBoolList.begin(), m_listOfMyBoolList.end());
+	}
+	
+	void Test11Lists::reserve_ListOfMyBoolList(const uint32_t &size) {
+		m_listOfMyBoolList.reserve(size);
+	}
+	
+	void Test11Lists::emplaceTo_ListOfMyBoolList(bool &&val) {
+		m_listOfMyBoolList.emplace_back(std::move(val));
+	}
 	std::vector<char> Test11Lists::getListOfMyCharList() const {
 		return m_listOfMyCharList;
 	}
@@ -172,6 +192,22 @@
 	std::pair<std::vector<char>::iterator, std::vector<char>::iterator> Test11Lists::iteratorPair_ListOfMyCharList() {
 		return std::make_pair(m_listOfMyCharList.begin(), m_listOfMyCharList.end());
 	}
+	
+	const std::vector<char>& Test11Lists::getConstRef_ListOfMyCharList() const {
+		return m_listOfMyCharList;
+	}
+	
+	std::pair<std::vector<char>::const_iterator, std::vector<char>::const_iterator> Test11Lists::constIteratorPair_ListOfMyCharList() const {
+		return std::make_pair(m_listOfMyCharList.begin(), m_listOfMyCharList.end());
+	}
+	
+	void Test11Lists::reserve_ListOfMyCharList(const uint32_t &size) {
+		m_listOfMyCharList.reserve(size);
+	}
+	
+	void Test11Lists::emplaceTo_ListOfMyCharList(char &&val) {
+		m_listOfMyCharList.emplace_back(std::move(val));
+	}
 	std::vector<int32_t> Test11Lists::getListOfMyInt32List() const {
 		return m_listOfMyInt32List;
 	}
@@ -207,6 +243,22 @@
 	std::pair<std::vector<int32_t>::iterator, std::vector<int32_t>::iterator> Test11Lists::iteratorPair_ListOfMyInt32List() {
 		return std::make_pair(m_listOfMyInt32List.begin(), m_listOfMyInt32List.end());
 	}
+	
+	const std::vector<int32_t>& Test11Lists::getConstRef_ListOfMyInt32List() const {
+		return m_listOfMyInt32List;
+	}
+	
+	std::pair<std::vector<int32_t>::const_iterator, std::vector<int32_t>::const_iterator> Test11Lists::constIteratorPair_ListOfMyInt32List() const {
+		return std::make_pair(m_listOfMyInt32List.begin(), m_listOfMyInt32List.end());
+	}
+	
+	void Test11Lists::reserve_ListOfMyInt32List(const uint32_t &size) {
+		m_listOfMyInt32List.reserve(size);
+	}
+	
+	void Test11Lists::emplaceTo_ListOfMyInt32List(int32_t &&val) {
+		m_listOfMyInt32List.emplace_back(std::move(val));
+	}
 	std::vector<uint32_t> Test11Lists::getListOfMyUint32List() const {
 		return m_listOfMyUint32List;
 	}
@@ -242,6 +294,22 @@
 	std::pair<std::vector<uint32_t>::iterator, std::vector<uint32_t>::iterator> Test11Lists::iteratorPair_ListOfMyUint32List() {
 		return std::make_pair(m_listOfMyUint32List.begin(), m_listOfMyUint32List.end());
 	}
+	
+	const std::vector<uint32_t>& Test11Lists::getConstRef_ListOfMyUint32List() const {
+		return m_listOfMyUint32List;
+	}
+	
+	std::pair<std::vector<uint32_t>::const_iterator, std::vector<uint32_t>::const_iterator> Test11Lists::constIteratorPair_ListOfMyUint32List() const {
+		return std::make_pair(m_listOfMyUint32List.begin(), m_listOfMyUint32List.end());
+	}
+	
+	void Test11Lists::reserve_ListOfMyUint32List(const uint32_t &size) {
+		m_listOfMyUint32List.reserve(size);
+	}
+	
+	void Test11Lists::emplaceTo_ListOfMyUint32List(uint32_t &&val) {
+		m_listOfMyUint32List.emplace_back(std::move(val));
+	}
 	std::vector<float> Test11Lists::getListOfMyFloatList() const {
 		return m_listOfMyFloatList;
 	}
@@ -277,6 +345,22 @@
 	std::pair<std::vector<float>::iterator, std::vector<float>::iterator> Test11Lists::iteratorPair_ListOfMyFloatList() {
 		return std::make_pair(m_listOfMyFloatList.begin(), m_listOfMyFloatList.end());
 	}
+	
+	const std::vector<float>& Test11Lists::getConstRef_ListOfMyFloatList() const {
+		return m_listOfMyFloatList;
+	}
+	
+	std::pair<std::vector<float>::const_iterator, std::vector<float>::const_iterator> Test11Lists::constIteratorPair_ListOfMyFloatList() const {
+		return std::make_pair(m_listOfMyFloatList.begin(), m_listOfMyFloatList.end());
+	}
+	
+	void Test11Lists::reserve_ListOfMyFloatList(const uint32_t &size) {
+		m_listOfMyFloatList.reserve(size);
+	}
+	
+	void Test11Lists::emplaceTo_ListOfMyFloatList(float &&val) {
+		m_listOfMyFloatList.emplace_back(std::move(val));
+	}
 	std::vector<double> Test11Lists::getListOfMyDoubleList() const {
 		return m_listOfMyDoubleList;
 	}
@@ -312,6 +396,22 @@
 	std::pair<std::vector<double>::iterator, std::vector<double>::iterator> Test11Lists::iteratorPair_ListOfMyDoubleList() {
 		return std::make_pair(m_listOfMyDoubleList.begin(), m_listOfMyDoubleList.end());
 	}
+	
+	const std::vector<double>& Test11Lists::getConstRef_ListOfMyDoubleList() const {
+		return m_listOfMyDoubleList;
+	}
+	
+	std::pair<std::vector<double>::const_iterator, std::vector<double>::const_iterator> Test11Lists::constIteratorPair_ListOfMyDoubleList() const {
+		return std::make_pair(m_listOfMyDoubleList.begin(), m_listOfMyDoubleList.end());
+	}
+	
+	void Test11Lists::reserve_ListOfMyDoubleList(const uint32_t &size) {
+		m_listOfMyDoubleList.reserve(size);
+	}
+	
+	void Test11Lists::emplaceTo_ListOfMyDoubleList(double &&val) {
+		m_listOfMyDoubleList.emplace_back(std::move(val));
+	}
 	std::vector<std::string> Test11Lists::getListOfMyStringList() const {
 		return m_listOfMyStringList;
 	}
@@ -347,6 +447,22 @@
 	std::pair<std::vector<std::string>::iterator, std::vector<std::string>::iterator> Test11Lists::iteratorPair_ListOfMyStringList() {
 		return std::make_pair(m_listOfMyStringList.begin(), m_listOfMyStringList.end());
 	}
+	
+	const std::vector<std::string>& Test11Lists::getConstRef_ListOfMyStringList() const {
+		return m_listOfMyStringList;
+	}
+	
+	std::pair<std::vector<std::string>::const_iterator, std::vector<std::string>::const_iterator> Test11Lists::constIteratorPair_ListOfMyStringList() const {
+		return std::make_pair(m_listOfMyStringList.begin(), m_listOfMyStringList.end());
+	}
+	
+	void Test11Lists::reserve_ListOfMyStringList(const uint32_t &size) {
+		m_listOfMyStringList.reserve(size);
+	}
+	
+	void Test11Lists::emplaceTo_ListOfMyStringList(std::string &&val) {
+		m_listOfMyStringList.emplace_back(std::move(val));
+	}
 
 	void Test11Lists::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -370,6 +486,11 @@
 	ostream& Test11Lists::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		// Store elements from m_listOfMyBoolList into a string.
@@ -462,6 +583,11 @@
 	istream& Test11Lists::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into m_listOfMyBoolList.
@@ -578,3 +704,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test11Lists::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_listOfMyBoolList);
+		size += ProtoEncoder::getSize(2, m_listOfMyCharList);
+		size += ProtoEncoder::getSize(3, m_listOfMyInt32List);
+		size += ProtoEncoder::getSize(4, m_listOfMyUint32List);
+		size += ProtoEncoder::getSize(5, m_listOfMyFloatList);
+		size += ProtoEncoder::getSize(6, m_listOfMyDoubleList);
+		size += ProtoEncoder::getSize(7, m_listOfMyStringList);
+		return size;
+	}
+
+	void Test11Lists::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_listOfMyBoolList);
+		ProtoEncoder::write(out, 2, m_listOfMyCharList);
+		ProtoEncoder::write(out, 3, m_listOfMyInt32List);
+		ProtoEncoder::write(out, 4, m_listOfMyUint32List);
+		ProtoEncoder::write(out, 5, m_listOfMyFloatList);
+		ProtoEncoder::write(out, 6, m_listOfMyDoubleList);
+		ProtoEncoder::write(out, 7, m_listOfMyStringList);
+	}
+
+	bool Test11Lists::decodeFrom(const ByteSpan &in) {
+		m_listOfMyBoolList.clear();
+		m_listOfMyCharList.clear();
+		m_listOfMyInt32List.clear();
+		m_listOfMyUint32List.clear();
+		m_listOfMyFloatList.clear();
+		m_listOfMyDoubleList.clear();
+		m_listOfMyStringList.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_listOfMyBoolList);
+				break;
+				case 2:
+					d.read(m_listOfMyCharList);
+				break;
+				case 3:
+					d.read(m_listOfMyInt32List);
+				break;
+				case 4:
+					d.read(m_listOfMyUint32List);
+				break;
+				case 5:
+					d.read(m_listOfMyFloatList);
+				break;
+				case 6:
+					d.read(m_listOfMyDoubleList);
+				break;
+				case 7:
+					d.read(m_listOfMyStringList);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -134,6 +138,18 @@
 	std::pair<std::map<bool, bool>::iterator, std::map<bool, bool>::iterator> Test11MapBool::iteratorPair_MapOfMyBoolBoolMap() {
 		return std::make_pair(m_mapOfMyBoolBoolMap.begin(), m_mapOfMyBoolBoolMap.end());
 	}
+	
+	const std::map<bool, bool>& Test11MapBool::getConstRef_MapOfMyBoolBoolMap() const {
+		return m_mapOfMyBoolBoolMap;
+	}
+	
+	std::pair<std::map<bool, bool>::const_iterator, std::map<bool, bool>::const_iterator> Test11MapBool::constIteratorPair_MapOfMyBoolBoolMap() const {
+		return std::make_pair(m_mapOfMyBoolBoolMap.begin(), m_mapOfMyBoolBoolMap.end());
+	}
+	
+	void Test11MapBool::emplaceTo_MapOfMyBoolBoolMap(const bool &key, bool &&val) {
+		m_mapOfMyBoolBoolMap[key] = std::move(val);
+	}
 	std::map<bool, char> Test11MapBool::getMapOfMyBoolCharMap() const {
 		return m_mapOfMyBoolCharMap;
 	}
@@ -169,6 +185,18 @@
 	std::pair<std::map<bool, char>::iterator, std::map<bool, char>::iterator> Test11MapBool::iteratorPair_MapOfMyBoolCharMap() {
 		return std::make_pair(m_mapOfMyBoolCharMap.begin(), m_mapOfMyBoolCharMap.end());
 	}
+	
+	const std::map<bool, char>& Test11MapBool::getConstRef_MapOfMyBoolCharMap() const {
+		return m_mapOfMyBoolCharMap;
+	}
+	
+	std::pair<std::map<bool, char>::const_iterator, std::map<bool, char>::const_iterator> Test11MapBool::constIteratorPair_MapOfMyBoolCharMap() const {
+		return std::make_pair(m_mapOfMyBoolCharMap.begin(), m_mapOfMyBoolCharMap.end());
+	}
+	
+	void Test11MapBool::emplaceTo_MapOfMyBoolCharMap(const bool &key, char &&val) {
+		m_mapOfMyBoolCharMap[key] = std::move(val);
+	}
 	std::map<bool, int32_t> Test11MapBool::getMapOfMyBoolInt32Map() const {
 		return m_mapOfMyBoolInt32Map;
 	}
@@ -204,6 +232,18 @@
 	std::pair<std::map<bool, int32_t>::iterator, std::map<bool, int32_t>::iterator> Test11MapBool::iteratorPair_MapOfMyBoolInt32Map() {
 		return std::make_pair(m_mapOfMyBoolInt32Map.begin(), m_mapOfMyBoolInt32Map.end());
 	}
+	
+	const std::map<bool, int32_t>& Test11MapBool::getConstRef_MapOfMyBoolInt32Map() const {
+		return m_mapOfMyBoolInt32Map;
+	}
+	
+	std::pair<std::map<bool, int32_t>::const_iterator, std::map<bool, int32_t>::const_iterator> Test11MapBool::constIteratorPair_MapOfMyBoolInt32Map() const {
+		return std::make_pair(m_mapOfMyBoolInt32Map.begin(), m_mapOfMyBoolInt32Map.end());
+	}
+	
+	void Test11MapBool::emplaceTo_MapOfMyBoolInt32Map(const bool &key, int32_t &&val) {
+		m_mapOfMyBoolInt32Map[key] = std::move(val);
+	}
 	std::map<bool, uint32_t> Test11MapBool::getMapOfMyBoolUint32Map() const {
 		return m_mapOfMyBoolUint32Map;
 	}
@@ -239,6 +279,18 @@
 	std::pair<std::map<bool, uint32_t>::iterator, std::map<bool, uint32_t>::iterator> Test11MapBool::iteratorPair_MapOfMyBoolUint32Map() {
 		return std::make_pair(m_mapOfMyBoolUint32Map.begin(), m_mapOfMyBoolUint32Map.end());
 	}
+	
+	const std::map<bool, uint32_t>& Test11MapBool::getConstRef_MapOfMyBoolUint32Map() const {
+		return m_mapOfMyBoolUint32Map;
+	}
+	
+	std::pair<std::map<bool, uint32_t>::const_iterator, std::map<bool, uint32_t>::const_iterator> Test11MapBool::constIteratorPair_MapOfMyBoolUint32Map() const {
+		return std::make_pair(m_mapOfMyBoolUint32Map.begin(), m_mapOfMyBoolUint32Map.end());
+	}
+	
+	void Test11MapBool::emplaceTo_MapOfMyBoolUint32Map(const bool &key, uint32_t &&val) {
+		m_mapOfMyBoolUint32Map[key] = std::move(val);
+	}
 	std::map<bool, float> Test11MapBool::getMapOfMyBoolFloatMap() const {
 		return m_mapOfMyBoolFloatMap;
 	}
@@ -274,6 +326,18 @@
 	std::pair<std::map<bool, float>::iterator, std::map<bool, float>::iterator> Test11MapBool::iteratorPair_MapOfMyBoolFloatMap() {
 		return std::make_pair(m_mapOfMyBoolFloatMap.begin(), m_mapOfMyBoolFloatMap.end());
 	}
+	
+	const std::map<bool, float>& Test11MapBool::getConstRef_MapOfMyBoolFloatMap() const {
+		return m_mapOfMyBoolFloatMap;
+	}
+	
+	std::pair<std::map<bool, float>::const_iterator, std::map<bool, float>::const_iterator> Test11MapBool::constIteratorPair_MapOfMyBoolFloatMap() const {
+		return std::make_pair(m_mapOfMyBoolFloatMap.begin(), m_mapOfMyBoolFloatMap.end());
+	}
+	
+	void Test11MapBool::emplaceTo_MapOfMyBoolFloatMap(const bool &key, float &&val) {
+		m_mapOfMyBoolFloatMap[key] = std::move(val);
+	}
 	std::map<bool, double> Test11MapBool::getMapOfMyBoolDoubleMap() const {
 		return m_mapOfMyBoolDoubleMap;
 	}
@@ -309,6 +373,18 @@
 	std::pair<std::map<bool, double>::iterator, std::map<bool, double>::iterator> Test11MapBool::iteratorPair_MapOfMyBoolDoubleMap() {
 		return std::make_pair(m_mapOfMyBoolDoubleMap.begin(), m_mapOfMyBoolDoubleMap.end());
 	}
+	
+	const std::map<bool, double>& Test11MapBool::getConstRef_MapOfMyBoolDoubleMap() const {
+		return m_mapOfMyBoolDoubleMap;
+	}
+	
+	std::pair<std::map<bool, double>::const_iterator, std::map<bool, double>::const_iterator> Test11MapBool::constIteratorPair_MapOfMyBoolDoubleMap() const {
+		return std::make_pair(m_mapOfMyBoolDoubleMap.begin(), m_mapOfMyBoolDoubleMap.end());
+	}
+	
+	void Test11MapBool::emplaceTo_MapOfMyBoolDoubleMap(const bool &key, double &&val) {
+		m_mapOfMyBoolDoubleMap[key] = std::move(val);
+	}
 	std::map<bool, std::string> Test11MapBool::getMapOfMyBoolStringMap() const {
 		return m_mapOfMyBoolStringMap;
 	}
@@ -344,6 +420,18 @@
 	std::pair<std::map<bool, std::string>::iterator, std::map<bool, std::string>::iterator> Test11MapBool::iteratorPair_MapOfMyBoolStringMap() {
 		return std::make_pair(m_mapOfMyBoolStringMap.begin(), m_mapOfMyBoolStringMap.end());
 	}
+	
+	const std::map<bool, std::string>& Test11MapBool::getConstRef_MapOfMyBoolStringMap() const {
+		return m_mapOfMyBoolStringMap;
+	}
+	
+	std::pair<std::map<bool, std::string>::const_iterator, std::map<bool, std::string>::const_iterator> Test11MapBool::constIteratorPair_MapOfMyBoolStringMap() const {
+		return std::make_pair(m_mapOfMyBoolStringMap.begin(), m_mapOfMyBoolStringMap.end());
+	}
+	
+	void Test11MapBool::emplaceTo_MapOfMyBoolStringMap(const bool &key, std::string &&val) {
+		m_mapOfMyBoolStringMap[key] = std::move(val);
+	}
 
 	void Test11MapBool::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -367,6 +455,11 @@
 	ostream& Test11MapBool::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		{
@@ -543,6 +636,11 @@
 	istream& Test11MapBool::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into MyBoolBoolMap.
@@ -785,3 +883,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test11MapBool::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_mapOfMyBoolBoolMap);
+		size += ProtoEncoder::getSize(2, m_mapOfMyBoolCharMap);
+		size += ProtoEncoder::getSize(3, m_mapOfMyBoolInt32Map);
+		size += ProtoEncoder::getSize(4, m_mapOfMyBoolUint32Map);
+		size += ProtoEncoder::getSize(5, m_mapOfMyBoolFloatMap);
+		size += ProtoEncoder::getSize(6, m_mapOfMyBoolDoubleMap);
+		size += ProtoEncoder::getSize(7, m_mapOfMyBoolStringMap);
+		return size;
+	}
+
+	void Test11MapBool::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_mapOfMyBoolBoolMap);
+		ProtoEncoder::write(out, 2, m_mapOfMyBoolCharMap);
+		ProtoEncoder::write(out, 3, m_mapOfMyBoolInt32Map);
+		ProtoEncoder::write(out, 4, m_mapOfMyBoolUint32Map);
+		ProtoEncoder::write(out, 5, m_mapOfMyBoolFloatMap);
+		ProtoEncoder::write(out, 6, m_mapOfMyBoolDoubleMap);
+		ProtoEncoder::write(out, 7, m_mapOfMyBoolStringMap);
+	}
+
+	bool Test11MapBool::decodeFrom(const ByteSpan &in) {
+		m_mapOfMyBoolBoolMap.clear();
+		m_mapOfMyBoolCharMap.clear();
+		m_mapOfMyBoolInt32Map.clear();
+		m_mapOfMyBoolUint32Map.clear();
+		m_mapOfMyBoolFloatMap.clear();
+		m_mapOfMyBoolDoubleMap.clear();
+		m_mapOfMyBoolStringMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_mapOfMyBoolBoolMap);
+				break;
+				case 2:
+					d.read(m_mapOfMyBoolCharMap);
+				break;
+				case 3:
+					d.read(m_mapOfMyBoolInt32Map);
+				break;
+				case 4:
+					d.read(m_mapOfMyBoolUint32Map);
+				break;
+				case 5:
+					d.read(m_mapOfMyBoolFloatMap);
+				break;
+				case 6:
+					d.read(m_mapOfMyBoolDoubleMap);
+				break;
+				case 7:
+					d.read(m_mapOfMyBoolStringMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -134,6 +138,18 @@
 	std::pair<std::map<char, bool>::iterator, std::map<char, bool>::iterator> Test12MapChar::iteratorPair_MapOfMyCharBoolMap() {
 		return std::make_pair(m_mapOfMyCharBoolMap.begin(), m_mapOfMyCharBoolMap.end());
 	}
+	
+	const std::map<char, bool>& Test12MapChar::getConstRef_MapOfMyCharBoolMap() const {
+		return m_mapOfMyCharBoolMap;
+	}
+	
+	std::pair<std::map<char, bool>::const_iterator, std::map<char, bool>::const_iterator> Test12MapChar::constIteratorPair_MapOfMyCharBoolMap() const {
+		return std::make_pair(m_mapOfMyCharBoolMap.begin(), m_mapOfMyCharBoolMap.end());
+	}
+	
+	void Test12MapChar::emplaceTo_MapOfMyCharBoolMap(const char &key, bool &&val) {
+		m_mapOfMyCharBoolMap[key] = std::move(val);
+	}
 	std::map<char, char> Test12MapChar::getMapOfMyCharCharMap() const {
 		return m_mapOfMyCharCharMap;
 	}
@@ -169,6 +185,18 @@
 	std::pair<std::map<char, char>::iterator, std::map<char, char>::iterator> Test12MapChar::iteratorPair_MapOfMyCharCharMap() {
 		return std::make_pair(m_mapOfMyCharCharMap.begin(), m_mapOfMyCharCharMap.end());
 	}
+	
+	const std::map<char, char>& Test12MapChar::getConstRef_MapOfMyCharCharMap() const {
+		return m_mapOfMyCharCharMap;
+	}
+	
+	std::pair<std::map<char, char>::const_iterator, std::map<char, char>::const_iterator> Test12MapChar::constIteratorPair_MapOfMyCharCharMap() const {
+		return std::make_pair(m_mapOfMyCharCharMap.begin(), m_mapOfMyCharCharMap.end());
+	}
+	
+	void Test12MapChar::emplaceTo_MapOfMyCharCharMap(const char &key, char &&val) {
+		m_mapOfMyCharCharMap[key] = std::move(val);
+	}
 	std::map<char, int32_t> Test12MapChar::getMapOfMyCharInt32Map() const {
 		return m_mapOfMyCharInt32Map;
 	}
@@ -204,6 +232,18 @@
 	std::pair<std::map<char, int32_t>::iterator, std::map<char, int32_t>::iterator> Test12MapChar::iteratorPair_MapOfMyCharInt32Map() {
 		return std::make_pair(m_mapOfMyCharInt32Map.begin(), m_mapOfMyCharInt32Map.end());
 	}
+	
+	const std::map<char, int32_t>& Test12MapChar::getConstRef_MapOfMyCharInt32Map() const {
+		return m_mapOfMyCharInt32Map;
+	}
+	
+	std::pair<std::map<char, int32_t>::const_iterator, std::map<char, int32_t>::const_iterator> Test12MapChar::constIteratorPair_MapOfMyCharInt32Map() const {
+		return std::make_pair(m_mapOfMyCharInt32Map.begin(), m_mapOfMyCharInt32Map.end());
+	}
+	
+	void Test12MapChar::emplaceTo_MapOfMyCharInt32Map(const char &key, int32_t &&val) {
+		m_mapOfMyCharInt32Map[key] = std::move(val);
+	}
 	std::map<char, uint32_t> Test12MapChar::getMapOfMyCharUint32Map() const {
 		return m_mapOfMyCharUint32Map;
 	}
@@ -239,6 +279,18 @@
 	std::pair<std::map<char, uint32_t>::iterator, std::map<char, uint32_t>::iterator> Test12MapChar::iteratorPair_MapOfMyCharUint32Map() {
 		return std::make_pair(m_mapOfMyCharUint32Map.begin(), m_mapOfMyCharUint32Map.end());
 	}
+	
+	const std::map<char, uint32_t>& Test12MapChar::getConstRef_MapOfMyCharUint32Map() const {
+		return m_mapOfMyCharUint32Map;
+	}
+	
+	std::pair<std::map<char, uint32_t>::const_iterator, std::map<char, uint32_t>::const_iterator> Test12MapChar::constIteratorPair_MapOfMyCharUint32Map() const {
+		return std::make_pair(m_mapOfMyCharUint32Map.begin(), m_mapOfMyCharUint32Map.end());
+	}
+	
+	void Test12MapChar::emplaceTo_MapOfMyCharUint32Map(const char &key, uint32_t &&val) {
+		m_mapOfMyCharUint32Map[key] = std::move(val);
+	}
 	std::map<char, float> Test12MapChar::getMapOfMyCharFloatMap() const {
 		return m_mapOfMyCharFloatMap;
 	}
@@ -274,6 +326,18 @@
 	std::pair<std::map<char, float>::iterator, std::map<char, float>::iterator> Test12MapChar::iteratorPair_MapOfMyCharFloatMap() {
 		return std::make_pair(m_mapOfMyCharFloatMap.begin(), m_mapOfMyCharFloatMap.end());
 	}
+	
+	const std::map<char, float>& Test12MapChar::getConstRef_MapOfMyCharFloatMap() const {
+		return m_mapOfMyCharFloatMap;
+	}
+	
+	std::pair<std::map<char, float>::const_iterator, std::map<char, float>::const_iterator> Test12MapChar::constIteratorPair_MapOfMyCharFloatMap() const {
+		return std::make_pair(m_mapOfMyCharFloatMap.begin(), m_mapOfMyCharFloatMap.end());
+	}
+	
+	void Test12MapChar::emplaceTo_MapOfMyCharFloatMap(const char &key, float &&val) {
+		m_mapOfMyCharFloatMap[key] = std::move(val);
+	}
 	std::map<char, double> Test12MapChar::getMapOfMyCharDoubleMap() const {
 		return m_mapOfMyCharDoubleMap;
 	}
@@ -309,6 +373,18 @@
 	std::pair<std::map<char, double>::iterator, std::map<char, double>::iterator> Test12MapChar::iteratorPair_MapOfMyCharDoubleMap() {
 		return std::make_pair(m_mapOfMyCharDoubleMap.begin(), m_mapOfMyCharDoubleMap.end());
 	}
+	
+	const std::map<char, double>& Test12MapChar::getConstRef_MapOfMyCharDoubleMap() const {
+		return m_mapOfMyCharDoubleMap;
+	}
+	
+	std::pair<std::map<char, double>::const_iterator, std::map<char, double>::const_iterator> Test12MapChar::constIteratorPair_MapOfMyCharDoubleMap() const {
+		return std::make_pair(m_mapOfMyCharDoubleMap.begin(), m_mapOfMyCharDoubleMap.end());
+	}
+	
+	void Test12MapChar::emplaceTo_MapOfMyCharDoubleMap(const char &key, double &&val) {
+		m_mapOfMyCharDoubleMap[key] = std::move(val);
+	}
 	std::map<char, std::string> Test12MapChar::getMapOfMyCharStringMap() const {
 		return m_mapOfMyCharStringMap;
 	}
@@ -344,6 +420,18 @@
 	std::pair<std::map<char, std::string>::iterator, std::map<char, std::string>::iterator> Test12MapChar::iteratorPair_MapOfMyCharStringMap() {
 		return std::make_pair(m_mapOfMyCharStringMap.begin(), m_mapOfMyCharStringMap.end());
 	}
+	
+	const std::map<char, std::string>& Test12MapChar::getConstRef_MapOfMyCharStringMap() const {
+		return m_mapOfMyCharStringMap;
+	}
+	
+	std::pair<std::map<char, std::string>::const_iterator, std::map<char, std::string>::const_iterator> Test12MapChar::constIteratorPair_MapOfMyCharStringMap() const {
+		return std::make_pair(m_mapOfMyCharStringMap.begin(), m_mapOfMyCharStringMap.end());
+	}
+	
+	void Test12MapChar::emplaceTo_MapOfMyCharStringMap(const char &key, std::string &&val) {
+		m_mapOfMyCharStringMap[key] = std::move(val);
+	}
 
 	void Test12MapChar::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -367,6 +455,11 @@
 	ostream& Test12MapChar::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		{
@@ -543,6 +636,11 @@
 	istream& Test12MapChar::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into MyCharBoolMap.
@@ -785,3 +883,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test12MapChar::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_mapOfMyCharBoolMap);
+		size += ProtoEncoder::getSize(2, m_mapOfMyCharCharMap);
+		size += ProtoEncoder::getSize(3, m_mapOfMyCharInt32Map);
+		size += ProtoEncoder::getSize(4, m_mapOfMyCharUint32Map);
+		size += ProtoEncoder::getSize(5, m_mapOfMyCharFloatMap);
+		size += ProtoEncoder::getSize(6, m_mapOfMyCharDoubleMap);
+		size += ProtoEncoder::getSize(7, m_mapOfMyCharStringMap);
+		return size;
+	}
+
+	void Test12MapChar::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_mapOfMyCharBoolMap);
+		ProtoEncoder::write(out, 2, m_mapOfMyCharCharMap);
+		ProtoEncoder::write(out, 3, m_mapOfMyCharInt32Map);
+		ProtoEncoder::write(out, 4, m_mapOfMyCharUint32Map);
+		ProtoEncoder::write(out, 5, m_mapOfMyCharFloatMap);
+		ProtoEncoder::write(out, 6, m_mapOfMyCharDoubleMap);
+		ProtoEncoder::write(out, 7, m_mapOfMyCharStringMap);
+	}
+
+	bool Test12MapChar::decodeFrom(const ByteSpan &in) {
+		m_mapOfMyCharBoolMap.clear();
+		m_mapOfMyCharCharMap.clear();
+		m_mapOfMyCharInt32Map.clear();
+		m_mapOfMyCharUint32Map.clear();
+		m_mapOfMyCharFloatMap.clear();
+		m_mapOfMyCharDoubleMap.clear();
+		m_mapOfMyCharStringMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_mapOfMyCharBoolMap);
+				break;
+				case 2:
+					d.read(m_mapOfMyCharCharMap);
+				break;
+				case 3:
+					d.read(m_mapOfMyCharInt32Map);
+				break;
+				case 4:
+					d.read(m_mapOfMyCharUint32Map);
+				break;
+				case 5:
+					d.read(m_mapOfMyCharFloatMap);
+				break;
+				case 6:
+					d.read(m_mapOfMyCharDoubleMap);
+				break;
+				case 7:
+					d.read(m_mapOfMyCharStringMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
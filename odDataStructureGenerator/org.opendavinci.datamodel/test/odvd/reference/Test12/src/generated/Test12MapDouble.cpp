@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -134,6 +138,18 @@
 	std::pair<std::map<double, bool>::iterator, std::map<double, bool>::iterator> Test12MapDouble::iteratorPair_MapOfMyDoubleBoolMap() {
 		return std::make_pair(m_mapOfMyDoubleBoolMap.begin(), m_mapOfMyDoubleBoolMap.end());
 	}
+	
+	const std::map<double, bool>& Test12MapDouble::getConstRef_MapOfMyDoubleBoolMap() const {
+		return m_mapOfMyDoubleBoolMap;
+	}
+	
+	std::pair<std::map<double, bool>::const_iterator, std::map<double, bool>::const_iterator> Test12MapDouble::constIteratorPair_MapOfMyDoubleBoolMap() const {
+		return std::make_pair(m_mapOfMyDoubleBoolMap.begin(), m_mapOfMyDoubleBoolMap.end());
+	}
+	
+	void Test12MapDouble::emplaceTo_MapOfMyDoubleBoolMap(const double &key, bool &&val) {
+		m_mapOfMyDoubleBoolMap[key] = std::move(val);
+	}
 	std::map<double, char> Test12MapDouble::getMapOfMyDoubleCharMap() const {
 		return m_mapOfMyDoubleCharMap;
 	}
@@ -169,6 +185,18 @@
 	std::pair<std::map<double, char>::iterator, std::map<double, char>::iterator> Test12MapDouble::iteratorPair_MapOfMyDoubleCharMap() {
 		return std::make_pair(m_mapOfMyDoubleCharMap.begin(), m_mapOfMyDoubleCharMap.end());
 	}
+	
+	const std::map<double, char>& Test12MapDouble::getConstRef_MapOfMyDoubleCharMap() const {
+		return m_mapOfMyDoubleCharMap;
+	}
+	
+	std::pair<std::map<double, char>::const_iterator, std::map<double, char>::const_iterator> Test12MapDouble::constIteratorPair_MapOfMyDoubleCharMap() const {
+		return std::make_pair(m_mapOfMyDoubleCharMap.begin(), m_mapOfMyDoubleCharMap.end());
+	}
+	
+	void Test12MapDouble::emplaceTo_MapOfMyDoubleCharMap(const double &key, char &&val) {
+		m_mapOfMyDoubleCharMap[key] = std::move(val);
+	}
 	std::map<double, int32_t> Test12MapDouble::getMapOfMyDoubleInt32Map() const {
 		return m_mapOfMyDoubleInt32Map;
 	}
@@ -204,6 +232,18 @@
 	std::pair<std::map<double, int32_t>::iterator, std::map<double, int32_t>::iterator> Test12MapDouble::iteratorPair_MapOfMyDoubleInt32Map() {
 		return std::make_pair(m_mapOfMyDoubleInt32Map.begin(), m_mapOfMyDoubleInt32Map.end());
 	}
+	
+	const std::map<double, int32_t>& Test12MapDouble::getConstRef_MapOfMyDoubleInt32Map() const {
+		return m_mapOfMyDoubleInt32Map;
+	}
+	
+	std::pair<std::map<double, int32_t>::const_iterator, std::map<double, int32_t>::const_iterator> Test12MapDouble::constIteratorPair_MapOfMyDoubleInt32Map() const {
+		return std::make_pair(m_mapOfMyDoubleInt32Map.begin(), m_mapOfMyDoubleInt32Map.end());
+	}
+	
+	void Test12MapDouble::emplaceTo_MapOfMyDoubleInt32Map(const double &key, int32_t &&val) {
+		m_mapOfMyDoubleInt32Map[key] = std::move(val);
+	}
 	std::map<double, uint32_t> Test12MapDouble::getMapOfMyDoubleUint32Map() const {
 		return m_mapOfMyDoubleUint32Map;
 	}
@@ -239,6 +279,18 @@
 	std::pair<std::map<double, uint32_t>::iterator, std::map<double, uint32_t>::iterator> Test12MapDouble::iteratorPair_MapOfMyDoubleUint32Map() {
 		return std::make_pair(m_mapOfMyDoubleUint32Map.begin(), m_mapOfMyDoubleUint32Map.end());
 	}
+	
+	const std::map<double, uint32_t>& Test12MapDouble::getConstRef_MapOfMyDoubleUint32Map() const {
+		return m_mapOfMyDoubleUint32Map;
+	}
+	
+	std::pair<std::map<double, uint32_t>::const_iterator, std::map<double, uint32_t>::const_iterator> Test12MapDouble::constIteratorPair_MapOfMyDoubleUint32Map() const {
+		return std::make_pair(m_mapOfMyDoubleUint32Map.begin(), m_mapOfMyDoubleUint32Map.end());
+	}
+	
+	void Test12MapDouble::emplaceTo_MapOfMyDoubleUint32Map(const double &key, uint32_t &&val) {
+		m_mapOfMyDoubleUint32Map[key] = std::move(val);
+	}
 	std::map<double, float> Test12MapDouble::getMapOfMyDoubleFloatMap() const {
 		return m_mapOfMyDoubleFloatMap;
 	}
@@ -274,6 +326,18 @@
 	std::pair<std::map<double, float>::iterator, std::map<double, float>::iterator> Test12MapDouble::iteratorPair_MapOfMyDoubleFloatMap() {
 		return std::make_pair(m_mapOfMyDoubleFloatMap.begin(), m_mapOfMyDoubleFloatMap.end());
 	}
+	
+	const std::map<double, float>& Test12MapDouble::getConstRef_MapOfMyDoubleFloatMap() const {
+		return m_mapOfMyDoubleFloatMap;
+	}
+	
+	std::pair<std::map<double, float>::const_iterator, std::map<double, float>::const_iterator> Test12MapDouble::constIteratorPair_MapOfMyDoubleFloatMap() const {
+		return std::make_pair(m_mapOfMyDoubleFloatMap.begin(), m_mapOfMyDoubleFloatMap.end());
+	}
+	
+	void Test12MapDouble::emplaceTo_MapOfMyDoubleFloatMap(const double &key, float &&val) {
+		m_mapOfMyDoubleFloatMap[key] = std::move(val);
+	}
 	std::map<double, double> Test12MapDouble::getMapOfMyDoubleDoubleMap() const {
 		return m_mapOfMyDoubleDoubleMap;
 	}
@@ -309,6 +373,18 @@
 	std::pair<std::map<double, double>::iterator, std::map<double, double>::iterator> Test12MapDouble::iteratorPair_MapOfMyDoubleDoubleMap() {
 		return std::make_pair(m_mapOfMyDoubleDoubleMap.begin(), m_mapOfMyDoubleDoubleMap.end());
 	}
+	
+	const std::map<double, double>& Test12MapDouble::getConstRef_MapOfMyDoubleDoubleMap() const {
+		return m_mapOfMyDoubleDoubleMap;
+	}
+	
+	std::pair<std::map<double, double>::const_iterator, std::map<double, double>::const_iterator> Test12MapDouble::constIteratorPair_MapOfMyDoubleDoubleMap() const {
+		return std::make_pair(m_mapOfMyDoubleDoubleMap.begin(), m_mapOfMyDoubleDoubleMap.end());
+	}
+	
+	void Test12MapDouble::emplaceTo_MapOfMyDoubleDoubleMap(const double &key, double &&val) {
+		m_mapOfMyDoubleDoubleMap[key] = std::move(val);
+	}
 	std::map<double, std::string> Test12MapDouble::getMapOfMyDoubleStringMap() const {
 		return m_mapOfMyDoubleStringMap;
 	}
@@ -344,6 +420,18 @@
 	std::pair<std::map<double, std::string>::iterator, std::map<double, std::string>::iterator> Test12MapDouble::iteratorPair_MapOfMyDoubleStringMap() {
 		return std::make_pair(m_mapOfMyDoubleStringMap.begin(), m_mapOfMyDoubleStringMap.end());
 	}
+	
+	const std::map<double, std::string>& Test12MapDouble::getConstRef_MapOfMyDoubleStringMap() const {
+		return m_mapOfMyDoubleStringMap;
+	}
+	
+	std::pair<std::map<double, std::string>::const_iterator, std::map<double, std::string>::const_iterator> Test12MapDouble::constIteratorPair_MapOfMyDoubleStringMap() const {
+		return std::make_pair(m_mapOfMyDoubleStringMap.begin(), m_mapOfMyDoubleStringMap.end());
+	}
+	
+	void Test12MapDouble::emplaceTo_MapOfMyDoubleStringMap(const double &key, std::string &&val) {
+		m_mapOfMyDoubleStringMap[key] = std::move(val);
+	}
 
 	void Test12MapDouble::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -367,6 +455,11 @@
 	ostream& Test12MapDouble::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		{
@@ -543,6 +636,11 @@
 	istream& Test12MapDouble::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into MyDoubleBoolMap.
@@ -785,3 +883,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test12MapDouble::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_mapOfMyDoubleBoolMap);
+		size += ProtoEncoder::getSize(2, m_mapOfMyDoubleCharMap);
+		size += ProtoEncoder::getSize(3, m_mapOfMyDoubleInt32Map);
+		size += ProtoEncoder::getSize(4, m_mapOfMyDoubleUint32Map);
+		size += ProtoEncoder::getSize(5, m_mapOfMyDoubleFloatMap);
+		size += ProtoEncoder::getSize(6, m_mapOfMyDoubleDoubleMap);
+		size += ProtoEncoder::getSize(7, m_mapOfMyDoubleStringMap);
+		return size;
+	}
+
+	void Test12MapDouble::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_mapOfMyDoubleBoolMap);
+		ProtoEncoder::write(out, 2, m_mapOfMyDoubleCharMap);
+		ProtoEncoder::write(out, 3, m_mapOfMyDoubleInt32Map);
+		ProtoEncoder::write(out, 4, m_mapOfMyDoubleUint32Map);
+		ProtoEncoder::write(out, 5, m_mapOfMyDoubleFloatMap);
+		ProtoEncoder::write(out, 6, m_mapOfMyDoubleDoubleMap);
+		ProtoEncoder::write(out, 7, m_mapOfMyDoubleStringMap);
+	}
+
+	bool Test12MapDouble::decodeFrom(const ByteSpan &in) {
+		m_mapOfMyDoubleBoolMap.clear();
+		m_mapOfMyDoubleCharMap.clear();
+		m_mapOfMyDoubleInt32Map.clear();
+		m_mapOfMyDoubleUint32Map.clear();
+		m_mapOfMyDoubleFloatMap.clear();
+		m_mapOfMyDoubleDoubleMap.clear();
+		m_mapOfMyDoubleStringMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_mapOfMyDoubleBoolMap);
+				break;
+				case 2:
+					d.read(m_mapOfMyDoubleCharMap);
+				break;
+				case 3:
+					d.read(m_mapOfMyDoubleInt32Map);
+				break;
+				case 4:
+					d.read(m_mapOfMyDoubleUint32Map);
+				break;
+				case 5:
+					d.read(m_mapOfMyDoubleFloatMap);
+				break;
+				case 6:
+					d.read(m_mapOfMyDoubleDoubleMap);
+				break;
+				case 7:
+					d.read(m_mapOfMyDoubleStringMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
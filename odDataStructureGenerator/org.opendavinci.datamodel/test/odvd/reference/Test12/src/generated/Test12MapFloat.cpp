@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -134,6 +138,18 @@
 	std::pair<std::map<float, bool>::iterator, std::map<float, bool>::iterator> Test12MapFloat::iteratorPair_MapOfMyFloatBoolMap() {
 		return std::make_pair(m_mapOfMyFloatBoolMap.begin(), m_mapOfMyFloatBoolMap.end());
 	}
+	
+	const std::map<float, bool>& Test12MapFloat::getConstRef_MapOfMyFloatBoolMap() const {
+		return m_mapOfMyFloatBoolMap;
+	}
+	
+	std::pair<std::map<float, bool>::const_iterator, std::map<float, bool>::const_iterator> Test12MapFloat::constIteratorPair_MapOfMyFloatBoolMap() const {
+		return std::make_pair(m_mapOfMyFloatBoolMap.begin(), m_mapOfMyFloatBoolMap.end());
+	}
+	
+	void Test12MapFloat::emplaceTo_MapOfMyFloatBoolMap(const float &key, bool &&val) {
+		m_mapOfMyFloatBoolMap[key] = std::move(val);
+	}
 	std::map<float, char> Test12MapFloat::getMapOfMyFloatCharMap() const {
 		return m_mapOfMyFloatCharMap;
 	}
@@ -169,6 +185,18 @@
 	std::pair<std::map<float, char>::iterator, std::map<float, char>::iterator> Test12MapFloat::iteratorPair_MapOfMyFloatCharMap() {
 		return std::make_pair(m_mapOfMyFloatCharMap.begin(), m_mapOfMyFloatCharMap.end());
 	}
+	
+	const std::map<float, char>& Test12MapFloat::getConstRef_MapOfMyFloatCharMap() const {
+		return m_mapOfMyFloatCharMap;
+	}
+	
+	std::pair<std::map<float, char>::const_iterator, std::map<float, char>::const_iterator> Test12MapFloat::constIteratorPair_MapOfMyFloatCharMap() const {
+		return std::make_pair(m_mapOfMyFloatCharMap.begin(), m_mapOfMyFloatCharMap.end());
+	}
+	
+	void Test12MapFloat::emplaceTo_MapOfMyFloatCharMap(const float &key, char &&val) {
+		m_mapOfMyFloatCharMap[key] = std::move(val);
+	}
 	std::map<float, int32_t> Test12MapFloat::getMapOfMyFloatInt32Map() const {
 		return m_mapOfMyFloatInt32Map;
 	}
@@ -204,6 +232,18 @@
 	std::pair<std::map<float, int32_t>::iterator, std::map<float, int32_t>::iterator> Test12MapFloat::iteratorPair_MapOfMyFloatInt32Map() {
 		return std::make_pair(m_mapOfMyFloatInt32Map.begin(), m_mapOfMyFloatInt32Map.end());
 	}
+	
+	const std::map<float, int32_t>& Test12MapFloat::getConstRef_MapOfMyFloatInt32Map() const {
+		return m_mapOfMyFloatInt32Map;
+	}
+	
+	std::pair<std::map<float, int32_t>::const_iterator, std::map<float, int32_t>::const_iterator> Test12MapFloat::constIteratorPair_MapOfMyFloatInt32Map() const {
+		return std::make_pair(m_mapOfMyFloatInt32Map.begin(), m_mapOfMyFloatInt32Map.end());
+	}
+	
+	void Test12MapFloat::emplaceTo_MapOfMyFloatInt32Map(const float &key, int32_t &&val) {
+		m_mapOfMyFloatInt32Map[key] = std::move(val);
+	}
 	std::map<float, uint32_t> Test12MapFloat::getMapOfMyFloatUint32Map() const {
 		return m_mapOfMyFloatUint32Map;
 	}
@@ -239,6 +279,18 @@
 	std::pair<std::map<float, uint32_t>::iterator, std::map<float, uint32_t>::iterator> Test12MapFloat::iteratorPair_MapOfMyFloatUint32Map() {
 		return std::make_pair(m_mapOfMyFloatUint32Map.begin(), m_mapOfMyFloatUint32Map.end());
 	}
+	
+	const std::map<float, uint32_t>& Test12MapFloat::getConstRef_MapOfMyFloatUint32Map() const {
+		return m_mapOfMyFloatUint32Map;
+	}
+	
+	std::pair<std::map<float, uint32_t>::const_iterator, std::map<float, uint32_t>::const_iterator> Test12MapFloat::constIteratorPair_MapOfMyFloatUint32Map() const {
+		return std::make_pair(m_mapOfMyFloatUint32Map.begin(), m_mapOfMyFloatUint32Map.end());
+	}
+	
+	void Test12MapFloat::emplaceTo_MapOfMyFloatUint32Map(const float &key, uint32_t &&val) {
+		m_mapOfMyFloatUint32Map[key] = std::move(val);
+	}
 	std::map<float, float> Test12MapFloat::getMapOfMyFloatFloatMap() const {
 		return m_mapOfMyFloatFloatMap;
 	}
@@ -274,6 +326,18 @@
 	std::pair<std::map<float, float>::iterator, std::map<float, float>::iterator> Test12MapFloat::iteratorPair_MapOfMyFloatFloatMap() {
 		return std::make_pair(m_mapOfMyFloatFloatMap.begin(), m_mapOfMyFloatFloatMap.end());
 	}
+	
+	const std::map<float, float>& Test12MapFloat::getConstRef_MapOfMyFloatFloatMap() const {
+		return m_mapOfMyFloatFloatMap;
+	}
+	
+	std::pair<std::map<float, float>::const_iterator, std::map<float, float>::const_iterator> Test12MapFloat::constIteratorPair_MapOfMyFloatFloatMap() const {
+		return std::make_pair(m_mapOfMyFloatFloatMap.begin(), m_mapOfMyFloatFloatMap.end());
+	}
+	
+	void Test12MapFloat::emplaceTo_MapOfMyFloatFloatMap(const float &key, float &&val) {
+		m_mapOfMyFloatFloatMap[key] = std::move(val);
+	}
 	std::map<float, double> Test12MapFloat::getMapOfMyFloatDoubleMap() const {
 		return m_mapOfMyFloatDoubleMap;
 	}
@@ -309,6 +373,18 @@
 	std::pair<std::map<float, double>::iterator, std::map<float, double>::iterator> Test12MapFloat::iteratorPair_MapOfMyFloatDoubleMap() {
 		return std::make_pair(m_mapOfMyFloatDoubleMap.begin(), m_mapOfMyFloatDoubleMap.end());
 	}
+	
+	const std::map<float, double>& Test12MapFloat::getConstRef_MapOfMyFloatDoubleMap() const {
+		return m_mapOfMyFloatDoubleMap;
+	}
+	
+	std::pair<std::map<float, double>::const_iterator, std::map<float, double>::const_iterator> Test12MapFloat::constIteratorPair_MapOfMyFloatDoubleMap() const {
+		return std::make_pair(m_mapOfMyFloatDoubleMap.begin(), m_mapOfMyFloatDoubleMap.end());
+	}
+	
+	void Test12MapFloat::emplaceTo_MapOfMyFloatDoubleMap(const float &key, double &&val) {
+		m_mapOfMyFloatDoubleMap[key] = std::move(val);
+	}
 	std::map<float, std::string> Test12MapFloat::getMapOfMyFloatStringMap() const {
 		return m_mapOfMyFloatStringMap;
 	}
@@ -344,6 +420,18 @@
 	std::pair<std::map<float, std::string>::iterator, std::map<float, std::string>::iterator> Test12MapFloat::iteratorPair_MapOfMyFloatStringMap() {
 		return std::make_pair(m_mapOfMyFloatStringMap.begin(), m_mapOfMyFloatStringMap.end());
 	}
+	
+	const std::map<float, std::string>& Test12MapFloat::getConstRef_MapOfMyFloatStringMap() const {
+		return m_mapOfMyFloatStringMap;
+	}
+	
+	std::pair<std::map<float, std::string>::const_iterator, std::map<float, std::string>::const_iterator> Test12MapFloat::constIteratorPair_MapOfMyFloatStringMap() const {
+		return std::make_pair(m_mapOfMyFloatStringMap.begin(), m_mapOfMyFloatStringMap.end());
+	}
+	
+	void Test12MapFloat::emplaceTo_MapOfMyFloatStringMap(const float &key, std::string &&val) {
+		m_mapOfMyFloatStringMap[key] = std::move(val);
+	}
 
 	void Test12MapFloat::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -367,6 +455,11 @@
 	ostream& Test12MapFloat::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		{
@@ -543,6 +636,11 @@
 	istream& Test12MapFloat::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into MyFloatBoolMap.
@@ -785,3 +883,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test12MapFloat::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_mapOfMyFloatBoolMap);
+		size += ProtoEncoder::getSize(2, m_mapOfMyFloatCharMap);
+		size += ProtoEncoder::getSize(3, m_mapOfMyFloatInt32Map);
+		size += ProtoEncoder::getSize(4, m_mapOfMyFloatUint32Map);
+		size += ProtoEncoder::getSize(5, m_mapOfMyFloatFloatMap);
+		size += ProtoEncoder::getSize(6, m_mapOfMyFloatDoubleMap);
+		size += ProtoEncoder::getSize(7, m_mapOfMyFloatStringMap);
+		return size;
+	}
+
+	void Test12MapFloat::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_mapOfMyFloatBoolMap);
+		ProtoEncoder::write(out, 2, m_mapOfMyFloatCharMap);
+		ProtoEncoder::write(out, 3, m_mapOfMyFloatInt32Map);
+		ProtoEncoder::write(out, 4, m_mapOfMyFloatUint32Map);
+		ProtoEncoder::write(out, 5, m_mapOfMyFloatFloatMap);
+		ProtoEncoder::write(out, 6, m_mapOfMyFloatDoubleMap);
+		ProtoEncoder::write(out, 7, m_mapOfMyFloatStringMap);
+	}
+
+	bool Test12MapFloat::decodeFrom(const ByteSpan &in) {
+		m_mapOfMyFloatBoolMap.clear();
+		m_mapOfMyFloatCharMap.clear();
+		m_mapOfMyFloatInt32Map.clear();
+		m_mapOfMyFloatUint32Map.clear();
+		m_mapOfMyFloatFloatMap.clear();
+		m_mapOfMyFloatDoubleMap.clear();
+		m_mapOfMyFloatStringMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_mapOfMyFloatBoolMap);
+				break;
+				case 2:
+					d.read(m_mapOfMyFloatCharMap);
+				break;
+				case 3:
+					d.read(m_mapOfMyFloatInt32Map);
+				break;
+				case 4:
+					d.read(m_mapOfMyFloatUint32Map);
+				break;
+				case 5:
+					d.read(m_mapOfMyFloatFloatMap);
+				break;
+				case 6:
+					d.read(m_mapOfMyFloatDoubleMap);
+				break;
+				case 7:
+					d.read(m_mapOfMyFloatStringMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
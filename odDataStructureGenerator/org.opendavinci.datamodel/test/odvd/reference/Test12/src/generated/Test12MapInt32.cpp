@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -134,6 +138,18 @@
 	std::pair<std::map<int32_t, bool>::iterator, std::map<int32_t, bool>::iterator> Test12MapInt32::iteratorPair_MapOfMyInt32BoolMap() {
 		return std::make_pair(m_mapOfMyInt32BoolMap.begin(), m_mapOfMyInt32BoolMap.end());
 	}
+	
+	const std::map<int32_t, bool>& Test12MapInt32::getConstRef_MapOfMyInt32BoolMap() const {
+		return m_mapOfMyInt32BoolMap;
+	}
+	
+	std::pair<std::map<int32_t, bool>::const_iterator, std::map<int32_t, bool>::const_iterator> Test12MapInt32::constIteratorPair_MapOfMyInt32BoolMap() const {
+		return std::make_pair(m_mapOfMyInt32BoolMap.begin(), m_mapOfMyInt32BoolMap.end());
+	}
+	
+	void Test12MapInt32::emplaceTo_MapOfMyInt32BoolMap(const int32_t &key, bool &&val) {
+		m_mapOfMyInt32BoolMap[key] = std::move(val);
+	}
 	std::map<int32_t, char> Test12MapInt32::getMapOfMyInt32CharMap() const {
 		return m_mapOfMyInt32CharMap;
 	}
@@ -169,6 +185,18 @@
 	std::pair<std::map<int32_t, char>::iterator, std::map<int32_t, char>::iterator> Test12MapInt32::iteratorPair_MapOfMyInt32CharMap() {
 		return std::make_pair(m_mapOfMyInt32CharMap.begin(), m_mapOfMyInt32CharMap.end());
 	}
+	
+	const std::map<int32_t, char>& Test12MapInt32::getConstRef_MapOfMyInt32CharMap() const {
+		return m_mapOfMyInt32CharMap;
+	}
+	
+	std::pair<std::map<int32_t, char>::const_iterator, std::map<int32_t, char>::const_iterator> Test12MapInt32::constIteratorPair_MapOfMyInt32CharMap() const {
+		return std::make_pair(m_mapOfMyInt32CharMap.begin(), m_mapOfMyInt32CharMap.end());
+	}
+	
+	void Test12MapInt32::emplaceTo_MapOfMyInt32CharMap(const int32_t &key, char &&val) {
+		m_mapOfMyInt32CharMap[key] = std::move(val);
+	}
 	std::map<int32_t, int32_t> Test12MapInt32::getMapOfMyInt32Int32Map() const {
 		return m_mapOfMyInt32Int32Map;
 	}
@@ -204,6 +232,18 @@
 	std::pair<std::map<int32_t, int32_t>::iterator, std::map<int32_t, int32_t>::iterator> Test12MapInt32::iteratorPair_MapOfMyInt32Int32Map() {
 		return std::make_pair(m_mapOfMyInt32Int32Map.begin(), m_mapOfMyInt32Int32Map.end());
 	}
+	
+	const std::map<int32_t, int32_t>& Test12MapInt32::getConstRef_MapOfMyInt32Int32Map() const {
+		return m_mapOfMyInt32Int32Map;
+	}
+	
+	std::pair<std::map<int32_t, int32_t>::const_iterator, std::map<int32_t, int32_t>::const_iterator> Test12MapInt32::constIteratorPair_MapOfMyInt32Int32Map() const {
+		return std::make_pair(m_mapOfMyInt32Int32Map.begin(), m_mapOfMyInt32Int32Map.end());
+	}
+	
+	void Test12MapInt32::emplaceTo_MapOfMyInt32Int32Map(const int32_t &key, int32_t &&val) {
+		m_mapOfMyInt32Int32Map[key] = std::move(val);
+	}
 	std::map<int32_t, uint32_t> Test12MapInt32::getMapOfMyInt32Uint32Map() const {
 		return m_mapOfMyInt32Uint32Map;
 	}
@@ -239,6 +279,18 @@
 	std::pair<std::map<int32_t, uint32_t>::iterator, std::map<int32_t, uint32_t>::iterator> Test12MapInt32::iteratorPair_MapOfMyInt32Uint32Map() {
 		return std::make_pair(m_mapOfMyInt32Uint32Map.begin(), m_mapOfMyInt32Uint32Map.end());
 	}
+	
+	const std::map<int32_t, uint32_t>& Test12MapInt32::getConstRef_MapOfMyInt32Uint32Map() const {
+		return m_mapOfMyInt32Uint32Map;
+	}
+	
+	std::pair<std::map<int32_t, uint32_t>::const_iterator, std::map<int32_t, uint32_t>::const_iterator> Test12MapInt32::constIteratorPair_MapOfMyInt32Uint32Map() const {
+		return std::make_pair(m_mapOfMyInt32Uint32Map.begin(), m_mapOfMyInt32Uint32Map.end());
+	}
+	
+	void Test12MapInt32::emplaceTo_MapOfMyInt32Uint32Map(const int32_t &key, uint32_t &&val) {
+		m_mapOfMyInt32Uint32Map[key] = std::move(val);
+	}
 	std::map<int32_t, float> Test12MapInt32::getMapOfMyInt32FloatMap() const {
 		return m_mapOfMyInt32FloatMap;
 	}
@@ -274,6 +326,18 @@
 	std::pair<std::map<int32_t, float>::iterator, std::map<int32_t, float>::iterator> Test12MapInt32::iteratorPair_MapOfMyInt32FloatMap() {
 		return std::make_pair(m_mapOfMyInt32FloatMap.begin(), m_mapOfMyInt32FloatMap.end());
 	}
+	
+	const std::map<int32_t, float>& Test12MapInt32::getConstRef_MapOfMyInt32FloatMap() const {
+		return m_mapOfMyInt32FloatMap;
+	}
+	
+	std::pair<std::map<int32_t, float>::const_iterator, std::map<int32_t, float>::const_iterator> Test12MapInt32::constIteratorPair_MapOfMyInt32FloatMap() const {
+		return std::make_pair(m_mapOfMyInt32FloatMap.begin(), m_mapOfMyInt32FloatMap.end());
+	}
+	
+	void Test12MapInt32::emplaceTo_MapOfMyInt32FloatMap(const int32_t &key, float &&val) {
+		m_mapOfMyInt32FloatMap[key] = std::move(val);
+	}
 	std::map<int32_t, double> Test12MapInt32::getMapOfMyInt32DoubleMap() const {
 		return m_mapOfMyInt32DoubleMap;
 	}
@@ -309,6 +373,18 @@
 	std::pair<std::map<int32_t, double>::iterator, std::map<int32_t, double>::iterator> Test12MapInt32::iteratorPair_MapOfMyInt32DoubleMap() {
 		return std::make_pair(m_mapOfMyInt32DoubleMap.begin(), m_mapOfMyInt32DoubleMap.end());
 	}
+	
+	const std::map<int32_t, double>& Test12MapInt32::getConstRef_MapOfMyInt32DoubleMap() const {
+		return m_mapOfMyInt32DoubleMap;
+	}
+	
+	std::pair<std::map<int32_t, double>::const_iterator, std::map<int32_t, double>::const_iterator> Test12MapInt32::constIteratorPair_MapOfMyInt32DoubleMap() const {
+		return std::make_pair(m_mapOfMyInt32DoubleMap.begin(), m_mapOfMyInt32DoubleMap.end());
+	}
+	
+	void Test12MapInt32::emplaceTo_MapOfMyInt32DoubleMap(const int32_t &key, double &&val) {
+		m_mapOfMyInt32DoubleMap[key] = std::move(val);
+	}
 	std::map<int32_t, std::string> Test12MapInt32::getMapOfMyInt32StringMap() const {
 		return m_mapOfMyInt32StringMap;
 	}
@@ -344,6 +420,18 @@
 	std::pair<std::map<int32_t, std::string>::iterator, std::map<int32_t, std::string>::iterator> Test12MapInt32::iteratorPair_MapOfMyInt32StringMap() {
 		return std::make_pair(m_mapOfMyInt32StringMap.begin(), m_mapOfMyInt32StringMap.end());
 	}
+	
+	const std::map<int32_t, std::string>& Test12MapInt32::getConstRef_MapOfMyInt32StringMap() const {
+		return m_mapOfMyInt32StringMap;
+	}
+	
+	std::pair<std::map<int32_t, std::string>::const_iterator, std::map<int32_t, std::string>::const_iterator> Test12MapInt32::constIteratorPair_MapOfMyInt32StringMap() const {
+		return std::make_pair(m_mapOfMyInt32StringMap.begin(), m_mapOfMyInt32StringMap.end());
+	}
+	
+	void Test12MapInt32::emplaceTo_MapOfMyInt32StringMap(const int32_t &key, std::string &&val) {
+		m_mapOfMyInt32StringMap[key] = std::move(val);
+	}
 
 	void Test12MapInt32::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -367,6 +455,11 @@
 	ostream& Test12MapInt32::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		{
@@ -543,6 +636,11 @@
 	istream& Test12MapInt32::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into MyInt32BoolMap.
@@ -785,3 +883,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test12MapInt32::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_mapOfMyInt32BoolMap);
+		size += ProtoEncoder::getSize(2, m_mapOfMyInt32CharMap);
+		size += ProtoEncoder::getSize(3, m_mapOfMyInt32Int32Map);
+		size += ProtoEncoder::getSize(4, m_mapOfMyInt32Uint32Map);
+		size += ProtoEncoder::getSize(5, m_mapOfMyInt32FloatMap);
+		size += ProtoEncoder::getSize(6, m_mapOfMyInt32DoubleMap);
+		size += ProtoEncoder::getSize(7, m_mapOfMyInt32StringMap);
+		return size;
+	}
+
+	void Test12MapInt32::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_mapOfMyInt32BoolMap);
+		ProtoEncoder::write(out, 2, m_mapOfMyInt32CharMap);
+		ProtoEncoder::write(out, 3, m_mapOfMyInt32Int32Map);
+		ProtoEncoder::write(out, 4, m_mapOfMyInt32Uint32Map);
+		ProtoEncoder::write(out, 5, m_mapOfMyInt32FloatMap);
+		ProtoEncoder::write(out, 6, m_mapOfMyInt32DoubleMap);
+		ProtoEncoder::write(out, 7, m_mapOfMyInt32StringMap);
+	}
+
+	bool Test12MapInt32::decodeFrom(const ByteSpan &in) {
+		m_mapOfMyInt32BoolMap.clear();
+		m_mapOfMyInt32CharMap.clear();
+		m_mapOfMyInt32Int32Map.clear();
+		m_mapOfMyInt32Uint32Map.clear();
+		m_mapOfMyInt32FloatMap.clear();
+		m_mapOfMyInt32DoubleMap.clear();
+		m_mapOfMyInt32StringMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_mapOfMyInt32BoolMap);
+				break;
+				case 2:
+					d.read(m_mapOfMyInt32CharMap);
+				break;
+				case 3:
+					d.read(m_mapOfMyInt32Int32Map);
+				break;
+				case 4:
+					d.read(m_mapOfMyInt32Uint32Map);
+				break;
+				case 5:
+					d.read(m_mapOfMyInt32FloatMap);
+				break;
+				case 6:
+					d.read(m_mapOfMyInt32DoubleMap);
+				break;
+				case 7:
+					d.read(m_mapOfMyInt32StringMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
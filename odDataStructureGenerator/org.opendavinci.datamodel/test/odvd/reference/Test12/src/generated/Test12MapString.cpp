@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -134,6 +138,18 @@
 	std::pair<std::map<std::string, bool>::iterator, std::map<std::string, bool>::iterator> Test12MapString::iteratorPair_MapOfMyStringBoolMap() {
 		return std::make_pair(m_mapOfMyStringBoolMap.begin(), m_mapOfMyStringBoolMap.end());
 	}
+	
+	const std::map<std::string, bool>& Test12MapString::getConstRef_MapOfMyStringBoolMap() const {
+		return m_mapOfMyStringBoolMap;
+	}
+	
+	std::pair<std::map<std::string, bool>::const_iterator, std::map<std::string, bool>::const_iterator> Test12MapString::constIteratorPair_MapOfMyStringBoolMap() const {
+		return std::make_pair(m_mapOfMyStringBoolMap.begin(), m_mapOfMyStringBoolMap.end());
+	}
+	
+	void Test12MapString::emplaceTo_MapOfMyStringBoolMap(const std::string &key, bool &&val) {
+		m_mapOfMyStringBoolMap[key] = std::move(val);
+	}
 	std::map<std::string, char> Test12MapString::getMapOfMyStringCharMap() const {
 		return m_mapOfMyStringCharMap;
 	}
@@ -169,6 +185,18 @@
 	std::pair<std::map<std::string, char>::iterator, std::map<std::string, char>::iterator> Test12MapString::iteratorPair_MapOfMyStringCharMap() {
 		return std::make_pair(m_mapOfMyStringCharMap.begin(), m_mapOfMyStringCharMap.end());
 	}
+	
+	const std::map<std::string, char>& Test12MapString::getConstRef_MapOfMyStringCharMap() const {
+		return m_mapOfMyStringCharMap;
+	}
+	
+	std::pair<std::map<std::string, char>::const_iterator, std::map<std::string, char>::const_iterator> Test12MapString::constIteratorPair_MapOfMyStringCharMap() const {
+		return std::make_pair(m_mapOfMyStringCharMap.begin(), m_mapOfMyStringCharMap.end());
+	}
+	
+	void Test12MapString::emplaceTo_MapOfMyStringCharMap(const std::string &key, char &&val) {
+		m_mapOfMyStringCharMap[key] = std::move(val);
+	}
 	std::map<std::string, int32_t> Test12MapString::getMapOfMyStringInt32Map() const {
 		return m_mapOfMyStringInt32Map;
 	}
@@ -204,6 +232,18 @@
 	std::pair<std::map<std::string, int32_t>::iterator, std::map<std::string, int32_t>::iterator> Test12MapString::iteratorPair_MapOfMyStringInt32Map() {
 		return std::make_pair(m_mapOfMyStringInt32Map.begin(), m_mapOfMyStringInt32Map.end());
 	}
+	
+	const std::map<std::string, int32_t>& Test12MapString::getConstRef_MapOfMyStringInt32Map() const {
+		return m_mapOfMyStringInt32Map;
+	}
+	
+	std::pair<std::map<std::string, int32_t>::const_iterator, std::map<std::string, int32_t>::const_iterator> Test12MapString::constIteratorPair_MapOfMyStringInt32Map() const {
+		return std::make_pair(m_mapOfMyStringInt32Map.begin(), m_mapOfMyStringInt32Map.end());
+	}
+	
+	void Test12MapString::emplaceTo_MapOfMyStringInt32Map(const std::string &key, int32_t &&val) {
+		m_mapOfMyStringInt32Map[key] = std::move(val);
+	}
 	std::map<std::string, uint32_t> Test12MapString::getMapOfMyStringUint32Map() const {
 		return m_mapOfMyStringUint32Map;
 	}
@@ -239,6 +279,18 @@
 	std::pair<std::map<std::string, uint32_t>::iterator, std::map<std::string, uint32_t>::iterator> Test12MapString::iteratorPair_MapOfMyStringUint32Map() {
 		return std::make_pair(m_mapOfMyStringUint32Map.begin(), m_mapOfMyStringUint32Map.end());
 	}
+	
+	const std::map<std::string, uint32_t>& Test12MapString::getConstRef_MapOfMyStringUint32Map() const {
+		return m_mapOfMyStringUint32Map;
+	}
+	
+	std::pair<std::map<std::string, uint32_t>::const_iterator, std::map<std::string, uint32_t>::const_iterator> Test12MapString::constIteratorPair_MapOfMyStringUint32Map() const {
+		return std::make_pair(m_mapOfMyStringUint32Map.begin(), m_mapOfMyStringUint32Map.end());
+	}
+	
+	void Test12MapString::emplaceTo_MapOfMyStringUint32Map(const std::string &key, uint32_t &&val) {
+		m_mapOfMyStringUint32Map[key] = std::move(val);
+	}
 	std::map<std::string, float> Test12MapString::getMapOfMyStringFloatMap() const {
 		return m_mapOfMyStringFloatMap;
 	}
@@ -274,6 +326,18 @@
 	std::pair<std::map<std::string, float>::iterator, std::map<std::string, float>::iterator> Test12MapString::iteratorPair_MapOfMyStringFloatMap() {
 		return std::make_pair(m_mapOfMyStringFloatMap.begin(), m_mapOfMyStringFloatMap.end());
 	}
+	
+	const std::map<std::string, float>& Test12MapString::getConstRef_MapOfMyStringFloatMap() const {
+		return m_mapOfMyStringFloatMap;
+	}
+	
+	std::pair<std::map<std::string, float>::const_iterator, std::map<std::string, float>::const_iterator> Test12MapString::constIteratorPair_MapOfMyStringFloatMap() const {
+		return std::make_pair(m_mapOfMyStringFloatMap.begin(), m_mapOfMyStringFloatMap.end());
+	}
+	
+	void Test12MapString::emplaceTo_MapOfMyStringFloatMap(const std::string &key, float &&val) {
+		m_mapOfMyStringFloatMap[key] = std::move(val);
+	}
 	std::map<std::string, double> Test12MapString::getMapOfMyStringDoubleMap() const {
 		return m_mapOfMyStringDoubleMap;
 	}
@@ -309,6 +373,18 @@
 	std::pair<std::map<std::string, double>::iterator, std::map<std::string, double>::iterator> Test12MapString::iteratorPair_MapOfMyStringDoubleMap() {
 		return std::make_pair(m_mapOfMyStringDoubleMap.begin(), m_mapOfMyStringDoubleMap.end());
 	}
+	
+	const std::map<std::string, double>& Test12MapString::getConstRef_MapOfMyStringDoubleMap() const {
+		return m_mapOfMyStringDoubleMap;
+	}
+	
+	std::pair<std::map<std::string, double>::const_iterator, std::map<std::string, double>::const_iterator> Test12MapString::constIteratorPair_MapOfMyStringDoubleMap() const {
+		return std::make_pair(m_mapOfMyStringDoubleMap.begin(), m_mapOfMyStringDoubleMap.end());
+	}
+	
+	void Test12MapString::emplaceTo_MapOfMyStringDoubleMap(const std::string &key, double &&val) {
+		m_mapOfMyStringDoubleMap[key] = std::move(val);
+	}
 	std::map<std::string, std::string> Test12MapString::getMapOfMyStringStringMap() const {
 		return m_mapOfMyStringStringMap;
 	}
@@ -344,6 +420,18 @@
 	std::pair<std::map<std::string, std::string>::iterator, std::map<std::string, std::string>::iterator> Test12MapString::iteratorPair_MapOfMyStringStringMap() {
 		return std::make_pair(m_mapOfMyStringStringMap.begin(), m_mapOfMyStringStringMap.end());
 	}
+	
+	const std::map<std::string, std::string>& Test12MapString::getConstRef_MapOfMyStringStringMap() const {
+		return m_mapOfMyStringStringMap;
+	}
+	
+	std::pair<std::map<std::string, std::string>::const_iterator, std::map<std::string, std::string>::const_iterator> Test12MapString::constIteratorPair_MapOfMyStringStringMap() const {
+		return std::make_pair(m_mapOfMyStringStringMap.begin(), m_mapOfMyStringStringMap.end());
+	}
+	
+	void Test12MapString::emplaceTo_MapOfMyStringStringMap(const std::string &key, std::string &&val) {
+		m_mapOfMyStringStringMap[key] = std::move(val);
+	}
 
 	void Test12MapString::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -367,6 +455,11 @@
 	ostream& Test12MapString::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		{
@@ -543,6 +636,11 @@
 	istream& Test12MapString::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into MyStringBoolMap.
@@ -785,3 +883,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test12MapString::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_mapOfMyStringBoolMap);
+		size += ProtoEncoder::getSize(2, m_mapOfMyStringCharMap);
+		size += ProtoEncoder::getSize(3, m_mapOfMyStringInt32Map);
+		size += ProtoEncoder::getSize(4, m_mapOfMyStringUint32Map);
+		size += ProtoEncoder::getSize(5, m_mapOfMyStringFloatMap);
+		size += ProtoEncoder::getSize(6, m_mapOfMyStringDoubleMap);
+		size += ProtoEncoder::getSize(7, m_mapOfMyStringStringMap);
+		return size;
+	}
+
+	void Test12MapString::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_mapOfMyStringBoolMap);
+		ProtoEncoder::write(out, 2, m_mapOfMyStringCharMap);
+		ProtoEncoder::write(out, 3, m_mapOfMyStringInt32Map);
+		ProtoEncoder::write(out, 4, m_mapOfMyStringUint32Map);
+		ProtoEncoder::write(out, 5, m_mapOfMyStringFloatMap);
+		ProtoEncoder::write(out, 6, m_mapOfMyStringDoubleMap);
+		ProtoEncoder::write(out, 7, m_mapOfMyStringStringMap);
+	}
+
+	bool Test12MapString::decodeFrom(const ByteSpan &in) {
+		m_mapOfMyStringBoolMap.clear();
+		m_mapOfMyStringCharMap.clear();
+		m_mapOfMyStringInt32Map.clear();
+		m_mapOfMyStringUint32Map.clear();
+		m_mapOfMyStringFloatMap.clear();
+		m_mapOfMyStringDoubleMap.clear();
+		m_mapOfMyStringStringMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_mapOfMyStringBoolMap);
+				break;
+				case 2:
+					d.read(m_mapOfMyStringCharMap);
+				break;
+				case 3:
+					d.read(m_mapOfMyStringInt32Map);
+				break;
+				case 4:
+					d.read(m_mapOfMyStringUint32Map);
+				break;
+				case 5:
+					d.read(m_mapOfMyStringFloatMap);
+				break;
+				case 6:
+					d.read(m_mapOfMyStringDoubleMap);
+				break;
+				case 7:
+					d.read(m_mapOfMyStringStringMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -134,6 +138,18 @@
 	std::pair<std::map<uint32_t, bool>::iterator, std::map<uint32_t, bool>::iterator> Test12MapUint32::iteratorPair_MapOfMyUint32BoolMap() {
 		return std::make_pair(m_mapOfMyUint32BoolMap.begin(), m_mapOfMyUint32BoolMap.end());
 	}
+	
+	const std::map<uint32_t, bool>& Test12MapUint32::getConstRef_MapOfMyUint32BoolMap() const {
+		return m_mapOfMyUint32BoolMap;
+	}
+	
+	std::pair<std::map<uint32_t, bool>::const_iterator, std::map<uint32_t, bool>::const_iterator> Test12MapUint32::constIteratorPair_MapOfMyUint32BoolMap() const {
+		return std::make_pair(m_mapOfMyUint32BoolMap.begin(), m_mapOfMyUint32BoolMap.end());
+	}
+	
+	void Test12MapUint32::emplaceTo_MapOfMyUint32BoolMap(const uint32_t &key, bool &&val) {
+		m_mapOfMyUint32BoolMap[key] = std::move(val);
+	}
 	std::map<uint32_t, char> Test12MapUint32::getMapOfMyUint32CharMap() const {
 		return m_mapOfMyUint32CharMap;
 	}
@@ -169,6 +185,18 @@
 	std::pair<std::map<uint32_t, char>::iterator, std::map<uint32_t, char>::iterator> Test12MapUint32::iteratorPair_MapOfMyUint32CharMap() {
 		return std::make_pair(m_mapOfMyUint32CharMap.begin(), m_mapOfMyUint32CharMap.end());
 	}
+	
+	const std::map<uint32_t, char>& Test12MapUint32::getConstRef_MapOfMyUint32CharMap() const {
+		return m_mapOfMyUint32CharMap;
+	}
+	
+	std::pair<std::map<uint32_t, char>::const_iterator, std::map<uint32_t, char>::const_iterator> Test12MapUint32::constIteratorPair_MapOfMyUint32CharMap() const {
+		return std::make_pair(m_mapOfMyUint32CharMap.begin(), m_mapOfMyUint32CharMap.end());
+	}
+	
+	void Test12MapUint32::emplaceTo_MapOfMyUint32CharMap(const uint32_t &key, char &&val) {
+		m_mapOfMyUint32CharMap[key] = std::move(val);
+	}
 	std::map<uint32_t, int32_t> Test12MapUint32::getMapOfMyUint32Int32Map() const {
 		return m_mapOfMyUint32Int32Map;
 	}
@@ -204,6 +232,18 @@
 	std::pair<std::map<uint32_t, int32_t>::iterator, std::map<uint32_t, int32_t>::iterator> Test12MapUint32::iteratorPair_MapOfMyUint32Int32Map() {
 		return std::make_pair(m_mapOfMyUint32Int32Map.begin(), m_mapOfMyUint32Int32Map.end());
 	}
+	
+	const std::map<uint32_t, int32_t>& Test12MapUint32::getConstRef_MapOfMyUint32Int32Map() const {
+		return m_mapOfMyUint32Int32Map;
+	}
+	
+	std::pair<std::map<uint32_t, int32_t>::const_iterator, std::map<uint32_t, int32_t>::const_iterator> Test12MapUint32::constIteratorPair_MapOfMyUint32Int32Map() const {
+		return std::make_pair(m_mapOfMyUint32Int32Map.begin(), m_mapOfMyUint32Int32Map.end());
+	}
+	
+	void Test12MapUint32::emplaceTo_MapOfMyUint32Int32Map(const uint32_t &key, int32_t &&val) {
+		m_mapOfMyUint32Int32Map[key] = std::move(val);
+	}
 	std::map<uint32_t, uint32_t> Test12MapUint32::getMapOfMyUint32Uint32Map() const {
 		return m_mapOfMyUint32Uint32Map;
 	}
@@ -239,6 +279,18 @@
 	std::pair<std::map<uint32_t, uint32_t>::iterator, std::map<uint32_t, uint32_t>::iterator> Test12MapUint32::iteratorPair_MapOfMyUint32Uint32Map() {
 		return std::make_pair(m_mapOfMyUint32Uint32Map.begin(), m_mapOfMyUint32Uint32Map.end());
 	}
+	
+	const std::map<uint32_t, uint32_t>& Test12MapUint32::getConstRef_MapOfMyUint32Uint32Map() const {
+		return m_mapOfMyUint32Uint32Map;
+	}
+	
+	std::pair<std::map<uint32_t, uint32_t>::const_iterator, std::map<uint32_t, uint32_t>::const_iterator> Test12MapUint32::constIteratorPair_MapOfMyUint32Uint32Map() const {
+		return std::make_pair(m_mapOfMyUint32Uint32Map.begin(), m_mapOfMyUint32Uint32Map.end());
+	}
+	
+	void Test12MapUint32::emplaceTo_MapOfMyUint32Uint32Map(const uint32_t &key, uint32_t &&val) {
+		m_mapOfMyUint32Uint32Map[key] = std::move(val);
+	}
 	std::map<uint32_t, float> Test12MapUint32::getMapOfMyUint32FloatMap() const {
 		return m_mapOfMyUint32FloatMap;
 	}
@@ -274,6 +326,18 @@
 	std::pair<std::map<uint32_t, float>::iterator, std::map<uint32_t, float>::iterator> Test12MapUint32::iteratorPair_MapOfMyUint32FloatMap() {
 		return std::make_pair(m_mapOfMyUint32FloatMap.begin(), m_mapOfMyUint32FloatMap.end());
 	}
+	
+	const std::map<uint32_t, float>& Test12MapUint32::getConstRef_MapOfMyUint32FloatMap() const {
+		return m_mapOfMyUint32FloatMap;
+	}
+	
+	std::pair<std::map<uint32_t, float>::const_iterator, std::map<uint32_t, float>::const_iterator> Test12MapUint32::constIteratorPair_MapOfMyUint32FloatMap() const {
+		return std::make_pair(m_mapOfMyUint32FloatMap.begin(), m_mapOfMyUint32FloatMap.end());
+	}
+	
+	void Test12MapUint32::emplaceTo_MapOfMyUint32FloatMap(const uint32_t &key, float &&val) {
+		m_mapOfMyUint32FloatMap[key] = std::move(val);
+	}
 	std::map<uint32_t, double> Test12MapUint32::getMapOfMyUint32DoubleMap() const {
 		return m_mapOfMyUint32DoubleMap;
 	}
@@ -309,6 +373,18 @@
 	std::pair<std::map<uint32_t, double>::iterator, std::map<uint32_t, double>::iterator> Test12MapUint32::iteratorPair_MapOfMyUint32DoubleMap() {
 		return std::make_pair(m_mapOfMyUint32DoubleMap.begin(), m_mapOfMyUint32DoubleMap.end());
 	}
+	
+	const std::map<uint32_t, double>& Test12MapUint32::getConstRef_MapOfMyUint32DoubleMap() const {
+		return m_mapOfMyUint32DoubleMap;
+	}
+	
+	std::pair<std::map<uint32_t, double>::const_iterator, std::map<uint32_t, double>::const_iterator> Test12MapUint32::constIteratorPair_MapOfMyUint32DoubleMap() const {
+		return std::make_pair(m_mapOfMyUint32DoubleMap.begin(), m_mapOfMyUint32DoubleMap.end());
+	}
+	
+	void Test12MapUint32::emplaceTo_MapOfMyUint32DoubleMap(const uint32_t &key, double &&val) {
+		m_mapOfMyUint32DoubleMap[key] = std::move(val);
+	}
 	std::map<uint32_t, std::string> Test12MapUint32::getMapOfMyUint32StringMap() const {
 		return m_mapOfMyUint32StringMap;
 	}
@@ -344,6 +420,18 @@
 	std::pair<std::map<uint32_t, std::string>::iterator, std::map<uint32_t, std::string>::iterator> Test12MapUint32::iteratorPair_MapOfMyUint32StringMap() {
 		return std::make_pair(m_mapOfMyUint32StringMap.begin(), m_mapOfMyUint32StringMap.end());
 	}
+	
+	const std::map<uint32_t, std::string>& Test12MapUint32::getConstRef_MapOfMyUint32StringMap() const {
+		return m_mapOfMyUint32StringMap;
+	}
+	
+	std::pair<std::map<uint32_t, std::string>::const_iterator, std::map<uint32_t, std::string>::const_iterator> Test12MapUint32::constIteratorPair_MapOfMyUint32StringMap() const {
+		return std::make_pair(m_mapOfMyUint32StringMap.begin(), m_mapOfMyUint32StringMap.end());
+	}
+	
+	void Test12MapUint32::emplaceTo_MapOfMyUint32StringMap(const uint32_t &key, std::string &&val) {
+		m_mapOfMyUint32StringMap[key] = std::move(val);
+	}
 
 	void Test12MapUint32::accept(odcore::base::Visitor &v) {
 		v.beginVisit(ID(), ShortName(), LongName());
@@ -367,6 +455,11 @@
 	ostream& Test12MapUint32::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		{
@@ -543,6 +636,11 @@
 	istream& Test12MapUint32::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore elements from a string into MyUint32BoolMap.
@@ -785,3 +883,64 @@
 		}
 		return in;
 	}
+
+	uint32_t Test12MapUint32::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, m_mapOfMyUint32BoolMap);
+		size += ProtoEncoder::getSize(2, m_mapOfMyUint32CharMap);
+		size += ProtoEncoder::getSize(3, m_mapOfMyUint32Int32Map);
+		size += ProtoEncoder::getSize(4, m_mapOfMyUint32Uint32Map);
+		size += ProtoEncoder::getSize(5, m_mapOfMyUint32FloatMap);
+		size += ProtoEncoder::getSize(6, m_mapOfMyUint32DoubleMap);
+		size += ProtoEncoder::getSize(7, m_mapOfMyUint32StringMap);
+		return size;
+	}
+
+	void Test12MapUint32::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, m_mapOfMyUint32BoolMap);
+		ProtoEncoder::write(out, 2, m_mapOfMyUint32CharMap);
+		ProtoEncoder::write(out, 3, m_mapOfMyUint32Int32Map);
+		ProtoEncoder::write(out, 4, m_mapOfMyUint32Uint32Map);
+		ProtoEncoder::write(out, 5, m_mapOfMyUint32FloatMap);
+		ProtoEncoder::write(out, 6, m_mapOfMyUint32DoubleMap);
+		ProtoEncoder::write(out, 7, m_mapOfMyUint32StringMap);
+	}
+
+	bool Test12MapUint32::decodeFrom(const ByteSpan &in) {
+		m_mapOfMyUint32BoolMap.clear();
+		m_mapOfMyUint32CharMap.clear();
+		m_mapOfMyUint32Int32Map.clear();
+		m_mapOfMyUint32Uint32Map.clear();
+		m_mapOfMyUint32FloatMap.clear();
+		m_mapOfMyUint32DoubleMap.clear();
+		m_mapOfMyUint32StringMap.clear();
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.read(m_mapOfMyUint32BoolMap);
+				break;
+				case 2:
+					d.read(m_mapOfMyUint32CharMap);
+				break;
+				case 3:
+					d.read(m_mapOfMyUint32Int32Map);
+				break;
+				case 4:
+					d.read(m_mapOfMyUint32Uint32Map);
+				break;
+				case 5:
+					d.read(m_mapOfMyUint32FloatMap);
+				break;
+				case 6:
+					d.read(m_mapOfMyUint32DoubleMap);
+				break;
+				case 7:
+					d.read(m_mapOfMyUint32StringMap);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -106,6 +110,11 @@
 	ostream& Test15Simple::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		int32_t int32t_buttonState = m_buttonState;
@@ -117,6 +126,11 @@
 	istream& Test15Simple::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		int32_t int32t_buttonState = 0;
@@ -125,3 +139,31 @@
 		m_buttonState = static_cast<Test15Simple::ButtonState>(int32t_buttonState);
 		return in;
 	}
+
+	uint32_t Test15Simple::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(1, static_cast<int32_t>(m_buttonState));
+		return size;
+	}
+
+	void Test15Simple::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 1, static_cast<int32_t>(m_buttonState));
+	}
+
+	bool Test15Simple::decodeFrom(const ByteSpan &in) {
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+				{
+					int32_t int32t_buttonState = 0;
+					d.read(int32t_buttonState);
+					m_buttonState = static_cast<Test15Simple::ButtonState>(int32t_buttonState);
+				}
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
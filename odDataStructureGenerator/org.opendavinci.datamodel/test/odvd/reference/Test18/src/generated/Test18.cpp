@@ -8,7 +8,11 @@
 #include <cstring>
 #include <opendavinci/odcore/opendavinci.h>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -176,6 +180,11 @@
 	ostream& Test18::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		// Store elements from m_myArray1 into a string.
@@ -212,6 +221,11 @@
 	istream& Test18::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		// Restore values for myArray1
@@ -260,3 +274,47 @@
 				m_myAtt3);
 		return in;
 	}
+
+	uint32_t Test18::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getArraySize(1, m_myArray1, getSize_MyArray1());
+		size += ProtoEncoder::getArraySize(2, m_myArray2, getSize_MyArray2());
+		size += ProtoEncoder::getSize(3, m_myAtt1);
+		size += ProtoEncoder::getSize(4, m_myAtt2);
+		size += ProtoEncoder::getSize(5, m_myAtt3);
+		return size;
+	}
+
+	void Test18::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::writeArray(out, 1, m_myArray1, getSize_MyArray1());
+		ProtoEncoder::writeArray(out, 2, m_myArray2, getSize_MyArray2());
+		ProtoEncoder::write(out, 3, m_myAtt1);
+		ProtoEncoder::write(out, 4, m_myAtt2);
+		ProtoEncoder::write(out, 5, m_myAtt3);
+	}
+
+	bool Test18::decodeFrom(const ByteSpan &in) {
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 1:
+					d.readArray(m_myArray1, getSize_MyArray1());
+				break;
+				case 2:
+					d.readArray(m_myArray2, getSize_MyArray2());
+				break;
+				case 3:
+					d.read(m_myAtt1);
+				break;
+				case 4:
+					d.read(m_myAtt2);
+				break;
+				case 5:
+					d.read(m_myAtt3);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -81,3 +85,23 @@
 	istream& Test2b::operator>>(istream &in) {
 		return in;
 	}
+
+	uint32_t Test2b::getEncodedSize() const {
+		uint32_t size = 0;
+		return size;
+	}
+
+	void Test2b::encodeTo(ByteWriter &out) const {
+		(void)out; // Avoid unused parameter warning.
+	}
+
+	bool Test2b::decodeFrom(const ByteSpan &in) {
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -108,6 +112,11 @@
 	ostream& Test20a::operator<<(ostream &out) const {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls.
+			return ProtoEncoder::encode(out, *this);
+		}
+
 		std::shared_ptr<Serializer> s = sf.getSerializer(out);
 
 		s->write(2,
@@ -120,6 +129,11 @@
 	istream& Test20a::operator>>(istream &in) {
 		SerializationFactory& sf = SerializationFactory::getInstance();
 
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls.
+			return ProtoDecoder::decode(in, *this);
+		}
+
 		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 
 		d->read(2,
@@ -128,3 +142,32 @@
 				m_timeStamp);
 		return in;
 	}
+
+	uint32_t Test20a::getEncodedSize() const {
+		uint32_t size = 0;
+		size += ProtoEncoder::getSize(2, m_val1);
+		size += ProtoEncoder::getSize(3, m_timeStamp);
+		return size;
+	}
+
+	void Test20a::encodeTo(ByteWriter &out) const {
+		ProtoEncoder::write(out, 2, m_val1);
+		ProtoEncoder::write(out, 3, m_timeStamp);
+	}
+
+	bool Test20a::decodeFrom(const ByteSpan &in) {
+		ProtoDecoder d(in);
+		while (d.next()) {
+			switch (d.getFieldId()) {
+				case 2:
+					d.read(m_val1);
+				break;
+				case 3:
+					d.read(m_timeStamp);
+				break;
+				default:
+				break;
+			}
+		}
+		return d.isGood();
+	}
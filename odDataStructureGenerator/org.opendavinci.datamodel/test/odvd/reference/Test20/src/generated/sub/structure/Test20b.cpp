@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -96,6 +100,11 @@ namespace sub {
 			ostream& Test20b::operator<<(ostream &out) const {
 				SerializationFactory& sf = SerializationFactory::getInstance();
 		
+				if (sf.usesDefaultSerialization()) {
+					// Encode directly without any virtual method calls.
+					return ProtoEncoder::encode(out, *this);
+				}
+		
 				std::shared_ptr<Serializer> s = sf.getSerializer(out);
 		
 				s->write(1,
@@ -106,11 +115,40 @@ namespace sub {
 			istream& Test20b::operator>>(istream &in) {
 				SerializationFactory& sf = SerializationFactory::getInstance();
 		
+				if (sf.usesDefaultSerialization()) {
+					// Decode directly without any virtual method calls.
+					return ProtoDecoder::decode(in, *this);
+				}
+		
 				std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 		
 				d->read(1,
 						m_val2);
 				return in;
 			}
+		
+			uint32_t Test20b::getEncodedSize() const {
+				uint32_t size = 0;
+				size += ProtoEncoder::getSize(1, m_val2);
+				return size;
+			}
+		
+			void Test20b::encodeTo(ByteWriter &out) const {
+				ProtoEncoder::write(out, 1, m_val2);
+			}
+		
+			bool Test20b::decodeFrom(const ByteSpan &in) {
+				ProtoDecoder d(in);
+				while (d.next()) {
+					switch (d.getFieldId()) {
+						case 1:
+							d.read(m_val2);
+						break;
+						default:
+						break;
+					}
+				}
+				return d.isGood();
+			}
 	} // structure
 } // sub
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -110,6 +114,11 @@ namespace sub {
 			ostream& Test20c::operator<<(ostream &out) const {
 				SerializationFactory& sf = SerializationFactory::getInstance();
 		
+				if (sf.usesDefaultSerialization()) {
+					// Encode directly without any virtual method calls.
+					return ProtoEncoder::encode(out, *this);
+				}
+		
 				std::shared_ptr<Serializer> s = sf.getSerializer(out);
 		
 				s->write(1,
@@ -122,6 +131,11 @@ namespace sub {
 			istream& Test20c::operator>>(istream &in) {
 				SerializationFactory& sf = SerializationFactory::getInstance();
 		
+				if (sf.usesDefaultSerialization()) {
+					// Decode directly without any virtual method calls.
+					return ProtoDecoder::decode(in, *this);
+				}
+		
 				std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 		
 				d->read(1,
@@ -130,5 +144,34 @@ namespace sub {
 						m_val4);
 				return in;
 			}
+		
+			uint32_t Test20c::getEncodedSize() const {
+				uint32_t size = 0;
+				size += ProtoEncoder::getSize(1, m_val3);
+				size += ProtoEncoder::getSize(2, m_val4);
+				return size;
+			}
+		
+			void Test20c::encodeTo(ByteWriter &out) const {
+				ProtoEncoder::write(out, 1, m_val3);
+				ProtoEncoder::write(out, 2, m_val4);
+			}
+		
+			bool Test20c::decodeFrom(const ByteSpan &in) {
+				ProtoDecoder d(in);
+				while (d.next()) {
+					switch (d.getFieldId()) {
+						case 1:
+							d.read(m_val3);
+						break;
+						case 2:
+							d.read(m_val4);
+						break;
+						default:
+						break;
+					}
+				}
+				return d.isGood();
+			}
 	} // structure2
 } // sub
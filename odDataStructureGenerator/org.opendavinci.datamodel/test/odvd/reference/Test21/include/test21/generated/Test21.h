@@ -0,0 +1,286 @@
+/*
+ * This software is open source. Please see COPYING and AUTHORS for further information.
+ *
+ * This file is auto-generated. DO NOT CHANGE AS YOUR CHANGES MIGHT BE OVERWRITTEN!
+ */
+
+#ifndef TEST21_H
+#define TEST21_H
+
+#include "opendavinci/odcore/opendavinci.h"
+
+
+#include "opendavinci/odcore/base/Visitable.h"
+#include "opendavinci/odcore/data/SerializableData.h"
+#include "opendavinci/odcore/serialization/ByteSpan.h"
+#include "opendavinci/odcore/serialization/ByteWriter.h"
+
+
+using namespace std;
+
+class OPENDAVINCI_API Test21 : public odcore::data::SerializableData, public odcore::base::Visitable {
+	public:
+		Test21();
+
+		Test21(
+		const bool &val0, 
+		const int32_t &val1, 
+		const uint32_t &val2, 
+		const float &val3, 
+		const double &val4
+		);
+
+		virtual ~Test21();
+
+		/**
+		 * Copy constructor.
+		 *
+		 * @param obj Reference to an object of this class.
+		 */
+		Test21(const Test21 &obj);
+
+		/**
+		 * Assignment operator.
+		 *
+		 * @param obj Reference to an object of this class.
+		 * @return Reference to this instance.
+		 */
+		Test21& operator=(const Test21 &obj);
+
+	public:
+		/**
+		 * @return attribute1.
+		 */
+		bool getAttribute1() const;
+		
+		/**
+		 * This method sets attribute1.
+		 *
+		 * @param val Value for attribute1.
+		 */
+		void setAttribute1(const bool &val);
+	public:
+		/**
+		 * @return attribute2.
+		 */
+		int32_t getAttribute2() const;
+		
+		/**
+		 * This method sets attribute2.
+		 *
+		 * @param val Value for attribute2.
+		 */
+		void setAttribute2(const int32_t &val);
+	public:
+		/**
+		 * @return attribute3.
+		 */
+		uint32_t getAttribute3() const;
+		
+		/**
+		 * This method sets attribute3.
+		 *
+		 * @param val Value for attribute3.
+		 */
+		void setAttribute3(const uint32_t &val);
+	public:
+		/**
+		 * @return attribute4.
+		 */
+		float getAttribute4() const;
+		
+		/**
+		 * This method sets attribute4.
+		 *
+		 * @param val Value for attribute4.
+		 */
+		void setAttribute4(const float &val);
+	public:
+		/**
+		 * @return attribute5.
+		 */
+		double getAttribute5() const;
+		
+		/**
+		 * This method sets attribute5.
+		 *
+		 * @param val Value for attribute5.
+		 */
+		void setAttribute5(const double &val);
+
+	public:
+		/**
+		 * Number of bytes of the flat representation.
+		 */
+		static const uint32_t FLAT_SIZE = 21;
+
+		/**
+		 * This struct contains the attributes of this message in a
+		 * fixed memory layout and can be copied with memcpy.
+		 */
+		struct Flat {
+			bool attribute1;
+			int32_t attribute2;
+			uint32_t attribute3;
+			float attribute4;
+			double attribute5;
+		};
+
+		/**
+		 * This class reads the attributes of this message directly
+		 * from a buffer containing its flat representation without
+		 * decoding or copying the buffer.
+		 */
+		class OPENDAVINCI_API View {
+			public:
+				/**
+				 * Constructor.
+				 *
+				 * @param data Buffer to read from; the caller is responsible for its lifecycle.
+				 * @param length Number of bytes in the buffer.
+				 */
+				View(const char *data, const uint32_t &length);
+
+				/**
+				 * Constructor.
+				 *
+				 * @param in Bytes to read from.
+				 */
+				View(const odcore::serialization::ByteSpan &in);
+
+				/**
+				 * @return true if the buffer contains at least FLAT_SIZE bytes.
+				 */
+				bool isValid() const;
+
+				/**
+				 * @return attribute1 or its default value if !isValid().
+				 */
+				bool getAttribute1() const;
+
+				/**
+				 * @return attribute2 or its default value if !isValid().
+				 */
+				int32_t getAttribute2() const;
+
+				/**
+				 * @return attribute3 or its default value if !isValid().
+				 */
+				uint32_t getAttribute3() const;
+
+				/**
+				 * @return attribute4 or its default value if !isValid().
+				 */
+				float getAttribute4() const;
+
+				/**
+				 * @return attribute5 or its default value if !isValid().
+				 */
+				double getAttribute5() const;
+
+			private:
+				odcore::serialization::ByteSpan m_data;
+		};
+
+		/**
+		 * @return Flat representation of this message.
+		 */
+		Flat toFlat() const;
+
+		/**
+		 * This method sets the attributes from a flat representation.
+		 *
+		 * @param f Flat representation.
+		 */
+		void fromFlat(const Flat &f);
+
+	public:
+		/**
+		 * This method returns the message id.
+		 *
+		 * @return Message id.
+		 */
+		static int32_t ID();
+
+		/**
+		 * This method returns the short message name.
+		 *
+		 * @return Short message name.
+		 */
+		static const string ShortName();
+
+		/**
+		 * This method returns the long message name include package/sub structure.
+		 *
+		 * @return Long message name.
+		 */
+		static const string LongName();
+
+		/**
+		 * This method returns the message id.
+		 *
+		 * @return Message id.
+		 */
+		virtual int32_t getID() const;
+
+		/**
+		 * This method returns the short message name.
+		 *
+		 * @return Short message name.
+		 */
+		virtual const string getShortName() const;
+
+		/**
+		 * This method returns the long message name include package/sub structure.
+		 *
+		 * @return Long message name.
+		 */
+		virtual const string getLongName() const;
+
+	public:
+		virtual void accept(odcore::base::Visitor &v);
+
+		virtual ostream& operator<<(ostream &out) const;
+		virtual istream& operator>>(istream &in);
+
+		/**
+		 * This method returns the number of bytes needed to encode
+		 * this message in its flat representation (i.e. FLAT_SIZE).
+		 *
+		 * @return Number of bytes.
+		 */
+		uint32_t getEncodedSize() const;
+
+		/**
+		 * This method encodes this message in its flat representation
+		 * into a pre-sized buffer (cf. getEncodedSize()).
+		 *
+		 * @param out ByteWriter to write to.
+		 */
+		void encodeTo(odcore::serialization::ByteWriter &out) const;
+
+		/**
+		 * This method decodes this message from bytes encoded in
+		 * its flat representation.
+		 *
+		 * @param in Bytes to decode from.
+		 * @return true if the bytes were well-formed.
+		 */
+		bool decodeFrom(const odcore::serialization::ByteSpan &in);
+
+		virtual const string toString() const;
+
+	private:
+		bool m_attribute1;
+	private:
+		int32_t m_attribute2;
+	private:
+		uint32_t m_attribute3;
+	private:
+		float m_attribute4;
+	private:
+		double m_attribute5;
+
+};
+
+#endif /*TEST21_H*/
@@ -0,0 +1,42 @@
+/*
+ * THIS IS A GENERATED FILE - CHANGES WILL BE OVERWRITTEN.
+ */
+
+#include <iostream>
+#include <test21/GeneratedHeaders_Test21.h>
+#include <test21/GeneratedHeaders_Test21_Helper.h>
+#include <opendavinci/odcore/base/Visitable.h>
+#include <opendavinci/odcore/reflection/MessageFromVisitableVisitor.h>
+extern "C" {
+    odcore::reflection::Helper *newHelper() {
+        return new GeneratedHeaders_Test21_Helper;
+    }
+    void deleteHelper(odcore::reflection::Helper *h) {
+        delete h;
+    }
+}
+GeneratedHeaders_Test21_Helper::~GeneratedHeaders_Test21_Helper() {}
+void GeneratedHeaders_Test21_Helper::delegateVistor(odcore::data::Container &c, odcore::base::Visitor &v, bool &successfullyDelegated) {
+    GeneratedHeaders_Test21_Helper::__delegateVistor(c, v, successfullyDelegated);
+}
+odcore::reflection::Message GeneratedHeaders_Test21_Helper::map(odcore::data::Container &c, bool &successfullyMapped) {
+    return GeneratedHeaders_Test21_Helper::__map(c, successfullyMapped);
+}
+void GeneratedHeaders_Test21_Helper::__delegateVistor(odcore::data::Container &c, odcore::base::Visitor &v, bool &successfullyDelegated) {
+    successfullyDelegated = false;
+    if (c.getDataType() == Test21::ID()) {
+        Test21 payload = c.getData<Test21>();
+        payload.accept(v);
+        successfullyDelegated = true;
+    }
+}
+odcore::reflection::Message GeneratedHeaders_Test21_Helper::__map(odcore::data::Container &c, bool &successfullyMapped) {
+    successfullyMapped = false;
+    odcore::reflection::Message msg;
+    odcore::reflection::MessageFromVisitableVisitor mfvv;
+    __delegateVistor(c, mfvv, successfullyMapped);
+    if (successfullyMapped) {
+        msg = mfvv.getMessage();
+    }
+    return msg;
+}
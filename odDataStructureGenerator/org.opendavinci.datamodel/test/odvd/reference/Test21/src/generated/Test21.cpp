@@ -0,0 +1,277 @@
+/*
+ * This software is open source. Please see COPYING and AUTHORS for further information.
+ *
+ * This file is auto-generated. DO NOT CHANGE AS YOUR CHANGES MIGHT BE OVERWRITTEN!
+ */
+
+#include <memory>
+#include <type_traits>
+
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
+#include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/FlatCodec.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
+#include <opendavinci/odcore/serialization/SerializationFactory.h>
+#include <opendavinci/odcore/serialization/Serializer.h>
+
+#include "test21/generated/Test21.h"
+
+	using namespace std;
+	using namespace odcore::base;
+	using namespace odcore::serialization;
+
+
+	Test21::Test21() :
+	    SerializableData(), Visitable()
+		, m_attribute1(false)
+		, m_attribute2(0)
+		, m_attribute3(0)
+		, m_attribute4(0)
+		, m_attribute5(0.0)
+	{
+	}
+
+	Test21::Test21(
+		const bool &val0, 
+		const int32_t &val1, 
+		const uint32_t &val2, 
+		const float &val3, 
+		const double &val4
+	) :
+	    SerializableData(), Visitable()
+		, m_attribute1(val0)
+		, m_attribute2(val1)
+		, m_attribute3(val2)
+		, m_attribute4(val3)
+		, m_attribute5(val4)
+	{
+	}
+
+	Test21::Test21(const Test21 &obj) :
+	    SerializableData(), Visitable()
+		, m_attribute1(obj.m_attribute1)
+		, m_attribute2(obj.m_attribute2)
+		, m_attribute3(obj.m_attribute3)
+		, m_attribute4(obj.m_attribute4)
+		, m_attribute5(obj.m_attribute5)
+	{
+	}
+	
+	Test21::~Test21() {
+	}
+
+	Test21& Test21::operator=(const Test21 &obj) {
+		m_attribute1 = obj.m_attribute1;
+		m_attribute2 = obj.m_attribute2;
+		m_attribute3 = obj.m_attribute3;
+		m_attribute4 = obj.m_attribute4;
+		m_attribute5 = obj.m_attribute5;
+		return (*this);
+	}
+
+	int32_t Test21::ID() {
+		return 21;
+	}
+
+	const string Test21::ShortName() {
+		return "Test21";
+	}
+
+	const string Test21::LongName() {
+		return "Test21";
+	}
+
+	int32_t Test21::getID() const {
+		return Test21::ID();
+	}
+
+	const string Test21::getShortName() const {
+		return Test21::ShortName();
+	}
+
+	const string Test21::getLongName() const {
+		return Test21::LongName();
+	}
+
+	bool Test21::getAttribute1() const {
+		return m_attribute1;
+	}
+	
+	void Test21::setAttribute1(const bool &val) {
+		m_attribute1 = val;
+	}
+	int32_t Test21::getAttribute2() const {
+		return m_attribute2;
+	}
+	
+	void Test21::setAttribute2(const int32_t &val) {
+		m_attribute2 = val;
+	}
+	uint32_t Test21::getAttribute3() const {
+		return m_attribute3;
+	}
+	
+	void Test21::setAttribute3(const uint32_t &val) {
+		m_attribute3 = val;
+	}
+	float Test21::getAttribute4() const {
+		return m_attribute4;
+	}
+	
+	void Test21::setAttribute4(const float &val) {
+		m_attribute4 = val;
+	}
+	double Test21::getAttribute5() const {
+		return m_attribute5;
+	}
+	
+	void Test21::setAttribute5(const double &val) {
+		m_attribute5 = val;
+	}
+
+	void Test21::accept(odcore::base::Visitor &v) {
+		v.beginVisit(ID(), ShortName(), LongName());
+		v.visit(1, "Test21.attribute1", "attribute1", m_attribute1);
+		v.visit(2, "Test21.attribute2", "attribute2", m_attribute2);
+		v.visit(3, "Test21.attribute3", "attribute3", m_attribute3);
+		v.visit(4, "Test21.attribute4", "attribute4", m_attribute4);
+		v.visit(5, "Test21.attribute5", "attribute5", m_attribute5);
+		v.endVisit();
+	}
+
+	const string Test21::toString() const {
+		stringstream s;
+
+		s << "Attribute1: " << getAttribute1() << " ";
+		s << "Attribute2: " << getAttribute2() << " ";
+		s << "Attribute3: " << getAttribute3() << " ";
+		s << "Attribute4: " << getAttribute4() << " ";
+		s << "Attribute5: " << getAttribute5() << " ";
+
+		return s.str();
+	}
+
+	ostream& Test21::operator<<(ostream &out) const {
+		SerializationFactory& sf = SerializationFactory::getInstance();
+
+		if (sf.usesDefaultSerialization()) {
+			// Encode directly without any virtual method calls in the fixed layout.
+			return ProtoEncoder::encode(out, *this);
+		}
+
+		std::shared_ptr<Serializer> s = sf.getSerializer(out);
+
+		s->write(1,
+				m_attribute1);
+		s->write(2,
+				m_attribute2);
+		s->write(3,
+				m_attribute3);
+		s->write(4,
+				m_attribute4);
+		s->write(5,
+				m_attribute5);
+		return out;
+	}
+
+	istream& Test21::operator>>(istream &in) {
+		SerializationFactory& sf = SerializationFactory::getInstance();
+
+		if (sf.usesDefaultSerialization()) {
+			// Decode directly without any virtual method calls from the fixed layout.
+			return ProtoDecoder::decode(in, *this);
+		}
+
+		std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
+
+		d->read(1,
+				m_attribute1);
+		d->read(2,
+				m_attribute2);
+		d->read(3,
+				m_attribute3);
+		d->read(4,
+				m_attribute4);
+		d->read(5,
+				m_attribute5);
+		return in;
+	}
+
+	const uint32_t Test21::FLAT_SIZE;
+
+	static_assert(std::is_pod<Test21::Flat>::value, "Test21::Flat must be a plain old data type.");
+
+	Test21::View::View(const char *data, const uint32_t &length) :
+		m_data(data, length) {}
+
+	Test21::View::View(const ByteSpan &in) :
+		m_data(in) {}
+
+	bool Test21::View::isValid() const {
+		return (m_data.getLength() >= FLAT_SIZE);
+	}
+
+	bool Test21::View::getAttribute1() const {
+		return isValid() ? FlatCodec::read<bool>(m_data.getData() + 0) : bool();
+	}
+
+	int32_t Test21::View::getAttribute2() const {
+		return isValid() ? FlatCodec::read<int32_t>(m_data.getData() + 1) : int32_t();
+	}
+
+	uint32_t Test21::View::getAttribute3() const {
+		return isValid() ? FlatCodec::read<uint32_t>(m_data.getData() + 5) : uint32_t();
+	}
+
+	float Test21::View::getAttribute4() const {
+		return isValid() ? FlatCodec::read<float>(m_data.getData() + 9) : float();
+	}
+
+	double Test21::View::getAttribute5() const {
+		return isValid() ? FlatCodec::read<double>(m_data.getData() + 13) : double();
+	}
+
+	Test21::Flat Test21::toFlat() const {
+		Flat f;
+		f.attribute1 = m_attribute1;
+		f.attribute2 = m_attribute2;
+		f.attribute3 = m_attribute3;
+		f.attribute4 = m_attribute4;
+		f.attribute5 = m_attribute5;
+		return f;
+	}
+
+	void Test21::fromFlat(const Flat &f) {
+		m_attribute1 = f.attribute1;
+		m_attribute2 = f.attribute2;
+		m_attribute3 = f.attribute3;
+		m_attribute4 = f.attribute4;
+		m_attribute5 = f.attribute5;
+	}
+
+	uint32_t Test21::getEncodedSize() const {
+		return FLAT_SIZE;
+	}
+
+	void Test21::encodeTo(ByteWriter &out) const {
+		FlatCodec::write(out, m_attribute1);
+		FlatCodec::write(out, m_attribute2);
+		FlatCodec::write(out, m_attribute3);
+		FlatCodec::write(out, m_attribute4);
+		FlatCodec::write(out, m_attribute5);
+	}
+
+	bool Test21::decodeFrom(const ByteSpan &in) {
+		if (in.getLength() < FLAT_SIZE) {
+			return false;
+		}
+
+		m_attribute1 = FlatCodec::read<bool>(in.getData() + 0);
+		m_attribute2 = FlatCodec::read<int32_t>(in.getData() + 1);
+		m_attribute3 = FlatCodec::read<uint32_t>(in.getData() + 5);
+		m_attribute4 = FlatCodec::read<float>(in.getData() + 9);
+		m_attribute5 = FlatCodec::read<double>(in.getData() + 13);
+		return true;
+	}
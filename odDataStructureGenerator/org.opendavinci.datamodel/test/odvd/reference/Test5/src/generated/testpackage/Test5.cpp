@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -179,6 +183,11 @@ namespace testpackage {
 		ostream& Test5::operator<<(ostream &out) const {
 			SerializationFactory& sf = SerializationFactory::getInstance();
 	
+			if (sf.usesDefaultSerialization()) {
+				// Encode directly without any virtual method calls.
+				return ProtoEncoder::encode(out, *this);
+			}
+	
 			std::shared_ptr<Serializer> s = sf.getSerializer(out);
 	
 			s->write(1,
@@ -201,6 +210,11 @@ namespace testpackage {
 		istream& Test5::operator>>(istream &in) {
 			SerializationFactory& sf = SerializationFactory::getInstance();
 	
+			if (sf.usesDefaultSerialization()) {
+				// Decode directly without any virtual method calls.
+				return ProtoDecoder::decode(in, *this);
+			}
+	
 			std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 	
 			d->read(1,
@@ -219,4 +233,58 @@ namespace testpackage {
 					m_attribute7);
 			return in;
 		}
+	
+		uint32_t Test5::getEncodedSize() const {
+			uint32_t size = 0;
+			size += ProtoEncoder::getSize(1, m_attribute1);
+			size += ProtoEncoder::getSize(2, m_attribute2);
+			size += ProtoEncoder::getSize(3, m_attribute3);
+			size += ProtoEncoder::getSize(4, m_attribute4);
+			size += ProtoEncoder::getSize(5, m_attribute5);
+			size += ProtoEncoder::getSize(6, m_attribute6);
+			size += ProtoEncoder::getSize(7, m_attribute7);
+			return size;
+		}
+	
+		void Test5::encodeTo(ByteWriter &out) const {
+			ProtoEncoder::write(out, 1, m_attribute1);
+			ProtoEncoder::write(out, 2, m_attribute2);
+			ProtoEncoder::write(out, 3, m_attribute3);
+			ProtoEncoder::write(out, 4, m_attribute4);
+			ProtoEncoder::write(out, 5, m_attribute5);
+			ProtoEncoder::write(out, 6, m_attribute6);
+			ProtoEncoder::write(out, 7, m_attribute7);
+		}
+	
+		bool Test5::decodeFrom(const ByteSpan &in) {
+			ProtoDecoder d(in);
+			while (d.next()) {
+				switch (d.getFieldId()) {
+					case 1:
+						d.read(m_attribute1);
+					break;
+					case 2:
+						d.read(m_attribute2);
+					break;
+					case 3:
+						d.read(m_attribute3);
+					break;
+					case 4:
+						d.read(m_attribute4);
+					break;
+					case 5:
+						d.read(m_attribute5);
+					break;
+					case 6:
+						d.read(m_attribute6);
+					break;
+					case 7:
+						d.read(m_attribute7);
+					break;
+					default:
+					break;
+				}
+			}
+			return d.isGood();
+		}
 } // testpackage
@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -123,6 +127,11 @@ namespace testpackage {
 		ostream& Test7A::operator<<(ostream &out) const {
 			SerializationFactory& sf = SerializationFactory::getInstance();
 	
+			if (sf.usesDefaultSerialization()) {
+				// Encode directly without any virtual method calls.
+				return ProtoEncoder::encode(out, *this);
+			}
+	
 			std::shared_ptr<Serializer> s = sf.getSerializer(out);
 	
 			s->write(1,
@@ -137,6 +146,11 @@ namespace testpackage {
 		istream& Test7A::operator>>(istream &in) {
 			SerializationFactory& sf = SerializationFactory::getInstance();
 	
+			if (sf.usesDefaultSerialization()) {
+				// Decode directly without any virtual method calls.
+				return ProtoDecoder::decode(in, *this);
+			}
+	
 			std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 	
 			d->read(1,
@@ -147,4 +161,38 @@ namespace testpackage {
 					m_attribute3);
 			return in;
 		}
+	
+		uint32_t Test7A::getEncodedSize() const {
+			uint32_t size = 0;
+			size += ProtoEncoder::getSize(1, m_attribute1);
+			size += ProtoEncoder::getSize(2, m_attribute2);
+			size += ProtoEncoder::getSize(3, m_attribute3);
+			return size;
+		}
+	
+		void Test7A::encodeTo(ByteWriter &out) const {
+			ProtoEncoder::write(out, 1, m_attribute1);
+			ProtoEncoder::write(out, 2, m_attribute2);
+			ProtoEncoder::write(out, 3, m_attribute3);
+		}
+	
+		bool Test7A::decodeFrom(const ByteSpan &in) {
+			ProtoDecoder d(in);
+			while (d.next()) {
+				switch (d.getFieldId()) {
+					case 1:
+						d.read(m_attribute1);
+					break;
+					case 2:
+						d.read(m_attribute2);
+					break;
+					case 3:
+						d.read(m_attribute3);
+					break;
+					default:
+					break;
+				}
+			}
+			return d.isGood();
+		}
 } // testpackage
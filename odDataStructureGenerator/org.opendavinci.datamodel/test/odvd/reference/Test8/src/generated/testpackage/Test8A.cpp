@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include <opendavinci/odcore/serialization/ByteSpan.h>
+#include <opendavinci/odcore/serialization/ByteWriter.h>
 #include <opendavinci/odcore/serialization/Deserializer.h>
+#include <opendavinci/odcore/serialization/ProtoDecoder.h>
+#include <opendavinci/odcore/serialization/ProtoEncoder.h>
 #include <opendavinci/odcore/serialization/SerializationFactory.h>
 #include <opendavinci/odcore/serialization/Serializer.h>
 
@@ -95,6 +99,11 @@ namespace testpackage {
 		ostream& Test8A::operator<<(ostream &out) const {
 			SerializationFactory& sf = SerializationFactory::getInstance();
 	
+			if (sf.usesDefaultSerialization()) {
+				// Encode directly without any virtual method calls.
+				return ProtoEncoder::encode(out, *this);
+			}
+	
 			std::shared_ptr<Serializer> s = sf.getSerializer(out);
 	
 			s->write(1,
@@ -105,10 +114,39 @@ namespace testpackage {
 		istream& Test8A::operator>>(istream &in) {
 			SerializationFactory& sf = SerializationFactory::getInstance();
 	
+			if (sf.usesDefaultSerialization()) {
+				// Decode directly without any virtual method calls.
+				return ProtoDecoder::decode(in, *this);
+			}
+	
 			std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
 	
 			d->read(1,
 					m_attribute1);
 			return in;
 		}
+	
+		uint32_t Test8A::getEncodedSize() const {
+			uint32_t size = 0;
+			size += ProtoEncoder::getSize(1, m_attribute1);
+			return size;
+		}
+	
+		void Test8A::encodeTo(ByteWriter &out) const {
+			ProtoEncoder::write(out, 1, m_attribute1);
+		}
+	
+		bool Test8A::decodeFrom(const ByteSpan &in) {
+			ProtoDecoder d(in);
+			while (d.next()) {
+				switch (d.getFieldId()) {
+					case 1:
+						d.read(m_attribute1);
+					break;
+					default:
+					break;
+				}
+			}
+			return d.isGood();
+		}
 } // testpackage
@@ -1752,5 +1752,40 @@ public class DataStructureGeneratorTest {
 			org.junit.Assert.fail(e.toString());
 		}
 	}
+
+	@Test
+	public void test_generateFile_Test21() {
+		try {
+			int EXPECTED_RETVAL = 0;
+			boolean withCMake = false;
+			
+			TestDataSet tds = new TestDataSet(EXPECTED_RETVAL,
+					PATH_FOR_INPUT_FILES + "Test21.odvd",
+					withCMake,
+					new String[]{"include/test21/generated/Test21.h",
+					             "src/generated/Test21.cpp"},       /* List of generated files. */
+		            new String[]{"Test21/include/test21/generated/Test21.h",
+            					 "Test21/src/generated/Test21.cpp"}  /* List of reference files. */
+                    );
+			
+			org.junit.Assert.assertTrue("Initialization of DataStructureGenerator with '" + tds.get_args() + "' successful.", tds.isSuccessfullyInitialized());
+			org.junit.Assert.assertTrue("Calling DataStructureGenerator with '" + tds.get_args() + "'.", DataStructureGenerator.process(tds.get_args()) == tds.getExpectedRetVal());
+			org.junit.Assert.assertTrue("Generation of DataStructureGenerator with '" + tds.get_args() + "' successful.", tds.isSuccessfullyGenerated());
+
+			HashMap<String, DataStructureGeneratorTest.Entry> results = tds.getEntriesToCompare();
+			for (Map.Entry<String, DataStructureGeneratorTest.Entry> entry : results.entrySet()) {
+			    String key = entry.getKey();
+			    Entry value = entry.getValue();
+			    
+				org.junit.Assert.assertTrue(key, value.equal);
+			}
+			
+			tds.removeGeneratedFiles();
+		} catch (FileNotFoundException e) {
+			org.junit.Assert.fail(e.toString());
+		} catch (IOException e) {
+			org.junit.Assert.fail(e.toString());
+		}
+	}
 }
 
@@ -42,6 +42,7 @@
 #include "opendavinci/odcore/dmcp/discoverer/Client.h"
 #include "opendavinci/odcore/dmcp/discoverer/Server.h"
 #include "opendavinci/odcore/exceptions/Exceptions.h"
+#include "opendavinci/odcore/io/Reactor.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
 #include "opendavinci/odcore/io/conference/ContainerConferenceFactory.h"
 #include "opendavinci/odcore/strings/StringToolbox.h"
@@ -102,6 +103,14 @@ namespace odsupercomponent {
         // Parse command line arguments.
         parseAdditionalCommandLineParameters(argc, argv);
 
+        // Serve all sockets created from here on by a few shared I/O threads if configured.
+        try {
+            Reactor::setNumberOfThreads(m_configuration.getValue<uint32_t>("odsupercomponent.iothreads"));
+        }
+        catch(...) {
+            // If "odsupercomponent.iothreads" is not specified, use one thread per socket.
+        }
+
         const uint32_t SERVER_PORT = odcore::data::dmcp::Constants::CONNECTIONSERVER_PORT_BASE + getCID();
         // Listen on all interfaces.
         ServerInformation serverInformation("0.0.0.0", SERVER_PORT, m_managedLevel);
@@ -63,6 +63,8 @@ namespace odredirector {
 
             virtual void add(odcore::data::Container &container);
 
+            virtual void add(odcore::data::Container &&container);
+
             virtual void clear();
 
             virtual uint32_t getSize() const;
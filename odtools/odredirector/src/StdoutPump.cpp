@@ -100,6 +100,10 @@ namespace odredirector {
         std::cout.flush();
     }
 
+    void StdoutPump::add(odcore::data::Container &&container) {
+        add(container);
+    }
+
     void StdoutPump::clear() {}
 
     uint32_t StdoutPump::getSize() const {